@@ -0,0 +1,167 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/grading.hpp>
+#include <chomp/util/cache.hpp>
+#include <chomp/util/constants.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace chomp::core {
+
+namespace {
+
+constexpr std::size_t CACHE_SIZE = 1 << 12;
+constexpr std::size_t KEY_COUNT = 1 << 16;
+
+// Key sequence drawn from a working set of `keys` distinct values; a working
+// set smaller than the cache is hit-heavy, a larger one miss-heavy.
+std::vector<std::uint64_t> make_keys(std::size_t keys) {
+  std::vector<std::uint64_t> result;
+  result.reserve(KEY_COUNT);
+  std::uint64_t state = 1;
+  for (std::size_t index = 0; index < KEY_COUNT; ++index) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    result.push_back((state >> 33) % keys);
+  }
+  return result;
+}
+
+// Value construction cheap enough that the cache bookkeeping dominates.
+std::uint64_t square(const std::uint64_t& key) {
+  return key * key;
+}
+
+template <typename C>
+void BM_CacheAccess(benchmark::State& state) {
+  const std::vector<std::uint64_t> keys =
+      make_keys(static_cast<std::size_t>(state.range(0)));
+  C cache(square, CACHE_SIZE);
+  std::size_t index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cache[keys[index]]);
+    index = (index + 1) % KEY_COUNT;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["working_set"] = static_cast<double>(state.range(0));
+}
+
+using LRU = LRUCache<std::uint64_t, std::uint64_t>;
+using Clock = ClockCache<std::uint64_t, std::uint64_t>;
+using Sharded = ShardedLRUCache<std::uint64_t, std::uint64_t>;
+
+// Working sets at a quarter of, equal to, and sixteen times the capacity
+BENCHMARK(BM_CacheAccess<LRU>)
+    ->Arg(CACHE_SIZE / 4)
+    ->Arg(CACHE_SIZE)
+    ->Arg(CACHE_SIZE * 16);
+BENCHMARK(BM_CacheAccess<Clock>)
+    ->Arg(CACHE_SIZE / 4)
+    ->Arg(CACHE_SIZE)
+    ->Arg(CACHE_SIZE * 16);
+BENCHMARK(BM_CacheAccess<Sharded>)
+    ->Arg(CACHE_SIZE / 4)
+    ->Arg(CACHE_SIZE)
+    ->Arg(CACHE_SIZE * 16);
+
+// One cache shared by all benchmark threads; threads start at different keys.
+void BM_SharedCacheAccess(benchmark::State& state) {
+  static std::unique_ptr<Sharded> cache;
+  const std::vector<std::uint64_t> keys =
+      make_keys(static_cast<std::size_t>(state.range(0)));
+  if (state.thread_index() == 0) {
+    cache = std::make_unique<Sharded>(square, CACHE_SIZE);
+  }
+  std::size_t index = KEY_COUNT / static_cast<std::size_t>(state.threads()) *
+                      static_cast<std::size_t>(state.thread_index());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize((*cache)[keys[index]]);
+    index = (index + 1) % KEY_COUNT;
+  }
+  if (state.thread_index() == 0) {
+    cache.reset();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SharedCacheAccess)
+    ->Arg(CACHE_SIZE / 4)
+    ->Arg(CACHE_SIZE * 16)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// Grading of the cells of a 3-dimensional box with an expensive enough lookup
+// (a hashed set of cubes) for caching to matter.
+constexpr std::size_t GRADING_SIDE = 32;
+
+using Grading3 = SetGrading<Cube<3>, 0, 1>;
+
+Grading3 make_grading() {
+  DefaultSet<Cube<3>> cubes;
+  CubeOrthant<3> orthant;
+  for (std::size_t index = 0; index < GRADING_SIDE * GRADING_SIDE; ++index) {
+    orthant[0] = static_cast<HypercubeCoordinate>(index % GRADING_SIDE);
+    orthant[1] = static_cast<HypercubeCoordinate>(index / GRADING_SIDE);
+    orthant[2] = static_cast<HypercubeCoordinate>(index % 7);
+    cubes.insert(Cube<3>(orthant, 7));
+  }
+  return Grading3(cubes);
+}
+
+std::vector<Cube<3>> make_cubes(std::size_t count) {
+  std::vector<Cube<3>> cubes;
+  cubes.reserve(KEY_COUNT);
+  for (std::uint64_t key : make_keys(count)) {
+    CubeOrthant<3> orthant;
+    orthant[0] = static_cast<HypercubeCoordinate>(key % GRADING_SIDE);
+    orthant[1] = static_cast<HypercubeCoordinate>(key / GRADING_SIDE % 32);
+    orthant[2] = static_cast<HypercubeCoordinate>(key / 1024 % 32);
+    cubes.push_back(Cube<3>(orthant, key % 8));
+  }
+  return cubes;
+}
+
+template <typename G>
+void BM_Grading(benchmark::State& state) {
+  const std::vector<Cube<3>> cubes =
+      make_cubes(static_cast<std::size_t>(state.range(0)));
+  G grading = [] {
+    if constexpr (std::same_as<G, Grading3>) {
+      return make_grading();
+    } else {
+      return G(make_grading(), CACHE_SIZE);
+    }
+  }();
+  std::size_t index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(grading(cubes[index]));
+    index = (index + 1) % KEY_COUNT;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+using CachedGrading3 = CachedGradingWrapper<Grading3>;
+using ClockGrading3 = CachedGradingWrapper<
+    Grading3, DefaultMap, ClockCache<Cube<3>, GradingResultType>>;
+
+BENCHMARK(BM_Grading<Grading3>)->Arg(CACHE_SIZE / 4)->Arg(CACHE_SIZE * 16);
+BENCHMARK(BM_Grading<CachedGrading3>)
+    ->Arg(CACHE_SIZE / 4)
+    ->Arg(CACHE_SIZE * 16);
+BENCHMARK(BM_Grading<ClockGrading3>)
+    ->Arg(CACHE_SIZE / 4)
+    ->Arg(CACHE_SIZE * 16);
+
+}  // namespace
+
+}  // namespace chomp::core
@@ -0,0 +1,260 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/algebra/modules.hpp>
+#include <chomp/complexes/cached.hpp>
+#include <chomp/complexes/complexes.hpp>
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/dense.hpp>
+#include <chomp/complexes/filtration.hpp>
+#include <chomp/complexes/grading.hpp>
+#include <chomp/complexes/morse.hpp>
+#include <chomp/complexes/tiling.hpp>
+#include <chomp/util/constants.hpp>
+#include <chomp/util/parallel.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace chomp::core {
+
+namespace {
+
+// Grading with a single grade, so that only the cell operations are measured.
+template <std::size_t CCDIM>
+struct ConstantGrading {
+  using InputType = Cube<CCDIM>;
+  GradingResultType operator()(const InputType&) const noexcept {
+    return 0;
+  }
+};
+
+template <std::size_t CCDIM>
+using BenchComplex = CubicalComplex<CCDIM, ConstantGrading<CCDIM>>;
+
+// Box with `side` orthants along each axis
+template <std::size_t CCDIM>
+BenchComplex<CCDIM> make_complex(std::int64_t side) {
+  CubeOrthant<CCDIM> maximum;
+  maximum.fill(static_cast<HypercubeCoordinate>(side - 1));
+  return BenchComplex<CCDIM>(maximum, ConstantGrading<CCDIM>());
+}
+
+// Cells are visited with a prime stride to wander through the whole box.
+constexpr std::size_t CELL_STRIDE = 7919;
+
+template <std::size_t CCDIM>
+void BM_CubicalBoundary(benchmark::State& state) {
+  BenchComplex<CCDIM> complex = make_complex<CCDIM>(state.range(0));
+  const std::size_t count = complex.cell_count();
+  std::size_t index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(boundary(complex, complex.cell_at(index)));
+    index = (index + CELL_STRIDE) % count;
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["cells"] = static_cast<double>(count);
+}
+
+template <std::size_t CCDIM>
+void BM_CubicalBoundaryIf(benchmark::State& state) {
+  BenchComplex<CCDIM> complex = make_complex<CCDIM>(state.range(0));
+  const std::size_t count = complex.cell_count();
+  const auto is_outer = [](const Cube<CCDIM>& face) {
+    return face.coordinate(0) % 2 == 0;
+  };
+  std::size_t index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        boundary_if(complex, complex.cell_at(index), is_outer)
+    );
+    index = (index + CELL_STRIDE) % count;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <std::size_t CCDIM>
+void BM_CubicalForEachBoundary(benchmark::State& state) {
+  BenchComplex<CCDIM> complex = make_complex<CCDIM>(state.range(0));
+  const std::size_t count = complex.cell_count();
+  std::size_t index = 0;
+  for (auto _ : state) {
+    std::size_t faces = 0;
+    for_each_boundary(
+        complex, complex.cell_at(index),
+        [&faces](const Cube<CCDIM>&, const Z<2>&) { ++faces; }
+    );
+    benchmark::DoNotOptimize(faces);
+    index = (index + CELL_STRIDE) % count;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <std::size_t CCDIM>
+void BM_CubicalCoboundary(benchmark::State& state) {
+  BenchComplex<CCDIM> complex = make_complex<CCDIM>(state.range(0));
+  const std::size_t count = complex.cell_count();
+  std::size_t index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(coboundary(complex, complex.cell_at(index)));
+    index = (index + CELL_STRIDE) % count;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Boundary of the chain of all top-dimensional cells; arguments are the side
+// of the box and the number of threads, with 0 for the sequential policy.
+template <std::size_t CCDIM>
+void BM_ChainBoundary(benchmark::State& state) {
+  BenchComplex<CCDIM> complex = make_complex<CCDIM>(state.range(0));
+  using Chain = typename BenchComplex<CCDIM>::ChainType;
+  Chain chain;
+  for (const Cube<CCDIM>& cell : complex.cells_of_dimension(CCDIM)) {
+    chain.insert(cell, one<Z<2>>());
+  }
+  const std::size_t threads = static_cast<std::size_t>(state.range(1));
+  for (auto _ : state) {
+    if (threads == 0) {
+      benchmark::DoNotOptimize(boundary(complex, chain));
+    } else {
+      benchmark::DoNotOptimize(
+          boundary(complex, chain, ParallelPolicy{.threads = threads})
+      );
+    }
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(chain.size())
+  );
+}
+
+// Coreduction of a whole box, either at once or by tiles of the given side.
+template <std::size_t CCDIM>
+void BM_MorseReduction(benchmark::State& state) {
+  BenchComplex<CCDIM> complex = make_complex<CCDIM>(state.range(0));
+  const std::size_t tile_side = static_cast<std::size_t>(state.range(1));
+  std::array<std::size_t, CCDIM> shape;
+  shape.fill(tile_side);
+  for (auto _ : state) {
+    if (tile_side == 0) {
+      benchmark::DoNotOptimize(MorseMatching(complex, complex.cells()));
+    } else {
+      benchmark::DoNotOptimize(tiled_morse_matching(
+          complex, CubicalTiling<CCDIM>(complex, shape)
+      ));
+    }
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(complex.cell_count())
+  );
+}
+
+// Coreduction through `CachedChainComplex`, with a budget for the whole box;
+// as the grading is trivial, this measures the overhead of the cache.
+template <std::size_t CCDIM>
+void BM_CachedMorseReduction(benchmark::State& state) {
+  BenchComplex<CCDIM> complex = make_complex<CCDIM>(state.range(0));
+  for (auto _ : state) {
+    CachedChainComplex cached(complex, std::size_t(1) << 30);
+    benchmark::DoNotOptimize(MorseMatching(cached, complex.cells()));
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(complex.cell_count())
+  );
+}
+
+// Boundary matrices of each of `levels` grade levels of a 2D box, either by
+// one pass over the box per level or from a single `Filtration`.
+void BM_LevelMatrices(benchmark::State& state) {
+  using Grading = DenseGrading<2, 0, 255>;
+  using Complex = CubicalComplex<2, Grading>;
+  const std::int64_t side = state.range(0);
+  const std::size_t levels = static_cast<std::size_t>(state.range(1));
+  const bool filtered = state.range(2) != 0;
+  std::vector<int> voxels(static_cast<std::size_t>(side * side));
+  for (std::size_t voxel = 0; voxel < voxels.size(); ++voxel) {
+    voxels[voxel] = static_cast<int>((voxel * CELL_STRIDE) % levels);
+  }
+  CubeOrthant<2> maximum;
+  maximum.fill(static_cast<HypercubeCoordinate>(side - 1));
+  Complex complex(
+      maximum, Grading({0, 0}, maximum, voxels.cbegin(), voxels.cend())
+  );
+  for (auto _ : state) {
+    std::size_t nonzeros = 0;
+    if (filtered) {
+      const Filtration filtration(complex, complex.cells());
+      for (std::size_t level = 0; level < filtration.levels().size();
+           ++level) {
+        nonzeros += filtration.level_matrix(level).nonzeros();
+      }
+    } else {
+      for (std::size_t level = 0; level < levels; ++level) {
+        nonzeros += complex.boundary_matrix(level).matrix.nonzeros();
+      }
+    }
+    benchmark::DoNotOptimize(nonzeros);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(complex.cell_count())
+  );
+}
+
+BENCHMARK(BM_CubicalBoundary<2>)->RangeMultiplier(4)->Range(16, 256);
+BENCHMARK(BM_CubicalBoundary<3>)->RangeMultiplier(4)->Range(16, 256);
+BENCHMARK(BM_CubicalBoundary<4>)->RangeMultiplier(2)->Range(8, 64);
+BENCHMARK(BM_CubicalBoundary<5>)->RangeMultiplier(2)->Range(4, 32);
+BENCHMARK(BM_CubicalBoundary<6>)->RangeMultiplier(2)->Range(4, 16);
+
+BENCHMARK(BM_CubicalBoundaryIf<2>)->Arg(256);
+BENCHMARK(BM_CubicalBoundaryIf<3>)->Arg(256);
+BENCHMARK(BM_CubicalBoundaryIf<6>)->Arg(16);
+
+BENCHMARK(BM_CubicalForEachBoundary<2>)->Arg(256);
+BENCHMARK(BM_CubicalForEachBoundary<3>)->Arg(256);
+BENCHMARK(BM_CubicalForEachBoundary<4>)->Arg(64);
+BENCHMARK(BM_CubicalForEachBoundary<5>)->Arg(32);
+BENCHMARK(BM_CubicalForEachBoundary<6>)->Arg(16);
+
+BENCHMARK(BM_CubicalCoboundary<2>)->Arg(256);
+BENCHMARK(BM_CubicalCoboundary<3>)->Arg(256);
+BENCHMARK(BM_CubicalCoboundary<6>)->Arg(16);
+
+BENCHMARK(BM_ChainBoundary<2>)
+    ->ArgsProduct({{64, 256}, {0, 4}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ChainBoundary<3>)
+    ->ArgsProduct({{16, 64}, {0, 4}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_MorseReduction<2>)
+    ->ArgsProduct({{32, 128}, {0, 16}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MorseReduction<3>)
+    ->ArgsProduct({{16, 32}, {0, 8}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CachedMorseReduction<2>)
+    ->Arg(32)
+    ->Arg(128)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_CachedMorseReduction<3>)
+    ->Arg(16)
+    ->Arg(32)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_LevelMatrices)
+    ->ArgsProduct({{64, 256}, {4, 32}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+}  // namespace chomp::core
@@ -0,0 +1,97 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/cyclic.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace chomp::core {
+
+namespace {
+
+template <int p>
+std::vector<Z<p>> make_coefficients(std::size_t count, std::uint64_t seed) {
+  std::vector<Z<p>> result;
+  result.reserve(count);
+  std::uint64_t state = seed;
+  for (std::size_t index = 0; index < count; ++index) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    result.push_back(Z<p>(static_cast<int>((state >> 33) % p)));
+  }
+  return result;
+}
+
+constexpr std::size_t COEFFICIENT_COUNT = 1 << 12;
+
+template <int p>
+void BM_CyclicArithmetic(benchmark::State& state) {
+  const std::vector<Z<p>> lhs = make_coefficients<p>(COEFFICIENT_COUNT, 1);
+  const std::vector<Z<p>> rhs = make_coefficients<p>(COEFFICIENT_COUNT, 2);
+  for (auto _ : state) {
+    Z<p> total;
+    for (std::size_t index = 0; index < COEFFICIENT_COUNT; ++index) {
+      total += lhs[index] * rhs[index];
+    }
+    benchmark::DoNotOptimize(total);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(COEFFICIENT_COUNT)
+  );
+}
+
+template <int p>
+void BM_CyclicInverse(benchmark::State& state) {
+  const std::vector<Z<p>> values = make_coefficients<p>(COEFFICIENT_COUNT, 1);
+  for (auto _ : state) {
+    for (const Z<p>& value : values) {
+      benchmark::DoNotOptimize(value.inverse());
+    }
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(COEFFICIENT_COUNT)
+  );
+}
+
+template <int p>
+void BM_CyclicAxpy(benchmark::State& state) {
+  const std::size_t count = static_cast<std::size_t>(state.range(0));
+  const std::vector<Z<p>> x = make_coefficients<p>(count, 1);
+  std::vector<Z<p>> y = make_coefficients<p>(count, 2);
+  const Z<p> a(p - 1);
+  for (auto _ : state) {
+    axpy(a, std::span<const Z<p>>(x), std::span<Z<p>>(y));
+    benchmark::DoNotOptimize(y.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.SetBytesProcessed(
+      state.iterations() * state.range(0) *
+      static_cast<std::int64_t>(2 * sizeof(Z<p>))
+  );
+}
+
+BENCHMARK(BM_CyclicArithmetic<2>);
+BENCHMARK(BM_CyclicArithmetic<3>);
+BENCHMARK(BM_CyclicArithmetic<251>);
+BENCHMARK(BM_CyclicArithmetic<46337>);
+
+BENCHMARK(BM_CyclicInverse<3>);
+BENCHMARK(BM_CyclicInverse<251>);
+BENCHMARK(BM_CyclicInverse<46337>);
+
+BENCHMARK(BM_CyclicAxpy<2>)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK(BM_CyclicAxpy<3>)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK(BM_CyclicAxpy<251>)->RangeMultiplier(16)->Range(256, 1 << 20);
+BENCHMARK(BM_CyclicAxpy<46337>)->RangeMultiplier(16)->Range(256, 1 << 20);
+
+}  // namespace
+
+}  // namespace chomp::core
@@ -0,0 +1,194 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/util/constants.hpp>
+#include <chomp/util/hash.hpp>
+#include <chomp/util/hashtable.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+namespace chomp::core {
+
+namespace {
+
+// The former polynomial hash of `Cube`, for comparison
+template <std::size_t CCDIM>
+struct PolynomialCubeHash {
+  std::size_t operator()(const Cube<CCDIM>& cube) const noexcept {
+    std::size_t result = 0;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      result = 11 * result + cube.orthant()[axis];
+    }
+    return result ^ (cube.extent() << (SIZE_T_BITS - CCDIM));
+  }
+};
+
+// Every cell of the orthants of a grid of `side` orthants along each axis
+template <std::size_t CCDIM>
+std::vector<Cube<CCDIM>> grid_cubes(std::size_t side) {
+  std::vector<Cube<CCDIM>> result;
+  CubeOrthant<CCDIM> orthant{};
+  while (true) {
+    for (std::size_t extent = 0; extent < (std::size_t(1) << CCDIM);
+         ++extent) {
+      result.emplace_back(orthant, extent);
+    }
+    std::size_t axis = 0;
+    while (axis < CCDIM && orthant[axis] + std::size_t(1) == side) {
+      orthant[axis] = 0;
+      ++axis;
+    }
+    if (axis == CCDIM) {
+      return result;
+    }
+    ++orthant[axis];
+  }
+}
+
+// Smallest prime at least `value`, as bucket count of `std::unordered_set`
+std::size_t next_prime(std::size_t value) {
+  for (;; ++value) {
+    bool prime = value > 1;
+    for (std::size_t divisor = 2; prime && divisor * divisor <= value;
+         ++divisor) {
+      prime = value % divisor != 0;
+    }
+    if (prime) {
+      return value;
+    }
+  }
+}
+
+// Fraction of the cubes landing in an already occupied bucket of a table of
+// about as many buckets as cubes, reducing hashes modulo a prime (as
+// `std::unordered_set`), by the Fibonacci-mixed high bits (as `FlatHashSet`),
+// and by a mask of the low bits (as other open-addressing tables). A uniform
+// hash gives a rate of about 1/e.
+template <typename Hash, std::size_t CCDIM>
+void report_collisions(
+    benchmark::State& state, const std::vector<Cube<CCDIM>>& cubes
+) {
+  const std::size_t primes = next_prime(cubes.size());
+  const std::size_t buckets = std::bit_ceil(cubes.size());
+  const std::size_t shift =
+      SIZE_T_BITS - static_cast<std::size_t>(std::countr_zero(buckets));
+  std::vector<bool> modulo(primes);
+  std::vector<bool> fibonacci(buckets);
+  std::vector<bool> mask(buckets);
+  std::size_t modulo_collisions = 0;
+  std::size_t fibonacci_collisions = 0;
+  std::size_t mask_collisions = 0;
+  const auto occupy = [](std::vector<bool>& table, std::size_t bucket) {
+    const bool occupied = table[bucket];
+    table[bucket] = true;
+    return occupied ? std::size_t(1) : std::size_t(0);
+  };
+  for (const Cube<CCDIM>& cube : cubes) {
+    const std::size_t hash = Hash{}(cube);
+    modulo_collisions += occupy(modulo, hash % primes);
+    fibonacci_collisions += occupy(
+        fibonacci,
+        (hash * static_cast<std::size_t>(0x9E3779B97F4A7C15ULL)) >> shift
+    );
+    mask_collisions += occupy(mask, hash & (buckets - 1));
+  }
+  const double count = static_cast<double>(cubes.size());
+  state.counters["modulo_collisions"] =
+      static_cast<double>(modulo_collisions) / count;
+  state.counters["fibonacci_collisions"] =
+      static_cast<double>(fibonacci_collisions) / count;
+  state.counters["mask_collisions"] =
+      static_cast<double>(mask_collisions) / count;
+}
+
+template <typename Hash, std::size_t CCDIM>
+void BM_CubeHash(benchmark::State& state) {
+  const std::vector<Cube<CCDIM>> cubes =
+      grid_cubes<CCDIM>(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::size_t combined = 0;
+    for (const Cube<CCDIM>& cube : cubes) {
+      combined ^= Hash{}(cube);
+    }
+    benchmark::DoNotOptimize(combined);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(cubes.size())
+  );
+  report_collisions<Hash>(state, cubes);
+}
+
+// Insertion and lookup of every cube of the grid, in grid order (as when
+// traversing a complex) or shuffled, the access patterns of gradings, caches
+// and modules keyed by cells
+template <typename Set, std::size_t CCDIM>
+void BM_CubeSet(benchmark::State& state) {
+  std::vector<Cube<CCDIM>> cubes =
+      grid_cubes<CCDIM>(static_cast<std::size_t>(state.range(0)));
+  if (state.range(1) != 0) {
+    std::ranges::shuffle(cubes, std::mt19937_64(1));
+  }
+  for (auto _ : state) {
+    Set set;
+    for (const Cube<CCDIM>& cube : cubes) {
+      set.insert(cube);
+    }
+    std::size_t found = 0;
+    for (const Cube<CCDIM>& cube : cubes) {
+      found += set.contains(cube) ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(cubes.size())
+  );
+  state.counters["cells"] = static_cast<double>(cubes.size());
+}
+
+template <std::size_t CCDIM>
+using Polynomial = PolynomialCubeHash<CCDIM>;
+template <std::size_t CCDIM>
+using Packed = std::hash<Cube<CCDIM>>;
+template <std::size_t CCDIM>
+using Mixed = MixedHash<Cube<CCDIM>>;
+
+}  // namespace
+
+// Grids of up to 256 orthants along each axis, the range of coordinates
+BENCHMARK(BM_CubeHash<Polynomial<2>, 2>)->Arg(64)->Arg(256);
+BENCHMARK(BM_CubeHash<Packed<2>, 2>)->Arg(64)->Arg(256);
+BENCHMARK(BM_CubeHash<Mixed<2>, 2>)->Arg(64)->Arg(256);
+BENCHMARK(BM_CubeHash<Polynomial<3>, 3>)->Arg(16)->Arg(64);
+BENCHMARK(BM_CubeHash<Packed<3>, 3>)->Arg(16)->Arg(64);
+BENCHMARK(BM_CubeHash<Mixed<3>, 3>)->Arg(16)->Arg(64);
+BENCHMARK(BM_CubeHash<Polynomial<6>, 6>)->Arg(4)->Arg(8);
+BENCHMARK(BM_CubeHash<Packed<6>, 6>)->Arg(4)->Arg(8);
+BENCHMARK(BM_CubeHash<Mixed<6>, 6>)->Arg(4)->Arg(8);
+
+BENCHMARK(BM_CubeSet<std::unordered_set<Cube<3>, Polynomial<3>>, 3>)
+    ->ArgsProduct({{16, 32}, {0, 1}});
+BENCHMARK(BM_CubeSet<std::unordered_set<Cube<3>, Packed<3>>, 3>)
+    ->ArgsProduct({{16, 32}, {0, 1}});
+BENCHMARK(BM_CubeSet<std::unordered_set<Cube<3>, Mixed<3>>, 3>)
+    ->ArgsProduct({{16, 32}, {0, 1}});
+BENCHMARK(BM_CubeSet<FlatHashSet<Cube<3>, Polynomial<3>>, 3>)
+    ->ArgsProduct({{16, 32}, {0, 1}});
+BENCHMARK(BM_CubeSet<FlatHashSet<Cube<3>, Packed<3>>, 3>)
+    ->ArgsProduct({{16, 32}, {0, 1}});
+BENCHMARK(BM_CubeSet<FlatHashSet<Cube<3>, Mixed<3>>, 3>)
+    ->ArgsProduct({{16, 32}, {0, 1}});
+
+}  // namespace chomp::core
@@ -0,0 +1,216 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/algebra/expressions.hpp>
+#include <chomp/algebra/modules.hpp>
+#include <chomp/util/memory.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+namespace {
+
+// Pseudo-random cells in [0, range), so that sums of elements partially cancel.
+std::vector<int> make_cells(std::size_t count, std::uint64_t seed) {
+  std::vector<int> cells;
+  cells.reserve(count);
+  std::uint64_t state = seed;
+  for (std::size_t index = 0; index < count; ++index) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    cells.push_back(static_cast<int>((state >> 33) % (4 * count)));
+  }
+  return cells;
+}
+
+template <typename M>
+M make_element(std::size_t count, std::uint64_t seed) {
+  using R = typename M::RingType;
+  M result;
+  for (int cell : make_cells(count, seed)) {
+    result.insert(cell, one<R>());
+  }
+  return result;
+}
+
+template <typename M>
+void BM_ModuleInsert(benchmark::State& state) {
+  using R = typename M::RingType;
+  const std::vector<int> cells =
+      make_cells(static_cast<std::size_t>(state.range(0)), 1);
+  for (auto _ : state) {
+    M element;
+    for (int cell : cells) {
+      element.insert(cell, one<R>());
+    }
+    benchmark::DoNotOptimize(element);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(cells.size())
+  );
+}
+
+template <typename M>
+void BM_ModuleAddition(benchmark::State& state) {
+  const std::size_t count = static_cast<std::size_t>(state.range(0));
+  const M lhs = make_element<M>(count, 1);
+  const M rhs = make_element<M>(count, 2);
+  for (auto _ : state) {
+    M sum = lhs;
+    sum += rhs;
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(lhs.size() + rhs.size())
+  );
+}
+
+// Map sending each cell to the chain of itself and its successor, as the
+// boundary of an interval would.
+template <typename M>
+void BM_ModuleLinearApply(benchmark::State& state) {
+  using R = typename M::RingType;
+  const M element =
+      make_element<M>(static_cast<std::size_t>(state.range(0)), 1);
+  const auto interval = [](const int& cell) {
+    M image;
+    image.insert(cell, one<R>());
+    image.insert(cell + 1, -one<R>());
+    return image;
+  };
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(linear_apply(element, interval));
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(element.size())
+  );
+}
+
+template <typename M>
+void BM_ModuleLinearAccumulate(benchmark::State& state) {
+  using R = typename M::RingType;
+  const M element =
+      make_element<M>(static_cast<std::size_t>(state.range(0)), 1);
+  const auto interval = [](const int& cell, const R& coef, M& out) {
+    out.insert(cell, coef);
+    out.insert(cell + 1, -coef);
+  };
+  for (auto _ : state) {
+    M result;
+    linear_accumulate(element, interval, result);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(element.size())
+  );
+}
+
+// Arena variants run inside a fresh arena per iteration, as a boundary pass
+// would.
+template <typename M>
+void BM_ArenaModuleLinearAccumulate(benchmark::State& state) {
+  using R = typename M::RingType;
+  const M element =
+      make_element<M>(static_cast<std::size_t>(state.range(0)), 1);
+  const auto interval = [](const int& cell, const R& coef, M& out) {
+    out.insert(cell, coef);
+    out.insert(cell + 1, -coef);
+  };
+  for (auto _ : state) {
+    ScopedArena arena;
+    M result;
+    linear_accumulate(element, interval, result);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(
+      state.iterations() * static_cast<std::int64_t>(element.size())
+  );
+}
+
+// The combination `a + b - 2 * c`, with the eager operators or evaluated from
+// a `ModuleExpression`.
+template <typename M, bool LAZY>
+void BM_ModuleCombination(benchmark::State& state) {
+  using R = typename M::RingType;
+  const std::size_t count = static_cast<std::size_t>(state.range(0));
+  const M a = make_element<M>(count, 1);
+  const M b = make_element<M>(count, 2);
+  const M c = make_element<M>(count, 3);
+  const R two = one<R>() + one<R>();
+  for (auto _ : state) {
+    if constexpr (LAZY) {
+      const M result = lazy(a) + lazy(b) - two * lazy(c);
+      benchmark::DoNotOptimize(result);
+    } else {
+      const M result = a + b - two * c;
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  state.SetItemsProcessed(
+      state.iterations() *
+      static_cast<std::int64_t>(a.size() + b.size() + c.size())
+  );
+}
+
+template <typename R>
+using NodeModule = DefaultModule<int, R, NodeModuleStorage>;
+template <typename R>
+using FlatModule = DefaultModule<int, R, FlatModuleStorage>;
+template <typename R>
+using SortedModule = DefaultModule<int, R, SortedModuleStorage>;
+template <typename R>
+using ArenaModule = DefaultModule<int, R, ArenaModuleStorage>;
+
+// Element sizes from 64 to 65536 terms
+#define CHOMP_MODULE_BENCHMARKS(M)                                             \
+  BENCHMARK(BM_ModuleInsert<M>)->RangeMultiplier(16)->Range(64, 1 << 16);      \
+  BENCHMARK(BM_ModuleAddition<M>)->RangeMultiplier(16)->Range(64, 1 << 16);    \
+  BENCHMARK(BM_ModuleLinearApply<M>)->RangeMultiplier(16)->Range(64, 1 << 16); \
+  BENCHMARK(BM_ModuleLinearAccumulate<M>)                                      \
+      ->RangeMultiplier(16)                                                    \
+      ->Range(64, 1 << 16)
+
+CHOMP_MODULE_BENCHMARKS(NodeModule<Z<2>>);
+CHOMP_MODULE_BENCHMARKS(NodeModule<Z<3>>);
+CHOMP_MODULE_BENCHMARKS(FlatModule<Z<2>>);
+CHOMP_MODULE_BENCHMARKS(FlatModule<Z<3>>);
+CHOMP_MODULE_BENCHMARKS(SortedModule<Z<2>>);
+CHOMP_MODULE_BENCHMARKS(SortedModule<Z<3>>);
+CHOMP_MODULE_BENCHMARKS(ArenaModule<Z<2>>);
+CHOMP_MODULE_BENCHMARKS(ArenaModule<Z<3>>);
+
+#undef CHOMP_MODULE_BENCHMARKS
+
+BENCHMARK(BM_ArenaModuleLinearAccumulate<ArenaModule<Z<2>>>)
+    ->RangeMultiplier(16)
+    ->Range(64, 1 << 16);
+BENCHMARK(BM_ArenaModuleLinearAccumulate<ArenaModule<Z<3>>>)
+    ->RangeMultiplier(16)
+    ->Range(64, 1 << 16);
+
+BENCHMARK(BM_ModuleCombination<NodeModule<Z<3>>, false>)
+    ->RangeMultiplier(16)
+    ->Range(64, 1 << 16);
+BENCHMARK(BM_ModuleCombination<NodeModule<Z<3>>, true>)
+    ->RangeMultiplier(16)
+    ->Range(64, 1 << 16);
+BENCHMARK(BM_ModuleCombination<FlatModule<Z<3>>, false>)
+    ->RangeMultiplier(16)
+    ->Range(64, 1 << 16);
+BENCHMARK(BM_ModuleCombination<FlatModule<Z<3>>, true>)
+    ->RangeMultiplier(16)
+    ->Range(64, 1 << 16);
+
+}  // namespace
+
+}  // namespace chomp::core
@@ -15,12 +15,15 @@
 #define CHOMP_ALGEBRA_ALGEBRA_H
 
 #include <chomp/util/concepts.hpp>
+#include <chomp/util/parallel.hpp>
 
 #include <concepts>
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace chomp::core {
 
@@ -416,28 +419,143 @@ concept Module = requires(M mod) {
 template <Module M>
 using LinearMap = std::function<M(const typename M::BasisType&)>;
 
+/**
+ * @brief Call `visitor` on each (cell, coefficient) term of the module element
+ * `elem`.
+ *
+ * Module classes providing a `for_each_term` method, such as those in
+ * `chomp/algebra/modules.hpp`, visit their stored pairs directly. Otherwise,
+ * the coefficient of each cell is looked up with `operator[]`.
+ *
+ * @tparam M Module type.
+ * @tparam V Function object type invocable on (constant references to) basis
+ * elements and coefficients of `M`.
+ * @param elem Module element.
+ * @param visitor Function object called on each term.
+ */
+template <ModulePrecursor M, typename V>
+requires std::invocable<
+    V&, const typename M::BasisType&, const typename M::RingType&>
+void for_each_term(const M& elem, V&& visitor) {
+  if constexpr (requires { elem.for_each_term(visitor); }) {
+    elem.for_each_term(visitor);
+  } else {
+    for (const typename M::BasisType& cell : elem) {
+      visitor(cell, elem[cell]);
+    }
+  }
+}
+
 /**
  * @brief Apply the linear map `func` to each the module element `elem`.
  *
+ * The map is taken by its own type rather than as a `LinearMap`, so that it is
+ * inlined rather than called indirectly; `LinearMap` instances are accepted as
+ * well. Terms with unit coefficient add the image of their cell without
+ * scaling it.
+ *
+ * With a `ParallelPolicy`, the terms are partitioned over the tasks of the
+ * scheduler of the policy as in `linear_accumulate`; `func` is then called
+ * concurrently and must be safe to do so.
+ *
  * @tparam M Module Type
- * @tparam F Function object type; must be convertible to `LinearMap<M>`.
+ * @tparam F Function object type invocable on (constant references to) basis
+ * elements of `M`, returning a value convertible to `M`.
+ * @tparam P Execution policy type.
  * @param elem Input module element.
  * @param func Linear map to apply to `elem`.
+ * @param policy Execution policy; sequential by default.
  * @return M A new module element that is the result of `func` applied to
  * `elem`.
  *
- * @sa `LinearMap`
+ * @sa `LinearMap`, `linear_accumulate`
  */
-template <Module M, typename F>
-requires std::convertible_to<F, LinearMap<M>>
-[[nodiscard]] M linear_apply(const M& elem, const F& func) {
+template <Module M, typename F, ExecutionPolicy P = SequencedPolicy>
+requires std::invocable<const F&, const typename M::BasisType&> &&
+         std::convertible_to<
+             std::invoke_result_t<const F&, const typename M::BasisType&>, M>
+[[nodiscard]] M
+linear_apply(const M& elem, const F& func, const P& policy = P()) {
+  using R = typename M::RingType;
+  const auto add_image = [&func](
+                             const typename M::BasisType& cell, const R& coef,
+                             M& out
+                         ) {
+    if (coef == one<R>()) {
+      out += M(func(cell));
+    } else {
+      out += coef * func(cell);
+    }
+  };
   M result;
-  for (const typename M::BasisType& cell : elem) {
-    result += elem[cell] * func(cell);
+  if constexpr (std::same_as<P, SequencedPolicy>) {
+    for_each_term(
+        elem, [&result, &add_image](
+                  const typename M::BasisType& cell, const R& coef
+              ) { add_image(cell, coef, result); }
+    );
+  } else {
+    linear_accumulate(elem, add_image, result, policy);
   }
   return result;
 }
 
+/**
+ * @brief Accumulate the linear map `func` applied to the module element `elem`
+ * into `out`.
+ *
+ * For each term of `elem`, `func` is called with the cell, its coefficient,
+ * and `out`, and adds the coefficient times the image of the cell to `out`
+ * directly, e.g. term by term with `insert`. No temporary module element is
+ * needed per cell, unlike `linear_apply`.
+ *
+ * With a `ParallelPolicy`, the terms of `elem` are partitioned over threads
+ * which each accumulate into their own module element; these are merged by
+ * `parallel_reduce` and then added to `out`. In that case `func` is called
+ * concurrently and must be safe to do so.
+ *
+ * @tparam M Module type.
+ * @tparam F Function object type invocable on (constant references to) a basis
+ * element and a coefficient of `M`, and a reference to `M`.
+ * @tparam P Execution policy type.
+ * @param elem Input module element.
+ * @param func Accumulating linear map.
+ * @param out Module element to which the image of `elem` is added.
+ * @param policy Execution policy; sequential by default.
+ *
+ * @sa `linear_apply`
+ */
+template <Module M, typename F, ExecutionPolicy P = SequencedPolicy>
+requires std::invocable<
+    const F&, const typename M::BasisType&, const typename M::RingType&, M&>
+void linear_accumulate(
+    const M& elem, const F& func, M& out, const P& policy = P()
+) {
+  using T = typename M::BasisType;
+  using R = typename M::RingType;
+  if constexpr (std::same_as<P, SequencedPolicy>) {
+    for_each_term(elem, [&func, &out](const T& cell, const R& coef) {
+      func(cell, coef, out);
+    });
+  } else {
+    std::vector<std::pair<const T*, R>> terms;
+    for_each_term(elem, [&terms](const T& cell, const R& coef) {
+      terms.emplace_back(&cell, coef);
+    });
+    out += parallel_reduce<M>(
+        policy, terms.size(),
+        [&terms, &func](std::size_t first, std::size_t last) {
+          M partial;
+          for (std::size_t idx = first; idx < last; ++idx) {
+            func(*terms[idx].first, terms[idx].second, partial);
+          }
+          return partial;
+        },
+        [](M& lhs, M&& rhs) { lhs += std::move(rhs); }
+    );
+  }
+}
+
 }  // namespace chomp::core
 
 #endif  // CHOMP_ALGEBRA_ALGEBRA_H
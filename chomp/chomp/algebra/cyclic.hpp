@@ -5,16 +5,89 @@
  */
 
 /** @file
- * @brief This header defines the cyclic integral ring `Z` class template.
+ * @brief This header defines the cyclic integral ring `Z` class template and
+ * bulk arithmetic kernels over arrays of its elements.
  */
 
 #ifndef CHOMP_ALGEBRA_CYCLIC_H
 #define CHOMP_ALGEBRA_CYCLIC_H
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <limits>
+#include <span>
+#include <type_traits>
 
 namespace chomp::core {
 
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+/**
+ * @brief Narrowest unsigned integer type holding the values `[0, p-1]`.
+ */
+template <int p>
+using CyclicStorageType = std::conditional_t<
+    (p <= std::numeric_limits<std::uint8_t>::max() + 1), std::uint8_t,
+    std::conditional_t<
+        (p <= std::numeric_limits<std::uint16_t>::max() + 1), std::uint16_t,
+        std::uint32_t>>;
+
+/**
+ * @brief Inverse of `a` modulo `p` by the extended Euclidean algorithm, or `0`
+ * if `a` is not a unit.
+ */
+constexpr int cyclic_inverse(int a, int p) noexcept {
+  int old_remainder = a;
+  int remainder = p;
+  int old_coef = 1;
+  int coef = 0;
+  while (remainder != 0) {
+    const int quotient = old_remainder / remainder;
+    const int next_remainder = old_remainder - quotient * remainder;
+    old_remainder = remainder;
+    remainder = next_remainder;
+    const int next_coef = old_coef - quotient * coef;
+    old_coef = coef;
+    coef = next_coef;
+  }
+  if (old_remainder != 1) {
+    return 0;
+  }
+  return old_coef < 0 ? old_coef + p : old_coef;
+}
+
+/** @brief Whether `p` is prime, i.e. whether `Z<p>` is a field. */
+constexpr bool is_prime(int p) noexcept {
+  if (p < 2) {
+    return false;
+  }
+  for (int divisor = 2; divisor <= p / divisor; ++divisor) {
+    if (p % divisor == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @brief Largest divisor for which `Z` precomputes a table of inverses. */
+constexpr int CYCLIC_INVERSE_TABLE_MAX = 256;
+
+/** @brief Inverses of `[0, p-1]` modulo `p` (`0` for non-units). */
+template <int p>
+requires(p <= CYCLIC_INVERSE_TABLE_MAX)
+constexpr std::array<CyclicStorageType<p>, p> cyclic_inverse_table = []() {
+  std::array<CyclicStorageType<p>, p> table{};
+  for (int a = 0; a < p; ++a) {
+    table[a] = static_cast<CyclicStorageType<p>>(cyclic_inverse(a, p));
+  }
+  return table;
+}();
+
+}  // namespace detail
+#endif
+
 /**
  * @brief The cyclic ring of integers modulo `p`.
  *
@@ -34,7 +107,20 @@ requires requires {
   p <= std::numeric_limits<int>::max() / p;
 }
 class Z {
-  int value;
+public:
+  /**
+   * @brief Narrowest unsigned integer type holding the representatives
+   * `[0, p-1]`, so that arrays of coefficients are densely packed.
+   */
+  using StorageType = detail::CyclicStorageType<p>;
+
+private:
+  StorageType value;
+
+  // Intermediate results (sums below 2p, products below p * p) fit in int
+  struct Raw {};
+  constexpr Z(Raw, int reduced) noexcept :
+      value(static_cast<StorageType>(reduced)) {}
 
 public:
   /**
@@ -42,7 +128,8 @@ public:
    *
    * @param n
    */
-  constexpr explicit Z(int n = 0) : value(n >= 0 ? n % p : n % p + p) {}
+  constexpr explicit Z(int n = 0) :
+      Z(Raw(), n % p < 0 ? n % p + p : n % p) {}
   // % operator truncates towards zero
 
   /**
@@ -63,13 +150,30 @@ public:
     return p;
   }
 
+  /**
+   * @brief Multiplicative inverse modulo `p`.
+   *
+   * For `p` up to 256, inverses are read from a table computed at compile
+   * time; otherwise they are computed by the extended Euclidean algorithm.
+   *
+   * @return Z The inverse, or zero if this element is not a unit (in
+   * particular, every nonzero element is a unit when `p` is prime).
+   */
+  [[nodiscard]] constexpr Z inverse() const noexcept {
+    if constexpr (p <= detail::CYCLIC_INVERSE_TABLE_MAX) {
+      return Z(Raw(), detail::cyclic_inverse_table<p>[value]);
+    } else {
+      return Z(Raw(), detail::cyclic_inverse(value, p));
+    }
+  }
+
   /**
    * @brief Negative operator modulo `p`.
    *
    * @return Z
    */
   [[nodiscard]] constexpr Z operator-() const noexcept {
-    return Z(p - value);  // Result in [0, p-1]
+    return Z(Raw(), value == 0 ? 0 : p - value);  // Result in [0, p-1]
   }
   /**
    * @brief Sum operator modulo `p`.
@@ -123,10 +227,8 @@ public:
    * @return Z&
    */
   constexpr Z& operator+=(const Z& rhs) noexcept {
-    value += rhs.value;  // safe from overflow as p * p <= max(int)
-    if (value >= p) {
-      value -= p;
-    }
+    const int sum = int(value) + rhs.value;  // safe as p * p <= max(int)
+    value = static_cast<StorageType>(sum >= p ? sum - p : sum);
     return *this;
   }
   /**
@@ -136,20 +238,23 @@ public:
    * @return Z&
    */
   constexpr Z& operator-=(const Z& rhs) noexcept {
-    value += (p - rhs.value);
-    if (value >= p) {
-      value -= p;
-    }
+    const int difference = int(value) - rhs.value;
+    value =
+        static_cast<StorageType>(difference < 0 ? difference + p : difference);
     return *this;
   }
   /**
    * @brief Compound assignment product operator modulo `p`.
    *
+   * As `p` is a compile-time constant, the remainder compiles to a
+   * multiplication by a precomputed reciprocal rather than a division.
+   *
    * @param rhs
    * @return Z&
    */
   constexpr Z& operator*=(const Z& rhs) noexcept {
-    value = (value * rhs.value) % p;  // safe as p * p <= max(int)
+    // safe as p * p <= max(int)
+    value = static_cast<StorageType>((int(value) * rhs.value) % p);
     return *this;
   }
 };
@@ -162,6 +267,11 @@ public:
  */
 template <>
 class Z<2> {
+public:
+  /** @brief Storage type of the representative. */
+  using StorageType = bool;
+
+private:
   bool odd;
 
 public:
@@ -191,6 +301,15 @@ public:
     return 2;
   }
 
+  /**
+   * @brief Multiplicative inverse modulo `2`.
+   *
+   * @return Z This element; `1` is its own inverse and `0` is not a unit.
+   */
+  [[nodiscard]] constexpr Z inverse() const noexcept {
+    return *this;
+  }
+
   /**
    * @brief Negative operator modulo `2` (no effect).
    *
@@ -276,6 +395,56 @@ public:
   }
 };
 
+/**
+ * @brief Compute `y[i] += a * x[i]` for each `i` over arrays of `Z<p>`.
+ *
+ * The loop body is branch-free over the densely packed `Z<p>::StorageType`
+ * representatives, so it is readily vectorized by the compiler for the target
+ * instruction set. Intended for dense (co)boundary columns and coefficient
+ * arrays of matrix reductions.
+ *
+ * @tparam p Divisor.
+ * @param a Scalar factor.
+ * @param x Input array.
+ * @param y Output array; at least as long as `x`.
+ */
+template <int p>
+constexpr void axpy(Z<p> a, std::span<const Z<p>> x, std::span<Z<p>> y) {
+  for (std::size_t entry = 0; entry < x.size(); ++entry) {
+    y[entry] += a * x[entry];
+  }
+}
+/**
+ * @brief Specialization of `axpy` for `Z<2>`; a sum of `x` if `a` is `1`.
+ *
+ * @param a Scalar factor.
+ * @param x Input array.
+ * @param y Output array; at least as long as `x`.
+ */
+template <>
+constexpr void axpy(Z<2> a, std::span<const Z<2>> x, std::span<Z<2>> y) {
+  if (a == Z<2>(0)) {
+    return;
+  }
+  for (std::size_t entry = 0; entry < x.size(); ++entry) {
+    y[entry] += x[entry];
+  }
+}
+
+/**
+ * @brief Compute `x[i] *= a` for each `i` over an array of `Z<p>`.
+ *
+ * @tparam p Divisor.
+ * @param a Scalar factor.
+ * @param x Array scaled in place.
+ */
+template <int p>
+constexpr void scale(Z<p> a, std::span<Z<p>> x) {
+  for (Z<p>& entry : x) {
+    entry *= a;
+  }
+}
+
 }  // namespace chomp::core
 
 #endif  // CHOMP_ALGEBRA_CYCLIC_H
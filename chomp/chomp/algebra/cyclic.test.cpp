@@ -9,6 +9,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <span>
+#include <vector>
+
 #ifndef CHOMP_DOXYGEN
 
 namespace chomp::core {
@@ -49,6 +52,62 @@ TEST_CASE("Arithmetic operators of Z work as intended", "[algebra]") {
   REQUIRE(a.rep() == 1);
 }
 
+TEST_CASE("Z reduces negative multiples of the divisor to zero", "[algebra]") {
+  CHECK(Z<5>(-5).rep() == 0);
+  CHECK(Z<5>(-10) == Z<5>(0));
+  CHECK(Z<7>(-1).rep() == 6);
+  CHECK(-Z<7>(0) == Z<7>(0));
+  CHECK((-Z<7>(0)).rep() == 0);
+}
+
+TEST_CASE("Z stores representatives in the narrowest type", "[algebra]") {
+  STATIC_REQUIRE(sizeof(Z<3>) == 1);
+  STATIC_REQUIRE(sizeof(Z<256>) == 1);
+  STATIC_REQUIRE(sizeof(Z<257>) == 2);
+  STATIC_REQUIRE(sizeof(Z<46337>) == 2);
+  CHECK(Z<257>(256) * Z<257>(256) == Z<257>(1));
+  CHECK(Z<46337>(46336) * Z<46337>(46336) == Z<46337>(1));
+  CHECK(Z<46337>(46336) + Z<46337>(46336) == Z<46337>(46335));
+}
+
+TEST_CASE("Z inverses", "[algebra]") {
+  for (int value = 1; value < 13; ++value) {
+    REQUIRE(Z<13>(value) * Z<13>(value).inverse() == Z<13>(1));
+  }
+  for (int value = 1; value < 1009; value += 7) {
+    REQUIRE(Z<1009>(value) * Z<1009>(value).inverse() == Z<1009>(1));
+  }
+  STATIC_REQUIRE(Z<7>(3).inverse() == Z<7>(5));
+  STATIC_REQUIRE(Z<2>(1).inverse() == Z<2>(1));
+  // Non-units have no inverse
+  CHECK(Z<12>(4).inverse() == Z<12>(0));
+  CHECK(Z<12>(5).inverse() == Z<12>(5));
+}
+
+TEST_CASE("Bulk Z kernels", "[algebra]") {
+  std::vector<Z<5>> x;
+  std::vector<Z<5>> y;
+  for (int entry = 0; entry < 37; ++entry) {
+    x.emplace_back(entry);
+    y.emplace_back(2 * entry + 1);
+  }
+  axpy(Z<5>(3), std::span<const Z<5>>(x), std::span<Z<5>>(y));
+  for (int entry = 0; entry < 37; ++entry) {
+    REQUIRE(y[entry] == Z<5>(2 * entry + 1 + 3 * entry));
+  }
+  scale(Z<5>(2), std::span<Z<5>>(y));
+  for (int entry = 0; entry < 37; ++entry) {
+    REQUIRE(y[entry] == Z<5>(2 * (5 * entry + 1)));
+  }
+
+  std::vector<Z<2>> bits = {Z<2>(1), Z<2>(0), Z<2>(1)};
+  std::vector<Z<2>> sums = {Z<2>(1), Z<2>(1), Z<2>(0)};
+  axpy(Z<2>(0), std::span<const Z<2>>(bits), std::span<Z<2>>(sums));
+  REQUIRE(sums == std::vector<Z<2>>{Z<2>(1), Z<2>(1), Z<2>(0)});
+  axpy(Z<2>(1), std::span<const Z<2>>(bits), std::span<Z<2>>(sums));
+  REQUIRE(sums == std::vector<Z<2>>{Z<2>(0), Z<2>(1), Z<2>(1)});
+}
+
 }  // namespace chomp::core
 
 #endif  // CHOMP_DOXYGEN
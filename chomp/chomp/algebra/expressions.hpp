@@ -0,0 +1,369 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains lazy linear combinations of module elements,
+ * `ModuleExpression`, evaluated without temporaries when assigned into a
+ * module element.
+ *
+ * Expressions are built from operands wrapped with `lazy`, e.g.
+ * `M result = lazy(a) + lazy(b) - two * lazy(c);`, and reference rather than
+ * copy their operands, which must outlive the expression. The eager operators
+ * of `chomp/algebra/algebra.hpp` are unaffected.
+ */
+
+#ifndef CHOMP_ALGEBRA_EXPRESSIONS_H
+#define CHOMP_ALGEBRA_EXPRESSIONS_H
+
+#include <chomp/algebra/algebra.hpp>
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+namespace chomp::core {
+
+/**
+ * @brief A deferred linear combination of `N` module elements of type `M`,
+ * each with a scalar coefficient.
+ *
+ * Sums, differences, negations and scalar products of expressions are again
+ * expressions, flattened into a single combination, so no intermediate module
+ * element is constructed. Converting to `M`, or adding into one with `+=` or
+ * `-=`, inserts the scaled terms of each operand directly into the result,
+ * which is first reserved for the total size of the operands when `M`
+ * supports it. `for_each_term` instead visits each cell of the combination
+ * exactly once with its total coefficient, without any result.
+ *
+ * @tparam M Module type of the operands and the result.
+ * @tparam N Number of operands.
+ *
+ * @sa `lazy`
+ */
+template <Module M, std::size_t N>
+requires(N > 0)
+class ModuleExpression {
+public:
+  /** @brief Module type of the operands and the result. */
+  using ModuleType = M;
+  /** @brief Coefficient ring type. */
+  using RingType = typename M::RingType;
+  /** @brief Basis type. */
+  using BasisType = typename M::BasisType;
+
+private:
+  std::array<const M*, N> operands;
+  std::array<RingType, N> scales;
+
+public:
+  /**
+   * @brief Initialize the combination of `operands` with coefficients
+   * `scales`; usually built through `lazy` and the operators instead.
+   *
+   * @param operands Referenced module elements.
+   * @param scales Coefficient of each operand.
+   */
+  ModuleExpression(
+      const std::array<const M*, N>& operands,
+      const std::array<RingType, N>& scales
+  ) noexcept : operands(operands), scales(scales) {}
+
+  /**
+   * @brief The `index`-th operand.
+   *
+   * @param index Less than `N`.
+   * @return const M&
+   */
+  [[nodiscard]] const M& operand(std::size_t index) const noexcept {
+    return *operands[index];
+  }
+  /**
+   * @brief The coefficient of the `index`-th operand.
+   *
+   * @param index Less than `N`.
+   * @return const RingType&
+   */
+  [[nodiscard]] const RingType& scale(std::size_t index) const noexcept {
+    return scales[index];
+  }
+
+  /**
+   * @brief Call `visitor` on each cell with nonzero coefficient in the
+   * combination, once, with that coefficient.
+   *
+   * A cell is visited from the first operand containing it; its coefficients
+   * in the later operands are looked up with `operator[]`.
+   *
+   * @tparam V Function object type invocable on (constant references to) a
+   * basis element and a coefficient.
+   * @param visitor
+   */
+  template <typename V>
+  requires std::invocable<V&, const BasisType&, const RingType&>
+  void for_each_term(V&& visitor) const {
+    const RingType zero_coef = zero<RingType>();
+    for (std::size_t first = 0; first < N; ++first) {
+      if (scales[first] == zero_coef) {
+        continue;
+      }
+      chomp::core::for_each_term(
+          *operands[first],
+          [&](const BasisType& cell, const RingType& coef) {
+            for (std::size_t prior = 0; prior < first; ++prior) {
+              if (scales[prior] != zero_coef &&
+                  (*operands[prior])[cell] != zero_coef) {
+                return;  // visited from an earlier operand
+              }
+            }
+            RingType total = scales[first] * coef;
+            for (std::size_t later = first + 1; later < N; ++later) {
+              if (scales[later] != zero_coef) {
+                total += scales[later] * (*operands[later])[cell];
+              }
+            }
+            if (total != zero_coef) {
+              visitor(cell, total);
+            }
+          }
+      );
+    }
+  }
+
+  /**
+   * @brief Upper bound on the number of cells of the result: the total size
+   * of the operands with nonzero coefficient.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t size_bound() const
+  requires requires(const M& elem) {
+    { elem.size() } -> std::convertible_to<std::size_t>;
+  }
+  {
+    std::size_t bound = 0;
+    for (std::size_t index = 0; index < N; ++index) {
+      if (scales[index] != zero<RingType>()) {
+        bound += operands[index]->size();
+      }
+    }
+    return bound;
+  }
+
+  /**
+   * @brief Add the combination into `out` term by term.
+   *
+   * Inserting each scaled operand term is cheaper than combining the
+   * coefficients of a cell first, which takes a lookup in every other operand.
+   * `out` must not be an operand.
+   *
+   * @param out
+   */
+  void accumulate(M& out) const {
+    for (std::size_t index = 0; index < N; ++index) {
+      const RingType& operand_scale = scales[index];
+      if (operand_scale == zero<RingType>()) {
+        continue;
+      }
+      chomp::core::for_each_term(
+          *operands[index],
+          [&out, &operand_scale](const BasisType& cell, const RingType& coef) {
+            out.insert(cell, operand_scale * coef);
+          }
+      );
+    }
+  }
+
+  /**
+   * @brief Evaluate the combination into a new module element.
+   *
+   * @return M
+   */
+  [[nodiscard]] M evaluate() const {
+    M result;
+    if constexpr (requires { result.reserve(size_bound()); }) {
+      result.reserve(size_bound());
+    }
+    accumulate(result);
+    return result;
+  }
+
+  /**
+   * @brief Implicitly evaluate on initialization of or assignment to `M`; see
+   * `evaluate`.
+   */
+  operator M() const {
+    return evaluate();
+  }
+};
+
+/**
+ * @brief Wrap `elem` as a single-term `ModuleExpression`, starting a lazy
+ * linear combination.
+ *
+ * `elem` is referenced, not copied; rvalues are rejected, as the expression
+ * would outlive them.
+ *
+ * @tparam M Module type.
+ * @param elem
+ * @return ModuleExpression<M, 1>
+ */
+template <Module M>
+[[nodiscard]] ModuleExpression<M, 1> lazy(const M& elem) noexcept {
+  return ModuleExpression<M, 1>({&elem}, {one<typename M::RingType>()});
+}
+/** @brief Deleted for rvalues; see `lazy`. */
+template <Module M>
+void lazy(const M&& elem) = delete;
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+// Concatenate the operands of `lhs` and `rhs`, scaling those of `rhs`
+template <Module M, std::size_t N1, std::size_t N2>
+ModuleExpression<M, N1 + N2> concatenate(
+    const ModuleExpression<M, N1>& lhs, const ModuleExpression<M, N2>& rhs,
+    const typename M::RingType& rhs_scale
+) {
+  std::array<const M*, N1 + N2> operands;
+  std::array<typename M::RingType, N1 + N2> scales;
+  for (std::size_t index = 0; index < N1; ++index) {
+    operands[index] = &lhs.operand(index);
+    scales[index] = lhs.scale(index);
+  }
+  for (std::size_t index = 0; index < N2; ++index) {
+    operands[N1 + index] = &rhs.operand(index);
+    scales[N1 + index] = rhs_scale * rhs.scale(index);
+  }
+  return ModuleExpression<M, N1 + N2>(operands, scales);
+}
+
+// Scale every operand of `expr` by `coef`
+template <Module M, std::size_t N>
+ModuleExpression<M, N> scaled(
+    const ModuleExpression<M, N>& expr, const typename M::RingType& coef
+) {
+  std::array<const M*, N> operands;
+  std::array<typename M::RingType, N> scales;
+  for (std::size_t index = 0; index < N; ++index) {
+    operands[index] = &expr.operand(index);
+    scales[index] = coef * expr.scale(index);
+  }
+  return ModuleExpression<M, N>(operands, scales);
+}
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
+/**
+ * @brief Lazy sum of module expressions.
+ *
+ * @tparam M Module type.
+ * @tparam N1 Number of operands of `lhs`.
+ * @tparam N2 Number of operands of `rhs`.
+ * @param lhs
+ * @param rhs
+ * @return ModuleExpression<M, N1 + N2>
+ */
+template <Module M, std::size_t N1, std::size_t N2>
+[[nodiscard]] ModuleExpression<M, N1 + N2> operator+(
+    const ModuleExpression<M, N1>& lhs, const ModuleExpression<M, N2>& rhs
+) {
+  return detail::concatenate(lhs, rhs, one<typename M::RingType>());
+}
+
+/**
+ * @brief Lazy difference of module expressions.
+ *
+ * @tparam M Module type.
+ * @tparam N1 Number of operands of `lhs`.
+ * @tparam N2 Number of operands of `rhs`.
+ * @param lhs
+ * @param rhs
+ * @return ModuleExpression<M, N1 + N2>
+ */
+template <Module M, std::size_t N1, std::size_t N2>
+[[nodiscard]] ModuleExpression<M, N1 + N2> operator-(
+    const ModuleExpression<M, N1>& lhs, const ModuleExpression<M, N2>& rhs
+) {
+  return detail::concatenate(lhs, rhs, -one<typename M::RingType>());
+}
+
+/**
+ * @brief Lazy negation of a module expression.
+ *
+ * @tparam M Module type.
+ * @tparam N Number of operands.
+ * @param expr
+ * @return ModuleExpression<M, N>
+ */
+template <Module M, std::size_t N>
+[[nodiscard]] ModuleExpression<M, N>
+operator-(const ModuleExpression<M, N>& expr) {
+  return detail::scaled(expr, -one<typename M::RingType>());
+}
+
+/**
+ * @brief Lazy scalar product of a module expression with `coef`.
+ *
+ * @tparam M Module type.
+ * @tparam N Number of operands.
+ * @param expr
+ * @param coef
+ * @return ModuleExpression<M, N>
+ */
+template <Module M, std::size_t N>
+[[nodiscard]] ModuleExpression<M, N> operator*(
+    const ModuleExpression<M, N>& expr, const typename M::RingType& coef
+) {
+  return detail::scaled(expr, coef);
+}
+/** @brief Lazy scalar product of `coef` with a module expression. */
+template <Module M, std::size_t N>
+[[nodiscard]] ModuleExpression<M, N> operator*(
+    const typename M::RingType& coef, const ModuleExpression<M, N>& expr
+) {
+  return detail::scaled(expr, coef);
+}
+
+/**
+ * @brief Add the module expression `expr` into `lhs`; see
+ * `ModuleExpression::accumulate`.
+ *
+ * `lhs` must not be an operand of `expr`.
+ *
+ * @tparam M Module type.
+ * @tparam N Number of operands.
+ * @param lhs
+ * @param expr
+ * @return M&
+ */
+template <Module M, std::size_t N>
+M& operator+=(M& lhs, const ModuleExpression<M, N>& expr) {
+  expr.accumulate(lhs);
+  return lhs;
+}
+
+/**
+ * @brief Subtract the module expression `expr` from `lhs`; see
+ * `ModuleExpression::accumulate`.
+ *
+ * `lhs` must not be an operand of `expr`.
+ *
+ * @tparam M Module type.
+ * @tparam N Number of operands.
+ * @param lhs
+ * @param expr
+ * @return M&
+ */
+template <Module M, std::size_t N>
+M& operator-=(M& lhs, const ModuleExpression<M, N>& expr) {
+  return lhs += -expr;
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_ALGEBRA_EXPRESSIONS_H
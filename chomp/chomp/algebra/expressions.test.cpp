@@ -0,0 +1,80 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/algebra/expressions.hpp>
+#include <chomp/algebra/modules.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <utility>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+TEMPLATE_TEST_CASE(
+    "ModuleExpression evaluates lazy linear combinations", "[algebra]",
+    (DefaultModule<int, Z<5>>), (DefaultModule<int, Z<5>, FlatModuleStorage>),
+    (DefaultModule<int, Z<3>, SortedModuleStorage>),
+    (DefaultModule<int, Z<2>>), (SmallChain<int, Z<7>, 4>)
+) {
+  using M = TestType;
+  using R = typename M::RingType;
+
+  M a;
+  M b;
+  M c;
+  for (int cell = 0; cell < 12; ++cell) {
+    a.insert(cell, R(cell % 4));
+    b.insert(cell + 6, R(2));
+    c.insert(2 * cell, R(cell % 3 + 1));
+  }
+  const R two = R(2);
+
+  SECTION("Matches the eager operators") {
+    const M lazy_result = lazy(a) + lazy(b) - two * lazy(c);
+    REQUIRE(lazy_result == a + b - two * c);
+    REQUIRE(M(-lazy(a) * two) == -(a * two));
+    REQUIRE(lazy(a).evaluate() == a);
+  }
+
+  SECTION("Cancelled and repeated operands") {
+    REQUIRE(M(lazy(a) - lazy(a)).size() == 0);
+    REQUIRE(M(lazy(b) + lazy(c) + lazy(b)) == b + c + b);
+    REQUIRE(M(R(0) * lazy(a) + lazy(c)) == c);
+  }
+
+  SECTION("for_each_term visits each cell once") {
+    std::size_t visits = 0;
+    M visited;
+    (lazy(a) - lazy(b) + lazy(c) + lazy(b))
+        .for_each_term([&](const int& cell, const R& coef) {
+          ++visits;
+          REQUIRE(visited[cell] == R(0));
+          visited.insert(cell, coef);
+        });
+    REQUIRE(visits == visited.size());
+    REQUIRE(visited == a + c);
+  }
+
+  SECTION("Compound assignment") {
+    M result = c;
+    result += lazy(a) - lazy(b);
+    REQUIRE(result == c + a - b);
+    result -= two * lazy(a);
+    REQUIRE(result == c + a - b - two * a);
+  }
+
+  CHECK_FALSE(requires { lazy(std::declval<M>()); });
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
@@ -14,38 +14,58 @@
 
 #include <chomp/algebra/algebra.hpp>
 #include <chomp/util/concepts.hpp>
+#include <chomp/util/hashtable.hpp>
 #include <chomp/util/iterators.hpp>
+#include <chomp/util/memory.hpp>
 
+#include <algorithm>
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <map>
+#include <optional>
 #include <set>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 namespace chomp::core {
 
 namespace detail {
 
+// The module classes live in this namespace, so the operators defined in
+// `chomp::core` for all `ModulePrecursor` types are not otherwise found by
+// argument-dependent lookup when no template argument is from `chomp::core`.
+using chomp::core::operator+;
+using chomp::core::operator+=;
+using chomp::core::operator-;
+using chomp::core::operator-=;
+using chomp::core::operator*;
+using chomp::core::operator*=;
+
 /**
- * @brief Common implementation for `UnorderedMapModule` and `MapModule`.
+ * @brief Common implementation for `UnorderedMapModule`, `MapModule`, and
+ * `FlatHashModule`.
  *
  * It is preferable to use the template aliases in the `chomp::core` namespace
  * than to directly access this.
  *
  * @tparam T Basis type.
  * @tparam R Coefficient ring type.
- * @tparam MapType Either `std::unordered_map<T, R>` or `std::map<T, R>`.
+ * @tparam MapType Either `std::unordered_map<T, R>`, `std::map<T, R>`, or
+ * `FlatHashMap<T, R>`.
  *
- * @sa `UnorderedMapModule`, `MapModule`.
+ * @sa `UnorderedMapModule`, `MapModule`, `FlatHashModule`.
  */
 template <Basis T, Ring R, typename MapType>
 class AssociativeModule {
   MapType cells;
   using MapIterType = typename MapType::iterator;
   using MapCIterType = typename MapType::const_iterator;
-  using NodeType = typename MapType::node_type;
 
 public:
   /** @brief Basis element type. */
@@ -89,6 +109,22 @@ public:
     return KeyIterator(cells.cend());
   }
 
+  /**
+   * @brief Call `visitor` on each (cell, coefficient) term of this element,
+   * without looking up the coefficients.
+   *
+   * @tparam V Function object type invocable on (constant references to) `T`
+   * and `R`.
+   * @param visitor
+   */
+  template <typename V>
+  requires std::invocable<V&, const T&, const R&>
+  void for_each_term(V&& visitor) const {
+    for (const typename MapType::value_type& entry : cells) {
+      visitor(entry.first, entry.second);
+    }
+  }
+
   /**
    * @brief Insert a basis element `cell` with coefficient `coef` into this
    * module element.
@@ -125,6 +161,41 @@ public:
     cells.clear();
   }
 
+  /**
+   * @brief Number of basis elements with nonzero coefficient in this element.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return cells.size();
+  }
+
+  /**
+   * @brief Reserve storage for at least `count` basis elements.
+   *
+   * Only available when the underlying container supports reservation.
+   *
+   * @param count
+   */
+  void reserve(std::size_t count)
+  requires requires(MapType map) { map.reserve(count); }
+  {
+    cells.reserve(count);
+  }
+  /**
+   * @brief Rehash the underlying container for at least `count` basis
+   * elements.
+   *
+   * Only available when the underlying container is a hash table.
+   *
+   * @param count
+   */
+  void rehash(std::size_t count)
+  requires requires(MapType map) { map.rehash(count); }
+  {
+    cells.rehash(count);
+  }
+
   /**
    * @brief Compoud assignment sum operator computes the formal sum of this
    * module element and `rhs`.
@@ -136,10 +207,18 @@ public:
    * @return AssociativeModule&
    */
   AssociativeModule& operator+=(AssociativeModule&& rhs) {
-    for (MapCIterType it = rhs.cells.cbegin(); it != rhs.cells.cend();) {
-      // Avoid invalidation of iterator with postincrement.
-      const NodeType nh = rhs.cells.extract(it++);
-      insert(std::move(nh.key()), std::move(nh.mapped()));
+    if constexpr (requires { typename MapType::node_type; }) {
+      for (MapCIterType it = rhs.cells.cbegin(); it != rhs.cells.cend();) {
+        // Avoid invalidation of iterator with postincrement.
+        const typename MapType::node_type nh = rhs.cells.extract(it++);
+        insert(std::move(nh.key()), std::move(nh.mapped()));
+      }
+    } else {
+      // Flat containers have no nodes to extract; move entries instead.
+      for (typename MapType::value_type& entry : rhs.cells) {
+        insert(std::move(entry.first), std::move(entry.second));
+      }
+      rhs.cells.clear();
     }
     return *this;
   }
@@ -154,10 +233,17 @@ public:
    * @return AssociativeModule&
    */
   AssociativeModule& operator-=(AssociativeModule&& rhs) {
-    for (MapCIterType it = rhs.cells.cbegin(); it != rhs.cells.cend();) {
-      // Avoid invalidation of iterator with postincrement.
-      const NodeType nh = rhs.cells.extract(it++);
-      insert(std::move(nh.key()), -std::move(nh.mapped()));
+    if constexpr (requires { typename MapType::node_type; }) {
+      for (MapCIterType it = rhs.cells.cbegin(); it != rhs.cells.cend();) {
+        // Avoid invalidation of iterator with postincrement.
+        const typename MapType::node_type nh = rhs.cells.extract(it++);
+        insert(std::move(nh.key()), -std::move(nh.mapped()));
+      }
+    } else {
+      for (typename MapType::value_type& entry : rhs.cells) {
+        insert(std::move(entry.first), -std::move(entry.second));
+      }
+      rhs.cells.clear();
     }
     return *this;
   }
@@ -176,23 +262,24 @@ public:
 
 
 /**
- * @brief Common implementation for `UnorderedSetModule` and `SetModule`.
+ * @brief Common implementation for `UnorderedSetModule`, `SetModule`, and
+ * `FlatHashSetModule`.
  *
  * It is preferable to use the template aliases in the `chomp::core` namespace
  * than to directly access this.
  *
  * @tparam T Basis type.
  * @tparam R Coefficient ring type.
- * @tparam SetType Either `std::unordered_set<T>` or `std::set<T>`.
+ * @tparam SetType Either `std::unordered_set<T>`, `std::set<T>`, or
+ * `FlatHashSet<T>`.
  *
- * @sa `UnorderedMapModule`, `MapModule`.
+ * @sa `UnorderedSetModule`, `SetModule`, `FlatHashSetModule`.
  */
 template <Basis T, BinaryRing R, typename SetType>
 class UniqueModule {
   SetType cells;
   using SetIterType = typename SetType::iterator;
   using SetCIterType = typename SetType::const_iterator;
-  using NodeType = typename SetType::node_type;
 
 public:
   /** @copydoc AssociativeModule::BasisType */
@@ -216,6 +303,16 @@ public:
     return cells.cend();
   }
 
+  /** @copydoc AssociativeModule::for_each_term() */
+  template <typename V>
+  requires std::invocable<V&, const T&, const R&>
+  void for_each_term(V&& visitor) const {
+    const R unit = one<R>();
+    for (const T& cell : cells) {
+      visitor(cell, unit);
+    }
+  }
+
   /** @copydoc AssociativeModule::insert() */
   template <typename TFor>
   requires std::same_as<std::remove_cvref_t<TFor>, T>
@@ -235,24 +332,45 @@ public:
     cells.clear();
   }
 
+  /** @copydoc AssociativeModule::size() */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return cells.size();
+  }
+
+  /** @copydoc AssociativeModule::reserve() */
+  void reserve(std::size_t count)
+  requires requires(SetType set) { set.reserve(count); }
+  {
+    cells.reserve(count);
+  }
+  /** @copydoc AssociativeModule::rehash() */
+  void rehash(std::size_t count)
+  requires requires(SetType set) { set.rehash(count); }
+  {
+    cells.rehash(count);
+  }
+
   /** @copydoc AssociativeModule::operator+=() */
   UniqueModule& operator+=(UniqueModule&& rhs) {
-    for (SetCIterType it = rhs.cells.cbegin(); it != rhs.cells.cend();) {
-      // Avoid invalidation of iterator with postincrement.
-      const NodeType nh = rhs.cells.extract(it++);
-      insert(std::move(nh.value()), one<RingType>());
+    if constexpr (requires { typename SetType::node_type; }) {
+      for (SetCIterType it = rhs.cells.cbegin(); it != rhs.cells.cend();) {
+        // Avoid invalidation of iterator with postincrement.
+        const typename SetType::node_type nh = rhs.cells.extract(it++);
+        insert(std::move(nh.value()), one<RingType>());
+      }
+    } else {
+      // Flat containers have no nodes to extract.
+      for (const T& cell : rhs.cells) {
+        insert(cell, one<RingType>());
+      }
+      rhs.cells.clear();
     }
     return *this;
   }
 
   /** @copydoc AssociativeModule::operator-=() */
   UniqueModule& operator-=(UniqueModule&& rhs) {
-    for (SetCIterType it = rhs.cells.cbegin(); it != rhs.cells.cend();) {
-      // Avoid invalidation of iterator with postincrement.
-      const NodeType nh = rhs.cells.extract(it++);
-      insert(std::move(nh.value()), one<RingType>());
-    }
-    return *this;
+    return *this += std::move(rhs);
   }
 
   /** @copydoc AssociativeModule::operator==() */
@@ -277,9 +395,11 @@ public:
  *
  * @tparam T Basis type modeling `Hashable` concept.
  * @tparam R Ring type modeling `BinaryRing` concept.
+ * @tparam Hash Hash function object type for `T`, e.g. `MixedHash<T>`.
  */
-template <Hashable T, BinaryRing R>
-using UnorderedSetModule = detail::UniqueModule<T, R, std::unordered_set<T>>;
+template <Hashable T, BinaryRing R, typename Hash = std::hash<T>>
+using UnorderedSetModule =
+    detail::UniqueModule<T, R, std::unordered_set<T, Hash>>;
 
 /**
  * @brief This class template implements a free `R`-module on basis set `T`. Its
@@ -306,10 +426,11 @@ using SetModule = detail::UniqueModule<T, R, std::set<T>>;
  *
  * @tparam T Basis type modeling `Hashable` concept.
  * @tparam Ring type modeling `Ring` concept.
+ * @tparam Hash Hash function object type for `T`, e.g. `MixedHash<T>`.
  */
-template <Hashable T, Ring R>
+template <Hashable T, Ring R, typename Hash = std::hash<T>>
 using UnorderedMapModule =
-    detail::AssociativeModule<T, R, std::unordered_map<T, R>>;
+    detail::AssociativeModule<T, R, std::unordered_map<T, R, Hash>>;
 
 /**
  * @brief This class template implements a free `R`-module on basis set `T`. Its
@@ -324,6 +445,381 @@ using UnorderedMapModule =
 template <Comparable T, Ring R>
 using MapModule = detail::AssociativeModule<T, R, std::map<T, R>>;
 
+/**
+ * @brief This class template implements a free `R`-module on basis set `T`. Its
+ * instantiations are elements of this `R`-module, which are formal `R`-linear
+ * combinations of elements of the basis set `T`.
+ *
+ * The implementation uses the open-addressing `FlatHashMap` to store the cells
+ * contiguously, avoiding one allocation per cell.
+ *
+ * @tparam T Basis type modeling `Hashable` concept.
+ * @tparam Ring type modeling `Ring` concept.
+ * @tparam Hash Hash function object type for `T`, e.g. `MixedHash<T>`.
+ */
+template <Hashable T, Ring R, typename Hash = std::hash<T>>
+using FlatHashModule =
+    detail::AssociativeModule<T, R, FlatHashMap<T, R, Hash>>;
+
+/**
+ * @brief This class template implements a free `R`-module on basis set `T`. Its
+ * instantiations are elements of this `R`-module, which are formal `R`-linear
+ * combinations of elements of the basis set `T`.
+ *
+ * The implementation uses the open-addressing `FlatHashSet` to store the cells
+ * contiguously, avoiding one allocation per cell. The coefficient ring `R` is
+ * required to be binary-valued (`BinaryRing`). These coefficients are not
+ * explicitly stored in this implementation and are instead based on inclusion
+ * in the set.
+ *
+ * @tparam T Basis type modeling `Hashable` concept.
+ * @tparam R Ring type modeling `BinaryRing` concept.
+ * @tparam Hash Hash function object type for `T`, e.g. `MixedHash<T>`.
+ */
+template <Hashable T, BinaryRing R, typename Hash = std::hash<T>>
+using FlatHashSetModule = detail::UniqueModule<T, R, FlatHashSet<T, Hash>>;
+
+/**
+ * @brief `UnorderedSetModule` whose nodes are allocated with `ArenaAllocator`,
+ * i.e., from the memory resource current when the element is constructed.
+ *
+ * @tparam T Basis type modeling `Hashable` concept.
+ * @tparam R Ring type modeling `BinaryRing` concept.
+ * @sa `ScopedArena`
+ */
+template <Hashable T, BinaryRing R>
+using ArenaUnorderedSetModule =
+    detail::UniqueModule<T, R, ArenaUnorderedSet<T>>;
+
+/**
+ * @brief `SetModule` whose nodes are allocated with `ArenaAllocator`, i.e.,
+ * from the memory resource current when the element is constructed.
+ *
+ * @tparam T Basis type modeling `Comparable` concept.
+ * @tparam R Ring type modeling `BinaryRing` concept.
+ * @sa `ScopedArena`
+ */
+template <Comparable T, BinaryRing R>
+using ArenaSetModule = detail::UniqueModule<T, R, ArenaSet<T>>;
+
+/**
+ * @brief `UnorderedMapModule` whose nodes are allocated with `ArenaAllocator`,
+ * i.e., from the memory resource current when the element is constructed.
+ *
+ * @tparam T Basis type modeling `Hashable` concept.
+ * @tparam R Ring type modeling `Ring` concept.
+ * @sa `ScopedArena`
+ */
+template <Hashable T, Ring R>
+using ArenaUnorderedMapModule =
+    detail::AssociativeModule<T, R, ArenaUnorderedMap<T, R>>;
+
+/**
+ * @brief `MapModule` whose nodes are allocated with `ArenaAllocator`, i.e.,
+ * from the memory resource current when the element is constructed.
+ *
+ * @tparam T Basis type modeling `Comparable` concept.
+ * @tparam R Ring type modeling `Ring` concept.
+ * @sa `ScopedArena`
+ */
+template <Comparable T, Ring R>
+using ArenaMapModule = detail::AssociativeModule<T, R, ArenaMap<T, R>>;
+
+/**
+ * @brief Module class storing its terms as (cell, coefficient) pairs in a
+ * contiguous vector sorted by cell.
+ *
+ * Lookups are binary searches, and the sum and difference of two elements
+ * are linear merges of their sorted terms which drop cancelled terms, with no
+ * per-term allocation. Many terms can be inserted at once with the iterator
+ * overload of `insert`, which appends them and then sorts and combines once.
+ * Inserting a single new term shifts the terms after it, so building large
+ * elements term by term is better done in bulk.
+ *
+ * @tparam T Basis type modeling `Comparable` concept.
+ * @tparam R Coefficient ring type.
+ */
+template <Comparable T, Ring R>
+class SortedVectorModule {
+  using TermType = std::pair<T, R>;
+  using TermIterType = typename std::vector<TermType>::const_iterator;
+
+  std::vector<TermType> terms;
+
+  [[nodiscard]] static bool precedes(const TermType& lhs, const T& rhs) {
+    return lhs.first < rhs;
+  }
+  [[nodiscard]] static bool
+  term_less(const TermType& lhs, const TermType& rhs) {
+    return lhs.first < rhs.first;
+  }
+
+  // Sum (or difference) of the sorted terms and other_terms, via a merge
+  void merge_terms(const std::vector<TermType>& other_terms, bool negate) {
+    std::vector<TermType> merged;
+    merged.reserve(terms.size() + other_terms.size());
+    auto lhs = terms.begin();
+    auto rhs = other_terms.cbegin();
+    while (lhs != terms.end() && rhs != other_terms.cend()) {
+      if (lhs->first < rhs->first) {
+        merged.push_back(std::move(*lhs++));
+      } else if (rhs->first < lhs->first) {
+        merged.emplace_back(rhs->first, negate ? -rhs->second : rhs->second);
+        ++rhs;
+      } else {
+        R coef = negate ? lhs->second - rhs->second : lhs->second + rhs->second;
+        if (coef != zero<R>()) {
+          merged.emplace_back(std::move(lhs->first), std::move(coef));
+        }
+        ++lhs;
+        ++rhs;
+      }
+    }
+    std::move(lhs, terms.end(), std::back_inserter(merged));
+    for (; rhs != other_terms.cend(); ++rhs) {
+      merged.emplace_back(rhs->first, negate ? -rhs->second : rhs->second);
+    }
+    terms.swap(merged);
+  }
+
+public:
+  /** @brief Basis element type. */
+  using BasisType = T;
+  /** @brief Coefficient ring type. */
+  using RingType = R;
+  /** @brief Iterator type over basis elements, in increasing order. */
+  using BasisIterType = KeyIterator<TermIterType>;
+
+  /**
+   * @brief Get the `R` coefficient of basis element `cell` in the module
+   * element.
+   *
+   * A value of zero (in `R`) indicates that `cell` is not present in the
+   * element.
+   *
+   * @param cell Basis element.
+   * @return R Coefficient of `cell`.
+   */
+  [[nodiscard]] R operator[](const T& cell) const {
+    const TermIterType found =
+        std::lower_bound(terms.cbegin(), terms.cend(), cell, precedes);
+    return found == terms.cend() || cell < found->first ? zero<R>()
+                                                        : found->second;
+  }
+
+  /**
+   * @brief Constant forward iterator to the beginning of the cells in this
+   * `R`-linear combination.
+   *
+   * @return BasisIterType
+   */
+  [[nodiscard]] BasisIterType begin() const noexcept {
+    return KeyIterator(terms.cbegin());
+  }
+  /**
+   * @brief Constant forward iterator to the end of the cells in this
+   * `R`-linear combination.
+   *
+   * @return BasisIterType
+   */
+  [[nodiscard]] BasisIterType end() const noexcept {
+    return KeyIterator(terms.cend());
+  }
+
+  /** @copydoc detail::AssociativeModule::for_each_term() */
+  template <typename V>
+  requires std::invocable<V&, const T&, const R&>
+  void for_each_term(V&& visitor) const {
+    for (const TermType& term : terms) {
+      visitor(term.first, term.second);
+    }
+  }
+
+  /**
+   * @brief Insert a basis element `cell` with coefficient `coef` into this
+   * module element.
+   *
+   * If `cell` is already present in the element, then `coef` is added to
+   * the coefficient of `cell` in the element.
+   *
+   * @tparam TFor Forwarding type whose cv-unqualified value matches `T`.
+   * @tparam RFor Forwarding type whose cv-unqualified value matches `R`.
+   * @param cell Basis element.
+   * @param coef Coefficient.
+   */
+  template <typename TFor, typename RFor>
+  requires std::same_as<std::remove_cvref_t<TFor>, T> &&
+           std::same_as<std::remove_cvref_t<RFor>, R>
+  void insert(TFor&& cell, RFor&& coef) {
+    if (coef == zero<R>()) {
+      return;
+    }
+    const auto found =
+        std::lower_bound(terms.begin(), terms.end(), cell, precedes);
+    if (found == terms.end() || cell < found->first) {
+      terms.emplace(found, std::forward<TFor>(cell), std::forward<RFor>(coef));
+      return;
+    }
+    found->second += std::forward<RFor>(coef);
+    if (found->second == zero<R>()) {
+      terms.erase(found);
+    }
+  }
+
+  /**
+   * @brief Insert the (cell, coefficient) pairs of `[first, last)` into this
+   * module element.
+   *
+   * The terms are appended, sorted, and merged with the existing terms once,
+   * summing the coefficients of equal cells and dropping zero coefficients.
+   *
+   * @tparam I Input iterator type with value type convertible to
+   * `std::pair<T, R>`.
+   * @param first
+   * @param last
+   */
+  template <std::input_iterator I>
+  requires std::convertible_to<std::iter_value_t<I>, std::pair<T, R>>
+  void insert(I first, I last) {
+    const std::ptrdiff_t old_size = static_cast<std::ptrdiff_t>(terms.size());
+    terms.insert(terms.end(), first, last);
+    const auto middle = terms.begin() + old_size;
+    std::stable_sort(middle, terms.end(), term_less);
+    std::inplace_merge(terms.begin(), middle, terms.end(), term_less);
+
+    // Combine runs of equal cells in place
+    auto write = terms.begin();
+    for (auto read = terms.begin(); read != terms.end();) {
+      R coef = zero<R>();
+      auto run = read;
+      for (; run != terms.end() && !(read->first < run->first); ++run) {
+        coef += run->second;
+      }
+      if (coef != zero<R>()) {
+        *write = std::move(*read);
+        write->second = std::move(coef);
+        ++write;
+      }
+      read = run;
+    }
+    terms.erase(write, terms.end());
+  }
+
+  /** @brief Reset the element to default initialization state. */
+  void clear() {
+    terms.clear();
+  }
+
+  /**
+   * @brief Number of basis elements with nonzero coefficient in this element.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return terms.size();
+  }
+
+  /**
+   * @brief Reserve storage for at least `count` basis elements.
+   *
+   * @param count
+   */
+  void reserve(std::size_t count) {
+    terms.reserve(count);
+  }
+
+  /**
+   * @brief Compound assignment sum operator computes the formal sum of this
+   * module element and `rhs` by merging their sorted terms.
+   *
+   * @param rhs Module element to sum with this element.
+   * @return SortedVectorModule&
+   */
+  SortedVectorModule& operator+=(const SortedVectorModule& rhs) {
+    merge_terms(rhs.terms, false);
+    return *this;
+  }
+  /** @copydoc operator+=(const SortedVectorModule&) */
+  SortedVectorModule& operator+=(SortedVectorModule&& rhs) {
+    if (terms.empty()) {
+      terms = std::move(rhs.terms);
+    } else {
+      merge_terms(rhs.terms, false);
+    }
+    rhs.terms.clear();
+    return *this;
+  }
+  /**
+   * @brief Compound assignment difference operator computes the formal
+   * difference of this module element and `rhs` by merging their sorted terms.
+   *
+   * @param rhs Module element to subtract from this element.
+   * @return SortedVectorModule&
+   */
+  SortedVectorModule& operator-=(const SortedVectorModule& rhs) {
+    merge_terms(rhs.terms, true);
+    return *this;
+  }
+  /** @copydoc operator-=(const SortedVectorModule&) */
+  SortedVectorModule& operator-=(SortedVectorModule&& rhs) {
+    merge_terms(rhs.terms, true);
+    rhs.terms.clear();
+    return *this;
+  }
+  /**
+   * @brief Compound assignment scalar product operator.
+   *
+   * Terms whose product is zero are dropped.
+   *
+   * @param rhs Scalar.
+   * @return SortedVectorModule&
+   */
+  SortedVectorModule& operator*=(const R& rhs) {
+    for (TermType& term : terms) {
+      term.second *= rhs;
+    }
+    std::erase_if(terms, [](const TermType& term) {
+      return term.second == zero<R>();
+    });
+    return *this;
+  }
+
+  /**
+   * @brief Equality as elements of the module.
+   *
+   * @param rhs
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool operator==(const SortedVectorModule& rhs) const {
+    return terms == rhs.terms;
+  }
+};
+
+/**
+ * @brief Storage tag for `DefaultModule` selecting modules built on the
+ * node-based standard containers.
+ */
+struct NodeModuleStorage {};
+
+/**
+ * @brief Storage tag for `DefaultModule` selecting modules built on the
+ * open-addressing flat hash tables when the basis type is hashable.
+ */
+struct FlatModuleStorage {};
+
+/**
+ * @brief Storage tag for `DefaultModule` selecting `SortedVectorModule` when
+ * the basis type is comparable.
+ */
+struct SortedModuleStorage {};
+
+/**
+ * @brief Storage tag for `DefaultModule` selecting modules built on the
+ * node-based standard containers allocating with `ArenaAllocator`.
+ */
+struct ArenaModuleStorage {};
+
 
 // Helper level of abstraction for DefaultModule
 namespace detail {
@@ -349,11 +845,66 @@ struct Chooser<false, true, T, R> {
   using type = SetModule<T, R>;
 };
 
-template <Basis T, Ring R>
+template <bool H, bool B, typename T, typename R>
+struct FlatChooser {
+  using type = typename Chooser<H, B, T, R>::type;
+};
+
+template <typename T, typename R>
+struct FlatChooser<true, true, T, R> {
+  using type = FlatHashSetModule<T, R>;
+};
+
+template <typename T, typename R>
+struct FlatChooser<true, false, T, R> {
+  using type = FlatHashModule<T, R>;
+};
+
+template <bool H, bool B, typename T, typename R>
+struct ArenaChooser {
+  using type = ArenaMapModule<T, R>;
+};
+
+template <typename T, typename R>
+struct ArenaChooser<true, true, T, R> {
+  using type = ArenaUnorderedSetModule<T, R>;
+};
+
+template <typename T, typename R>
+struct ArenaChooser<true, false, T, R> {
+  using type = ArenaUnorderedMapModule<T, R>;
+};
+
+template <typename T, typename R>
+struct ArenaChooser<false, true, T, R> {
+  using type = ArenaSetModule<T, R>;
+};
+
+template <Basis T, Ring R, typename S>
 struct DefaultModuleChooser {
   using type = typename Chooser<Hashable<T>, BinaryRing<R>, T, R>::type;
 };
 
+template <Basis T, Ring R>
+struct DefaultModuleChooser<T, R, FlatModuleStorage> {
+  using type = typename FlatChooser<Hashable<T>, BinaryRing<R>, T, R>::type;
+};
+
+template <Basis T, Ring R>
+struct DefaultModuleChooser<T, R, SortedModuleStorage> {
+  using type = typename Chooser<Hashable<T>, BinaryRing<R>, T, R>::type;
+};
+
+template <Comparable T, Ring R>
+struct DefaultModuleChooser<T, R, SortedModuleStorage> {
+  using type = SortedVectorModule<T, R>;
+};
+
+template <Basis T, Ring R>
+struct DefaultModuleChooser<T, R, ArenaModuleStorage> {
+  using type = typename ArenaChooser<Hashable<T>, BinaryRing<R>, T, R>::type;
+};
+
 #endif  // CHOMP_DOXYGEN
 }  // namespace detail
 
@@ -361,11 +912,300 @@ struct DefaultModuleChooser {
  * @brief Selects the optimal `Module` type at compile time based on concepts
  * modeled by `T` and `R`
  *
+ * With the default `NodeModuleStorage`, the module is built on the standard
+ * containers. With `FlatModuleStorage`, hashable basis types instead use
+ * `FlatHashSetModule` or `FlatHashModule`. With `SortedModuleStorage`,
+ * comparable basis types instead use `SortedVectorModule`. With
+ * `ArenaModuleStorage`, the standard containers allocate with
+ * `ArenaAllocator`.
+ *
  * @tparam T Basis type.
  * @tparam R Coefficient ring type.
+ * @tparam S Storage tag; `NodeModuleStorage`, `FlatModuleStorage`,
+ * `SortedModuleStorage`, or `ArenaModuleStorage`.
  */
-template <Basis T, Ring R>
-using DefaultModule = typename detail::DefaultModuleChooser<T, R>::type;
+template <Basis T, Ring R, typename S = NodeModuleStorage>
+using DefaultModule = typename detail::DefaultModuleChooser<T, R, S>::type;
+
+/**
+ * @brief Module class storing up to `N` terms inline, spilling into the
+ * module type `Spill` when it grows beyond that.
+ *
+ * Intended for chains with a small, known bound on their number of terms, such
+ * as the boundary of a single cell in a cubical complex, which has at most
+ * twice as many terms as the ambient dimension. While inline, the terms are
+ * kept in insertion order without heap allocation and are found by linear
+ * search. Once spilled, all operations are forwarded to the `Spill` module
+ * until the element is cleared.
+ *
+ * @tparam T Basis type.
+ * @tparam R Coefficient ring type.
+ * @tparam N Number of terms stored inline.
+ * @tparam Spill Module type used once more than `N` terms are present. Its
+ * basis type must be `T` and its coefficient ring type must be `R`. Defaults
+ * to `DefaultModule<T, R>`.
+ */
+template <Basis T, Ring R, std::size_t N, typename Spill = DefaultModule<T, R>>
+requires requires {
+  requires ModulePrecursor<Spill>;
+  requires std::same_as<typename Spill::BasisType, T>;
+  requires std::same_as<typename Spill::RingType, R>;
+}
+class SmallChain {
+  using TermType = std::optional<std::pair<T, R>>;
+  using InlineIterType = const TermType*;
+  using SpillIterType = typename Spill::BasisIterType;
+
+  std::array<TermType, N> terms;
+  std::size_t term_count = 0;
+  bool spilled = false;
+  Spill spill;
+
+  [[nodiscard]] std::size_t find_term(const T& cell) const noexcept {
+    std::size_t idx = 0;
+    while (idx < term_count && !(terms[idx]->first == cell)) {
+      ++idx;
+    }
+    return idx;
+  }
+
+  void spill_terms() {
+    for (std::size_t idx = 0; idx < term_count; ++idx) {
+      spill.insert(
+          std::move(terms[idx]->first), std::move(terms[idx]->second)
+      );
+      terms[idx].reset();
+    }
+    term_count = 0;
+    spilled = true;
+  }
+
+public:
+  /**
+   * @brief Constant forward iterator over the basis elements of a
+   * `SmallChain`, whether stored inline or spilled.
+   */
+  class Iterator {
+    InlineIterType inline_it = nullptr;
+    SpillIterType spill_it;
+    bool spilled = false;
+
+    friend class SmallChain;
+
+    explicit Iterator(InlineIterType inline_it) noexcept :
+        inline_it(inline_it) {}
+    explicit Iterator(SpillIterType spill_it) :
+        spill_it(spill_it), spilled(true) {}
+
+  public:
+    /** @brief Difference type between iterators. */
+    using difference_type = std::ptrdiff_t;
+    /** @brief Value type when dereferenced. */
+    using value_type = T;
+    /** @brief Pointer type. */
+    using pointer = const T*;
+    /** @brief Reference type. */
+    using reference = const T&;
+    /** @brief Tag for `iterator_traits` */
+    using iterator_concept = std::forward_iterator_tag;
+
+    /**
+     * @brief Default initialize a new Iterator object.
+     *
+     * Unusable in this state but can be assigned to, as normal.
+     */
+    Iterator() = default;
+
+    /**
+     * @brief Dereferencing this iterator yields a constant reference to the
+     * basis element.
+     *
+     * @return reference
+     */
+    [[nodiscard]] reference operator*() const {
+      return spilled ? *spill_it : (*inline_it)->first;
+    }
+
+    /**
+     * @brief Equality operates on the wrapped inline pointer or spill
+     * iterator.
+     *
+     * @param rhs
+     * @return true
+     * @return false
+     */
+    [[nodiscard]] bool operator==(const Iterator& rhs) const {
+      if (spilled != rhs.spilled) {
+        return false;
+      }
+      return spilled ? spill_it == rhs.spill_it : inline_it == rhs.inline_it;
+    }
+
+    /**
+     * @brief Preincrement operates on the wrapped inline pointer or spill
+     * iterator.
+     *
+     * @return Iterator&
+     */
+    Iterator& operator++() {
+      if (spilled) {
+        ++spill_it;
+      } else {
+        ++inline_it;
+      }
+      return *this;
+    }
+    /**
+     * @brief Postincrement operates on the wrapped inline pointer or spill
+     * iterator.
+     *
+     */
+    Iterator operator++(int) {
+      Iterator temp = *this;
+      ++*this;
+      return temp;
+    }
+  };
+
+  /** @brief Basis element type. */
+  using BasisType = T;
+  /** @brief Coefficient ring type. */
+  using RingType = R;
+  /** @brief Iterator type over basis elements. */
+  using BasisIterType = Iterator;
+  /** @brief Number of terms stored inline. */
+  static constexpr std::size_t inline_capacity = N;
+
+  /** @copydoc detail::AssociativeModule::operator[]() */
+  [[nodiscard]] R operator[](const T& cell) const {
+    if (spilled) {
+      return spill[cell];
+    }
+    const std::size_t idx = find_term(cell);
+    return idx == term_count ? zero<R>() : terms[idx]->second;
+  }
+
+  /** @copydoc detail::AssociativeModule::begin() */
+  [[nodiscard]] BasisIterType begin() const {
+    return spilled ? Iterator(spill.begin()) : Iterator(terms.data());
+  }
+  /** @copydoc detail::AssociativeModule::end() */
+  [[nodiscard]] BasisIterType end() const {
+    return spilled ? Iterator(spill.end())
+                   : Iterator(terms.data() + term_count);
+  }
+
+  /** @copydoc detail::AssociativeModule::for_each_term() */
+  template <typename V>
+  requires std::invocable<V&, const T&, const R&>
+  void for_each_term(V&& visitor) const {
+    if (spilled) {
+      chomp::core::for_each_term(spill, visitor);
+      return;
+    }
+    for (std::size_t idx = 0; idx < term_count; ++idx) {
+      visitor(terms[idx]->first, terms[idx]->second);
+    }
+  }
+
+  /**
+   * @brief Insert a basis element `cell` with coefficient `coef` into this
+   * module element.
+   *
+   * If `cell` is already present in the element, then `coef` is added to
+   * the coefficient of `cell` in the element. Inserting a new basis element
+   * beyond the inline capacity moves all terms into the spill module.
+   *
+   * @tparam TFor Forwarding type whose cv-unqualified value matches `T`.
+   * @tparam RFor Forwarding type whose cv-unqualified value matches `R`.
+   * @param cell Basis element.
+   * @param coef Coefficient.
+   */
+  template <typename TFor, typename RFor>
+  requires std::same_as<std::remove_cvref_t<TFor>, T> &&
+           std::same_as<std::remove_cvref_t<RFor>, R>
+  void insert(TFor&& cell, RFor&& coef) {
+    if (coef == zero<R>()) {
+      return;
+    }
+    if (spilled) {
+      spill.insert(std::forward<TFor>(cell), std::forward<RFor>(coef));
+      return;
+    }
+
+    const std::size_t idx = find_term(cell);
+    if (idx != term_count) {
+      terms[idx]->second += std::forward<RFor>(coef);
+      if (terms[idx]->second == zero<R>()) {
+        // Keep inline terms contiguous by moving the last term into the gap.
+        --term_count;
+        if (idx != term_count) {
+          terms[idx] = std::move(terms[term_count]);
+        }
+        terms[term_count].reset();
+      }
+      return;
+    }
+
+    if (term_count == N) {
+      spill_terms();
+      spill.insert(std::forward<TFor>(cell), std::forward<RFor>(coef));
+      return;
+    }
+    terms[term_count].emplace(
+        std::forward<TFor>(cell), std::forward<RFor>(coef)
+    );
+    ++term_count;
+  }
+
+  /** @copydoc detail::AssociativeModule::clear() */
+  void clear() {
+    for (std::size_t idx = 0; idx < term_count; ++idx) {
+      terms[idx].reset();
+    }
+    term_count = 0;
+    spilled = false;
+    spill.clear();
+  }
+
+  /** @copydoc detail::AssociativeModule::size() */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return spilled ? spill.size() : term_count;
+  }
+
+  /**
+   * @brief Whether the terms of this element have been moved into the spill
+   * module.
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool is_spilled() const noexcept {
+    return spilled;
+  }
+
+  /**
+   * @brief Equality operator.
+   *
+   * Elements are equal if they have the same coefficients on every basis
+   * element, regardless of whether either is spilled.
+   *
+   * @param rhs
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool operator==(const SmallChain& rhs) const {
+    if (size() != rhs.size()) {
+      return false;
+    }
+    for (const T& cell : *this) {
+      if (!((*this)[cell] == rhs[cell])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
 
 }  // namespace chomp::core
 
@@ -7,10 +7,13 @@
 #include <chomp/algebra/algebra.hpp>
 #include <chomp/algebra/cyclic.hpp>
 #include <chomp/algebra/modules.hpp>
+#include <chomp/util/parallel.hpp>
 
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <array>
 #include <compare>
 #include <concepts>
 #include <cstddef>
@@ -77,7 +80,34 @@ using ModuleTypes = std::tuple<
 
     std::tuple<
         MapModule<bool, int>, std::integral_constant<bool, true>,
-        std::integral_constant<bool, false>>
+        std::integral_constant<bool, false>>,
+
+    std::tuple<
+        FlatHashSetModule<int, Z<2>>, std::integral_constant<int, 7>,
+        std::integral_constant<int, -4>>,
+
+    std::tuple<
+        FlatHashModule<HashableCell, Z<7>>,
+        std::integral_constant<HashableCell, HashableCell(87)>,
+        std::integral_constant<HashableCell, HashableCell(3)>>,
+
+    std::tuple<
+        SmallChain<ComparableCell, Z<3>, 4>,
+        std::integral_constant<ComparableCell, ComparableCell(5)>,
+        std::integral_constant<ComparableCell, ComparableCell(6)>>,
+
+    std::tuple<
+        SmallChain<int, Z<2>, 1>, std::integral_constant<int, 11>,
+        std::integral_constant<int, 12>>,
+
+    std::tuple<
+        SortedVectorModule<ComparableCell, Z<3>>,
+        std::integral_constant<ComparableCell, ComparableCell(9)>,
+        std::integral_constant<ComparableCell, ComparableCell(-8)>>,
+
+    std::tuple<
+        SortedVectorModule<int, Z<2>>, std::integral_constant<int, 13>,
+        std::integral_constant<int, 2>>
 
     >;
 
@@ -168,6 +198,52 @@ TEMPLATE_LIST_TEST_CASE(
   REQUIRE(elem_0[cell_1] == one<R>());
   REQUIRE(elem_1[cell_0] == -one<R>() - one<R>());
   REQUIRE(elem_1[cell_1] == zero<R>());
+  REQUIRE(
+      linear_apply(elem_0, lfunc, ParallelPolicy{.threads = 2, .grain = 1}) ==
+      elem_1
+  );
+}
+
+TEMPLATE_LIST_TEST_CASE(
+    "Modules visit terms and accumulate linear maps", "[algebra]", ModuleTypes
+) {
+  using M = std::tuple_element_t<0, TestType>;
+  using T = typename M::BasisType;
+  using R = typename M::RingType;
+  const T cell_0 = std::tuple_element_t<1, TestType>();
+  const T cell_1 = std::tuple_element_t<2, TestType>();
+  M elem;
+  elem.insert(cell_0, -one<R>());
+  elem.insert(cell_1, one<R>());
+
+  M visited;
+  std::size_t term_count = 0;
+  for_each_term(elem, [&](const T& cell, const R& coef) {
+    REQUIRE(coef == elem[cell]);
+    visited.insert(cell, coef);
+    ++term_count;
+  });
+  REQUIRE(term_count == 2);
+  REQUIRE(visited == elem);
+
+  // Accumulating map sending each cell to itself plus cell_1.
+  const auto afunc = [&](const T& cell, const R& coef, M& out) {
+    out.insert(cell, coef);
+    out.insert(cell_1, coef);
+  };
+  const LinearMap<M> lfunc = [&](const T& cell) {
+    M image;
+    afunc(cell, one<R>(), image);
+    return image;
+  };
+  M accumulated;
+  accumulated.insert(cell_0, one<R>());
+  linear_accumulate(elem, afunc, accumulated);
+  REQUIRE(accumulated - linear_apply(elem, lfunc) == [&]() {
+    M initial;
+    initial.insert(cell_0, one<R>());
+    return initial;
+  }());
 }
 
 #  endif  // CHOMP_CLANG_TIDY
@@ -292,6 +368,162 @@ TEMPLATE_LIST_TEST_CASE(
   CHECK(std::same_as<DefaultModule<T, R>, M>);
 }
 
+using FlatCellAndRingTypes = std::tuple<
+    std::tuple<int, Z<2>, FlatHashSetModule<int, Z<2>>>,
+    std::tuple<int, Z<3>, FlatHashModule<int, Z<3>>>,
+    std::tuple<std::vector<short>, Z<2>, SetModule<std::vector<short>, Z<2>>>,
+    std::tuple<std::vector<short>, Z<5>, MapModule<std::vector<short>, Z<5>>>>;
+
+TEMPLATE_LIST_TEST_CASE(
+    "DefaultModule chooses flat Module type correctly", "[algebra]",
+    FlatCellAndRingTypes
+) {
+  using T = std::tuple_element_t<0, TestType>;
+  using R = std::tuple_element_t<1, TestType>;
+  using M = std::tuple_element_t<2, TestType>;
+
+  CHECK(std::same_as<DefaultModule<T, R, FlatModuleStorage>, M>);
+}
+
+using SortedCellAndRingTypes = std::tuple<
+    std::tuple<int, Z<2>, SortedVectorModule<int, Z<2>>>,
+    std::tuple<
+        ComparableCell, Z<3>, SortedVectorModule<ComparableCell, Z<3>>>,
+    std::tuple<HashableCell, Z<2>, UnorderedSetModule<HashableCell, Z<2>>>,
+    std::tuple<HashableCell, Z<5>, UnorderedMapModule<HashableCell, Z<5>>>>;
+
+TEMPLATE_LIST_TEST_CASE(
+    "DefaultModule chooses sorted Module type correctly", "[algebra]",
+    SortedCellAndRingTypes
+) {
+  using T = std::tuple_element_t<0, TestType>;
+  using R = std::tuple_element_t<1, TestType>;
+  using M = std::tuple_element_t<2, TestType>;
+
+  CHECK(std::same_as<DefaultModule<T, R, SortedModuleStorage>, M>);
+}
+
+TEST_CASE("Flat modules cancel, reserve, and report size", "[algebra]") {
+  FlatHashModule<int, Z<5>> elem;
+  elem.reserve(64);
+  for (int cell = 0; cell < 100; ++cell) {
+    elem.insert(cell, Z<5>(cell));
+  }
+  REQUIRE(elem.size() == 80);  // multiples of 5 have zero coefficient
+
+  FlatHashModule<int, Z<5>> other;
+  for (int cell = 0; cell < 100; ++cell) {
+    other.insert(cell, Z<5>(4 * cell));
+  }
+  elem += std::move(other);
+  REQUIRE(elem.size() == 0);
+  REQUIRE(elem == FlatHashModule<int, Z<5>>());
+
+  FlatHashSetModule<int, Z<2>> set_elem;
+  set_elem.rehash(16);
+  set_elem.insert(1, Z<2>(1));
+  set_elem.insert(2, Z<2>(1));
+  FlatHashSetModule<int, Z<2>> set_other;
+  set_other.insert(2, Z<2>(1));
+  set_other.insert(3, Z<2>(1));
+  set_elem -= std::move(set_other);
+  REQUIRE(set_elem.size() == 2);
+  REQUIRE(set_elem[1] == Z<2>(1));
+  REQUIRE(set_elem[2] == Z<2>(0));
+  REQUIRE(set_elem[3] == Z<2>(1));
+}
+
+TEST_CASE("SortedVectorModule merges and inserts in bulk", "[algebra]") {
+  using Elem = SortedVectorModule<int, Z<5>>;
+  Elem elem;
+  for (const int cell : {7, 3, 9, 1, 5}) {
+    elem.insert(cell, Z<5>(cell));
+  }
+  REQUIRE(elem.size() == 4);  // 5 has zero coefficient
+  REQUIRE(std::ranges::equal(elem, std::array{1, 3, 7, 9}));
+
+  Elem other;
+  other.insert(3, Z<5>(2));
+  other.insert(4, Z<5>(1));
+  other.insert(9, Z<5>(1));
+  elem += other;
+  REQUIRE(std::ranges::equal(elem, std::array{1, 4, 7}));
+  REQUIRE(elem[3] == Z<5>(0));
+  REQUIRE(elem[9] == Z<5>(0));
+
+  elem -= other;
+  REQUIRE(std::ranges::equal(elem, std::array{1, 3, 7, 9}));
+  REQUIRE(elem[3] == Z<5>(3));
+  elem -= Elem(elem);
+  REQUIRE(elem == Elem());
+
+  // Bulk insertion combines duplicates, including with existing terms.
+  elem.insert(2, Z<5>(1));
+  const std::vector<std::pair<int, Z<5>>> terms{
+      {8, Z<5>(1)}, {2, Z<5>(4)}, {6, Z<5>(2)}, {8, Z<5>(3)}, {0, Z<5>(1)},
+      {6, Z<5>(2)}
+  };
+  elem.insert(terms.begin(), terms.end());
+  REQUIRE(std::ranges::equal(elem, std::array{0, 6, 8}));
+  REQUIRE(elem[6] == Z<5>(4));
+  REQUIRE(elem[8] == Z<5>(4));
+
+  Elem expected;
+  expected.insert(0, Z<5>(1));
+  expected.insert(6, Z<5>(4));
+  expected.insert(8, Z<5>(4));
+  REQUIRE(elem == expected);
+
+  elem *= Z<5>(0);
+  REQUIRE(elem.size() == 0);
+}
+
+TEST_CASE("SmallChain stores inline and spills past capacity", "[algebra]") {
+  using Chain = SmallChain<int, Z<5>, 3>;
+  Chain elem;
+  elem.insert(1, Z<5>(1));
+  elem.insert(2, Z<5>(2));
+  elem.insert(3, Z<5>(3));
+  REQUIRE_FALSE(elem.is_spilled());
+  REQUIRE(elem.size() == 3);
+
+  // Cancelling a term keeps the remaining terms reachable.
+  elem.insert(1, Z<5>(4));
+  REQUIRE(elem.size() == 2);
+  REQUIRE(elem[1] == Z<5>(0));
+  REQUIRE(elem[3] == Z<5>(3));
+
+  elem.insert(4, Z<5>(1));
+  REQUIRE_FALSE(elem.is_spilled());
+  elem.insert(5, Z<5>(1));
+  REQUIRE(elem.is_spilled());
+  REQUIRE(elem.size() == 4);
+  REQUIRE(elem[2] == Z<5>(2));
+  REQUIRE(elem[5] == Z<5>(1));
+
+  Chain copy;
+  for (const int cell : {5, 4, 3, 2}) {
+    copy.insert(cell, elem[cell]);
+  }
+  REQUIRE(copy == elem);
+
+  // Spilled elements compare equal to inline elements with the same terms.
+  copy.insert(4, Z<5>(4));
+  copy.insert(5, Z<5>(4));
+  REQUIRE(copy.is_spilled());
+  Chain inline_elem;
+  inline_elem.insert(2, Z<5>(2));
+  inline_elem.insert(3, Z<5>(3));
+  REQUIRE(copy == inline_elem);
+  REQUIRE(inline_elem == copy);
+  inline_elem -= copy;
+  REQUIRE(inline_elem == Chain());
+
+  elem.clear();
+  REQUIRE_FALSE(elem.is_spilled());
+  REQUIRE(elem == Chain());
+}
+
 }  // namespace chomp::core
 
 #endif  // CHOMP_DOXYGEN
@@ -0,0 +1,473 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header defines the compressed sparse column matrix class
+ * template `SparseMatrix` and the `ColumnReduction` kernel over the prime
+ * fields `Z<p>`.
+ */
+
+#ifndef CHOMP_ALGEBRA_SPARSE_H
+#define CHOMP_ALGEBRA_SPARSE_H
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/algebra/cyclic.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+/**
+ * @brief Matrix over the ring `R` stored in compressed sparse column (CSC)
+ * format.
+ *
+ * Columns are appended in order with `push_column`, or `push_sorted_column`
+ * for entries already sorted; the row indices of each column are kept sorted
+ * and unique and zero entries are never stored. The entries of all columns
+ * share two contiguous arrays, so traversing a column touches no other
+ * allocation.
+ *
+ * @tparam R Coefficient ring; models `Ring`.
+ */
+template <Ring R>
+class SparseMatrix {
+  std::size_t row_count;
+  std::vector<std::size_t> offsets{0};
+  std::vector<std::size_t> row_indices;
+  std::vector<R> values;
+
+public:
+  /** @brief Coefficient ring of the matrix. */
+  using RingType = R;
+  /** @brief A (row, coefficient) entry of a column. */
+  using EntryType = std::pair<std::size_t, R>;
+
+  /**
+   * @brief Construct a new `SparseMatrix` object with `rows` rows and no
+   * columns.
+   *
+   * @param rows
+   */
+  explicit SparseMatrix(std::size_t rows = 0) : row_count(rows) {}
+
+  /**
+   * @brief Append a column with the given entries.
+   *
+   * Entries may be in any order; entries with equal rows are summed and zero
+   * results are dropped.
+   *
+   * @param entries (row, coefficient) pairs; each row is less than `rows()`.
+   */
+  void push_column(std::vector<EntryType> entries) {
+    std::sort(
+        entries.begin(), entries.end(),
+        [](const EntryType& lhs, const EntryType& rhs) {
+          return lhs.first < rhs.first;
+        }
+    );
+
+    auto entry = entries.cbegin();
+    while (entry != entries.cend()) {
+      const std::size_t row = entry->first;
+      R coef = zero<R>();
+      for (; entry != entries.cend() && entry->first == row; ++entry) {
+        coef += entry->second;
+      }
+      if (coef != zero<R>()) {
+        row_indices.push_back(row);
+        values.push_back(coef);
+      }
+    }
+    offsets.push_back(row_indices.size());
+  }
+
+  /**
+   * @brief Append a column with the given entries, already sorted.
+   *
+   * Unlike `push_column`, the entries are copied as they are, without sorting
+   * or combining them.
+   *
+   * @param entries (row, coefficient) pairs with strictly increasing rows, each
+   * less than `rows()`, and nonzero coefficients.
+   */
+  void push_sorted_column(std::span<const EntryType> entries) {
+    for (const auto& [row, coef] : entries) {
+      row_indices.push_back(row);
+      values.push_back(coef);
+    }
+    offsets.push_back(row_indices.size());
+  }
+
+  /**
+   * @brief Reserve storage for `columns` columns and `nonzeros` entries.
+   *
+   * @param columns
+   * @param nonzeros
+   */
+  void reserve(std::size_t columns, std::size_t nonzeros) {
+    offsets.reserve(columns + 1);
+    row_indices.reserve(nonzeros);
+    values.reserve(nonzeros);
+  }
+
+  /** @brief Number of rows of the matrix. */
+  [[nodiscard]] std::size_t rows() const noexcept {
+    return row_count;
+  }
+  /** @brief Number of columns of the matrix. */
+  [[nodiscard]] std::size_t columns() const noexcept {
+    return offsets.size() - 1;
+  }
+  /** @brief Number of stored (nonzero) entries of the matrix. */
+  [[nodiscard]] std::size_t nonzeros() const noexcept {
+    return row_indices.size();
+  }
+
+  /**
+   * @brief Sorted row indices of the nonzero entries of column `column`.
+   *
+   * @param column Must be less than `columns()`.
+   * @return std::span<const std::size_t>
+   */
+  [[nodiscard]] std::span<const std::size_t> column_rows(std::size_t column
+  ) const noexcept {
+    return {
+        row_indices.data() + offsets[column],
+        offsets[column + 1] - offsets[column]
+    };
+  }
+  /**
+   * @brief Coefficients of column `column`, parallel to `column_rows(column)`.
+   *
+   * @param column Must be less than `columns()`.
+   * @return std::span<const R>
+   */
+  [[nodiscard]] std::span<const R> column_values(std::size_t column
+  ) const noexcept {
+    return {
+        values.data() + offsets[column], offsets[column + 1] - offsets[column]
+    };
+  }
+
+  /**
+   * @brief The entry at row `row` and column `column`.
+   *
+   * @param row Must be less than `rows()`.
+   * @param column Must be less than `columns()`.
+   * @return R
+   */
+  [[nodiscard]] R operator()(std::size_t row, std::size_t column) const {
+    const std::span<const std::size_t> rows_of_column = column_rows(column);
+    const auto found =
+        std::lower_bound(rows_of_column.begin(), rows_of_column.end(), row);
+    if (found == rows_of_column.end() || *found != row) {
+      return zero<R>();
+    }
+    return column_values(column)[found - rows_of_column.begin()];
+  }
+
+  /**
+   * @brief Equality operator; matrices are equal if they have the same shape
+   * and entries.
+   *
+   * @param rhs
+   * @return true If the matrices are equal.
+   * @return false Otherwise.
+   */
+  [[nodiscard]] bool operator==(const SparseMatrix& rhs) const = default;
+};
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+/**
+ * @brief Working column representation of `ColumnReduction`.
+ *
+ * Columns are sorted by row. Over `Z<2>` every stored entry is one, so
+ * columns are sorted row vectors and column addition is a symmetric
+ * difference.
+ */
+template <Ring R>
+struct ReductionColumn {
+  using type = std::vector<std::pair<std::size_t, R>>;
+
+  static std::size_t row(const std::pair<std::size_t, R>& entry) noexcept {
+    return entry.first;
+  }
+
+  static void assign(
+      type& column, std::span<const std::size_t> rows, std::span<const R> values
+  ) {
+    column.clear();
+    for (std::size_t entry = 0; entry < rows.size(); ++entry) {
+      column.emplace_back(rows[entry], values[entry]);
+    }
+  }
+
+  // target += factor * source, writing through scratch
+  static void
+  add(type& target, const type& source, const R& factor, type& scratch) {
+    scratch.clear();
+    auto lhs = target.cbegin();
+    auto rhs = source.cbegin();
+    while (lhs != target.cend() && rhs != source.cend()) {
+      if (lhs->first < rhs->first) {
+        scratch.push_back(*lhs++);
+      } else if (rhs->first < lhs->first) {
+        scratch.emplace_back(rhs->first, factor * rhs->second);
+        ++rhs;
+      } else {
+        const R coef = lhs->second + factor * rhs->second;
+        if (coef != zero<R>()) {
+          scratch.emplace_back(lhs->first, coef);
+        }
+        ++lhs;
+        ++rhs;
+      }
+    }
+    scratch.insert(scratch.end(), lhs, target.cend());
+    for (; rhs != source.cend(); ++rhs) {
+      scratch.emplace_back(rhs->first, factor * rhs->second);
+    }
+    target.swap(scratch);
+  }
+
+  // Factor eliminating the pivot of target using the pivot of source
+  static R elimination_factor(const type& target, const type& source) {
+    return -(target.back().second * source.back().second.inverse());
+  }
+
+  static std::vector<std::pair<std::size_t, R>> entries(const type& column) {
+    return column;
+  }
+};
+
+template <>
+struct ReductionColumn<Z<2>> {
+  using type = std::vector<std::size_t>;
+
+  static std::size_t row(std::size_t entry) noexcept {
+    return entry;
+  }
+
+  static void assign(
+      type& column, std::span<const std::size_t> rows, std::span<const Z<2>>
+  ) {
+    column.assign(rows.begin(), rows.end());
+  }
+
+  static void add(type& target, const type& source, Z<2>, type& scratch) {
+    scratch.clear();
+    std::set_symmetric_difference(
+        target.cbegin(), target.cend(), source.cbegin(), source.cend(),
+        std::back_inserter(scratch)
+    );
+    target.swap(scratch);
+  }
+
+  static Z<2> elimination_factor(const type&, const type&) noexcept {
+    return one<Z<2>>();
+  }
+
+  static std::vector<std::pair<std::size_t, Z<2>>> entries(const type& column
+  ) {
+    std::vector<std::pair<std::size_t, Z<2>>> result;
+    result.reserve(column.size());
+    for (const std::size_t row : column) {
+      result.emplace_back(row, one<Z<2>>());
+    }
+    return result;
+  }
+};
+
+}  // namespace detail
+#endif
+
+/**
+ * @brief Left-to-right column reduction of a `SparseMatrix` over a prime
+ * field, as used for computing persistent homology.
+ *
+ * The pivot of a column is the row of its last (largest row) nonzero entry.
+ * Each column is reduced by adding multiples of earlier columns until its
+ * pivot is unique among the reduced columns or it is zero. The result
+ * satisfies that no two nonzero reduced columns share a pivot.
+ *
+ * When the dimension of each column is supplied, the matrix is treated as the
+ * boundary matrix of a filtered complex (row `i` and column `i` are the same
+ * cell) and the twist (clearing) optimization is used: columns are reduced by
+ * decreasing dimension, and a column that appears as the pivot of a reduced
+ * column is known to reduce to zero and is cleared without being reduced.
+ *
+ * Over `Z<2>` the working columns are sorted row vectors and column additions
+ * are symmetric differences; otherwise the working columns hold (row,
+ * coefficient) pairs. Neither allocates per entry.
+ *
+ * @tparam R Coefficient ring; a prime field `Z<p>`. Rings `Z<p>` of composite
+ * `p` are rejected, as a pivot coefficient without inverse could not be
+ * eliminated.
+ */
+template <Ring R>
+requires requires(const R& coef) {
+  { coef.inverse() } -> std::convertible_to<R>;
+  requires detail::is_prime(R::divisor());
+}
+class ColumnReduction {
+  using Column = detail::ReductionColumn<R>;
+
+  std::vector<typename Column::type> reduced_columns;
+  std::vector<std::size_t> column_pivots;
+  std::vector<std::size_t> row_pivots;
+  std::size_t row_count;
+
+  void reduce_column(
+      const SparseMatrix<R>& matrix, std::size_t column,
+      typename Column::type& scratch
+  ) {
+    typename Column::type& working = reduced_columns[column];
+    Column::assign(
+        working, matrix.column_rows(column), matrix.column_values(column)
+    );
+
+    while (!working.empty()) {
+      const std::size_t pivot_row = Column::row(working.back());
+      const std::size_t other = row_pivots[pivot_row];
+      if (other == NO_PIVOT) {
+        row_pivots[pivot_row] = column;
+        column_pivots[column] = pivot_row;
+        return;
+      }
+      const typename Column::type& source = reduced_columns[other];
+      Column::add(
+          working, source, Column::elimination_factor(working, source), scratch
+      );
+    }
+  }
+
+public:
+  /** @brief Coefficient ring of the reduced matrix. */
+  using RingType = R;
+
+  /** @brief Value returned for zero columns and rows that are not pivots. */
+  static constexpr std::size_t NO_PIVOT =
+      std::numeric_limits<std::size_t>::max();
+
+  /**
+   * @brief Reduce `matrix` with the standard left-to-right algorithm.
+   *
+   * @param matrix
+   */
+  explicit ColumnReduction(const SparseMatrix<R>& matrix)
+      : reduced_columns(matrix.columns()),
+        column_pivots(matrix.columns(), NO_PIVOT),
+        row_pivots(matrix.rows(), NO_PIVOT),
+        row_count(matrix.rows()) {
+    typename Column::type scratch;
+    for (std::size_t column = 0; column < matrix.columns(); ++column) {
+      reduce_column(matrix, column, scratch);
+    }
+  }
+
+  /**
+   * @brief Reduce the boundary matrix `matrix` of a filtered complex using the
+   * twist (clearing) optimization.
+   *
+   * @param matrix Square matrix whose rows and columns index the same cells in
+   * filtration order.
+   * @param dimensions Dimension of the cell of each column; the nonzero
+   * entries of a column of dimension `d` lie in rows of dimension `d - 1`.
+   */
+  ColumnReduction(
+      const SparseMatrix<R>& matrix, std::span<const std::size_t> dimensions
+  )
+      : reduced_columns(matrix.columns()),
+        column_pivots(matrix.columns(), NO_PIVOT),
+        row_pivots(matrix.rows(), NO_PIVOT),
+        row_count(matrix.rows()) {
+    // Stable bucket of the columns by decreasing dimension
+    std::vector<std::size_t> order(matrix.columns());
+    for (std::size_t column = 0; column < order.size(); ++column) {
+      order[column] = column;
+    }
+    std::stable_sort(
+        order.begin(), order.end(),
+        [&dimensions](std::size_t lhs, std::size_t rhs) {
+          return dimensions[lhs] > dimensions[rhs];
+        }
+    );
+
+    std::vector<bool> cleared(matrix.columns(), false);
+    typename Column::type scratch;
+    for (const std::size_t column : order) {
+      if (cleared[column]) {
+        continue;
+      }
+      reduce_column(matrix, column, scratch);
+      if (column_pivots[column] != NO_PIVOT) {
+        cleared[column_pivots[column]] = true;
+      }
+    }
+  }
+
+  /**
+   * @brief Pivot (largest nonzero row) of reduced column `column`.
+   *
+   * @param column
+   * @return std::size_t The pivot row, or `NO_PIVOT` if the reduced column is
+   * zero.
+   */
+  [[nodiscard]] std::size_t pivot(std::size_t column) const noexcept {
+    return column_pivots[column];
+  }
+
+  /**
+   * @brief The reduced column whose pivot is row `row`.
+   *
+   * @param row
+   * @return std::size_t The column, or `NO_PIVOT` if `row` is not a pivot.
+   */
+  [[nodiscard]] std::size_t pivot_column(std::size_t row) const noexcept {
+    return row_pivots[row];
+  }
+
+  /**
+   * @brief Whether reduced column `column` is zero.
+   *
+   * With the twist optimization, cleared columns are reported as zero; they
+   * are not reduced and their entries are not computed.
+   *
+   * @param column
+   * @return true If the reduced column is zero.
+   * @return false Otherwise.
+   */
+  [[nodiscard]] bool is_zero(std::size_t column) const noexcept {
+    return column_pivots[column] == NO_PIVOT;
+  }
+
+  /**
+   * @brief Assemble the reduced matrix.
+   *
+   * @return SparseMatrix<R>
+   */
+  [[nodiscard]] SparseMatrix<R> reduced() const {
+    SparseMatrix<R> result(row_count);
+    for (const typename Column::type& column : reduced_columns) {
+      result.push_column(Column::entries(column));
+    }
+    return result;
+  }
+};
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_ALGEBRA_SPARSE_H
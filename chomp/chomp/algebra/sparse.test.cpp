@@ -0,0 +1,124 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/algebra/sparse.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+namespace {
+
+// Boundary matrix of a filled triangle {0, 1, 2} with an extra vertex 3 and
+// edge {2, 3}; cells in filtration order
+//   0: v0, 1: v1, 2: v2, 3: e01, 4: e12, 5: e02, 6: v3, 7: e23, 8: t012
+template <typename R>
+SparseMatrix<R> filled_triangle() {
+  const R unit = one<R>();
+  SparseMatrix<R> matrix(9);
+  for (std::size_t vertex = 0; vertex < 3; ++vertex) {
+    matrix.push_column({});
+  }
+  matrix.push_column({{1, unit}, {0, -unit}});
+  matrix.push_column({{2, unit}, {1, -unit}});
+  matrix.push_column({{2, unit}, {0, -unit}});
+  matrix.push_column({});
+  matrix.push_column({{6, unit}, {2, -unit}});
+  matrix.push_column({{3, unit}, {4, unit}, {5, -unit}});
+  return matrix;
+}
+
+const std::vector<std::size_t> triangle_dimensions = {0, 0, 0, 1, 1,
+                                                      1, 0, 1, 2};
+
+template <typename R>
+concept Reducible = requires { typename ColumnReduction<R>; };
+
+}  // namespace
+
+TEST_CASE("SparseMatrix stores sorted columns", "[algebra]") {
+  SparseMatrix<Z<5>> matrix(4);
+  matrix.push_column({{3, Z<5>(1)}, {0, Z<5>(2)}, {3, Z<5>(4)}, {1, Z<5>(3)}});
+  matrix.push_column({});
+  matrix.push_column({{2, Z<5>(1)}});
+
+  REQUIRE(matrix.rows() == 4);
+  REQUIRE(matrix.columns() == 3);
+  REQUIRE(matrix.nonzeros() == 3);
+  REQUIRE(
+      std::vector<std::size_t>(
+          matrix.column_rows(0).begin(), matrix.column_rows(0).end()
+      ) == std::vector<std::size_t>{0, 1}
+  );
+  REQUIRE(matrix.column_values(0)[1] == Z<5>(3));
+  REQUIRE(matrix.column_rows(1).empty());
+  REQUIRE(matrix(0, 0) == Z<5>(2));
+  REQUIRE(matrix(3, 0) == Z<5>(0));
+  REQUIRE(matrix(2, 2) == Z<5>(1));
+  REQUIRE(matrix(2, 1) == Z<5>(0));
+
+  // Sorted entries are appended as they are
+  SparseMatrix<Z<5>> sorted(4);
+  const std::vector<SparseMatrix<Z<5>>::EntryType> entries = {
+      {0, Z<5>(2)}, {1, Z<5>(3)}, {2, Z<5>(1)}
+  };
+  sorted.push_sorted_column(std::span(entries).first(2));
+  sorted.push_sorted_column({});
+  sorted.push_sorted_column(std::span(entries).last(1));
+  REQUIRE(sorted == matrix);
+}
+
+TEST_CASE("ColumnReduction requires a prime field", "[algebra]") {
+  STATIC_REQUIRE(Reducible<Z<2>>);
+  STATIC_REQUIRE(Reducible<Z<251>>);
+  STATIC_REQUIRE(Reducible<Z<257>>);
+  STATIC_REQUIRE_FALSE(Reducible<Z<4>>);
+  STATIC_REQUIRE_FALSE(Reducible<Z<6>>);
+  STATIC_REQUIRE_FALSE(Reducible<Z<289>>);
+}
+
+TEMPLATE_TEST_CASE(
+    "ColumnReduction pairs cells of a filtered complex", "[algebra]", Z<2>,
+    Z<3>, Z<7>
+) {
+  const SparseMatrix<TestType> matrix = filled_triangle<TestType>();
+  const ColumnReduction<TestType> standard(matrix);
+  const ColumnReduction<TestType> twisted(matrix, triangle_dimensions);
+
+  constexpr std::size_t none = ColumnReduction<TestType>::NO_PIVOT;
+  const std::vector<std::size_t> pivots = {none, none, none, 1,   2,
+                                           none, none, 6,    5};
+  for (std::size_t column = 0; column < matrix.columns(); ++column) {
+    REQUIRE(standard.pivot(column) == pivots[column]);
+    REQUIRE(twisted.pivot(column) == pivots[column]);
+    if (pivots[column] != none) {
+      REQUIRE(standard.pivot_column(pivots[column]) == column);
+    }
+  }
+  REQUIRE(twisted.is_zero(5));
+  REQUIRE(standard.is_zero(5));
+
+  // Reduced columns are combinations of earlier columns with unique pivots
+  const SparseMatrix<TestType> reduced = standard.reduced();
+  REQUIRE(reduced.columns() == matrix.columns());
+  REQUIRE(reduced.column_rows(5).empty());
+  REQUIRE(reduced.column_rows(8).back() == 5);
+  REQUIRE(reduced.column_rows(3).size() == 2);
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
@@ -0,0 +1,483 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains the `CachedChainComplex` adaptor, memoizing the
+ * grade-filtered boundaries and coboundaries of the cells of an indexed chain
+ * complex within a memory budget.
+ */
+
+#ifndef CHOMP_COMPLEXES_CACHED_H
+#define CHOMP_COMPLEXES_CACHED_H
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/complexes/complexes.hpp>
+#include <chomp/complexes/grading.hpp>
+#include <chomp/util/cache.hpp>
+#include <chomp/util/constants.hpp>
+#include <chomp/util/statistics.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+/**
+ * @brief Requirements on a chain complex class whose cells are numbered by
+ * contiguous indices, e.g. `CubicalComplex`.
+ *
+ * @tparam CC
+ */
+template <typename CC>
+concept IndexedChainComplex = requires(
+    const CC complex, const typename CC::CellType cell, std::size_t index
+) {
+  requires ChainComplex<CC>;
+  { complex.cell_count() } -> std::convertible_to<std::size_t>;
+  { complex.index_of(cell) } -> std::convertible_to<std::size_t>;
+  { complex.cell_at(index) } -> std::convertible_to<typename CC::CellType>;
+};
+
+/**
+ * @brief The graded boundary and graded coboundary of one cell as compact
+ * lists of (index, coefficient) terms, as stored by `CachedChainComplex`.
+ *
+ * @tparam R Coefficient ring type.
+ */
+template <Ring R>
+struct CellNeighborhood {
+  /** @brief Term of a graded (co)boundary; the index is in the complex. */
+  using TermType = std::pair<std::size_t, R>;
+
+  /** @brief Graded boundary terms followed by graded coboundary terms. */
+  std::vector<TermType> terms;
+  /** @brief Number of leading `terms` forming the graded boundary. */
+  std::size_t boundary_size = 0;
+
+  /**
+   * @brief Terms of the graded boundary.
+   *
+   * @return std::span<const TermType>
+   */
+  [[nodiscard]] std::span<const TermType> boundary() const noexcept {
+    return std::span<const TermType>(terms).first(boundary_size);
+  }
+  /**
+   * @brief Terms of the graded coboundary.
+   *
+   * @return std::span<const TermType>
+   */
+  [[nodiscard]] std::span<const TermType> coboundary() const noexcept {
+    return std::span<const TermType>(terms).subspan(boundary_size);
+  }
+};
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+// Estimated bytes of one cached neighborhood: the entry itself, the list and
+// map nodes of `LRUCache`, and the terms of a typical small neighborhood.
+template <Ring R>
+constexpr std::size_t NEIGHBORHOOD_ENTRY_BYTES =
+    sizeof(std::pair<std::size_t, CellNeighborhood<R>>) + 6 * sizeof(void*) +
+    4 * sizeof(typename CellNeighborhood<R>::TermType);
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
+/**
+ * @brief Adaptor of an `IndexedChainComplex` memoizing the graded boundary and
+ * graded coboundary of each cell.
+ *
+ * The first access to either computes both, grading the cell and its
+ * (co)faces once (in a single `grade_many` batch when the complex provides
+ * one), and stores the terms of the same grade as a `CellNeighborhood` keyed
+ * by the cell index. Later calls to `graded_boundary`, `graded_coboundary` and
+ * the `for_each_graded_*` visitors are then served without grading.
+ * `MorseMatching` uses the latter, so that its repeated passes over each
+ * coboundary hit the cache.
+ *
+ * The cache holds at most about `memory_budget` bytes of neighborhoods,
+ * evicting the least recently used ones beyond it; the estimate assumes small
+ * neighborhoods, as is typical of graded (co)boundaries. Other operations are
+ * forwarded to the complex. The adapted complex is referenced, not copied,
+ * and must outlive the adaptor. When its grading changes, the neighborhoods
+ * of the cells whose own grade or (co)face grades changed must be dropped with
+ * `invalidate` or `invalidate_if`, e.g. those in `DirtyRegion::expanded(2)`
+ * after voxel updates. Not safe for concurrent use with the default
+ * `LRUCache`.
+ *
+ * @tparam CC Chain complex type modeling `IndexedChainComplex`.
+ * @tparam CacheType The cache type, modeling `ValueCache` from indices to
+ * `CellNeighborhood`; `LRUCache` by default. Use `ShardedLRUCache` to share
+ * the adaptor between threads.
+ *
+ * @sa `LRUCache`, `CachedGradingWrapper`
+ */
+template <
+    IndexedChainComplex CC,
+    ValueCache<std::size_t, CellNeighborhood<typename CC::RingType>> CacheType =
+        LRUCache<std::size_t, CellNeighborhood<typename CC::RingType>>>
+class CachedChainComplex {
+public:
+  /** @brief Coefficient ring type for chains. */
+  using RingType = typename CC::RingType;
+  /** @brief Cell type of the adapted complex. */
+  using CellType = typename CC::CellType;
+  /** @brief Chain (module) type of the adapted complex. */
+  using ChainType = typename CC::ChainType;
+  /** @brief Grading function object type of the adapted complex. */
+  using GradingType = typename CC::GradingType;
+  /** @brief Cached graded boundary and coboundary of a cell. */
+  using NeighborhoodType = CellNeighborhood<RingType>;
+
+private:
+  CC* adapted;
+  CacheType cache;
+
+  [[nodiscard]] static NeighborhoodType
+  compute_neighborhood(CC& complex, std::size_t index) {
+    // Faces, then cofaces, after the cell itself, in visitor order
+    const CellType cell = complex.cell_at(index);
+    std::vector<CellType> cells{cell};
+    std::vector<RingType> coefs{zero<RingType>()};
+    const auto gather = [&cells, &coefs](
+                            const CellType& other, const RingType& coef
+                        ) {
+      cells.push_back(other);
+      coefs.push_back(coef);
+    };
+    chomp::core::for_each_boundary(complex, cell, gather);
+    const std::size_t faces = cells.size() - 1;
+    chomp::core::for_each_coboundary(complex, cell, gather);
+
+    std::vector<GradingResultType> grades(cells.size());
+    if constexpr (requires {
+                    complex.grade_many(
+                        std::span<const CellType>(cells),
+                        std::span<GradingResultType>(grades)
+                    );
+                  }) {
+      complex.grade_many(
+          std::span<const CellType>(cells), std::span<GradingResultType>(grades)
+      );
+    } else {
+      std::ranges::transform(cells, grades.begin(), [&](const CellType& c) {
+        return complex.grade(c);
+      });
+    }
+
+    NeighborhoodType result;
+    for (std::size_t term = 1; term < cells.size(); ++term) {
+      if (grades[term] == grades[0]) {
+        result.terms.emplace_back(complex.index_of(cells[term]), coefs[term]);
+        result.boundary_size += term <= faces ? 1 : 0;
+      }
+    }
+    result.terms.shrink_to_fit();
+    return result;
+  }
+
+  template <typename V>
+  bool visit_terms(
+      std::span<const typename NeighborhoodType::TermType> terms, V& visitor
+  ) const {
+    for (const auto& [index, coef] : terms) {
+      if (!detail::visit_term(visitor, index, coef)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+public:
+  /**
+   * @brief Adapt `complex`, caching neighborhoods within `memory_budget`
+   * bytes.
+   *
+   * @param complex Referenced complex; must outlive the adaptor.
+   * @param memory_budget Approximate maximum bytes of cached neighborhoods;
+   * at least one neighborhood is always cached.
+   */
+  CachedChainComplex(CC& complex, std::size_t memory_budget) :
+      adapted(&complex),
+      cache(
+          [target = &complex](const std::size_t& index) {
+            return compute_neighborhood(*target, index);
+          },
+          std::max<std::size_t>(
+              1, memory_budget / detail::NEIGHBORHOOD_ENTRY_BYTES<RingType>
+          )
+      ) {}
+
+  /**
+   * @brief The adapted complex.
+   *
+   * @return CC&
+   */
+  [[nodiscard]] CC& complex() const noexcept {
+    return *adapted;
+  }
+
+  /**
+   * @brief Maximum number of cached neighborhoods, as derived from the memory
+   * budget.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t capacity() const noexcept {
+    return cache.max_size();
+  }
+
+  /**
+   * @brief Number of cells of the adapted complex.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t cell_count() const {
+    return adapted->cell_count();
+  }
+  /**
+   * @brief Index of `cell` in the adapted complex.
+   *
+   * @param cell
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t index_of(const CellType& cell) const {
+    return adapted->index_of(cell);
+  }
+  /**
+   * @brief Cell with index `index` in the adapted complex.
+   *
+   * @param index
+   * @return CellType
+   */
+  [[nodiscard]] CellType cell_at(std::size_t index) const {
+    return adapted->cell_at(index);
+  }
+  /**
+   * @brief Dimension of `cell` in the adapted complex.
+   *
+   * @param cell
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t dimension(const CellType& cell) const
+  requires requires(const CC& c, const CellType& x) { c.dimension(x); }
+  {
+    return adapted->dimension(cell);
+  }
+
+  /**
+   * @brief Grade of `cell` in the adapted complex; not cached.
+   *
+   * @param cell
+   * @return GradingResultType
+   */
+  GradingResultType grade(const CellType& cell) {
+    return adapted->grade(cell);
+  }
+
+  /** @brief Forwarded to the adapted complex; not cached. */
+  template <typename F>
+  requires std::predicate<const F&, const CellType&>
+  [[nodiscard]] ChainType boundary_if(const CellType& cell, const F& cond) {
+    return chomp::core::boundary_if(*adapted, cell, cond);
+  }
+  /** @brief Forwarded to the adapted complex; not cached. */
+  template <typename F>
+  requires std::predicate<const F&, const CellType&>
+  [[nodiscard]] ChainType coboundary_if(const CellType& cell, const F& cond) {
+    return chomp::core::coboundary_if(*adapted, cell, cond);
+  }
+
+  /** @brief Forwarded to the adapted complex; not cached. */
+  template <typename V>
+  requires BoundaryVisitor<V, CellType, RingType>
+  bool for_each_boundary(const CellType& cell, V&& visitor) {
+    return chomp::core::for_each_boundary(*adapted, cell, visitor);
+  }
+  /** @brief Forwarded to the adapted complex; not cached. */
+  template <typename V>
+  requires BoundaryVisitor<V, CellType, RingType>
+  bool for_each_coboundary(const CellType& cell, V&& visitor) {
+    return chomp::core::for_each_coboundary(*adapted, cell, visitor);
+  }
+
+  /**
+   * @brief Cached neighborhood of the cell with index `index`, computed on
+   * first access.
+   *
+   * With `LRUCache`, the reference is valid until the next access.
+   *
+   * @param index
+   * @return decltype(auto) Reference to, or copy of, the `NeighborhoodType`.
+   */
+  decltype(auto) neighborhood(std::size_t index) {
+    return cache[index];
+  }
+
+  /**
+   * @brief Stream the graded boundary of the cell with index `index` to
+   * `visitor` as (index, coefficient) pairs, from the cache.
+   *
+   * @tparam V Visitor type modeling `BoundaryVisitor` on indices.
+   * @param index
+   * @param visitor If it returns `false`, the iteration stops.
+   * @return true If every term was visited.
+   * @return false If `visitor` stopped the iteration early.
+   */
+  template <typename V>
+  requires BoundaryVisitor<V, std::size_t, RingType>
+  bool for_each_graded_boundary_index(std::size_t index, V&& visitor) {
+    const auto& cached = neighborhood(index);
+    return visit_terms(cached.boundary(), visitor);
+  }
+  /**
+   * @brief Stream the graded coboundary of the cell with index `index` to
+   * `visitor` as (index, coefficient) pairs, from the cache.
+   *
+   * @copydetails for_each_graded_boundary_index()
+   */
+  template <typename V>
+  requires BoundaryVisitor<V, std::size_t, RingType>
+  bool for_each_graded_coboundary_index(std::size_t index, V&& visitor) {
+    const auto& cached = neighborhood(index);
+    return visit_terms(cached.coboundary(), visitor);
+  }
+
+  /**
+   * @brief Stream the graded boundary of `cell` to `visitor` as (cell,
+   * coefficient) pairs, from the cache.
+   *
+   * @tparam V Visitor type modeling `BoundaryVisitor`.
+   * @param cell
+   * @param visitor If it returns `false`, the iteration stops.
+   * @return true If every term was visited.
+   * @return false If `visitor` stopped the iteration early.
+   */
+  template <typename V>
+  requires BoundaryVisitor<V, CellType, RingType>
+  bool for_each_graded_boundary(const CellType& cell, V&& visitor) {
+    return for_each_graded_boundary_index(
+        adapted->index_of(cell),
+        [this, &visitor](std::size_t index, const RingType& coef) {
+          return detail::visit_term(visitor, adapted->cell_at(index), coef);
+        }
+    );
+  }
+  /**
+   * @brief Stream the graded coboundary of `cell` to `visitor` as (cell,
+   * coefficient) pairs, from the cache.
+   *
+   * @copydetails for_each_graded_boundary()
+   */
+  template <typename V>
+  requires BoundaryVisitor<V, CellType, RingType>
+  bool for_each_graded_coboundary(const CellType& cell, V&& visitor) {
+    return for_each_graded_coboundary_index(
+        adapted->index_of(cell),
+        [this, &visitor](std::size_t index, const RingType& coef) {
+          return detail::visit_term(visitor, adapted->cell_at(index), coef);
+        }
+    );
+  }
+
+  /**
+   * @brief Graded boundary of `cell`, from the cache. Used by the free
+   * function `graded_boundary`.
+   *
+   * @param cell
+   * @return ChainType
+   */
+  [[nodiscard]] ChainType graded_boundary(const CellType& cell) {
+    ChainType result;
+    for_each_graded_boundary(
+        cell,
+        [&result](const CellType& face, const RingType& coef) {
+          result.insert(face, coef);
+        }
+    );
+    return result;
+  }
+  /**
+   * @brief Graded coboundary of `cell`, from the cache. Used by the free
+   * function `graded_coboundary`.
+   *
+   * @param cell
+   * @return ChainType
+   */
+  [[nodiscard]] ChainType graded_coboundary(const CellType& cell) {
+    ChainType result;
+    for_each_graded_coboundary(
+        cell,
+        [&result](const CellType& coface, const RingType& coef) {
+          result.insert(coface, coef);
+        }
+    );
+    return result;
+  }
+
+  /**
+   * @brief Drop the cached neighborhood of the cell with index `index`, if
+   * any; it is recomputed on its next access.
+   *
+   * @param index
+   * @return true If a cached neighborhood was dropped.
+   * @return false
+   */
+  bool invalidate(std::size_t index)
+  requires requires(CacheType& c) { c.erase(index); }
+  {
+    return cache.erase(index);
+  }
+
+  /**
+   * @brief Drop the cached neighborhoods of the cells whose indices satisfy
+   * `pred`.
+   *
+   * @tparam Pred Predicate type on `std::size_t`.
+   * @param pred
+   * @return std::size_t Number of cached neighborhoods dropped.
+   */
+  template <typename Pred>
+  requires std::predicate<const Pred&, const std::size_t&> &&
+           requires(CacheType& c, const Pred& pred) { c.erase_if(pred); }
+  std::size_t invalidate_if(const Pred& pred) {
+    return cache.erase_if(pred);
+  }
+
+  /** @brief Drop every cached neighborhood. */
+  void invalidate_all()
+  requires requires(CacheType& c) { c.clear(); }
+  {
+    cache.clear();
+  }
+
+  /**
+   * @brief Statistics counters of the cache.
+   *
+   * @return CacheStatistics
+   */
+  [[nodiscard]] CacheStatistics statistics() const
+  requires requires(const CacheType& c) { c.statistics(); }
+  {
+    return cache.statistics();
+  }
+  /** @brief Reset the statistics counters of the cache. */
+  void reset_statistics()
+  requires requires(CacheType& c) { c.reset_statistics(); }
+  {
+    cache.reset_statistics();
+  }
+};
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_COMPLEXES_CACHED_H
@@ -0,0 +1,134 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/complexes/cached.hpp>
+#include <chomp/complexes/complexes.hpp>
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/dense.hpp>
+#include <chomp/complexes/morse.hpp>
+#include <chomp/util/cache.hpp>
+#include <chomp/util/statistics.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+namespace {
+
+// Two components of grade 0, one with a hole, in a margin of grade 1 and 2
+const std::vector<int> VOXELS = {
+    2, 2, 2, 2, 2, 2,  //
+    2, 0, 0, 0, 2, 1,  //
+    2, 0, 2, 0, 2, 1,  //
+    2, 0, 0, 0, 2, 2,  //
+    2, 2, 2, 1, 0, 2,  //
+    2, 2, 2, 2, 2, 2
+};
+
+using Grading = DenseGrading<2, 0, 2>;
+using Complex = CubicalComplex<2, Grading, Z<3>>;
+
+Complex make_complex() {
+  return Complex(
+      CubeOrthant<2>{5, 5},
+      Grading({0, 0}, {5, 5}, VOXELS.cbegin(), VOXELS.cend())
+  );
+}
+
+}  // namespace
+
+TEST_CASE("CachedChainComplex models DimensionedChainComplex", "[complexes]") {
+  CHECK(IndexedChainComplex<Complex>);
+  CHECK(IndexedChainComplex<CachedChainComplex<Complex>>);
+  CHECK(DimensionedChainComplex<CachedChainComplex<Complex>>);
+  using Sharded = ShardedLRUCache<std::size_t, CellNeighborhood<Z<3>>>;
+  CHECK(DimensionedChainComplex<CachedChainComplex<Complex, Sharded>>);
+}
+
+TEST_CASE(
+    "CachedChainComplex serves the graded boundaries of the complex",
+    "[complexes]"
+) {
+  Complex complex = make_complex();
+  // A budget of a single neighborhood exercises eviction throughout
+  const std::size_t budget = GENERATE(std::size_t(0), std::size_t(1) << 20);
+  CachedChainComplex cached(complex, budget);
+  REQUIRE(&cached.complex() == &complex);
+  REQUIRE(cached.capacity() >= 1);
+  REQUIRE((budget == 0) == (cached.capacity() == 1));
+
+  for (std::size_t pass = 0; pass < 2; ++pass) {
+    for (const Cube<2>& cell : complex.cells()) {
+      REQUIRE(graded_boundary(cached, cell) == graded_boundary(complex, cell));
+      REQUIRE(
+          graded_coboundary(cached, cell) == graded_coboundary(complex, cell)
+      );
+      REQUIRE(boundary(cached, cell) == boundary(complex, cell));
+      REQUIRE(coboundary(cached, cell) == coboundary(complex, cell));
+      REQUIRE(cached.dimension(cell) == complex.dimension(cell));
+
+      typename Complex::ChainType from_indices;
+      cached.for_each_graded_coboundary_index(
+          cached.index_of(cell),
+          [&](std::size_t index, const Z<3>& coef) {
+            from_indices.insert(cached.cell_at(index), coef);
+          }
+      );
+      REQUIRE(from_indices == graded_coboundary(complex, cell));
+
+      // Stopping at the first term
+      std::size_t visited = 0;
+      const bool completed = cached.for_each_graded_boundary(
+          cell,
+          [&visited](const Cube<2>&, const Z<3>&) { return ++visited < 1; }
+      );
+      REQUIRE(completed == (graded_boundary(complex, cell).size() == 0));
+      REQUIRE(visited == (completed ? 0 : 1));
+    }
+  }
+
+  if constexpr (STATISTICS_ENABLED) {
+    const CacheStatistics statistics = cached.statistics();
+    REQUIRE(statistics.misses >= complex.cell_count());
+    if (budget != 0) {
+      REQUIRE(statistics.misses == complex.cell_count());
+      REQUIRE(statistics.evictions == 0);
+    }
+  }
+}
+
+TEST_CASE(
+    "Coreduction through CachedChainComplex is unchanged", "[complexes]"
+) {
+  Complex complex = make_complex();
+  CachedChainComplex cached(complex, std::size_t(1) << 20);
+  const MorseMatching matching(complex, complex.cells());
+  const MorseMatching cached_matching(cached, complex.cells());
+
+  REQUIRE(cached_matching.aces() == matching.aces());
+  for (const Cube<2>& cell : complex.cells()) {
+    REQUIRE(cached_matching.type(cell) == matching.type(cell));
+    REQUIRE(cached_matching.time(cell) == matching.time(cell));
+  }
+
+  MorseComplex morse(complex, matching);
+  MorseComplex cached_morse(cached, cached_matching);
+  for (const Cube<2>& ace : matching.aces()) {
+    REQUIRE(boundary(cached_morse, ace) == boundary(morse, ace));
+  }
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
@@ -9,6 +9,12 @@
  * requirements on a class to implement a chain complex. It also includes
  * shared functionality on grading and boundary/coboundary operators by
  * free function templates general to all types modeling `ChainComplex`.
+ *
+ * The chain overloads take an optional execution policy. With a
+ * `ParallelPolicy`, the cells of the chain are partitioned over threads as in
+ * `linear_accumulate`, so the methods of the complex they call, including its
+ * grading, must be safe to call concurrently; e.g. cache the grading with
+ * `ShardedLRUCache` rather than `LRUCache`.
  */
 
 
@@ -21,6 +27,7 @@
 
 #include <concepts>
 #include <functional>
+#include <type_traits>
 
 namespace chomp::core {
 
@@ -34,6 +41,56 @@ namespace chomp::core {
 template <typename C>
 using ConditionalType = std::function<bool(const C&)>;
 
+/**
+ * @brief Requirements on a function object type `V` to visit the terms of a
+ * boundary or coboundary in the `for_each_boundary` and `for_each_coboundary`
+ * free functions and methods in complex classes.
+ *
+ * The visitor is called with (constant references to) a cell of type `C` and
+ * its coefficient of type `R`. It either returns nothing or a value
+ * convertible to `bool`, in which case returning `false` stops the iteration.
+ *
+ * @tparam V
+ * @tparam C Cell type of the associated chain complex class.
+ * @tparam R Coefficient ring type of the associated chain complex class.
+ */
+template <typename V, typename C, typename R>
+concept BoundaryVisitor = requires {
+  requires std::invocable<V&, const C&, const R&>;
+  requires std::is_void_v<std::invoke_result_t<V&, const C&, const R&>> ||
+               std::convertible_to<
+                   std::invoke_result_t<V&, const C&, const R&>, bool>;
+};
+
+namespace detail {
+#ifndef CHOMP_DOXYGEN
+
+// Call `visitor` on a single term; returns `false` to stop the iteration.
+template <typename V, typename C, typename R>
+inline bool visit_term(V& visitor, const C& cell, const R& coef) {
+  if constexpr (std::is_void_v<std::invoke_result_t<V&, const C&, const R&>>) {
+    visitor(cell, coef);
+    return true;
+  } else {
+    return static_cast<bool>(visitor(cell, coef));
+  }
+}
+
+// Add `coef` times `chain` to `out` term by term.
+template <Module M>
+inline void
+add_scaled(M& out, const M& chain, const typename M::RingType& coef) {
+  for_each_term(
+      chain,
+      [&out, &coef](
+          const typename M::BasisType& cell, const typename M::RingType& term
+      ) { out.insert(cell, coef * term); }
+  );
+}
+
+#endif  // CHOMP_DOXYGEN
+}  // namespace detail
+
 /**
  * @brief Requirements on a class to implement a general chain complex.
  *
@@ -82,7 +139,12 @@ grade(CC& complex, const typename CC::CellType& cell) {
  * @brief The boundary of `cell` in the chain complex `complex` subject to the
  * condition `cond`.
  *
+ * The condition is a template parameter so that it may be inlined by
+ * complexes whose `boundary_if` method is itself a template; `ConditionalType`
+ * instances are accepted as well.
+ *
  * @tparam CC Class modeling `ChainComplex`.
+ * @tparam F Predicate type on (constant references to) cells of `CC`.
  * @param complex The chain complex to which `cell` belongs and in which the
  * boundary is taken.
  * @param cell The cell for which the boundary is computed.
@@ -90,25 +152,83 @@ grade(CC& complex, const typename CC::CellType& cell) {
  * in the resulting boundary if and only if this condition returns `true`.
  * @return CC::ChainType The boundary chain of `cell` in `complex`.
  */
-template <ChainComplex CC>
-[[nodiscard]] inline typename CC::ChainType boundary_if(
-    CC& complex, const typename CC::CellType& cell,
-    const ConditionalType<typename CC::CellType>& cond
-) {
+template <ChainComplex CC, typename F>
+requires std::predicate<const F&, const typename CC::CellType&>
+[[nodiscard]] inline typename CC::ChainType
+boundary_if(CC& complex, const typename CC::CellType& cell, const F& cond) {
   return complex.boundary_if(cell, cond);
 }
-/** @brief Overload of `boundary_if` linearly applied on `chain`. */
-template <ChainComplex CC>
+/**
+ * @brief Overload of `boundary_if` linearly applied on `chain` under `policy`.
+ *
+ * The boundary terms of each cell are streamed with `for_each_boundary` and
+ * accumulated into the result, with no intermediate chains.
+ */
+template <ChainComplex CC, typename F, ExecutionPolicy P = SequencedPolicy>
+requires std::predicate<const F&, const typename CC::CellType&>
 [[nodiscard]] inline typename CC::ChainType boundary_if(
-    CC& complex, const typename CC::ChainType& chain,
-    const ConditionalType<typename CC::CellType>& cond
+    CC& complex, const typename CC::ChainType& chain, const F& cond,
+    const P& policy = P()
 ) {
-  return linear_apply(
+  using C = typename CC::CellType;
+  using R = typename CC::RingType;
+  using M = typename CC::ChainType;
+  M result;
+  linear_accumulate(
       chain,
-      [&complex, &cond](const typename CC::CellType& cell) {
-        return boundary_if(complex, cell, cond);
-      }
+      [&complex, &cond](const C& cell, const R& coef, M& out) {
+        for_each_boundary(complex, cell, [&](const C& face, const R& term) {
+          if (cond(face)) {
+            out.insert(face, coef * term);
+          }
+        });
+      },
+      result, policy
   );
+  return result;
+}
+
+/**
+ * @brief Stream the boundary of `cell` in the chain complex `complex` to
+ * `visitor` as (cell, coefficient) pairs.
+ *
+ * Complexes providing a `for_each_boundary` method, such as `CubicalComplex`,
+ * do so without constructing a chain or allocating. Otherwise, the boundary is
+ * computed with `boundary_if` and its terms are visited.
+ *
+ * @tparam CC Class modeling `ChainComplex`.
+ * @tparam V Visitor type modeling `BoundaryVisitor`.
+ * @param complex The chain complex to which `cell` belongs and in which the
+ * boundary is taken.
+ * @param cell The cell for which the boundary is computed.
+ * @param visitor Function object called on each boundary cell and its
+ * coefficient; if it returns `false`, the iteration stops.
+ * @return true If every boundary cell was visited.
+ * @return false If `visitor` stopped the iteration early.
+ */
+template <ChainComplex CC, typename V>
+requires BoundaryVisitor<V, typename CC::CellType, typename CC::RingType>
+inline bool for_each_boundary(
+    CC& complex, const typename CC::CellType& cell, V&& visitor
+) {
+  if constexpr (requires { complex.for_each_boundary(cell, visitor); }) {
+    return complex.for_each_boundary(cell, visitor);
+  } else {
+    const typename CC::ChainType chain = complex.boundary_if(
+        cell,
+        []([[maybe_unused]] const typename CC::CellType& boundary_cell) {
+          return true;
+        }
+    );
+    for (const typename CC::CellType& boundary_cell : chain) {
+      if (!detail::visit_term(
+              visitor, boundary_cell, chain[boundary_cell]
+          )) {
+        return false;
+      }
+    }
+    return true;
+  }
 }
 
 /**
@@ -130,13 +250,30 @@ boundary(CC& complex, const typename CC::CellType& cell) {
       }
   );
 }
-/** @brief Overload of `boundary` linearly applied on `chain`. */
-template <ChainComplex CC>
-[[nodiscard]] inline typename CC::ChainType
-boundary(CC& complex, const typename CC::ChainType& chain) {
-  return linear_apply(chain, [&complex](const typename CC::CellType cell) {
-    return boundary(complex, cell);
-  });
+/**
+ * @brief Overload of `boundary` linearly applied on `chain` under `policy`.
+ *
+ * The boundary terms of each cell are streamed with `for_each_boundary` and
+ * accumulated into the result, with no intermediate chains.
+ */
+template <ChainComplex CC, ExecutionPolicy P = SequencedPolicy>
+[[nodiscard]] inline typename CC::ChainType boundary(
+    CC& complex, const typename CC::ChainType& chain, const P& policy = P()
+) {
+  using C = typename CC::CellType;
+  using R = typename CC::RingType;
+  using M = typename CC::ChainType;
+  M result;
+  linear_accumulate(
+      chain,
+      [&complex](const C& cell, const R& coef, M& out) {
+        for_each_boundary(complex, cell, [&](const C& face, const R& term) {
+          out.insert(face, coef * term);
+        });
+      },
+      result, policy
+  );
+  return result;
 }
 
 /**
@@ -149,41 +286,66 @@ boundary(CC& complex, const typename CC::ChainType& chain) {
  * @param cell The cell for which the boundary is computed.
  * @return CC::ChainType The boundary chain of `cell` in `complex`; all cells
  * present must have the same grade as `cell`.
+ *
+ * If `complex` has a `graded_boundary` method, e.g. one grading every
+ * face in a single batch, it is used instead; it is then responsible for
+ * skipping the grading of the faces of cells of minimal grade.
  */
 template <ChainComplex CC>
 [[nodiscard]] inline typename CC::ChainType
 graded_boundary(CC& complex, const typename CC::CellType& cell) {
-  GradingResultType current_grade = complex.grade(cell);
-  return complex.boundary_if(
-      cell,
-      [current_grade, &complex](const typename CC::CellType boundary_cell) {
-        return complex.grade(boundary_cell) == current_grade;
-      }
-  );
+  if constexpr (requires { complex.graded_boundary(cell); }) {
+    return complex.graded_boundary(cell);
+  } else {
+    GradingResultType current_grade = complex.grade(cell);
+    return complex.boundary_if(
+        cell,
+        [current_grade, &complex](const typename CC::CellType boundary_cell) {
+          return complex.grade(boundary_cell) == current_grade;
+        }
+    );
+  }
 }
 /** @brief Specialization for when `cell` has minimal grade. */
 template <typename CC>
 requires ChainComplex<CC> && LowerBoundedGrading<typename CC::GradingType>
 [[nodiscard]] inline typename CC::ChainType
 graded_boundary(CC& complex, const typename CC::CellType& cell) {
-  GradingResultType current_grade = complex.grade(cell);
-  if (current_grade == CC::GradingType::Minimum::value) {
-    return boundary(complex, cell);
+  if constexpr (requires { complex.graded_boundary(cell); }) {
+    return complex.graded_boundary(cell);
+  } else {
+    GradingResultType current_grade = complex.grade(cell);
+    if (current_grade == CC::GradingType::Minimum::value) {
+      return boundary(complex, cell);
+    }
+    return complex.boundary_if(
+        cell,
+        [current_grade, &complex](const typename CC::CellType boundary_cell) {
+          return complex.grade(boundary_cell) == current_grade;
+        }
+    );
   }
-  return complex.boundary_if(
-      cell,
-      [current_grade, &complex](const typename CC::CellType boundary_cell) {
-        return complex.grade(boundary_cell) == current_grade;
-      }
-  );
 }
-/** @brief Overload of `graded_boundary` linearly applied on `chain`. */
-template <ChainComplex CC>
-[[nodiscard]] inline typename CC::ChainType
-graded_boundary(CC& complex, const typename CC::ChainType& chain) {
-  return linear_apply(chain, [&complex](const typename CC::CellType cell) {
-    return graded_boundary(complex, cell);
-  });
+/**
+ * @brief Overload of `graded_boundary` linearly applied on `chain`
+ * under `policy`.
+ */
+template <ChainComplex CC, ExecutionPolicy P = SequencedPolicy>
+[[nodiscard]] inline typename CC::ChainType graded_boundary(
+    CC& complex, const typename CC::ChainType& chain, const P& policy = P()
+) {
+  using C = typename CC::CellType;
+  using R = typename CC::RingType;
+  using M = typename CC::ChainType;
+  M result;
+  linear_accumulate(
+      chain,
+      [&complex](const C& cell, const R& coef, M& out) {
+        detail::add_scaled(out, graded_boundary(complex, cell), coef);
+      },
+      result, policy
+  );
+  return result;
 }
 
 /**
@@ -205,20 +367,27 @@ template <ChainComplex CC>
 closure_boundary(CC& complex, const typename CC::CellType& cell) {
   return boundary(complex, cell);
 }
-/** @brief Overload of `closure_boundary` linearly applied on `chain`. */
-template <ChainComplex CC>
-[[nodiscard]] inline typename CC::ChainType
-closure_boundary(CC& complex, const typename CC::ChainType& chain) {
-  return linear_apply(chain, [&complex](const typename CC::CellType& cell) {
-    return closure_boundary(complex, cell);
-  });
+/**
+ * @brief Overload of `closure_boundary` linearly applied on `chain`
+ * under `policy`.
+ */
+template <ChainComplex CC, ExecutionPolicy P = SequencedPolicy>
+[[nodiscard]] inline typename CC::ChainType closure_boundary(
+    CC& complex, const typename CC::ChainType& chain, const P& policy = P()
+) {
+  return boundary(complex, chain, policy);
 }
 
 /**
  * @brief The coboundary of `cell` in the chain complex `complex` subject to the
  * condition `cond`.
  *
+ * The condition is a template parameter so that it may be inlined by
+ * complexes whose `coboundary_if` method is itself a template;
+ * `ConditionalType` instances are accepted as well.
+ *
  * @tparam CC Class modeling `ChainComplex`.
+ * @tparam F Predicate type on (constant references to) cells of `CC`.
  * @param complex The chain complex to which `cell` belongs and in which the
  * coboundary is taken.
  * @param cell The cell for which the coboundary is computed.
@@ -226,25 +395,85 @@ closure_boundary(CC& complex, const typename CC::ChainType& chain) {
  * in the resulting coboundary if and only if this condition returns `true`.
  * @return CC::ChainType The coboundary chain of `cell` in `complex`.
  */
-template <ChainComplex CC>
-[[nodiscard]] inline typename CC::ChainType coboundary_if(
-    CC& complex, const typename CC::CellType& cell,
-    const ConditionalType<typename CC::CellType>& cond
-) {
+template <ChainComplex CC, typename F>
+requires std::predicate<const F&, const typename CC::CellType&>
+[[nodiscard]] inline typename CC::ChainType
+coboundary_if(CC& complex, const typename CC::CellType& cell, const F& cond) {
   return complex.coboundary_if(cell, cond);
 }
-/** @brief Overload of `coboundary_if` linearly applied on `chain`. */
-template <ChainComplex CC>
+/**
+ * @brief Overload of `coboundary_if` linearly applied on `chain`
+ * under `policy`.
+ *
+ * The coboundary terms of each cell are streamed with `for_each_coboundary`
+ * and accumulated into the result, with no intermediate chains.
+ */
+template <ChainComplex CC, typename F, ExecutionPolicy P = SequencedPolicy>
+requires std::predicate<const F&, const typename CC::CellType&>
 [[nodiscard]] inline typename CC::ChainType coboundary_if(
-    CC& complex, const typename CC::ChainType& chain,
-    const ConditionalType<typename CC::CellType>& cond
+    CC& complex, const typename CC::ChainType& chain, const F& cond,
+    const P& policy = P()
 ) {
-  return linear_apply(
+  using C = typename CC::CellType;
+  using R = typename CC::RingType;
+  using M = typename CC::ChainType;
+  M result;
+  linear_accumulate(
       chain,
-      [&complex, &cond](const typename CC::CellType& cell) {
-        return coboundary_if(complex, cell, cond);
-      }
+      [&complex, &cond](const C& cell, const R& coef, M& out) {
+        for_each_coboundary(complex, cell, [&](const C& face, const R& term) {
+          if (cond(face)) {
+            out.insert(face, coef * term);
+          }
+        });
+      },
+      result, policy
   );
+  return result;
+}
+
+/**
+ * @brief Stream the coboundary of `cell` in the chain complex `complex` to
+ * `visitor` as (cell, coefficient) pairs.
+ *
+ * Complexes providing a `for_each_coboundary` method, such as
+ * `CubicalComplex`, do so without constructing a chain or allocating.
+ * Otherwise, the coboundary is computed with `coboundary_if` and its terms are
+ * visited.
+ *
+ * @tparam CC Class modeling `ChainComplex`.
+ * @tparam V Visitor type modeling `BoundaryVisitor`.
+ * @param complex The chain complex to which `cell` belongs and in which the
+ * coboundary is taken.
+ * @param cell The cell for which the coboundary is computed.
+ * @param visitor Function object called on each coboundary cell and its
+ * coefficient; if it returns `false`, the iteration stops.
+ * @return true If every coboundary cell was visited.
+ * @return false If `visitor` stopped the iteration early.
+ */
+template <ChainComplex CC, typename V>
+requires BoundaryVisitor<V, typename CC::CellType, typename CC::RingType>
+inline bool for_each_coboundary(
+    CC& complex, const typename CC::CellType& cell, V&& visitor
+) {
+  if constexpr (requires { complex.for_each_coboundary(cell, visitor); }) {
+    return complex.for_each_coboundary(cell, visitor);
+  } else {
+    const typename CC::ChainType chain = complex.coboundary_if(
+        cell,
+        []([[maybe_unused]] const typename CC::CellType& coboundary_cell) {
+          return true;
+        }
+    );
+    for (const typename CC::CellType& coboundary_cell : chain) {
+      if (!detail::visit_term(
+              visitor, coboundary_cell, chain[coboundary_cell]
+          )) {
+        return false;
+      }
+    }
+    return true;
+  }
 }
 
 /**
@@ -266,13 +495,30 @@ coboundary(CC& complex, const typename CC::CellType& cell) {
       }
   );
 }
-/** @brief Overload of `coboundary` linearly applied on `chain`. */
-template <ChainComplex CC>
-[[nodiscard]] inline typename CC::ChainType
-coboundary(CC& complex, const typename CC::ChainType& chain) {
-  return linear_apply(chain, [&complex](const typename CC::CellType cell) {
-    return coboundary(complex, cell);
-  });
+/**
+ * @brief Overload of `coboundary` linearly applied on `chain` under `policy`.
+ *
+ * The coboundary terms of each cell are streamed with `for_each_coboundary`
+ * and accumulated into the result, with no intermediate chains.
+ */
+template <ChainComplex CC, ExecutionPolicy P = SequencedPolicy>
+[[nodiscard]] inline typename CC::ChainType coboundary(
+    CC& complex, const typename CC::ChainType& chain, const P& policy = P()
+) {
+  using C = typename CC::CellType;
+  using R = typename CC::RingType;
+  using M = typename CC::ChainType;
+  M result;
+  linear_accumulate(
+      chain,
+      [&complex](const C& cell, const R& coef, M& out) {
+        for_each_coboundary(complex, cell, [&](const C& face, const R& term) {
+          out.insert(face, coef * term);
+        });
+      },
+      result, policy
+  );
+  return result;
 }
 
 /**
@@ -285,41 +531,66 @@ coboundary(CC& complex, const typename CC::ChainType& chain) {
  * @param cell The cell for which the coboundary is computed.
  * @return CC::ChainType The coboundary chain of `cell` in `complex`; all cells
  * present must have the same grade as `cell`.
+ *
+ * If `complex` has a `graded_coboundary` method, e.g. one grading every
+ * coface in a single batch, it is used instead; it is then responsible for
+ * skipping the grading of the cofaces of cells of maximal grade.
  */
 template <ChainComplex CC>
 [[nodiscard]] inline typename CC::ChainType
 graded_coboundary(CC& complex, const typename CC::CellType& cell) {
-  GradingResultType current_grade = complex.grade(cell);
-  return complex.coboundary_if(
-      cell,
-      [current_grade, &complex](const typename CC::CellType coboundary_cell) {
-        return complex.grade(coboundary_cell) == current_grade;
-      }
-  );
+  if constexpr (requires { complex.graded_coboundary(cell); }) {
+    return complex.graded_coboundary(cell);
+  } else {
+    GradingResultType current_grade = complex.grade(cell);
+    return complex.coboundary_if(
+        cell,
+        [current_grade, &complex](const typename CC::CellType coboundary_cell) {
+          return complex.grade(coboundary_cell) == current_grade;
+        }
+    );
+  }
 }
 /** @brief Specialization for when `cell` has maximal grade. */
 template <typename CC>
 requires ChainComplex<CC> && UpperBoundedGrading<typename CC::GradingType>
 [[nodiscard]] inline typename CC::ChainType
 graded_coboundary(CC& complex, const typename CC::CellType& cell) {
-  GradingResultType current_grade = complex.grade(cell);
-  if (current_grade == CC::GradingType::Maximum::value) {
-    return coboundary(complex, cell);
+  if constexpr (requires { complex.graded_coboundary(cell); }) {
+    return complex.graded_coboundary(cell);
+  } else {
+    GradingResultType current_grade = complex.grade(cell);
+    if (current_grade == CC::GradingType::Maximum::value) {
+      return coboundary(complex, cell);
+    }
+    return complex.coboundary_if(
+        cell,
+        [current_grade, &complex](const typename CC::CellType coboundary_cell) {
+          return complex.grade(coboundary_cell) == current_grade;
+        }
+    );
   }
-  return complex.coboundary_if(
-      cell,
-      [current_grade, &complex](const typename CC::CellType coboundary_cell) {
-        return complex.grade(coboundary_cell) == current_grade;
-      }
-  );
 }
-/** @brief Overload of `graded_coboundary` linearly applied on `chain`. */
-template <ChainComplex CC>
-[[nodiscard]] inline typename CC::ChainType
-graded_coboundary(CC& complex, const typename CC::ChainType& chain) {
-  return linear_apply(chain, [&complex](const typename CC::CellType cell) {
-    return graded_coboundary(complex, cell);
-  });
+/**
+ * @brief Overload of `graded_coboundary` linearly applied on `chain`
+ * under `policy`.
+ */
+template <ChainComplex CC, ExecutionPolicy P = SequencedPolicy>
+[[nodiscard]] inline typename CC::ChainType graded_coboundary(
+    CC& complex, const typename CC::ChainType& chain, const P& policy = P()
+) {
+  using C = typename CC::CellType;
+  using R = typename CC::RingType;
+  using M = typename CC::ChainType;
+  M result;
+  linear_accumulate(
+      chain,
+      [&complex](const C& cell, const R& coef, M& out) {
+        detail::add_scaled(out, graded_coboundary(complex, cell), coef);
+      },
+      result, policy
+  );
+  return result;
 }
 
 /**
@@ -360,13 +631,26 @@ closure_coboundary(CC& complex, const typename CC::CellType& cell) {
       }
   );
 }
-/** @brief Overload of `closure_coboundary` linearly applied on `chain`. */
-template <ChainComplex CC>
-[[nodiscard]] inline typename CC::ChainType
-closure_coboundary(CC& complex, const typename CC::ChainType& chain) {
-  return linear_apply(chain, [&complex](const typename CC::CellType& cell) {
-    return closure_coboundary(complex, cell);
-  });
+/**
+ * @brief Overload of `closure_coboundary` linearly applied on `chain`
+ * under `policy`.
+ */
+template <ChainComplex CC, ExecutionPolicy P = SequencedPolicy>
+[[nodiscard]] inline typename CC::ChainType closure_coboundary(
+    CC& complex, const typename CC::ChainType& chain, const P& policy = P()
+) {
+  using C = typename CC::CellType;
+  using R = typename CC::RingType;
+  using M = typename CC::ChainType;
+  M result;
+  linear_accumulate(
+      chain,
+      [&complex](const C& cell, const R& coef, M& out) {
+        detail::add_scaled(out, closure_coboundary(complex, cell), coef);
+      },
+      result, policy
+  );
+  return result;
 }
 
 }  // namespace chomp::core
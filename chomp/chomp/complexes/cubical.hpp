@@ -15,15 +15,28 @@
 #include <chomp/algebra/algebra.hpp>
 #include <chomp/algebra/cyclic.hpp>
 #include <chomp/algebra/modules.hpp>
+#include <chomp/algebra/sparse.hpp>
 #include <chomp/complexes/complexes.hpp>
 #include <chomp/complexes/grading.hpp>
 #include <chomp/util/constants.hpp>
+#include <chomp/util/hash.hpp>
+#include <chomp/util/statistics.hpp>
 
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <compare>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 
 namespace chomp::core {
@@ -38,6 +51,37 @@ namespace chomp::core {
 template <std::size_t CCDIM>
 using CubeOrthant = std::array<HypercubeCoordinate, CCDIM>;
 
+/**
+ * @brief Requirements on a cell type `C` of a cubical complex embedded in a
+ * `CCDIM`-dimensional hypercubical grid.
+ *
+ * Each cell is described by an orthant and an extent integer (see `Cube`).
+ * Beyond accessors to these, cell types must provide the faces and cofaces of
+ * a cell along a given axis; these are used by `CubicalComplex` to compute
+ * boundaries and coboundaries without unpacking the cell.
+ *
+ * The face methods are only required to be meaningful when the cell has
+ * extent along `axis` and the coface methods when it does not.
+ *
+ * @tparam C Cell type.
+ * @tparam CCDIM Ambient dimension of the hypercubical grid.
+ *
+ * @sa `Cube`, `PackedCube`
+ */
+template <typename C, std::size_t CCDIM>
+concept CubicalCell = requires(const C cell, std::size_t axis) {
+  requires Basis<C>;
+  requires std::constructible_from<C, const CubeOrthant<CCDIM>&, std::size_t>;
+
+  { cell.orthant() } -> std::convertible_to<CubeOrthant<CCDIM>>;
+  { cell.extent() } -> std::convertible_to<std::size_t>;
+  { cell.coordinate(axis) } -> std::convertible_to<HypercubeCoordinate>;
+  { cell.inner_face(axis) } -> std::same_as<C>;
+  { cell.outer_face(axis) } -> std::same_as<C>;
+  { cell.inner_coface(axis) } -> std::same_as<C>;
+  { cell.outer_coface(axis) } -> std::same_as<C>;
+};
+
 /**
  * @brief A hypercube embedded in `CCDIM`-dimensional space. This is the cell
  * type for the `CubicalComplex` chain complex.
@@ -96,6 +140,68 @@ public:
     return cube_extent;
   }
 
+  /**
+   * @brief Get the coordinate of the orthant of this cube along `axis`.
+   *
+   * @param axis
+   * @return HypercubeCoordinate
+   */
+  [[nodiscard]] HypercubeCoordinate coordinate(std::size_t axis
+  ) const noexcept {
+    return cube_orthant[axis];
+  }
+
+  /**
+   * @brief Get the face of this cube along `axis` in the same orthant.
+   *
+   * The cube must have extent along `axis`.
+   *
+   * @param axis
+   * @return Cube
+   */
+  [[nodiscard]] Cube inner_face(std::size_t axis) const noexcept {
+    return Cube(cube_orthant, cube_extent ^ (std::size_t(1) << axis));
+  }
+  /**
+   * @brief Get the face of this cube along `axis` in the next orthant along
+   * that axis.
+   *
+   * The cube must have extent along `axis`.
+   *
+   * @param axis
+   * @return Cube
+   */
+  [[nodiscard]] Cube outer_face(std::size_t axis) const noexcept {
+    CubeOrthant<CCDIM> new_orthant = cube_orthant;
+    new_orthant[axis] += 1;
+    return Cube(std::move(new_orthant), cube_extent ^ (std::size_t(1) << axis));
+  }
+  /**
+   * @brief Get the coface of this cube along `axis` in the previous orthant
+   * along that axis.
+   *
+   * The cube must not have extent along `axis`.
+   *
+   * @param axis
+   * @return Cube
+   */
+  [[nodiscard]] Cube inner_coface(std::size_t axis) const noexcept {
+    CubeOrthant<CCDIM> new_orthant = cube_orthant;
+    new_orthant[axis] -= 1;
+    return Cube(std::move(new_orthant), cube_extent | (std::size_t(1) << axis));
+  }
+  /**
+   * @brief Get the coface of this cube along `axis` in the same orthant.
+   *
+   * The cube must not have extent along `axis`.
+   *
+   * @param axis
+   * @return Cube
+   */
+  [[nodiscard]] Cube outer_coface(std::size_t axis) const noexcept {
+    return Cube(cube_orthant, cube_extent | (std::size_t(1) << axis));
+  }
+
   /**
    * @brief Equality of `Cube` instances is based on equality of orthant and
    * extent/shape parameters.
@@ -131,6 +237,221 @@ public:
   }
 };
 
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+/**
+ * @brief Bit layout of `PackedCube` words.
+ *
+ * Fields are packed upward from the least significant bit of the last word:
+ * first the extent, then the coordinates from the last axis to the first.
+ * A field that does not fit in the remainder of a word starts the preceding
+ * word. Hence comparing the words lexicographically agrees with the ordering
+ * of `Cube`.
+ */
+template <std::size_t CCDIM, std::size_t COORDINATE_BITS>
+struct PackedCubeLayout {
+  std::size_t words = 1;
+  std::array<std::size_t, CCDIM> word{};
+  std::array<std::size_t, CCDIM> shift{};
+
+  static constexpr PackedCubeLayout compute() noexcept {
+    PackedCubeLayout layout;
+    std::array<std::size_t, CCDIM> word_from_end{};
+    std::size_t current_word = 0;
+    std::size_t used_bits = CCDIM;
+
+    for (std::size_t axis = CCDIM; axis-- > 0;) {
+      if (used_bits + COORDINATE_BITS > SIZE_T_BITS) {
+        ++current_word;
+        used_bits = 0;
+      }
+      word_from_end[axis] = current_word;
+      layout.shift[axis] = used_bits;
+      used_bits += COORDINATE_BITS;
+    }
+
+    layout.words = current_word + 1;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      layout.word[axis] = layout.words - 1 - word_from_end[axis];
+    }
+    return layout;
+  }
+};
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
+/**
+ * @brief A hypercube embedded in `CCDIM`-dimensional space whose orthant and
+ * extent are bit-packed into one or two machine words.
+ *
+ * This is an alternative cell type to `Cube` for `CubicalComplex`. Each
+ * coordinate of the orthant occupies `COORDINATE_BITS` bits and the extent
+ * occupies `CCDIM` bits. Faces, cofaces, comparison, and hashing are all
+ * computed directly on the packed words.
+ *
+ * The ordering of `PackedCube` instances agrees with the ordering of the
+ * corresponding `Cube` instances.
+ *
+ * @tparam CCDIM The dimension of the hypercubical grid in which the associated
+ * cubical complex and this cube is embedded.
+ * @tparam COORDINATE_BITS Bits used to store each coordinate; orthant
+ * coordinates must be less than `2^COORDINATE_BITS`. The default stores the
+ * full range of `HypercubeCoordinate`.
+ *
+ * @sa `Cube`, `CubicalComplex`
+ */
+template <
+    std::size_t CCDIM,
+    std::size_t COORDINATE_BITS =
+        std::numeric_limits<HypercubeCoordinate>::digits>
+requires requires {
+  requires CCDIM > 0 && CCDIM <= SIZE_T_BITS;
+  requires COORDINATE_BITS > 0 &&
+               COORDINATE_BITS <=
+                   std::numeric_limits<HypercubeCoordinate>::digits;
+  requires detail::PackedCubeLayout<CCDIM, COORDINATE_BITS>::compute().words <=
+               2;
+}
+class PackedCube {
+private:
+  static constexpr detail::PackedCubeLayout<CCDIM, COORDINATE_BITS> LAYOUT =
+      detail::PackedCubeLayout<CCDIM, COORDINATE_BITS>::compute();
+  static constexpr std::size_t WORDS = LAYOUT.words;
+  static constexpr std::size_t EXTENT_MASK =
+      CCDIM == SIZE_T_BITS ? ~std::size_t(0) : (std::size_t(1) << CCDIM) - 1;
+  static constexpr std::size_t COORDINATE_MASK =
+      (std::size_t(1) << COORDINATE_BITS) - 1;
+
+  std::array<std::size_t, WORDS> cube_words{};
+
+public:
+  /** @brief Number of machine words storing each cube. */
+  static constexpr std::size_t word_count = WORDS;
+
+  /**
+   * @brief Initialize a `PackedCube` instance by providing an orthant and an
+   * extent parameter.
+   *
+   * @param cube_orthant Location of the orthant this cube is in; each
+   * coordinate must be less than `2^COORDINATE_BITS`.
+   * @param cube_extent Shape of this cube with each bit 1 or 0 depending on
+   * if the cube has extent along the corresponding axis.
+   */
+  PackedCube(const CubeOrthant<CCDIM>& cube_orthant, std::size_t cube_extent) {
+    cube_words[WORDS - 1] = cube_extent & EXTENT_MASK;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      cube_words[LAYOUT.word[axis]] |=
+          static_cast<std::size_t>(cube_orthant[axis]) << LAYOUT.shift[axis];
+    }
+  }
+
+  /**
+   * @brief Pack a `Cube` instance.
+   *
+   * @param cube
+   */
+  explicit PackedCube(const Cube<CCDIM>& cube) :
+      PackedCube(cube.orthant(), cube.extent()) {}
+
+  /**
+   * @brief Unpack this cube into a `Cube` instance.
+   *
+   * @return Cube<CCDIM>
+   */
+  [[nodiscard]] Cube<CCDIM> unpack() const {
+    return Cube<CCDIM>(orthant(), extent());
+  }
+
+  /**
+   * @brief Get the orthant of this cube.
+   *
+   * The orthant is not stored explicitly; it is computed from the packed words.
+   *
+   * @return CubeOrthant<CCDIM>
+   */
+  [[nodiscard]] CubeOrthant<CCDIM> orthant() const noexcept {
+    CubeOrthant<CCDIM> cube_orthant;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      cube_orthant[axis] = coordinate(axis);
+    }
+    return cube_orthant;
+  }
+
+  /**
+   * @brief Get the shape parameter of this cube.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t extent() const noexcept {
+    return cube_words[WORDS - 1] & EXTENT_MASK;
+  }
+
+  /** @copydoc Cube::coordinate() */
+  [[nodiscard]] HypercubeCoordinate coordinate(std::size_t axis
+  ) const noexcept {
+    return static_cast<HypercubeCoordinate>(
+        (cube_words[LAYOUT.word[axis]] >> LAYOUT.shift[axis]) & COORDINATE_MASK
+    );
+  }
+
+  /**
+   * @brief Get the packed words of this cube.
+   *
+   * @return const std::array<std::size_t, word_count>&
+   */
+  [[nodiscard]] const std::array<std::size_t, WORDS>& words() const noexcept {
+    return cube_words;
+  }
+
+  /** @copydoc Cube::inner_face() */
+  [[nodiscard]] PackedCube inner_face(std::size_t axis) const noexcept {
+    PackedCube result(*this);
+    result.cube_words[WORDS - 1] ^= std::size_t(1) << axis;
+    return result;
+  }
+  /** @copydoc Cube::outer_face() */
+  [[nodiscard]] PackedCube outer_face(std::size_t axis) const noexcept {
+    PackedCube result(*this);
+    result.cube_words[WORDS - 1] ^= std::size_t(1) << axis;
+    result.cube_words[LAYOUT.word[axis]] += std::size_t(1)
+                                            << LAYOUT.shift[axis];
+    return result;
+  }
+  /** @copydoc Cube::inner_coface() */
+  [[nodiscard]] PackedCube inner_coface(std::size_t axis) const noexcept {
+    PackedCube result(*this);
+    result.cube_words[WORDS - 1] |= std::size_t(1) << axis;
+    result.cube_words[LAYOUT.word[axis]] -= std::size_t(1)
+                                            << LAYOUT.shift[axis];
+    return result;
+  }
+  /** @copydoc Cube::outer_coface() */
+  [[nodiscard]] PackedCube outer_coface(std::size_t axis) const noexcept {
+    PackedCube result(*this);
+    result.cube_words[WORDS - 1] |= std::size_t(1) << axis;
+    return result;
+  }
+
+  /**
+   * @brief Equality of `PackedCube` instances is equality of their words.
+   *
+   * @param rhs
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool operator==(const PackedCube& rhs) const noexcept = default;
+
+  /**
+   * @brief Three-way comparison operator compares the words lexicographically.
+   *
+   * By the layout of the words, this agrees with the ordering of `Cube`.
+   */
+  [[nodiscard]] std::strong_ordering operator<=>(const PackedCube& rhs
+  ) const noexcept = default;
+};
+
 }  // namespace chomp::core
 
 namespace std {
@@ -138,20 +459,54 @@ namespace std {
 /**
  * @brief Hash specialization for `Cube` class.
  *
+ * Agrees with the hash of the corresponding `PackedCube` with the default
+ * coordinate width, when it exists; see there.
+ *
  * @tparam CCDIM
  */
 template <size_t CCDIM>
 struct hash<chomp::core::Cube<CCDIM>> {
   /** @brief Hash the `Cube` by its orthant and its extent/shape parameter. */
-  size_t operator()(const chomp::core::Cube<CCDIM>& cube) const {
-    constexpr size_t PRIME = chomp::core::CUBE_HASH_PRIME;
-    constexpr size_t BIT_DIFFERENCE = chomp::core::SIZE_T_BITS - CCDIM;
-    size_t hash_result = 0;
-    const chomp::core::CubeOrthant<CCDIM>& cube_orthant = cube.orthant();
-    for (size_t idx = 0; idx < CCDIM; ++idx) {
-      hash_result = PRIME * hash_result + cube_orthant[idx];
+  size_t operator()(const chomp::core::Cube<CCDIM>& cube) const noexcept {
+    if constexpr (requires { typename chomp::core::PackedCube<CCDIM>; }) {
+      return chomp::core::hash_words(
+          chomp::core::PackedCube<CCDIM>(cube).words()
+      );
+    } else {
+      // Too many axes to pack: fold the coordinates a word at a time
+      constexpr size_t COORDINATE_BITS =
+          numeric_limits<chomp::core::HypercubeCoordinate>::digits;
+      constexpr size_t PER_WORD = chomp::core::SIZE_T_BITS / COORDINATE_BITS;
+      constexpr size_t WORDS = (CCDIM + PER_WORD - 1) / PER_WORD + 1;
+      array<size_t, WORDS> cube_words{};
+      const chomp::core::CubeOrthant<CCDIM>& cube_orthant = cube.orthant();
+      for (size_t axis = 0; axis < CCDIM; ++axis) {
+        cube_words[axis / PER_WORD] |= static_cast<size_t>(cube_orthant[axis])
+                                       << (axis % PER_WORD * COORDINATE_BITS);
+      }
+      cube_words[WORDS - 1] = cube.extent();
+      return chomp::core::hash_words(cube_words);
     }
-    return hash_result ^ (cube.extent() << BIT_DIFFERENCE);
+  }
+};
+
+/**
+ * @brief Hash specialization for `PackedCube` class.
+ *
+ * A cube packed into one word is hashed by that word, so distinct cubes never
+ * collide and neighboring cubes land in nearby buckets; cubes packed into two
+ * words are hashed by `hash_words`. Use `MixedHash` as the hash of containers
+ * that need every bit of the hash mixed.
+ *
+ * @tparam CCDIM
+ * @tparam COORDINATE_BITS
+ */
+template <size_t CCDIM, size_t COORDINATE_BITS>
+struct hash<chomp::core::PackedCube<CCDIM, COORDINATE_BITS>> {
+  /** @brief Hash the `PackedCube` by its packed words. */
+  size_t operator()(const chomp::core::PackedCube<CCDIM, COORDINATE_BITS>& cube
+  ) const noexcept {
+    return chomp::core::hash_words(cube.words());
   }
 };
 
@@ -159,11 +514,309 @@ struct hash<chomp::core::Cube<CCDIM>> {
 
 namespace chomp::core {
 
+/**
+ * @brief Call `visitor` on every orthant of the box from `minimum` to
+ * `maximum` (inclusive), in linear order with axis `0` varying fastest.
+ *
+ * @tparam CCDIM Ambient dimension of the hypercubical grid.
+ * @tparam F Function object type invocable on `const CubeOrthant<CCDIM>&`.
+ * @param minimum Minimum orthant of the box.
+ * @param maximum Maximum orthant of the box; at least `minimum` along each
+ * axis.
+ * @param visitor
+ */
+template <std::size_t CCDIM, std::invocable<const CubeOrthant<CCDIM>&> F>
+void for_each_orthant(
+    const CubeOrthant<CCDIM>& minimum, const CubeOrthant<CCDIM>& maximum,
+    F&& visitor
+) {
+  CubeOrthant<CCDIM> orthant = minimum;
+  while (true) {
+    visitor(std::as_const(orthant));
+    // Advance the orthant odometer, first axis fastest
+    std::size_t axis = 0;
+    while (axis < CCDIM && orthant[axis] == maximum[axis]) {
+      orthant[axis] = minimum[axis];
+      ++axis;
+    }
+    if (axis == CCDIM) {
+      return;
+    }
+    ++orthant[axis];
+  }
+}
+
+/**
+ * @brief Bijection between the cells of a box of orthants in a
+ * `CCDIM`-dimensional hypercubical grid and the contiguous integers
+ * `[0, size())`.
+ *
+ * The box comprises every orthant between a minimum and a maximum orthant
+ * (inclusive) and, for each orthant, every one of the `2^CCDIM` extents. The
+ * index of a cell is its orthant's linear index (with axis `0` varying
+ * fastest) shifted left by `CCDIM` bits, with the extent in the low bits; the
+ * cells of each orthant are thus contiguous. Cells outside the box have no
+ * index.
+ *
+ * @tparam CCDIM Ambient dimension of the hypercubical grid; must be fewer than
+ * the bitwidth of `std::size_t`.
+ *
+ * @sa `CubicalComplex`, `DenseGrading`
+ */
+template <std::size_t CCDIM>
+requires(CCDIM < SIZE_T_BITS)
+class CubeIndexer {
+private:
+  CubeOrthant<CCDIM> minimum_orthant;
+  CubeOrthant<CCDIM> maximum_orthant;
+  std::array<std::size_t, CCDIM> orthant_strides;
+  std::size_t total_orthants;
+
+public:
+  /**
+   * @brief Initialize the indexer for the box between `minimum_orthant` and
+   * `maximum_orthant`, inclusive.
+   *
+   * @param minimum_orthant
+   * @param maximum_orthant Must be at least `minimum_orthant` along each axis.
+   */
+  CubeIndexer(
+      const CubeOrthant<CCDIM>& minimum_orthant,
+      const CubeOrthant<CCDIM>& maximum_orthant
+  ) : minimum_orthant(minimum_orthant), maximum_orthant(maximum_orthant) {
+    std::size_t stride = 1;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      orthant_strides[axis] = stride;
+      stride *= std::size_t(maximum_orthant[axis] - minimum_orthant[axis]) + 1;
+    }
+    total_orthants = stride;
+  }
+
+  /** @brief Get the minimum orthant of the box. */
+  [[nodiscard]] const CubeOrthant<CCDIM>& minimum() const noexcept {
+    return minimum_orthant;
+  }
+  /** @brief Get the maximum orthant of the box. */
+  [[nodiscard]] const CubeOrthant<CCDIM>& maximum() const noexcept {
+    return maximum_orthant;
+  }
+
+  /**
+   * @brief Number of cells in the box, i.e. one past the largest index.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return total_orthants << CCDIM;
+  }
+  /**
+   * @brief Number of orthants in the box.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t orthant_count() const noexcept {
+    return total_orthants;
+  }
+
+  /**
+   * @brief Difference in index between a cell and the cell with the same
+   * extent in the next orthant along `axis`.
+   *
+   * @param axis
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t stride(std::size_t axis) const noexcept {
+    return orthant_strides[axis] << CCDIM;
+  }
+
+  /**
+   * @brief Whether `cell` lies in the box.
+   *
+   * @tparam C Cell type modeling `CubicalCell`.
+   * @param cell
+   * @return true
+   * @return false
+   */
+  template <CubicalCell<CCDIM> C>
+  [[nodiscard]] bool contains(const C& cell) const noexcept {
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      const HypercubeCoordinate coordinate = cell.coordinate(axis);
+      if (coordinate < minimum_orthant[axis] ||
+          coordinate > maximum_orthant[axis]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Linear index of the orthant of `cell` in the box.
+   *
+   * @tparam C Cell type modeling `CubicalCell`.
+   * @param cell Must lie in the box.
+   * @return std::size_t
+   */
+  template <CubicalCell<CCDIM> C>
+  [[nodiscard]] std::size_t orthant_index(const C& cell) const noexcept {
+    std::size_t index = 0;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      index += std::size_t(cell.coordinate(axis) - minimum_orthant[axis]) *
+               orthant_strides[axis];
+    }
+    return index;
+  }
+
+  /**
+   * @brief Index of `cell` in the box.
+   *
+   * @tparam C Cell type modeling `CubicalCell`.
+   * @param cell Must lie in the box.
+   * @return std::size_t
+   */
+  template <CubicalCell<CCDIM> C>
+  [[nodiscard]] std::size_t index_of(const C& cell) const noexcept {
+    return (orthant_index(cell) << CCDIM) | std::size_t(cell.extent());
+  }
+
+  /**
+   * @brief Coordinate along `axis` of the orthant of the cell with index
+   * `index`, without constructing the cell.
+   *
+   * @param index Must be less than `size()`.
+   * @param axis
+   * @return HypercubeCoordinate
+   */
+  [[nodiscard]] HypercubeCoordinate
+  coordinate(std::size_t index, std::size_t axis) const noexcept {
+    const std::size_t length =
+        std::size_t(maximum_orthant[axis] - minimum_orthant[axis]) + 1;
+    return static_cast<HypercubeCoordinate>(
+        minimum_orthant[axis] +
+        ((index >> CCDIM) / orthant_strides[axis]) % length
+    );
+  }
+
+  /**
+   * @brief The cell with index `index` in the box; inverse of `index_of`.
+   *
+   * @tparam C Cell type modeling `CubicalCell`.
+   * @param index Must be less than `size()`.
+   * @return C
+   */
+  template <CubicalCell<CCDIM> C>
+  [[nodiscard]] C cell_at(std::size_t index) const {
+    const std::size_t extent = index & ((std::size_t(1) << CCDIM) - 1);
+    std::size_t remainder = index >> CCDIM;
+    CubeOrthant<CCDIM> orthant;
+    for (std::size_t axis = CCDIM; axis-- > 0;) {
+      orthant[axis] = static_cast<HypercubeCoordinate>(
+          minimum_orthant[axis] + remainder / orthant_strides[axis]
+      );
+      remainder %= orthant_strides[axis];
+    }
+    return C(orthant, extent);
+  }
+};
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+/**
+ * @brief Largest ambient dimension for which (co)boundary kernels read the
+ * face axes of each extent from a precomputed table, fully unrolled.
+ *
+ * Above this the tables (`2^CCDIM` entries) outgrow their benefit and the
+ * kernels iterate the set bits of the extent instead.
+ */
+constexpr std::size_t FACE_TABLE_MAX_DIM = 6;
+
+/**
+ * @brief Axes along which the cells of one extent have faces (or cofaces),
+ * with the sign of the coefficients along each.
+ *
+ * Faces lie along the axes with extent and cofaces along the axes without, in
+ * increasing order. `negative[i]` is set when an odd number of axes with extent
+ * precede `axes[i]`; the first face along that axis (outer face, or inner
+ * coface) then has coefficient `-1` and the second `1`, rather than the
+ * reverse.
+ */
+template <std::size_t CCDIM>
+struct FaceAxes {
+  std::size_t count = 0;
+  std::array<std::uint8_t, CCDIM> axes{};
+  std::array<bool, CCDIM> negative{};
+};
+
+template <std::size_t CCDIM, bool COFACES>
+constexpr std::array<FaceAxes<CCDIM>, std::size_t(1) << CCDIM>
+face_axes_table() noexcept {
+  std::array<FaceAxes<CCDIM>, std::size_t(1) << CCDIM> table{};
+  for (std::size_t extent = 0; extent < table.size(); ++extent) {
+    FaceAxes<CCDIM>& faces = table[extent];
+    bool negative = false;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      const bool has_extent = (extent >> axis) & 1;
+      if (has_extent != COFACES) {
+        faces.axes[faces.count] = static_cast<std::uint8_t>(axis);
+        faces.negative[faces.count] = negative;
+        ++faces.count;
+      }
+      negative ^= has_extent;
+    }
+  }
+  return table;
+}
+
+template <std::size_t CCDIM, bool COFACES>
+inline constexpr std::array<FaceAxes<CCDIM>, std::size_t(1) << CCDIM>
+    FACE_AXES = face_axes_table<CCDIM, COFACES>();
+
+/**
+ * @brief Call `step(axis, negative)` on each axis along which cells of extent
+ * `extent` have faces (or cofaces if `COFACES`), in increasing order.
+ *
+ * `negative` is as in `FaceAxes`. Bits of `extent` above `CCDIM` (such as the
+ * orthant of a `CubeIndexer` index) are ignored. Returning `false` from `step`
+ * stops the iteration early. For `CCDIM` at most `FACE_TABLE_MAX_DIM` the axes
+ * are read from `FACE_AXES` in a fully unrolled sequence; otherwise only the
+ * relevant bits of `extent` are visited, lowest first.
+ *
+ * @return true If every axis was visited.
+ * @return false If `step` stopped the iteration early.
+ */
+template <std::size_t CCDIM, bool COFACES, typename F>
+bool for_each_face_axis(std::size_t extent, F&& step) {
+  constexpr std::size_t ALL_AXES = (std::size_t(1) << CCDIM) - 1;
+  extent &= ALL_AXES;
+  if constexpr (CCDIM <= FACE_TABLE_MAX_DIM) {
+    const FaceAxes<CCDIM>& faces = FACE_AXES<CCDIM, COFACES>[extent];
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+      return ((I >= faces.count ||
+               step(std::size_t(faces.axes[I]), faces.negative[I])) &&
+              ...);
+    }(std::make_index_sequence<CCDIM>());
+  } else {
+    std::size_t axes = COFACES ? ~extent & ALL_AXES : extent;
+    for (; axes != 0; axes &= axes - 1) {
+      const std::size_t axis = std::countr_zero(axes);
+      const std::size_t preceding = extent & ((std::size_t(1) << axis) - 1);
+      if (!step(axis, bool(std::popcount(preceding) & 1))) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
 /**
  * @brief Class implementing a cubical complex embedded in a `CCDIM`-dimensional
  * hypercubical grid.
  *
- * The corresponding cell class is `Cube`.
+ * The cell type is the input type of the grading function, which may be `Cube`,
+ * `PackedCube`, or any other type modeling `CubicalCell`.
  *
  * The cubical complex includes all orthants in the hypercubical grid between
  * some minimum orthant (default the origin) and some user-provided maximum
@@ -173,36 +826,195 @@ namespace chomp::core {
  * dimension of `Cube` instances as cells and the number of axes. Notably, this
  * must be fewer than the bitwidth of `std::size_t`.
  * @tparam G The type of grading function object, which must model `Grading`.
+ * Its input type must model `CubicalCell` and is the cell type of the complex.
  * @tparam R The coefficient ring type, which must model `Ring`. Default value
  * is `Z<2>`, i.e. the ring (field) with two elements.
  * @tparam M The chain type, which must model `Module`. The basis type must be
- * `Cube<CCDIM>` and the coefficient ring type must be `R`. The default type is
- * set to `DefaultModule` on these types.
+ * the cell type and the coefficient ring type must be `R`. The default type is
+ * `SmallChain` on these types, storing the at most `2 * CCDIM` terms of a
+ * single cell boundary inline and spilling into `DefaultModule` for larger
+ * chains.
  */
 template <
     std::size_t CCDIM, Grading G, Ring R = Z<2>,
-    Module M = DefaultModule<Cube<CCDIM>, R>>
+    Module M = SmallChain<typename G::InputType, R, 2 * CCDIM>>
 requires requires {
-  requires CCDIM <= SIZE_T_BITS;
-  requires std::same_as<typename G::InputType, Cube<CCDIM>>;
+  requires CCDIM < SIZE_T_BITS;
+  requires CubicalCell<typename G::InputType, CCDIM>;
   requires std::same_as<typename M::RingType, R>;
-  requires std::same_as<typename M::BasisType, Cube<CCDIM>>;
+  requires std::same_as<typename M::BasisType, typename G::InputType>;
 }
 class CubicalComplex {
 private:
   CubeOrthant<CCDIM> minimum_orthant;
   CubeOrthant<CCDIM> maximum_orthant;
+  CubeIndexer<CCDIM> cell_indexer;
   G grading_function;
+  // Updated by const (co)boundary methods; empty unless statistics enabled.
+  [[no_unique_address]] mutable detail::ComplexCounters<> counters;
+
+  // Function objects for the cell ranges; named types keep the range types
+  // spellable.
+  struct IndexToCell {
+    const CubicalComplex* complex;
+    typename G::InputType operator()(std::size_t index) const {
+      return complex->cell_at(index);
+    }
+  };
+  struct RankToCell {
+    const CubicalComplex* complex;
+    // Extents of the given dimension, shared between copies of the range.
+    std::shared_ptr<const std::vector<std::size_t>> extents;
+    typename G::InputType operator()(std::size_t rank) const {
+      const std::size_t count = extents->size();
+      return complex->cell_at(
+          ((rank / count) << CCDIM) | (*extents)[rank % count]
+      );
+    }
+  };
+  struct HasGrade {
+    CubicalComplex* complex;
+    GradingResultType grade;
+    bool operator()(const typename G::InputType& cell) const {
+      return complex->grade(cell) == grade;
+    }
+  };
+
+public:
+  /**
+   * @brief Boundary operator of (part of) the complex as a square sparse
+   * matrix; see `boundary_matrix`.
+   */
+  struct BoundaryMatrixType {
+    /** @brief Boundary matrix; row and column `i` are the same cell. */
+    SparseMatrix<R> matrix;
+    /** @brief Complex index (see `index_of`) of the cell of each column. */
+    std::vector<std::size_t> cells;
+    /** @brief Dimension of the cell of each column. */
+    std::vector<std::size_t> dimensions;
+    /** @brief Grade of the cell of each column. */
+    std::vector<GradingResultType> grades;
+  };
+
+private:
+  // Assemble the boundary matrix on the cells whose grade satisfies include
+  template <typename F>
+  BoundaryMatrixType assemble_boundary_matrix(const F& include) {
+    BoundaryMatrixType result;
+    std::vector<std::tuple<GradingResultType, std::size_t, std::size_t>> keys;
+    for (std::size_t index = 0; index < cell_count(); ++index) {
+      const GradingResultType cell_grade = grade(cell_at(index));
+      if (include(cell_grade)) {
+        keys.emplace_back(cell_grade, dimension_of_index(index), index);
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+
+    // Position of each complex index in the filtration order
+    constexpr std::size_t absent = std::numeric_limits<std::size_t>::max();
+    std::vector<std::size_t> position(cell_count(), absent);
+    result.cells.reserve(keys.size());
+    result.dimensions.reserve(keys.size());
+    result.grades.reserve(keys.size());
+    for (const auto& [cell_grade, cell_dimension, index] : keys) {
+      position[index] = result.cells.size();
+      result.cells.push_back(index);
+      result.dimensions.push_back(cell_dimension);
+      result.grades.push_back(cell_grade);
+    }
+
+    result.matrix = SparseMatrix<R>(keys.size());
+    std::vector<typename SparseMatrix<R>::EntryType> entries;
+    for (const std::size_t index : result.cells) {
+      entries.clear();
+      for_each_boundary_index(
+          index,
+          [&entries, &position](std::size_t face, const RingType& coef) {
+            if (position[face] != absent) {
+              entries.emplace_back(position[face], coef);
+            }
+          }
+      );
+      result.matrix.push_column(entries);
+    }
+    return result;
+  }
+
+  // Graded (co)boundary of cell, grading its (co)faces in one batch. Every
+  // face of a cell of minimal grade, and every coface of a cell of maximal
+  // grade, has the grade of the cell and is kept without grading.
+  template <bool COBOUNDARY>
+  M graded_chain(const typename G::InputType& cell) {
+    const GradingResultType cell_grade = grade(cell);
+    bool extremal = false;
+    if constexpr (COBOUNDARY && UpperBoundedGrading<G>) {
+      extremal = cell_grade == G::Maximum::value;
+    } else if constexpr (!COBOUNDARY && LowerBoundedGrading<G>) {
+      extremal = cell_grade == G::Minimum::value;
+    }
+
+    // Cells need not be default constructible; fill with copies of cell
+    std::array<CellType, 2 * CCDIM + 1> chain_cells =
+        [&cell]<std::size_t... I>(std::index_sequence<I...>) {
+          return std::array<CellType, 2 * CCDIM + 1>{((void)I, cell)...};
+        }(std::make_index_sequence<2 * CCDIM + 1>());
+    std::array<RingType, 2 * CCDIM + 1> coefs;
+    std::size_t count = 1;
+    const auto gather = [&chain_cells, &coefs,
+                         &count](const CellType& other, const RingType& coef) {
+      chain_cells[count] = other;
+      coefs[count] = coef;
+      ++count;
+    };
+    if constexpr (COBOUNDARY) {
+      for_each_coboundary(cell, gather);
+    } else {
+      for_each_boundary(cell, gather);
+    }
+
+    std::array<GradingResultType, 2 * CCDIM + 1> grades;
+    grades.fill(cell_grade);
+    if (!extremal) {
+      grade_many(
+          std::span<const CellType>(chain_cells.data() + 1, count - 1),
+          std::span<GradingResultType>(grades.data() + 1, count - 1)
+      );
+    }
+    ChainType result;
+    for (std::size_t term = 1; term < count; ++term) {
+      if (grades[term] == cell_grade) {
+        result.insert(chain_cells[term], coefs[term]);
+      }
+    }
+    counters.record_emitted(result.size());
+    return result;
+  }
+
+  static std::size_t dimension_of_index(std::size_t index) noexcept {
+    return static_cast<std::size_t>(
+        std::popcount(index & ((std::size_t(1) << CCDIM) - 1))
+    );
+  }
 
 public:
   /** @brief Coefficient ring type for chains. */
   using RingType = R;
   /** @brief Cell type for cubical complexes. */
-  using CellType = Cube<CCDIM>;
+  using CellType = typename G::InputType;
   /** @brief Chain (module) type. */
   using ChainType = M;
   /** @brief Grading function object type. */
   using GradingType = G;
+  /** @brief Chain type over cell indices (see `index_of`). */
+  using IndexChainType = SmallChain<std::size_t, R, 2 * CCDIM>;
+  /** @brief Lazy range of cells in index order (see `cells`). */
+  using CellRangeType = std::ranges::transform_view<
+      std::ranges::iota_view<std::size_t, std::size_t>, IndexToCell>;
+  /** @brief Lazy range of cells of one dimension (see `cells_of_dimension`). */
+  using DimensionRangeType = std::ranges::transform_view<
+      std::ranges::iota_view<std::size_t, std::size_t>, RankToCell>;
+  /** @brief Lazy range of cells of one grade (see `cells_with_grade`). */
+  using GradeRangeType = std::ranges::filter_view<CellRangeType, HasGrade>;
 
   /**
    * @brief Initialize a new cubical complex with a maximum orthant and the
@@ -216,12 +1028,14 @@ public:
       const GradingType& grading_function
   ) :
       minimum_orthant(), maximum_orthant(maximum_orthant),
+      cell_indexer(minimum_orthant, maximum_orthant),
       grading_function(grading_function) {}
   /** @copydoc CubicalComplex(const CubeOrthant<CCDIM>&, const GradingType&) */
   CubicalComplex(
       const CubeOrthant<CCDIM>& maximum_orthant, GradingType&& grading_function
   ) :
       minimum_orthant(), maximum_orthant(maximum_orthant),
+      cell_indexer(minimum_orthant, maximum_orthant),
       grading_function(std::move(grading_function)) {}
   /**
    * @brief Initialize a new cubical complex with both a maximum and minimum
@@ -237,6 +1051,7 @@ public:
       const GradingType& grading_function
   ) :
       minimum_orthant(minimum_orthant), maximum_orthant(maximum_orthant),
+      cell_indexer(minimum_orthant, maximum_orthant),
       grading_function(grading_function) {}
   /**
    * @copydoc CubicalComplex(const CubeOrthant<CCDIM>&,
@@ -247,6 +1062,7 @@ public:
       const CubeOrthant<CCDIM>& maximum_orthant, GradingType&& grading_function
   ) :
       minimum_orthant(minimum_orthant), maximum_orthant(maximum_orthant),
+      cell_indexer(minimum_orthant, maximum_orthant),
       grading_function(std::move(grading_function)) {}
 
   /**
@@ -284,6 +1100,154 @@ public:
     return maximum_orthant.at(axis);
   }
 
+  /**
+   * @brief Get the indexer linearizing the cells of the complex.
+   *
+   * @return const CubeIndexer<CCDIM>&
+   */
+  [[nodiscard]] const CubeIndexer<CCDIM>& indexer() const noexcept {
+    return cell_indexer;
+  }
+  /**
+   * @brief Number of cells in the complex, i.e. one past the largest index.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t cell_count() const noexcept {
+    return cell_indexer.size();
+  }
+  /**
+   * @brief Index of `cell` in the complex in `[0, cell_count())`.
+   *
+   * @param cell Cell of the complex.
+   * @return std::size_t
+   *
+   * @sa `CubeIndexer`
+   */
+  [[nodiscard]] std::size_t index_of(const CellType& cell) const noexcept {
+    return cell_indexer.index_of(cell);
+  }
+  /**
+   * @brief The cell with index `index` in the complex; inverse of `index_of`.
+   *
+   * @param index Must be less than `cell_count()`.
+   * @return CellType
+   */
+  [[nodiscard]] CellType cell_at(std::size_t index) const {
+    return cell_indexer.template cell_at<CellType>(index);
+  }
+
+  /**
+   * @brief Dimension of `cell` as a cell of the complex, i.e. the number of
+   * axes along which it has extent.
+   *
+   * @param cell
+   * @return std::size_t
+   */
+  [[nodiscard]] static std::size_t dimension(const CellType& cell) noexcept {
+    return static_cast<std::size_t>(std::popcount(std::size_t(cell.extent())));
+  }
+
+  /**
+   * @brief Lazy range over every cell of the complex in index order.
+   *
+   * Cells are enumerated orthant by orthant, so that the cells of each orthant
+   * are visited together; no container of cells is materialized. The range is
+   * a random access view and composes with `std::views`.
+   *
+   * @return CellRangeType
+   *
+   * @sa `index_of`
+   */
+  [[nodiscard]] CellRangeType cells() const {
+    return cells(0, cell_count());
+  }
+  /**
+   * @brief Lazy range over the cells with indices in `[first, last)`.
+   *
+   * @param first
+   * @param last Must be at most `cell_count()`.
+   * @return CellRangeType
+   */
+  [[nodiscard]] CellRangeType
+  cells(std::size_t first, std::size_t last) const {
+    return CellRangeType(
+        std::ranges::iota_view<std::size_t, std::size_t>(first, last),
+        IndexToCell{this}
+    );
+  }
+  /**
+   * @brief Split `cells()` into `count` contiguous ranges of nearly equal
+   * size, e.g. for parallel consumers.
+   *
+   * Each range covers whole orthants where possible; empty ranges are
+   * included when there are fewer orthants than `count`.
+   *
+   * @param count Number of ranges; must be positive.
+   * @return std::vector<CellRangeType>
+   */
+  [[nodiscard]] std::vector<CellRangeType>
+  partition_cells(std::size_t count) const {
+    std::vector<CellRangeType> result;
+    result.reserve(count);
+    const std::size_t orthants = cell_indexer.orthant_count();
+    for (std::size_t part = 0; part < count; ++part) {
+      result.push_back(cells(
+          ((orthants * part) / count) << CCDIM,
+          ((orthants * (part + 1)) / count) << CCDIM
+      ));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Lazy range over every cell of dimension `dim` in the complex.
+   *
+   * Cells are enumerated orthant by orthant, with the extents of dimension
+   * `dim` in increasing order within each. The position of a cell in this
+   * range is its rank among cells of dimension `dim`. Only the list of
+   * extents of dimension `dim` is stored.
+   *
+   * @param dim Dimension; must be at most `CCDIM`.
+   * @return DimensionRangeType
+   */
+  [[nodiscard]] DimensionRangeType cells_of_dimension(std::size_t dim) const {
+    std::vector<std::size_t> extents;
+    if (dim == 0) {
+      extents.push_back(0);
+    } else {
+      // Enumerate extents with `dim` bits set in increasing order
+      std::size_t extent = (std::size_t(1) << dim) - 1;
+      while (extent < (std::size_t(1) << CCDIM)) {
+        extents.push_back(extent);
+        const std::size_t low = extent & -extent;
+        const std::size_t ripple = extent + low;
+        extent = ripple | (((extent ^ ripple) >> 2) / low);
+      }
+    }
+    const std::size_t count = cell_indexer.orthant_count() * extents.size();
+    return DimensionRangeType(
+        std::ranges::iota_view<std::size_t, std::size_t>(0, count),
+        RankToCell{
+            this,
+            std::make_shared<const std::vector<std::size_t>>(std::move(extents))
+        }
+    );
+  }
+
+  /**
+   * @brief Lazy range over every cell of the complex with grade `grade`.
+   *
+   * This filters `cells()` by the grading function, which is called as the
+   * range is iterated.
+   *
+   * @param grade
+   * @return GradeRangeType
+   */
+  [[nodiscard]] GradeRangeType cells_with_grade(GradingResultType grade) {
+    return GradeRangeType(cells(), HasGrade{this, grade});
+  }
+
   /**
    * @brief Grade a given cell according to the complex's grading function.
    *
@@ -291,9 +1255,307 @@ public:
    * @return GradingResultType
    */
   GradingResultType grade(const CellType& cell) {
+    counters.record_grading();
     return grading_function(cell);
   }
 
+  /**
+   * @brief Grade each of `cells`, storing the results in `grades`.
+   *
+   * Forwards the batch to the grading function if it models `BatchGrading`.
+   *
+   * @param cells
+   * @param grades Output; at least as long as `cells`.
+   */
+  void grade_many(
+      std::span<const CellType> cells, std::span<GradingResultType> grades
+  ) {
+    counters.record_grading(cells.size());
+    chomp::core::grade_many(grading_function, cells, grades);
+  }
+
+  /**
+   * @brief Get the grading function of the complex.
+   *
+   * @return const GradingType&
+   */
+  [[nodiscard]] const GradingType& grading() const noexcept {
+    return grading_function;
+  }
+  /**
+   * @brief Get the grading function of the complex, e.g. to update grades of a
+   * `MutableGrading` in place.
+   *
+   * @return GradingType&
+   */
+  [[nodiscard]] GradingType& grading() noexcept {
+    return grading_function;
+  }
+
+  /**
+   * @brief Snapshot of the boundary, coboundary, emitted cell, and grading
+   * call counters; all zero unless `CHOMP_ENABLE_STATISTICS` is enabled.
+   *
+   * Boundary and coboundary calls count every visitor traversal, including
+   * those underlying chain computations; emitted cells count the cells
+   * inserted into (co)boundary chains.
+   *
+   * @return ComplexStatistics
+   */
+  [[nodiscard]] ComplexStatistics statistics() const noexcept {
+    return counters.snapshot();
+  }
+  /** @brief Reset the statistics counters to zero. */
+  void reset_statistics() noexcept {
+    counters.reset();
+  }
+
+  /**
+   * @brief Stream the boundary of `cell` in the complex to `visitor` as
+   * (cell, coefficient) pairs without constructing a chain.
+   *
+   * No allocation is performed by this method. If `visitor` returns a value
+   * convertible to `bool`, returning `false` stops the iteration early.
+   *
+   * @tparam V Visitor type modeling `BoundaryVisitor`.
+   * @param cell
+   * @param visitor Function object called on each boundary cell and its
+   * coefficient.
+   * @return true If every boundary cell was visited.
+   * @return false If `visitor` stopped the iteration early.
+   */
+  template <typename V>
+  requires BoundaryVisitor<V, CellType, RingType>
+  bool for_each_boundary(const CellType& cell, V&& visitor) const {
+    counters.record_boundary();
+    // Implementation follows `Computational Homology` Kaczynski et al.
+    // Faces lie only along axes with extent; the coefficient is negated by
+    // each preceding axis with extent, as tabulated by `FaceAxes`.
+    const RingType positive = one<RingType>();
+    const RingType negative = -positive;
+
+    return detail::for_each_face_axis<CCDIM, false>(
+        cell.extent(),
+        [&](std::size_t axis, bool negated) {
+          // No outer cells along maximum edge of complex
+          if (cell.coordinate(axis) != maximum_orthant[axis]) {
+            if (!detail::visit_term(
+                    visitor, cell.outer_face(axis),
+                    negated ? negative : positive
+                )) {
+              return false;
+            }
+          }
+          // Always inner cells
+          return detail::visit_term(
+              visitor, cell.inner_face(axis), negated ? positive : negative
+          );
+        }
+    );
+  }
+
+  /**
+   * @brief Stream the coboundary of `cell` in the complex to `visitor` as
+   * (cell, coefficient) pairs without constructing a chain.
+   *
+   * @copydetails for_each_boundary()
+   */
+  template <typename V>
+  requires BoundaryVisitor<V, CellType, RingType>
+  bool for_each_coboundary(const CellType& cell, V&& visitor) const {
+    counters.record_coboundary();
+    // Cofaces lie only along axes without extent
+    const RingType positive = one<RingType>();
+    const RingType negative = -positive;
+
+    return detail::for_each_face_axis<CCDIM, true>(
+        cell.extent(),
+        [&](std::size_t axis, bool negated) {
+          // No inner cells along minimum edge of complex
+          if (cell.coordinate(axis) != minimum_orthant[axis]) {
+            if (!detail::visit_term(
+                    visitor, cell.inner_coface(axis),
+                    negated ? negative : positive
+                )) {
+              return false;
+            }
+          }
+          // Always outer cells
+          return detail::visit_term(
+              visitor, cell.outer_coface(axis), negated ? positive : negative
+          );
+        }
+    );
+  }
+
+  /**
+   * @brief Stream the boundary of the cell with index `index` to `visitor` as
+   * (index, coefficient) pairs.
+   *
+   * Face indices are obtained by adding precomputed strides to `index`; no
+   * cells are constructed and no allocation is performed. If `visitor` returns
+   * a value convertible to `bool`, returning `false` stops the iteration early.
+   *
+   * @tparam V Visitor type modeling `BoundaryVisitor` on indices.
+   * @param index Index of a cell of the complex.
+   * @param visitor Function object called on each boundary index and its
+   * coefficient.
+   * @return true If every boundary index was visited.
+   * @return false If `visitor` stopped the iteration early.
+   */
+  template <typename V>
+  requires BoundaryVisitor<V, std::size_t, RingType>
+  bool for_each_boundary_index(std::size_t index, V&& visitor) const {
+    counters.record_boundary();
+    const RingType positive = one<RingType>();
+    const RingType negative = -positive;
+
+    return detail::for_each_face_axis<CCDIM, false>(
+        index, [&](std::size_t axis, bool negated) {
+          const std::size_t inner_index = index ^ (std::size_t(1) << axis);
+          if (cell_indexer.coordinate(index, axis) != maximum_orthant[axis]) {
+            const std::size_t outer_index =
+                inner_index + cell_indexer.stride(axis);
+            if (!detail::visit_term(
+                    visitor, outer_index, negated ? negative : positive
+                )) {
+              return false;
+            }
+          }
+          return detail::visit_term(
+              visitor, inner_index, negated ? positive : negative
+          );
+        }
+    );
+  }
+
+  /**
+   * @brief Stream the coboundary of the cell with index `index` to `visitor`
+   * as (index, coefficient) pairs.
+   *
+   * @copydetails for_each_boundary_index()
+   */
+  template <typename V>
+  requires BoundaryVisitor<V, std::size_t, RingType>
+  bool for_each_coboundary_index(std::size_t index, V&& visitor) const {
+    counters.record_coboundary();
+    const RingType positive = one<RingType>();
+    const RingType negative = -positive;
+
+    return detail::for_each_face_axis<CCDIM, true>(
+        index, [&](std::size_t axis, bool negated) {
+          const std::size_t outer_index = index | (std::size_t(1) << axis);
+          if (cell_indexer.coordinate(index, axis) != minimum_orthant[axis]) {
+            const std::size_t inner_index =
+                outer_index - cell_indexer.stride(axis);
+            if (!detail::visit_term(
+                    visitor, inner_index, negated ? negative : positive
+                )) {
+              return false;
+            }
+          }
+          return detail::visit_term(
+              visitor, outer_index, negated ? positive : negative
+          );
+        }
+    );
+  }
+
+  /**
+   * @brief Get the boundary of the cell with index `index` as a chain of
+   * indices.
+   *
+   * @param index Index of a cell of the complex.
+   * @return IndexChainType
+   */
+  [[nodiscard]] IndexChainType boundary_indices(std::size_t index) const {
+    IndexChainType result;
+    for_each_boundary_index(
+        index,
+        [&result](std::size_t face, const RingType& coef) {
+          result.insert(face, coef);
+        }
+    );
+    return result;
+  }
+  /**
+   * @brief Get the coboundary of the cell with index `index` as a chain of
+   * indices.
+   *
+   * @param index Index of a cell of the complex.
+   * @return IndexChainType
+   */
+  [[nodiscard]] IndexChainType coboundary_indices(std::size_t index) const {
+    IndexChainType result;
+    for_each_coboundary_index(
+        index,
+        [&result](std::size_t coface, const RingType& coef) {
+          result.insert(coface, coef);
+        }
+    );
+    return result;
+  }
+
+  /**
+   * @brief Assemble the boundary operator of the complex into a sparse matrix.
+   *
+   * Rows and columns are the cells of the complex sorted by grade, then
+   * dimension, then index, so that every face precedes its cofaces when the
+   * grading is lower (a filtration order); the result is suitable input for
+   * `ColumnReduction` with `BoundaryMatrixType::dimensions`. Boundaries are
+   * computed from cell indices without constructing chains.
+   *
+   * @return BoundaryMatrixType
+   */
+  [[nodiscard]] BoundaryMatrixType boundary_matrix() {
+    return assemble_boundary_matrix([](GradingResultType) { return true; });
+  }
+  /**
+   * @brief Assemble the boundary operator of the complex restricted to the
+   * cells of grade `grade` into a sparse matrix.
+   *
+   * The columns are the boundaries of `graded_boundary`: faces of other grades
+   * are dropped. Rows and columns are sorted by dimension, then index.
+   *
+   * @param grade
+   * @return BoundaryMatrixType
+   */
+  [[nodiscard]] BoundaryMatrixType boundary_matrix(GradingResultType grade) {
+    return assemble_boundary_matrix([grade](GradingResultType cell_grade) {
+      return cell_grade == grade;
+    });
+  }
+
+  /**
+   * @brief Get the boundary of `cell` restricted to the faces with the same
+   * grade as `cell`.
+   *
+   * The (at most `2 * CCDIM`) faces are graded in a single `grade_many` call,
+   * unless the grade of `cell` is the minimum of a grading function modeling
+   * `LowerBoundedGrading`. Used by the free function `graded_boundary`.
+   *
+   * @param cell
+   * @return ChainType
+   */
+  [[nodiscard]] ChainType graded_boundary(const CellType& cell) {
+    return graded_chain<false>(cell);
+  }
+  /**
+   * @brief Get the coboundary of `cell` restricted to the cofaces with the
+   * same grade as `cell`.
+   *
+   * The (at most `2 * CCDIM`) cofaces are graded in a single `grade_many`
+   * call, unless the grade of `cell` is the maximum of a grading function
+   * modeling `UpperBoundedGrading`. Used by the free function
+   * `graded_coboundary`.
+   *
+   * @param cell
+   * @return ChainType
+   */
+  [[nodiscard]] ChainType graded_coboundary(const CellType& cell) {
+    return graded_chain<true>(cell);
+  }
+
   /**
    * @brief Get the boundary of `cell` in the complex subject to some constraint
    * `cond`.
@@ -302,49 +1564,36 @@ public:
    * `closure_boundary` function templates for this class along with the
    * generalizations to chain inputs.
    *
+   * The predicate is a template parameter so that it is inlined into the loop
+   * over faces; the `ConditionalType` overload remains for type-erased use.
+   *
+   * @tparam F Predicate type on (constant references to) cells.
    * @param cell
    * @param cond A function taking (a constant reference to) a potential
    * boundary cell and returning a boolean value; if `true`, the cell is added
    * to the boundary.
    * @return ChainType
    */
-  [[nodiscard]] ChainType
-  boundary_if(const CellType& cell, const ConditionalType<CellType>& cond) {
-    // Implementation follows `Computational Homology` Kaczynski et al.
-    const CubeOrthant<CCDIM>& cube_orthant = cell.orthant();
-    const std::size_t cube_extent = cell.extent();
-    std::size_t axis_bit = 1;
-    RingType coef = one<RingType>();  // axes with extent negate the coefficient
+  template <typename F>
+  requires std::predicate<const F&, const CellType&>
+  [[nodiscard]] ChainType boundary_if(const CellType& cell, const F& cond) {
     ChainType result;
-
-    for (std::size_t axis = 0; axis < CCDIM; ++axis, axis_bit <<= 1) {
-      // cell must have extent along this axis to have a boundary
-      if (cube_extent & axis_bit) {
-        // The extent is the same for inner and outer cell
-        std::size_t new_extent = cube_extent - axis_bit;
-
-        // No outer cells along maximum edge of complex
-        if (cube_orthant[axis] != maximum_orthant[axis]) {
-          CubeOrthant<CCDIM> new_orthant = cube_orthant;
-          new_orthant[axis] += 1;
-          Cube<CCDIM> outer_cell(std::move(new_orthant), new_extent);
-          if (cond(outer_cell)) {
-            result.insert(outer_cell, coef);
+    for_each_boundary(
+        cell,
+        [&result, &cond](const CellType& face, const RingType& coef) {
+          if (cond(face)) {
+            result.insert(face, coef);
           }
         }
-
-        // Always inner cells
-        Cube<CCDIM> inner_cell(cube_orthant, new_extent);
-        if (cond(inner_cell)) {
-          result.insert(inner_cell, -coef);
-        }
-
-        // Negate coefficient on axes with extent
-        coef = -coef;
-      }
-    }
+    );
+    counters.record_emitted(result.size());
     return result;
   }
+  /** @brief Overload of `boundary_if` for type-erased conditions. */
+  [[nodiscard]] ChainType
+  boundary_if(const CellType& cell, const ConditionalType<CellType>& cond) {
+    return boundary_if<ConditionalType<CellType>>(cell, cond);
+  }
 
   /**
    * @brief Get the coboundary of `cell` in the complex subject to some
@@ -353,49 +1602,36 @@ public:
    * This method synthesizes the `coboundary`, `graded_coboundary`, and
    * `closure_coboundary` function templates for this class.
    *
+   * The predicate is a template parameter so that it is inlined into the loop
+   * over cofaces; the `ConditionalType` overload remains for type-erased use.
+   *
+   * @tparam F Predicate type on (constant references to) cells.
    * @param cell
    * @param cond A function taking (a constant reference to) a potential
    * coboundary cell and returning a boolean value; if `true`, the cell is added
    * to the coboundary.
    * @return ChainType
    */
-  [[nodiscard]] ChainType
-  coboundary_if(const CellType& cell, const ConditionalType<CellType>& cond) {
-    const CubeOrthant<CCDIM>& cube_orthant = cell.orthant();
-    const std::size_t cube_extent = cell.extent();
-    std::size_t axis_bit = 1;
-    RingType coef = one<RingType>();
+  template <typename F>
+  requires std::predicate<const F&, const CellType&>
+  [[nodiscard]] ChainType coboundary_if(const CellType& cell, const F& cond) {
     ChainType result;
-
-    for (std::size_t axis = 0; axis < CCDIM; ++axis, axis_bit <<= 1) {
-      // cell must not have extent along this axis to have a boundary
-      if (!(cube_extent & axis_bit)) {
-        // The extent is the same for inner and outer cell
-        std::size_t new_extent = cube_extent + axis_bit;
-
-        // No inner cells along minimum edge of complex
-        if (cube_orthant[axis] != minimum_orthant[axis]) {
-          CubeOrthant<CCDIM> new_orthant = cube_orthant;
-          new_orthant[axis] -= 1;
-          Cube<CCDIM> inner_cell(std::move(new_orthant), new_extent);
-          if (cond(inner_cell)) {
-            result.insert(inner_cell, coef);
+    for_each_coboundary(
+        cell,
+        [&result, &cond](const CellType& coface, const RingType& coef) {
+          if (cond(coface)) {
+            result.insert(coface, coef);
           }
         }
-
-        // Always outer cells
-        Cube<CCDIM> outer_cell(cube_orthant, new_extent);
-        if (cond(outer_cell)) {
-          result.insert(outer_cell, -coef);
-        }
-
-      } else {
-        // Negate coefficient on axes with extent
-        coef = -coef;
-      }
-    }
+    );
+    counters.record_emitted(result.size());
     return result;
   }
+  /** @brief Overload of `coboundary_if` for type-erased conditions. */
+  [[nodiscard]] ChainType
+  coboundary_if(const CellType& cell, const ConditionalType<CellType>& cond) {
+    return coboundary_if<ConditionalType<CellType>>(cell, cond);
+  }
 };
 
 }  // namespace chomp::core
@@ -10,11 +10,21 @@
 #include <chomp/complexes/complexes.hpp>
 #include <chomp/complexes/cubical.hpp>
 #include <chomp/complexes/grading.hpp>
+#include <chomp/util/cache.hpp>
+#include <chomp/util/hash.hpp>
+#include <chomp/util/parallel.hpp>
+#include <chomp/util/statistics.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <concepts>
+#include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -45,7 +55,7 @@ TEST_CASE(
       CubeOrthant<3>{2, 4, 5}, std::move(grading_func)
   );
   using TestChainType = typename decltype(complex)::ChainType;
-  REQUIRE(std::same_as<TestChainType, UnorderedMapModule<Cube<3>, Z<5>>>);
+  REQUIRE(std::same_as<TestChainType, SmallChain<Cube<3>, Z<5>, 6>>);
   REQUIRE(complex.minimum() == CubeOrthant<3>({0, 0, 0}));
   REQUIRE(complex.maximum() == CubeOrthant<3>({2, 4, 5}));
 
@@ -179,6 +189,594 @@ TEST_CASE(
 }
 
 
+TEST_CASE(
+    "CubicalComplex conditional operators accept inline and type-erased "
+    "predicates",
+    "[complexes]"
+) {
+  CubicalComplex<2, SetGrading<Cube<2>, 0, 1>> complex(
+      CubeOrthant<2>{3, 3}, SetGrading<Cube<2>, 0, 1>({})
+  );
+  using Chain = typename decltype(complex)::ChainType;
+  const Cube<2> square({1, 1}, 0b11);
+
+  const auto is_vertical = [](const Cube<2>& cell) {
+    return cell.extent() == 0b10;
+  };
+  const ConditionalType<Cube<2>> erased_is_vertical(is_vertical);
+
+  Chain expected;
+  expected.insert(Cube<2>({2, 1}, 0b10), one<Z<2>>());
+  expected.insert(Cube<2>({1, 1}, 0b10), one<Z<2>>());
+  REQUIRE(complex.boundary_if(square, is_vertical) == expected);
+  REQUIRE(complex.boundary_if(square, erased_is_vertical) == expected);
+  REQUIRE(boundary_if(complex, square, is_vertical) == expected);
+  REQUIRE(boundary_if(complex, square, erased_is_vertical) == expected);
+
+  const Cube<2> vertex({1, 1}, 0b00);
+  expected.clear();
+  expected.insert(Cube<2>({1, 0}, 0b10), one<Z<2>>());
+  expected.insert(Cube<2>({1, 1}, 0b10), one<Z<2>>());
+  REQUIRE(complex.coboundary_if(vertex, is_vertical) == expected);
+  REQUIRE(coboundary_if(complex, vertex, erased_is_vertical) == expected);
+
+  // Chain overloads apply the predicate to each cell
+  Chain chain;
+  chain.insert(square, one<Z<2>>());
+  chain.insert(Cube<2>({0, 1}, 0b11), one<Z<2>>());
+  expected.clear();
+  expected.insert(Cube<2>({2, 1}, 0b10), one<Z<2>>());
+  expected.insert(Cube<2>({0, 1}, 0b10), one<Z<2>>());
+  REQUIRE(boundary_if(complex, chain, is_vertical) == expected);
+}
+
+TEST_CASE(
+    "CubicalComplex boundary visitors stream terms and stop early",
+    "[complexes]"
+) {
+  CubicalComplex<3, SetGrading<Cube<3>, 0, 1>, Z<5>> complex(
+      CubeOrthant<3>{3, 3, 3}, SetGrading<Cube<3>, 0, 1>({})
+  );
+  using Chain = typename decltype(complex)::ChainType;
+  const Cube<3> cube({1, 1, 1}, 0b111);
+  const Cube<3> vertex({1, 1, 1}, 0b000);
+
+  // Visited terms match the boundary chain
+  Chain visited;
+  REQUIRE(for_each_boundary(
+      complex, cube,
+      [&visited](const Cube<3>& cell, const Z<5>& coef) {
+        visited.insert(cell, coef);
+      }
+  ));
+  REQUIRE(visited == boundary(complex, cube));
+
+  visited.clear();
+  REQUIRE(complex.for_each_coboundary(
+      vertex,
+      [&visited](const Cube<3>& cell, const Z<5>& coef) {
+        visited.insert(cell, coef);
+      }
+  ));
+  REQUIRE(visited == coboundary(complex, vertex));
+
+  // Returning false stops the iteration
+  std::size_t count = 0;
+  REQUIRE_FALSE(for_each_coboundary(
+      complex, vertex,
+      [&count](const Cube<3>&, const Z<5>&) {
+        return ++count < 2;
+      }
+  ));
+  REQUIRE(count == 2);
+
+  // Along the maximum edge the outer faces are skipped
+  count = 0;
+  REQUIRE(complex.for_each_boundary(
+      Cube<3>({3, 0, 0}, 0b001),
+      [&count](const Cube<3>&, const Z<5>&) {
+        ++count;
+      }
+  ));
+  REQUIRE(count == 1);
+}
+
+TEST_CASE(
+    "CubicalComplex index-based boundaries match cell boundaries",
+    "[complexes]"
+) {
+  CubicalComplex<3, SetGrading<Cube<3>, 0, 1>, Z<3>> complex(
+      CubeOrthant<3>{1, 0, 2}, CubeOrthant<3>{3, 2, 3},
+      SetGrading<Cube<3>, 0, 1>({})
+  );
+  using Chain = typename decltype(complex)::ChainType;
+  using IndexChain = typename decltype(complex)::IndexChainType;
+  REQUIRE(std::same_as<IndexChain, SmallChain<std::size_t, Z<3>, 6>>);
+  REQUIRE(complex.cell_count() == 18 * 8);
+
+  const auto to_cells = [&complex](const IndexChain& index_chain) {
+    Chain result;
+    for (const std::size_t index : index_chain) {
+      result.insert(complex.cell_at(index), index_chain[index]);
+    }
+    return result;
+  };
+
+  for (std::size_t index = 0; index < complex.cell_count(); ++index) {
+    const Cube<3> cell = complex.cell_at(index);
+    REQUIRE(complex.index_of(cell) == index);
+    REQUIRE(
+        to_cells(complex.boundary_indices(index)) == boundary(complex, cell)
+    );
+    REQUIRE(
+        to_cells(complex.coboundary_indices(index)) == coboundary(complex, cell)
+    );
+  }
+}
+
+TEST_CASE(
+    "CubicalComplex chain operators agree under parallel policy",
+    "[complexes]"
+) {
+  using Grading = CachedGradingWrapper<
+      SetGrading<Cube<3>, 0, 1>, DefaultMap,
+      ShardedLRUCache<Cube<3>, GradingResultType>>;
+  CubicalComplex<3, Grading, Z<5>> complex(
+      CubeOrthant<3>{4, 3, 3},
+      Grading(
+          SetGrading<Cube<3>, 0, 1>(
+              {Cube<3>({0, 0, 0}, 0b000), Cube<3>({1, 0, 0}, 0b000),
+               Cube<3>({0, 0, 0}, 0b001), Cube<3>({2, 1, 1}, 0b111)}
+          ),
+          64
+      )
+  );
+  using Chain = typename decltype(complex)::ChainType;
+
+  Chain chain;
+  std::size_t index = 0;
+  for (const Cube<3>& cell : complex.cells()) {
+    chain.insert(cell, Z<5>(static_cast<int>(index++ % 4) + 1));
+  }
+  const ParallelPolicy policy{.threads = 4, .grain = 16};
+  REQUIRE(policy.partitions(index) == 4);
+
+  const Chain parallel_boundary = boundary(complex, chain, policy);
+  REQUIRE(parallel_boundary == boundary(complex, chain));
+  REQUIRE(boundary(complex, parallel_boundary, policy) == Chain());
+  REQUIRE(coboundary(complex, chain, policy) == coboundary(complex, chain));
+  REQUIRE(closure_boundary(complex, chain, par) == boundary(complex, chain));
+  REQUIRE(
+      graded_boundary(complex, chain, policy) == graded_boundary(complex, chain)
+  );
+  REQUIRE(
+      graded_coboundary(complex, chain, policy) ==
+      graded_coboundary(complex, chain)
+  );
+  REQUIRE(
+      closure_coboundary(complex, chain, policy) ==
+      closure_coboundary(complex, chain)
+  );
+
+  const auto is_vertex = [](const Cube<3>& cell) {
+    return cell.extent() == 0;
+  };
+  REQUIRE(
+      boundary_if(complex, chain, is_vertex, policy) ==
+      boundary_if(complex, chain, is_vertex)
+  );
+  REQUIRE(
+      coboundary_if(complex, chain, is_vertex, seq) ==
+      coboundary_if(complex, chain, is_vertex)
+  );
+}
+
+TEST_CASE("CubicalComplex cell ranges", "[complexes]") {
+  CubicalComplex<3, SetGrading<Cube<3>, 0, 1>> complex(
+      CubeOrthant<3>{1, 1, 1},
+      SetGrading<Cube<3>, 0, 1>(
+          {Cube<3>({0, 0, 0}, 0b000), Cube<3>({1, 0, 0}, 0b000),
+           Cube<3>({0, 0, 0}, 0b001)}
+      )
+  );
+  using Complex = decltype(complex);
+  REQUIRE(std::ranges::random_access_range<Complex::CellRangeType>);
+  REQUIRE(std::ranges::view<Complex::DimensionRangeType>);
+
+  std::size_t index = 0;
+  for (const Cube<3>& cell : complex.cells()) {
+    REQUIRE(complex.index_of(cell) == index++);
+  }
+  REQUIRE(index == complex.cell_count());
+
+  // Cells of each dimension appear once, orthant-major
+  const std::size_t binomial[] = {1, 3, 3, 1};
+  std::size_t total = 0;
+  for (std::size_t dim = 0; dim <= 3; ++dim) {
+    std::size_t previous = 0;
+    std::size_t count = 0;
+    for (const Cube<3>& cell : complex.cells_of_dimension(dim)) {
+      REQUIRE(Complex::dimension(cell) == dim);
+      REQUIRE((count == 0 || complex.index_of(cell) > previous));
+      previous = complex.index_of(cell);
+      ++count;
+    }
+    REQUIRE(count == 8 * binomial[dim]);
+    total += count;
+  }
+  REQUIRE(total == complex.cell_count());
+
+  // Ranges compose with views
+  const auto edges = complex.cells_of_dimension(1) | std::views::take(3);
+  REQUIRE(std::ranges::distance(edges) == 3);
+  REQUIRE(*edges.begin() == Cube<3>({0, 0, 0}, 0b001));
+  REQUIRE(complex.cells_of_dimension(2)[5] == Cube<3>({1, 0, 0}, 0b110));
+
+  std::vector<Cube<3>> graded;
+  for (const Cube<3>& cell : complex.cells_with_grade(0)) {
+    graded.push_back(cell);
+  }
+  REQUIRE(
+      graded == std::vector<Cube<3>>{
+                    Cube<3>({0, 0, 0}, 0b000), Cube<3>({0, 0, 0}, 0b001),
+                    Cube<3>({1, 0, 0}, 0b000)}
+  );
+
+  // Partitions are contiguous and cover every cell
+  const auto parts = complex.partition_cells(3);
+  REQUIRE(parts.size() == 3);
+  index = 0;
+  for (const auto& part : parts) {
+    for (const Cube<3>& cell : part) {
+      REQUIRE(complex.index_of(cell) == index++);
+    }
+  }
+  REQUIRE(index == complex.cell_count());
+  REQUIRE(complex.partition_cells(10)[0].empty());
+}
+
+TEST_CASE("CubicalComplex boundary matrix", "[complexes]") {
+  // Grade 0 cells form the boundary of a square
+  CubicalComplex<2, SetGrading<Cube<2>, 0, 1>, Z<3>> complex(
+      CubeOrthant<2>{2, 2},
+      SetGrading<Cube<2>, 0, 1>(
+          {Cube<2>({0, 0}, 0b00), Cube<2>({1, 0}, 0b00), Cube<2>({0, 1}, 0b00),
+           Cube<2>({1, 1}, 0b00), Cube<2>({0, 0}, 0b01), Cube<2>({0, 1}, 0b01),
+           Cube<2>({0, 0}, 0b10), Cube<2>({1, 0}, 0b10)}
+      )
+  );
+
+  const auto full = complex.boundary_matrix();
+  REQUIRE(full.matrix.columns() == complex.cell_count());
+  REQUIRE(full.matrix.rows() == complex.cell_count());
+  long euler = 0;
+  for (std::size_t column = 0; column < full.matrix.columns(); ++column) {
+    const std::size_t index = full.cells[column];
+    REQUIRE(
+        full.dimensions[column] == complex.dimension(complex.cell_at(index))
+    );
+    REQUIRE(full.grades[column] == complex.grade(complex.cell_at(index)));
+    REQUIRE((column == 0 || full.grades[column - 1] <= full.grades[column]));
+    euler += full.dimensions[column] % 2 ? -1 : 1;
+
+    // Columns agree with index boundaries and faces precede cofaces
+    const auto faces = complex.boundary_indices(index);
+    REQUIRE(full.matrix.column_rows(column).size() == faces.size());
+    for (const std::size_t row : full.matrix.column_rows(column)) {
+      REQUIRE(row < column);
+      REQUIRE(full.matrix(row, column) == faces[full.cells[row]]);
+    }
+  }
+
+  // Unpaired cells of the reduction preserve the Euler characteristic
+  const ColumnReduction reduction(full.matrix, full.dimensions);
+  long unpaired_euler = 0;
+  for (std::size_t column = 0; column < full.matrix.columns(); ++column) {
+    if (reduction.is_zero(column) &&
+        reduction.pivot_column(column) == decltype(reduction)::NO_PIVOT) {
+      unpaired_euler += full.dimensions[column] % 2 ? -1 : 1;
+    }
+  }
+  REQUIRE(unpaired_euler == euler);
+
+  // The grade 0 subcomplex is a circle
+  const auto graded = complex.boundary_matrix(0);
+  REQUIRE(graded.matrix.columns() == 8);
+  REQUIRE(
+      graded.dimensions == std::vector<std::size_t>{0, 0, 0, 0, 1, 1, 1, 1}
+  );
+  const ColumnReduction graded_reduction(graded.matrix, graded.dimensions);
+  std::vector<std::size_t> betti(2, 0);
+  for (std::size_t column = 0; column < graded.matrix.columns(); ++column) {
+    if (graded_reduction.is_zero(column) &&
+        graded_reduction.pivot_column(column) ==
+            decltype(graded_reduction)::NO_PIVOT) {
+      ++betti[graded.dimensions[column]];
+    }
+  }
+  REQUIRE(betti == std::vector<std::size_t>{1, 1});
+}
+
+TEST_CASE("CubicalComplex statistics", "[complexes]") {
+  CubicalComplex<2, SetGrading<Cube<2>, 0, 1>> complex(
+      CubeOrthant<2>{2, 2},
+      SetGrading<Cube<2>, 0, 1>({Cube<2>({0, 0}, 0b00)})
+  );
+  const Cube<2> square({1, 1}, 0b11);
+  REQUIRE(boundary(complex, square).size() == 4);
+  REQUIRE(graded_boundary(complex, square).size() == 4);
+  REQUIRE(coboundary(complex, Cube<2>({1, 1}, 0b00)).size() == 4);
+
+  if constexpr (STATISTICS_ENABLED) {
+    const ComplexStatistics snapshot = complex.statistics();
+    REQUIRE(snapshot.boundary_calls == 2);
+    REQUIRE(snapshot.coboundary_calls == 1);
+    REQUIRE(snapshot.emitted_cells == 12);
+    REQUIRE(snapshot.grading_calls == 5);
+  } else {
+    REQUIRE(complex.statistics() == ComplexStatistics());
+  }
+  complex.reset_statistics();
+  REQUIRE(complex.statistics() == ComplexStatistics());
+
+  // Faces of a cell of minimal grade, and cofaces of a cell of maximal grade,
+  // are kept without being graded
+  const Cube<2> edge({0, 0}, 0b01);
+  const Cube<2> vertex({0, 1}, 0b00);
+  CubicalComplex<2, SetGrading<Cube<2>, 0, 1>> extremal(
+      CubeOrthant<2>{2, 2},
+      SetGrading<Cube<2>, 0, 1>(
+          {edge, Cube<2>({0, 0}, 0b00), Cube<2>({1, 0}, 0b00)}
+      )
+  );
+  REQUIRE(graded_boundary(extremal, edge) == boundary(extremal, edge));
+  REQUIRE(graded_boundary(extremal, edge).size() == 2);
+  REQUIRE(
+      graded_coboundary(extremal, vertex) == coboundary(extremal, vertex)
+  );
+  if constexpr (STATISTICS_ENABLED) {
+    extremal.reset_statistics();
+    static_cast<void>(graded_boundary(extremal, edge));
+    static_cast<void>(graded_coboundary(extremal, vertex));
+    REQUIRE(extremal.statistics().grading_calls == 2);
+  }
+}
+
+TEST_CASE("PackedCube packs and unpacks orthant and extent", "[complexes]") {
+  CHECK(CubicalCell<Cube<3>, 3>);
+  CHECK(CubicalCell<PackedCube<3>, 3>);
+  CHECK(PackedCube<3>::word_count == 1);
+  CHECK(PackedCube<7>::word_count == 1);
+  CHECK(PackedCube<8>::word_count == 2);
+  CHECK(PackedCube<8, 4>::word_count == 1);
+  CHECK(sizeof(PackedCube<3>) == sizeof(std::size_t));
+
+  const Cube<3> cube({2, 255, 7}, 0b101);
+  const PackedCube<3> packed(cube);
+  REQUIRE(packed.orthant() == cube.orthant());
+  REQUIRE(packed.extent() == cube.extent());
+  REQUIRE(packed.unpack() == cube);
+
+  const Cube<8> wide_cube({1, 2, 3, 4, 5, 6, 7, 255}, 0b10011001);
+  const PackedCube<8> wide_packed(wide_cube);
+  REQUIRE(wide_packed.unpack() == wide_cube);
+  for (std::size_t axis = 0; axis < 8; ++axis) {
+    REQUIRE(wide_packed.coordinate(axis) == wide_cube.coordinate(axis));
+  }
+
+  // Faces and cofaces agree with those of `Cube`
+  CHECK(packed.inner_face(0).unpack() == cube.inner_face(0));
+  CHECK(packed.outer_face(2).unpack() == cube.outer_face(2));
+  CHECK(packed.inner_coface(1).unpack() == cube.inner_coface(1));
+  CHECK(packed.outer_coface(1).unpack() == cube.outer_coface(1));
+  CHECK(wide_packed.outer_face(3).unpack() == wide_cube.outer_face(3));
+  CHECK(wide_packed.inner_coface(1).unpack() == wide_cube.inner_coface(1));
+
+  // Ordering agrees with that of `Cube`
+  const std::vector<Cube<3>> cubes = {
+      Cube<3>({0, 0, 0}, 0b000), Cube<3>({0, 0, 0}, 0b111),
+      Cube<3>({0, 0, 1}, 0b000), Cube<3>({0, 1, 0}, 0b011),
+      Cube<3>({1, 0, 0}, 0b001), Cube<3>({255, 0, 0}, 0b000)
+  };
+  for (const Cube<3>& lhs : cubes) {
+    for (const Cube<3>& rhs : cubes) {
+      CHECK((lhs <=> rhs) == (PackedCube<3>(lhs) <=> PackedCube<3>(rhs)));
+    }
+  }
+
+  CHECK(
+      std::hash<PackedCube<3>>{}(packed) ==
+      std::hash<PackedCube<3>>{}(PackedCube<3>(cube))
+  );
+}
+
+TEST_CASE("Cube hashes are free of collisions", "[complexes]") {
+  // Every cell of a 64x64 grid, of which the former polynomial hash mapped
+  // about five cells to each hash value
+  std::vector<Cube<2>> cubes;
+  for (HypercubeCoordinate x = 0; x < 64; ++x) {
+    for (HypercubeCoordinate y = 0; y < 64; ++y) {
+      for (std::size_t extent = 0; extent < 4; ++extent) {
+        cubes.emplace_back(CubeOrthant<2>{x, y}, extent);
+      }
+    }
+  }
+
+  // Mixed hashes also fill the low and the high buckets evenly
+  constexpr std::size_t BUCKETS = 1024;
+  std::vector<std::size_t> low(BUCKETS);
+  std::vector<std::size_t> high(BUCKETS);
+  std::set<std::size_t> hashes;
+  std::set<std::size_t> mixed_hashes;
+  std::size_t packed_equal = 0;
+  for (const Cube<2>& cube : cubes) {
+    const std::size_t hash = std::hash<Cube<2>>{}(cube);
+    packed_equal +=
+        hash == std::hash<PackedCube<2>>{}(PackedCube<2>(cube)) ? 1 : 0;
+    hashes.insert(hash);
+    const std::size_t mixed = MixedHash<Cube<2>>{}(cube);
+    mixed_hashes.insert(mixed);
+    ++low[mixed % BUCKETS];
+    ++high[mixed >> (SIZE_T_BITS - 10)];
+  }
+  REQUIRE(packed_equal == cubes.size());
+  REQUIRE(hashes.size() == cubes.size());
+  REQUIRE(mixed_hashes.size() == cubes.size());
+  // 16 cells per bucket on average
+  REQUIRE(std::ranges::max(low) < 40);
+  REQUIRE(std::ranges::max(high) < 40);
+
+  // Cubes in more axes than `PackedCube` holds still hash by every coordinate
+  CubeOrthant<20> orthant{};
+  const std::size_t base = std::hash<Cube<20>>{}(Cube<20>(orthant, 0));
+  for (std::size_t axis = 0; axis < 20; ++axis) {
+    orthant[axis] = 1;
+    REQUIRE(std::hash<Cube<20>>{}(Cube<20>(orthant, 0)) != base);
+    orthant[axis] = 0;
+  }
+  REQUIRE(std::hash<Cube<20>>{}(Cube<20>(orthant, 1)) != base);
+}
+
+TEST_CASE("CubicalComplex over PackedCube matches Cube", "[complexes]") {
+  using Packed = PackedCube<3>;
+  const std::initializer_list<Cube<3>> zero_cube_ilist = {
+      Cube<3>({0, 0, 0}, 0b000), Cube<3>({0, 0, 0}, 0b001),
+      Cube<3>({1, 0, 0}, 0b000), Cube<3>({0, 0, 0}, 0b100),
+      Cube<3>({0, 0, 1}, 0b000)
+  };
+  std::vector<Packed> packed_ilist;
+  for (const Cube<3>& cube : zero_cube_ilist) {
+    packed_ilist.emplace_back(cube);
+  }
+
+  CubicalComplex<3, SetGrading<Cube<3>, 0, 1>, Z<3>> complex(
+      CubeOrthant<3>{2, 2, 2}, SetGrading<Cube<3>, 0, 1>(zero_cube_ilist)
+  );
+  CubicalComplex<3, SetGrading<Packed, 0, 1>, Z<3>> packed_complex(
+      CubeOrthant<3>{2, 2, 2},
+      SetGrading<Packed, 0, 1>(
+          DefaultSet<Packed>(packed_ilist.cbegin(), packed_ilist.cend())
+      )
+  );
+  using PackedChainType = typename decltype(packed_complex)::ChainType;
+  REQUIRE(std::same_as<PackedChainType, SmallChain<Packed, Z<3>, 6>>);
+
+  const std::vector<Cube<3>> cells = {
+      Cube<3>({0, 0, 0}, 0b000), Cube<3>({0, 0, 0}, 0b101),
+      Cube<3>({1, 1, 1}, 0b111), Cube<3>({2, 2, 2}, 0b111),
+      Cube<3>({2, 0, 1}, 0b010), Cube<3>({0, 2, 0}, 0b000)
+  };
+
+  const auto unpack_chain = [](const PackedChainType& packed_chain) {
+    typename decltype(complex)::ChainType result;
+    for (const Packed& cell : packed_chain) {
+      result.insert(cell.unpack(), packed_chain[cell]);
+    }
+    return result;
+  };
+
+  for (const Cube<3>& cell : cells) {
+    const Packed packed_cell(cell);
+    CHECK(complex.grade(cell) == packed_complex.grade(packed_cell));
+    CHECK(
+        boundary(complex, cell) ==
+        unpack_chain(boundary(packed_complex, packed_cell))
+    );
+    CHECK(
+        coboundary(complex, cell) ==
+        unpack_chain(coboundary(packed_complex, packed_cell))
+    );
+    CHECK(
+        graded_boundary(complex, cell) ==
+        unpack_chain(graded_boundary(packed_complex, packed_cell))
+    );
+    CHECK(
+        graded_coboundary(complex, cell) ==
+        unpack_chain(graded_coboundary(packed_complex, packed_cell))
+    );
+  }
+}
+
+
+namespace {
+
+// Check the (co)boundary kernels against the definition on every extent of a
+// few orthants, including those on the edges of the complex.
+template <std::size_t CCDIM>
+void check_face_kernels() {
+  using Grading = SetGrading<Cube<CCDIM>, 0, 1>;
+  using Complex = CubicalComplex<CCDIM, Grading, Z<3>>;
+  using Chain = typename Complex::ChainType;
+  CubeOrthant<CCDIM> maximum;
+  maximum.fill(2);
+  Complex complex(maximum, Grading(DefaultSet<Cube<CCDIM>>()));
+
+  std::vector<CubeOrthant<CCDIM>> orthants(3);
+  for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+    orthants[0][axis] = 0;
+    orthants[1][axis] = 1;
+    orthants[2][axis] = HypercubeCoordinate(axis % 3);
+  }
+
+  for (const CubeOrthant<CCDIM>& orthant : orthants) {
+    for (std::size_t extent = 0; extent < (std::size_t(1) << CCDIM);
+         ++extent) {
+      const Cube<CCDIM> cell(orthant, extent);
+      Chain expected_boundary;
+      Chain expected_coboundary;
+      Z<3> sign = one<Z<3>>();
+      for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+        if (extent & (std::size_t(1) << axis)) {
+          if (orthant[axis] != maximum[axis]) {
+            expected_boundary.insert(cell.outer_face(axis), sign);
+          }
+          expected_boundary.insert(cell.inner_face(axis), -sign);
+          sign = -sign;
+        } else {
+          if (orthant[axis] != 0) {
+            expected_coboundary.insert(cell.inner_coface(axis), sign);
+          }
+          expected_coboundary.insert(cell.outer_coface(axis), -sign);
+        }
+      }
+      CHECK(boundary(complex, cell) == expected_boundary);
+      CHECK(coboundary(complex, cell) == expected_coboundary);
+
+      Chain index_boundary;
+      complex.for_each_boundary_index(
+          complex.index_of(cell),
+          [&](std::size_t index, const Z<3>& coef) {
+            index_boundary.insert(complex.cell_at(index), coef);
+          }
+      );
+      Chain index_coboundary;
+      complex.for_each_coboundary_index(
+          complex.index_of(cell),
+          [&](std::size_t index, const Z<3>& coef) {
+            index_coboundary.insert(complex.cell_at(index), coef);
+          }
+      );
+      CHECK(index_boundary == expected_boundary);
+      CHECK(index_coboundary == expected_coboundary);
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE(
+    "CubicalComplex face kernels match the definition in every dimension",
+    "[complexes]"
+) {
+  // Dimensions up to `detail::FACE_TABLE_MAX_DIM` use the tabulated kernels
+  check_face_kernels<1>();
+  check_face_kernels<3>();
+  check_face_kernels<detail::FACE_TABLE_MAX_DIM>();
+  check_face_kernels<detail::FACE_TABLE_MAX_DIM + 1>();
+  check_face_kernels<9>();
+}
+
+
 }  // namespace chomp::core
 
 #endif  // CHOMP_DOXYGEN
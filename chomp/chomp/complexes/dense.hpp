@@ -0,0 +1,443 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains grading function objects for cubical complexes
+ * spanning a full box of orthants, storing the grade of every cell in
+ * contiguous arrays indexed by `CubeIndexer`.
+ */
+
+#ifndef CHOMP_COMPLEXES_DENSE_H
+#define CHOMP_COMPLEXES_DENSE_H
+
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/util/constants.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace chomp::core {
+
+namespace detail {
+#ifndef CHOMP_DOXYGEN
+
+// Narrowest unsigned integer type holding values in `[0, RANGE]`.
+template <GradingResultType RANGE>
+using DenseStorageType = std::conditional_t<
+    RANGE <= std::numeric_limits<std::uint8_t>::max(), std::uint8_t,
+    std::conditional_t<
+        RANGE <= std::numeric_limits<std::uint16_t>::max(), std::uint16_t,
+        std::conditional_t<
+            RANGE <= std::numeric_limits<std::uint32_t>::max(), std::uint32_t,
+            std::uint64_t>>>;
+
+// Grade every lower-dimensional cell of the box as the minimum grade of the
+// top-dimensional cells containing it, given those top-dimensional grades.
+//
+// Extents are visited in decreasing order, so for a cell lacking extent along
+// `axis`, both of its cofaces along `axis` are already graded; its top
+// cofaces are exactly the union of theirs.
+template <std::size_t CCDIM, typename Get, typename Set>
+void close_top_cells(const CubeIndexer<CCDIM>& indexer, Get get, Set set) {
+  constexpr std::size_t FULL_EXTENT = (std::size_t(1) << CCDIM) - 1;
+  for (std::size_t extent = FULL_EXTENT; extent-- > 0;) {
+    const std::size_t axis = std::countr_one(extent);
+    const std::size_t axis_bit = std::size_t(1) << axis;
+    const std::size_t axis_stride = indexer.stride(axis);
+    const std::size_t axis_length =
+        std::size_t(indexer.maximum()[axis] - indexer.minimum()[axis]) + 1;
+    const std::size_t orthant_stride = axis_stride >> CCDIM;
+
+    for (std::size_t orthant = 0; orthant < indexer.orthant_count();
+         ++orthant) {
+      const std::size_t index = (orthant << CCDIM) | extent;
+      GradingResultType grade = get(index | axis_bit);
+      // Inner coface exists unless on the minimum edge along `axis`.
+      if ((orthant / orthant_stride) % axis_length != 0) {
+        grade = std::min(grade, get((index | axis_bit) - axis_stride));
+      }
+      set(index, grade);
+    }
+  }
+}
+
+#endif  // CHOMP_DOXYGEN
+}  // namespace detail
+
+/**
+ * @brief A function object modeling `BoundedGrading` that stores the grade of
+ * every cell in a box of orthants in a contiguous array.
+ *
+ * Lookups are a single array access at the index given by `CubeIndexer`, with
+ * no hashing or branching. Each grade is stored as its offset from `MIN` in
+ * the narrowest unsigned integer type that can hold `MAX - MIN`.
+ *
+ * Inputs must lie in the box between the minimum and maximum orthant, as is
+ * the case for every cell of a `CubicalComplex` over the same box.
+ *
+ * @tparam CCDIM Ambient dimension of the hypercubical grid.
+ * @tparam MIN The minimal grade.
+ * @tparam MAX The maximal grade; cells not otherwise graded have this value.
+ * @tparam C Cell type modeling `CubicalCell`; default `Cube<CCDIM>`.
+ *
+ * @sa `DenseBinaryGrading`, `CubeIndexer`
+ */
+template <
+    std::size_t CCDIM, GradingResultType MIN, GradingResultType MAX,
+    CubicalCell<CCDIM> C = Cube<CCDIM>>
+requires(MIN <= MAX)
+class DenseGrading {
+public:
+  /** @brief Unsigned integer type storing the offset of each grade from MIN. */
+  using StorageType = detail::DenseStorageType<MAX - MIN>;
+
+private:
+  static constexpr std::size_t FULL_EXTENT = (std::size_t(1) << CCDIM) - 1;
+
+  CubeIndexer<CCDIM> cell_indexer;
+  std::vector<StorageType> grades;
+
+  // Minimum voxel of the top-dimensional cubes containing the cell of
+  // `orthant` and `extent`, which lie in its orthant shifted down along axes
+  // without extent
+  [[nodiscard]] GradingResultType closure_grade(
+      const CubeOrthant<CCDIM>& orthant, std::size_t extent
+  ) const noexcept {
+    const CubeOrthant<CCDIM>& minimum = cell_indexer.minimum();
+    const std::size_t free_axes = FULL_EXTENT & ~extent;
+    GradingResultType grade = MAX;
+    for (std::size_t shift = free_axes;; shift = (shift - 1) & free_axes) {
+      CubeOrthant<CCDIM> top_orthant = orthant;
+      bool inside = true;
+      for (std::size_t axis = 0; axis < CCDIM && inside; ++axis) {
+        if (((shift >> axis) & 1) != 0) {
+          inside = top_orthant[axis] > minimum[axis];
+          --top_orthant[axis];
+        }
+      }
+      if (inside) {
+        grade = std::min(grade, (*this)(InputType(top_orthant, FULL_EXTENT)));
+      }
+      if (shift == 0) {
+        return grade;
+      }
+    }
+  }
+
+public:
+  /** @brief The type expected as input to the call operator. */
+  using InputType = C;
+  /** @brief The minimal output value. */
+  using Minimum = std::integral_constant<GradingResultType, MIN>;
+  /** @brief The maximal output value. */
+  using Maximum = std::integral_constant<GradingResultType, MAX>;
+
+  /**
+   * @brief Initialize the grading on the box between `minimum_orthant` and
+   * `maximum_orthant` with every cell having the maximal grade `MAX`.
+   *
+   * @param minimum_orthant
+   * @param maximum_orthant
+   */
+  DenseGrading(
+      const CubeOrthant<CCDIM>& minimum_orthant,
+      const CubeOrthant<CCDIM>& maximum_orthant
+  ) :
+      cell_indexer(minimum_orthant, maximum_orthant),
+      grades(cell_indexer.size(), static_cast<StorageType>(MAX - MIN)) {}
+
+  /**
+   * @brief Initialize the grading on the box between `minimum_orthant` and
+   * `maximum_orthant` from a buffer of voxel values.
+   *
+   * Each voxel is the grade of the top-dimensional cube of one orthant, in
+   * the linear order of orthants of `CubeIndexer` (axis `0` varying fastest).
+   * Every other cell is graded by the minimum grade of the top-dimensional
+   * cubes containing it, so that the grading respects the face poset. Voxel
+   * values are clamped to `[MIN, MAX]`; orthants without a voxel (if the
+   * buffer is short) have grade `MAX`.
+   *
+   * @tparam I Input iterator type with values convertible to
+   * `GradingResultType`.
+   * @param minimum_orthant
+   * @param maximum_orthant
+   * @param voxels_first
+   * @param voxels_last
+   */
+  template <std::input_iterator I>
+  requires std::convertible_to<std::iter_value_t<I>, GradingResultType>
+  DenseGrading(
+      const CubeOrthant<CCDIM>& minimum_orthant,
+      const CubeOrthant<CCDIM>& maximum_orthant, I voxels_first, I voxels_last
+  ) : DenseGrading(minimum_orthant, maximum_orthant) {
+    for (std::size_t orthant = 0;
+         orthant < cell_indexer.orthant_count() && voxels_first != voxels_last;
+         ++orthant, ++voxels_first) {
+      const GradingResultType voxel = std::clamp(
+          static_cast<GradingResultType>(*voxels_first), MIN, MAX
+      );
+      grades[(orthant << CCDIM) | FULL_EXTENT] =
+          static_cast<StorageType>(voxel - MIN);
+    }
+    detail::close_top_cells(
+        cell_indexer,
+        [this](std::size_t index) {
+          return grade_at(index);
+        },
+        [this](std::size_t index, GradingResultType grade) {
+          grades[index] = static_cast<StorageType>(grade - MIN);
+        }
+    );
+  }
+
+  /**
+   * @brief Call the function object with `input` and return the grade.
+   *
+   * @param input Cell in the box of the grading.
+   * @return GradingResultType
+   */
+  GradingResultType operator()(const InputType& input) const noexcept {
+    return grade_at(cell_indexer.index_of(input));
+  }
+
+  /**
+   * @brief Grade each of `cells`, storing the results in `grades`.
+   *
+   * The loop has no calls or branches beyond the index computation and the
+   * storage lookup, so batches (e.g. every face of a cell) are graded without
+   * per-cell call overhead.
+   *
+   * @param cells Cells in the box of the grading.
+   * @param grades Output; at least as long as `cells`.
+   */
+  void grade_many(
+      std::span<const InputType> cells, std::span<GradingResultType> grades
+  ) const noexcept {
+    for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+      grades[cell] = grade_at(cell_indexer.index_of(cells[cell]));
+    }
+  }
+
+  /**
+   * @brief Set the grade of `input` to `grade`, clamped to `[MIN, MAX]`.
+   *
+   * Only `input` is regraded; use `update_voxel` to change a voxel together
+   * with the faces its grade determines.
+   *
+   * @param input Cell in the box of the grading.
+   * @param grade
+   */
+  void update(const InputType& input, GradingResultType grade) noexcept {
+    grades[cell_indexer.index_of(input)] =
+        static_cast<StorageType>(std::clamp(grade, MIN, MAX) - MIN);
+  }
+
+  /**
+   * @brief Set the voxel of `orthant`, i.e. the grade of its top-dimensional
+   * cube, to `voxel`, clamped to `[MIN, MAX]`, and regrade the faces of that
+   * cube as on construction from voxels.
+   *
+   * Only the cells of the orthants from `orthant` to one past it along each
+   * axis (within the box) are regraded, each from the voxels of the at most
+   * `2^CCDIM` top-dimensional cubes containing it. Cells elsewhere keep their
+   * grades.
+   *
+   * @param orthant Orthant in the box of the grading.
+   * @param voxel
+   */
+  void
+  update_voxel(const CubeOrthant<CCDIM>& orthant, GradingResultType voxel) {
+    update(InputType(orthant, FULL_EXTENT), voxel);
+    const CubeOrthant<CCDIM>& maximum = cell_indexer.maximum();
+    for (std::size_t extent = 0; extent < FULL_EXTENT; ++extent) {
+      // Faces of the cube lie in `orthant` shifted up along axes without
+      // extent
+      const std::size_t free_axes = FULL_EXTENT & ~extent;
+      for (std::size_t shift = free_axes;; shift = (shift - 1) & free_axes) {
+        CubeOrthant<CCDIM> face_orthant = orthant;
+        bool inside = true;
+        for (std::size_t axis = 0; axis < CCDIM && inside; ++axis) {
+          if (((shift >> axis) & 1) != 0) {
+            inside = face_orthant[axis] < maximum[axis];
+            ++face_orthant[axis];
+          }
+        }
+        if (inside) {
+          update(
+              InputType(face_orthant, extent),
+              closure_grade(face_orthant, extent)
+          );
+        }
+        if (shift == 0) {
+          break;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Get the grade of the cell with index `index` in the box.
+   *
+   * @param index Index of the cell, as given by `indexer()`.
+   * @return GradingResultType
+   */
+  [[nodiscard]] GradingResultType grade_at(std::size_t index) const noexcept {
+    return MIN + GradingResultType(grades[index]);
+  }
+
+  /**
+   * @brief Get the indexer for the box of this grading.
+   *
+   * @return const CubeIndexer<CCDIM>&
+   */
+  [[nodiscard]] const CubeIndexer<CCDIM>& indexer() const noexcept {
+    return cell_indexer;
+  }
+};
+
+/**
+ * @brief A function object modeling `BoundedGrading` that stores the grade of
+ * every cell in a box of orthants as a single bit.
+ *
+ * This is the dense analogue of `SetGrading`: cells whose bit is set have
+ * grade `MIN` and all others have grade `MAX`. Lookups are branch-free and the
+ * grading uses one bit of memory per cell.
+ *
+ * Inputs must lie in the box between the minimum and maximum orthant, as is
+ * the case for every cell of a `CubicalComplex` over the same box.
+ *
+ * @tparam CCDIM Ambient dimension of the hypercubical grid.
+ * @tparam MIN The grade of cells whose bit is set. Should satisfy
+ * `MIN <= MAX`.
+ * @tparam MAX The grade of all other cells. Should satisfy `MIN <= MAX`.
+ * @tparam C Cell type modeling `CubicalCell`; default `Cube<CCDIM>`.
+ *
+ * @sa `DenseGrading`, `SetGrading`, `CubeIndexer`
+ */
+template <
+    std::size_t CCDIM, GradingResultType MIN, GradingResultType MAX,
+    CubicalCell<CCDIM> C = Cube<CCDIM>>
+requires(MIN <= MAX)
+class DenseBinaryGrading {
+private:
+  using WordType = std::uint64_t;
+  static constexpr std::size_t WORD_BITS =
+      std::numeric_limits<WordType>::digits;
+
+  CubeIndexer<CCDIM> cell_indexer;
+  std::vector<WordType> bits;
+
+  void set_bit(std::size_t index) noexcept {
+    bits[index / WORD_BITS] |= WordType(1) << (index % WORD_BITS);
+  }
+
+public:
+  /** @brief The type expected as input to the call operator. */
+  using InputType = C;
+  /** @brief The grade of cells whose bit is set. */
+  using Minimum = std::integral_constant<GradingResultType, MIN>;
+  /** @brief The grade of all other cells. */
+  using Maximum = std::integral_constant<GradingResultType, MAX>;
+
+  /**
+   * @brief Initialize the grading on the box between `minimum_orthant` and
+   * `maximum_orthant` with every cell having the maximal grade `MAX`.
+   *
+   * @param minimum_orthant
+   * @param maximum_orthant
+   */
+  DenseBinaryGrading(
+      const CubeOrthant<CCDIM>& minimum_orthant,
+      const CubeOrthant<CCDIM>& maximum_orthant
+  ) :
+      cell_indexer(minimum_orthant, maximum_orthant),
+      bits((cell_indexer.size() + WORD_BITS - 1) / WORD_BITS, 0) {}
+
+  /**
+   * @brief Initialize the grading on the box between `minimum_orthant` and
+   * `maximum_orthant` from a buffer of voxel values.
+   *
+   * Each voxel marks whether the top-dimensional cube of one orthant has grade
+   * `MIN`, in the linear order of orthants of `CubeIndexer` (axis `0` varying
+   * fastest). Every other cell has grade `MIN` if and only if some
+   * top-dimensional cube containing it does. Orthants without a voxel (if the
+   * buffer is short) have grade `MAX`.
+   *
+   * @tparam I Input iterator type with values convertible to `bool`.
+   * @param minimum_orthant
+   * @param maximum_orthant
+   * @param voxels_first
+   * @param voxels_last
+   */
+  template <std::input_iterator I>
+  requires std::convertible_to<std::iter_value_t<I>, bool>
+  DenseBinaryGrading(
+      const CubeOrthant<CCDIM>& minimum_orthant,
+      const CubeOrthant<CCDIM>& maximum_orthant, I voxels_first, I voxels_last
+  ) : DenseBinaryGrading(minimum_orthant, maximum_orthant) {
+    constexpr std::size_t FULL_EXTENT = (std::size_t(1) << CCDIM) - 1;
+    for (std::size_t orthant = 0;
+         orthant < cell_indexer.orthant_count() && voxels_first != voxels_last;
+         ++orthant, ++voxels_first) {
+      if (static_cast<bool>(*voxels_first)) {
+        set_bit((orthant << CCDIM) | FULL_EXTENT);
+      }
+    }
+    detail::close_top_cells(
+        cell_indexer,
+        [this](std::size_t index) {
+          return grade_at(index);
+        },
+        [this](std::size_t index, GradingResultType grade) {
+          if (grade == MIN) {
+            set_bit(index);
+          }
+        }
+    );
+  }
+
+  /**
+   * @brief Call the function object with `input` and return the grade.
+   *
+   * @param input Cell in the box of the grading.
+   * @return GradingResultType
+   */
+  GradingResultType operator()(const InputType& input) const noexcept {
+    return grade_at(cell_indexer.index_of(input));
+  }
+
+  /** @copydoc DenseGrading::grade_many() */
+  void grade_many(
+      std::span<const InputType> cells, std::span<GradingResultType> grades
+  ) const noexcept {
+    for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+      grades[cell] = grade_at(cell_indexer.index_of(cells[cell]));
+    }
+  }
+
+  /** @copydoc DenseGrading::grade_at() */
+  [[nodiscard]] GradingResultType grade_at(std::size_t index) const noexcept {
+    const WordType bit = (bits[index / WORD_BITS] >> (index % WORD_BITS)) & 1U;
+    return MAX - static_cast<GradingResultType>(bit) * (MAX - MIN);
+  }
+
+  /** @copydoc DenseGrading::indexer() */
+  [[nodiscard]] const CubeIndexer<CCDIM>& indexer() const noexcept {
+    return cell_indexer;
+  }
+};
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_COMPLEXES_DENSE_H
@@ -0,0 +1,217 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/dense.hpp>
+#include <chomp/complexes/grading.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+TEST_CASE("CubeIndexer is a bijection on the box", "[complexes]") {
+  const CubeIndexer<3> indexer(
+      CubeOrthant<3>{1, 0, 2}, CubeOrthant<3>{3, 1, 2}
+  );
+  REQUIRE(indexer.orthant_count() == 6);
+  REQUIRE(indexer.size() == 48);
+  REQUIRE(indexer.stride(0) == 8);
+  REQUIRE(indexer.stride(1) == 24);
+
+  for (std::size_t index = 0; index < indexer.size(); ++index) {
+    const Cube<3> cell = indexer.cell_at<Cube<3>>(index);
+    REQUIRE(indexer.contains(cell));
+    REQUIRE(indexer.index_of(cell) == index);
+    REQUIRE(indexer.index_of(PackedCube<3>(cell)) == index);
+  }
+
+  REQUIRE(indexer.index_of(Cube<3>({1, 0, 2}, 0b000)) == 0);
+  REQUIRE(indexer.index_of(Cube<3>({2, 1, 2}, 0b101)) == (4 << 3 | 0b101));
+  REQUIRE_FALSE(indexer.contains(Cube<3>({0, 0, 2}, 0b000)));
+  REQUIRE_FALSE(indexer.contains(Cube<3>({1, 2, 2}, 0b000)));
+
+  // for_each_orthant walks the box in the order of the indices
+  std::size_t orthant_index = 0;
+  for_each_orthant(
+      indexer.minimum(), indexer.maximum(),
+      [&](const CubeOrthant<3>& orthant) {
+        REQUIRE(indexer.index_of(Cube<3>(orthant, 0)) == orthant_index << 3);
+        ++orthant_index;
+      }
+  );
+  REQUIRE(orthant_index == indexer.orthant_count());
+}
+
+TEST_CASE("DenseGrading models BoundedGrading", "[complexes]") {
+  CHECK(BoundedGrading<DenseGrading<2, 0, 10>>);
+  CHECK(BoundedGrading<DenseBinaryGrading<3, 0, 1, PackedCube<3>>>);
+  CHECK(std::same_as<DenseGrading<2, 5, 260>::StorageType, std::uint8_t>);
+  CHECK(std::same_as<DenseGrading<2, 0, 256>::StorageType, std::uint16_t>);
+}
+
+TEST_CASE(
+    "DenseGrading from voxels grades faces by their cofaces", "[complexes]"
+) {
+  // Voxels of a 3x3 image, axis 0 varying fastest
+  const std::vector<int> voxels = {4, 2, 7, 1, 5, 3, 6, 0, 9};
+  const CubeOrthant<2> minimum{0, 0};
+  const CubeOrthant<2> maximum{2, 2};
+  const DenseGrading<2, 0, 8> grading(
+      minimum, maximum, voxels.cbegin(), voxels.cend()
+  );
+  CubicalComplex<2, DenseGrading<2, 0, 8>> complex(minimum, maximum, grading);
+
+  // Expected grade is the minimum over top cells at orthants `o - delta` for
+  // axes without extent, clamped to the grading's maximum.
+  const CubeIndexer<2>& indexer = grading.indexer();
+  for (std::size_t index = 0; index < indexer.size(); ++index) {
+    const Cube<2> cell = indexer.cell_at<Cube<2>>(index);
+    GradingResultType expected = 8;
+    for (int dx = -1; dx <= 0; ++dx) {
+      for (int dy = -1; dy <= 0; ++dy) {
+        if ((dx != 0 && (cell.extent() & 0b01)) ||
+            (dy != 0 && (cell.extent() & 0b10))) {
+          continue;
+        }
+        const int x = cell.coordinate(0) + dx;
+        const int y = cell.coordinate(1) + dy;
+        if (x < 0 || y < 0) {
+          continue;
+        }
+        expected = std::min<GradingResultType>(
+            expected, std::min(voxels[3 * y + x], 8)
+        );
+      }
+    }
+    REQUIRE(grading(cell) == expected);
+    REQUIRE(grading.grade_at(index) == expected);
+
+    // Grading respects the face poset
+    for (const Cube<2>& face : boundary(complex, cell)) {
+      REQUIRE(grading(face) <= grading(cell));
+    }
+  }
+}
+
+TEST_CASE("DenseGrading updates voxels locally", "[complexes]") {
+  using Grading = DenseGrading<3, 0, 8>;
+  CHECK(MutableGrading<Grading>);
+
+  const CubeOrthant<3> minimum{1, 0, 2};
+  const CubeOrthant<3> maximum{4, 2, 4};
+  std::vector<int> voxels(4 * 3 * 3);
+  for (std::size_t voxel = 0; voxel < voxels.size(); ++voxel) {
+    voxels[voxel] = int((voxel * 5) % 9);
+  }
+  Grading grading(minimum, maximum, voxels.cbegin(), voxels.cend());
+  const CubeIndexer<3>& indexer = grading.indexer();
+
+  const std::vector<std::pair<std::size_t, int>> updates = {
+      {0, 8}, {35, 0}, {14, 1}, {14, 7}, {21, 3}, {9, 12}
+  };
+  for (const auto& [voxel, value] : updates) {
+    const Grading before = grading;
+    voxels[voxel] = value;
+    const CubeOrthant<3> orthant =
+        indexer.cell_at<Cube<3>>(voxel << 3).orthant();
+    grading.update_voxel(orthant, value);
+
+    const Grading rebuilt(minimum, maximum, voxels.cbegin(), voxels.cend());
+    for (std::size_t index = 0; index < indexer.size(); ++index) {
+      const Cube<3> cell = indexer.cell_at<Cube<3>>(index);
+      REQUIRE(grading(cell) == rebuilt(cell));
+      if (grading(cell) != before(cell)) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+          REQUIRE(cell.coordinate(axis) >= orthant[axis]);
+          REQUIRE(cell.coordinate(axis) <= orthant[axis] + 1);
+        }
+      }
+    }
+  }
+
+  grading.update(Cube<3>({2, 1, 3}, 0b010), 2);
+  REQUIRE(grading(Cube<3>({2, 1, 3}, 0b010)) == 2);
+  grading.update(Cube<3>({2, 1, 3}, 0b010), 20);
+  REQUIRE(grading(Cube<3>({2, 1, 3}, 0b010)) == 8);
+}
+
+TEST_CASE("DenseBinaryGrading matches SetGrading", "[complexes]") {
+  const std::vector<bool> voxels = {true, false, false, false, false, true};
+  const DenseBinaryGrading<2, 0, 1> grading(
+      CubeOrthant<2>{0, 0}, CubeOrthant<2>{2, 1}, voxels.cbegin(),
+      voxels.cend()
+  );
+  // Closures of the two marked top cells within the box; the complex is open
+  // along the maximum orthant, so only (2, 1) itself holds faces of the second
+  const SetGrading<Cube<2>, 0, 1> set_grading(
+      {Cube<2>({0, 0}, 0b11), Cube<2>({0, 0}, 0b01), Cube<2>({0, 0}, 0b10),
+       Cube<2>({0, 0}, 0b00), Cube<2>({1, 0}, 0b10), Cube<2>({1, 0}, 0b00),
+       Cube<2>({0, 1}, 0b01), Cube<2>({0, 1}, 0b00), Cube<2>({1, 1}, 0b00),
+       Cube<2>({2, 1}, 0b11), Cube<2>({2, 1}, 0b01), Cube<2>({2, 1}, 0b10),
+       Cube<2>({2, 1}, 0b00)}
+  );
+
+  const CubeIndexer<2>& indexer = grading.indexer();
+  for (std::size_t index = 0; index < indexer.size(); ++index) {
+    const Cube<2> cell = indexer.cell_at<Cube<2>>(index);
+    REQUIRE(grading(cell) == set_grading(cell));
+  }
+
+  const DenseBinaryGrading<2, 3, 7> empty(
+      CubeOrthant<2>{0, 0}, CubeOrthant<2>{1, 1}
+  );
+  REQUIRE(empty(Cube<2>({1, 1}, 0b11)) == 7);
+}
+
+TEST_CASE("Dense gradings grade batches", "[complexes]") {
+  const std::vector<int> voxels = {2, 0, 1, 3};
+  using Grading = DenseGrading<2, 0, 3>;
+  const Grading grading(
+      CubeOrthant<2>{0, 0}, CubeOrthant<2>{1, 1}, voxels.cbegin(),
+      voxels.cend()
+  );
+  CHECK(BatchGrading<Grading>);
+  CHECK(BatchGrading<DenseBinaryGrading<2, 0, 1>>);
+
+  std::vector<Cube<2>> cells;
+  for (std::size_t index = 0; index < grading.indexer().size(); ++index) {
+    cells.push_back(grading.indexer().cell_at<Cube<2>>(index));
+  }
+  std::vector<GradingResultType> grades(cells.size());
+  grading.grade_many(cells, grades);
+  for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+    REQUIRE(grades[cell] == grading(cells[cell]));
+  }
+
+  // graded_boundary grades the cell and its faces in one batch
+  CubicalComplex<2, Grading> complex(
+      CubeOrthant<2>{0, 0}, CubeOrthant<2>{1, 1}, grading
+  );
+  for (const Cube<2>& cell : cells) {
+    const auto expected = complex.boundary_if(cell, [&](const Cube<2>& face) {
+      return grading(face) == grading(cell);
+    });
+    REQUIRE(graded_boundary(complex, cell) == expected);
+    const auto expected_co =
+        complex.coboundary_if(cell, [&](const Cube<2>& coface) {
+          return grading(coface) == grading(cell);
+        });
+    REQUIRE(graded_coboundary(complex, cell) == expected_co);
+  }
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
@@ -0,0 +1,309 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains `DirtyRegion`, which tracks the orthants of a
+ * cubical box whose grades changed, so that only their neighborhoods are
+ * recomputed.
+ */
+
+#ifndef CHOMP_COMPLEXES_DIRTY_H
+#define CHOMP_COMPLEXES_DIRTY_H
+
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/util/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+/**
+ * @brief Union of boxes of orthants, within the box of a cubical complex,
+ * marked as changed.
+ *
+ * Marked boxes are clamped to the box of the complex and kept disjoint: a box
+ * overlapping or adjacent to (along every axis, including diagonally) a box
+ * already marked is merged with it into their bounding box. The region thus
+ * always contains every marked orthant, and may contain a few orthants more.
+ *
+ * A typical use follows changes of a grading since the last reduction. After
+ * `DenseGrading::update_voxel` at each orthant of the region, `expanded(1)`
+ * contains every regraded cell and `expanded(2)` every cell whose graded
+ * boundary or coboundary changed, i.e. the neighborhoods to invalidate in
+ * caches such as `CachedGradingWrapper` or `CachedChainComplex` (through
+ * `contains`) and to recompute (through `cells`).
+ *
+ * @tparam CCDIM Ambient dimension of the cubical complex.
+ *
+ * @sa `DenseGrading::update_voxel`, `CachedChainComplex::invalidate_if`
+ */
+template <std::size_t CCDIM>
+class DirtyRegion {
+public:
+  /** @brief Box of orthants from `minimum` to `maximum`, inclusive. */
+  struct OrthantRange {
+    /** @brief Minimum orthant of the box. */
+    CubeOrthant<CCDIM> minimum;
+    /** @brief Maximum orthant of the box, inclusive. */
+    CubeOrthant<CCDIM> maximum;
+
+    /**
+     * @brief Whether `orthant` lies in the box.
+     *
+     * @param orthant
+     * @return true
+     * @return false
+     */
+    [[nodiscard]] bool contains(const CubeOrthant<CCDIM>& orthant
+    ) const noexcept {
+      for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+        if (orthant[axis] < minimum[axis] || orthant[axis] > maximum[axis]) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * @brief Number of orthants in the box.
+     *
+     * @return std::size_t
+     */
+    [[nodiscard]] std::size_t orthant_count() const noexcept {
+      std::size_t count = 1;
+      for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+        count *= std::size_t(maximum[axis] - minimum[axis]) + 1;
+      }
+      return count;
+    }
+
+    /** @brief Equality of both bounds. */
+    [[nodiscard]] bool operator==(const OrthantRange&) const noexcept = default;
+  };
+
+private:
+  CubeOrthant<CCDIM> box_minimum;
+  CubeOrthant<CCDIM> box_maximum;
+  std::vector<OrthantRange> dirty;
+
+  // Whether the boxes overlap or are adjacent along every axis
+  [[nodiscard]] static bool
+  touches(const OrthantRange& lhs, const OrthantRange& rhs) noexcept {
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      if (std::size_t(lhs.minimum[axis]) > std::size_t(rhs.maximum[axis]) + 1 ||
+          std::size_t(rhs.minimum[axis]) > std::size_t(lhs.maximum[axis]) + 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+public:
+  /**
+   * @brief Initialize an empty region in the box of orthants from `minimum`
+   * to `maximum` (inclusive).
+   *
+   * @param minimum Minimum orthant of the box.
+   * @param maximum Maximum orthant of the box; at least `minimum` along each
+   * axis.
+   */
+  DirtyRegion(
+      const CubeOrthant<CCDIM>& minimum, const CubeOrthant<CCDIM>& maximum
+  ) : box_minimum(minimum), box_maximum(maximum) {}
+
+  /**
+   * @brief Initialize an empty region in the box of a cubical complex.
+   *
+   * @tparam CC Cubical complex type.
+   * @param complex
+   */
+  template <typename CC>
+  requires requires(const CC& complex) {
+    { complex.minimum() } -> std::convertible_to<CubeOrthant<CCDIM>>;
+    { complex.maximum() } -> std::convertible_to<CubeOrthant<CCDIM>>;
+  }
+  explicit DirtyRegion(const CC& complex) :
+      DirtyRegion(complex.minimum(), complex.maximum()) {}
+
+  /**
+   * @brief Mark the orthants from `minimum` to `maximum` (inclusive), clamped
+   * to the box, as changed.
+   *
+   * Nothing is marked if the clamped range is empty along some axis.
+   *
+   * @param minimum
+   * @param maximum
+   */
+  void
+  mark(const CubeOrthant<CCDIM>& minimum, const CubeOrthant<CCDIM>& maximum) {
+    OrthantRange range{minimum, maximum};
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      range.minimum[axis] = std::max(range.minimum[axis], box_minimum[axis]);
+      range.maximum[axis] = std::min(range.maximum[axis], box_maximum[axis]);
+      if (range.minimum[axis] > range.maximum[axis]) {
+        return;
+      }
+    }
+
+    // Absorb the marked boxes touching the range until none is left, since
+    // each merge may grow the range to touch more
+    bool merged = true;
+    while (merged) {
+      merged = false;
+      for (std::size_t index = 0; index < dirty.size(); ++index) {
+        if (touches(range, dirty[index])) {
+          for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+            range.minimum[axis] =
+                std::min(range.minimum[axis], dirty[index].minimum[axis]);
+            range.maximum[axis] =
+                std::max(range.maximum[axis], dirty[index].maximum[axis]);
+          }
+          dirty[index] = dirty.back();
+          dirty.pop_back();
+          merged = true;
+          break;
+        }
+      }
+    }
+    dirty.push_back(range);
+  }
+
+  /**
+   * @brief Mark `orthant` as changed.
+   *
+   * @param orthant Orthant in the box.
+   */
+  void mark(const CubeOrthant<CCDIM>& orthant) {
+    mark(orthant, orthant);
+  }
+
+  /**
+   * @brief The region grown by `layers` orthants in every direction along
+   * each axis, clamped to the box.
+   *
+   * @param layers
+   * @return DirtyRegion
+   */
+  [[nodiscard]] DirtyRegion expanded(std::size_t layers) const {
+    DirtyRegion result(box_minimum, box_maximum);
+    for (const OrthantRange& range : dirty) {
+      OrthantRange grown = range;
+      for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+        grown.minimum[axis] = static_cast<HypercubeCoordinate>(
+            std::size_t(range.minimum[axis]) -
+            std::min<std::size_t>(
+                layers, range.minimum[axis] - box_minimum[axis]
+            )
+        );
+        grown.maximum[axis] = static_cast<HypercubeCoordinate>(
+            std::size_t(range.maximum[axis]) +
+            std::min<std::size_t>(
+                layers, box_maximum[axis] - range.maximum[axis]
+            )
+        );
+      }
+      result.mark(grown.minimum, grown.maximum);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Whether no orthant is marked.
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool empty() const noexcept {
+    return dirty.empty();
+  }
+  /** @brief Unmark every orthant, e.g. after recomputing the region. */
+  void clear() noexcept {
+    dirty.clear();
+  }
+
+  /**
+   * @brief The disjoint boxes of orthants making up the region, in no
+   * particular order.
+   *
+   * @return const std::vector<OrthantRange>&
+   */
+  [[nodiscard]] const std::vector<OrthantRange>& ranges() const noexcept {
+    return dirty;
+  }
+
+  /**
+   * @brief Number of orthants in the region.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t orthant_count() const noexcept {
+    std::size_t count = 0;
+    for (const OrthantRange& range : dirty) {
+      count += range.orthant_count();
+    }
+    return count;
+  }
+
+  /**
+   * @brief Whether `orthant` lies in the region.
+   *
+   * @param orthant
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool contains(const CubeOrthant<CCDIM>& orthant
+  ) const noexcept {
+    return std::ranges::any_of(dirty, [&orthant](const OrthantRange& range) {
+      return range.contains(orthant);
+    });
+  }
+  /**
+   * @brief Whether the orthant of `cell` lies in the region.
+   *
+   * @tparam C Cell type modeling `CubicalCell`.
+   * @param cell
+   * @return true
+   * @return false
+   */
+  template <CubicalCell<CCDIM> C>
+  [[nodiscard]] bool contains(const C& cell) const noexcept {
+    return contains(CubeOrthant<CCDIM>(cell.orthant()));
+  }
+
+  /**
+   * @brief Every cell (of every extent) of the orthants of the region, each
+   * once, box by box and orthant by orthant.
+   *
+   * @tparam C Cell type modeling `CubicalCell`.
+   * @return std::vector<C>
+   */
+  template <CubicalCell<CCDIM> C>
+  [[nodiscard]] std::vector<C> cells() const {
+    std::vector<C> result;
+    result.reserve(orthant_count() << CCDIM);
+    for (const OrthantRange& range : dirty) {
+      for_each_orthant(
+          range.minimum, range.maximum,
+          [&result](const CubeOrthant<CCDIM>& orthant) {
+            for (std::size_t extent = 0; extent < (std::size_t(1) << CCDIM);
+                 ++extent) {
+              result.emplace_back(orthant, extent);
+            }
+          }
+      );
+    }
+    return result;
+  }
+};
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_COMPLEXES_DIRTY_H
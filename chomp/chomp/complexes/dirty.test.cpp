@@ -0,0 +1,118 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/complexes/cached.hpp>
+#include <chomp/complexes/complexes.hpp>
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/dense.hpp>
+#include <chomp/complexes/dirty.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+TEST_CASE("DirtyRegion merges marked boxes", "[complexes]") {
+  DirtyRegion<2> region(CubeOrthant<2>{0, 0}, CubeOrthant<2>{9, 9});
+  REQUIRE(region.empty());
+
+  region.mark(CubeOrthant<2>{2, 2});
+  region.mark(CubeOrthant<2>{7, 7}, CubeOrthant<2>{8, 8});
+  REQUIRE(region.ranges().size() == 2);
+  REQUIRE(region.orthant_count() == 5);
+  REQUIRE(region.contains(CubeOrthant<2>{2, 2}));
+  REQUIRE(region.contains(Cube<2>({8, 7}, 0b11)));
+  REQUIRE_FALSE(region.contains(CubeOrthant<2>{3, 2}));
+
+  // Adjacent, then overlapping, boxes merge into their bounding box
+  region.mark(CubeOrthant<2>{3, 2});
+  REQUIRE(region.ranges().size() == 2);
+  region.mark(CubeOrthant<2>{4, 3}, CubeOrthant<2>{6, 6});
+  REQUIRE(region.ranges().size() == 1);
+  using Range = DirtyRegion<2>::OrthantRange;
+  REQUIRE(region.ranges().front() == Range{{2, 2}, {8, 8}});
+
+  // Clamped to the box, and empty after clamping
+  region.clear();
+  region.mark(CubeOrthant<2>{8, 0}, CubeOrthant<2>{20, 1});
+  REQUIRE(region.ranges().front() == Range{{8, 0}, {9, 1}});
+  region.mark(CubeOrthant<2>{12, 0}, CubeOrthant<2>{20, 1});
+  REQUIRE(region.ranges().size() == 1);
+
+  const DirtyRegion<2> grown = region.expanded(2);
+  REQUIRE(grown.ranges().size() == 1);
+  REQUIRE(grown.ranges().front() == Range{{6, 0}, {9, 3}});
+
+  const std::vector<Cube<2>> cells = grown.cells<Cube<2>>();
+  REQUIRE(cells.size() == grown.orthant_count() * 4);
+  REQUIRE(std::set<Cube<2>>(cells.begin(), cells.end()).size() == cells.size());
+  for (const Cube<2>& cell : cells) {
+    REQUIRE(grown.contains(cell));
+  }
+}
+
+TEST_CASE(
+    "DirtyRegion bounds the neighborhoods changed by voxel updates",
+    "[complexes]"
+) {
+  using Grading = DenseGrading<2, 0, 4>;
+  using Complex = CubicalComplex<2, Grading, Z<3>>;
+  const CubeOrthant<2> minimum{0, 0};
+  const CubeOrthant<2> maximum{7, 7};
+  std::vector<int> voxels(64);
+  for (std::size_t voxel = 0; voxel < voxels.size(); ++voxel) {
+    voxels[voxel] = int((voxel * 7) % 5);
+  }
+
+  Complex complex(
+      minimum, maximum,
+      Grading(minimum, maximum, voxels.cbegin(), voxels.cend())
+  );
+  CachedChainComplex cached(complex, std::size_t(1) << 20);
+  for (const Cube<2>& cell : complex.cells()) {
+    static_cast<void>(graded_boundary(cached, cell));
+  }
+
+  DirtyRegion<2> region(complex);
+  for (const std::size_t voxel : {std::size_t(9), std::size_t(10)}) {
+    voxels[voxel] = 4 - voxels[voxel];
+    const CubeOrthant<2> orthant{
+        HypercubeCoordinate(voxel % 8), HypercubeCoordinate(voxel / 8)
+    };
+    complex.grading().update_voxel(orthant, voxels[voxel]);
+    region.mark(orthant);
+  }
+
+  const DirtyRegion<2> affected = region.expanded(2);
+  const std::size_t dropped = cached.invalidate_if([&](std::size_t index) {
+    return affected.contains(cached.cell_at(index));
+  });
+  REQUIRE(dropped == affected.orthant_count() * 4);
+  REQUIRE(dropped < complex.cell_count());
+
+  Complex rebuilt(
+      minimum, maximum,
+      Grading(minimum, maximum, voxels.cbegin(), voxels.cend())
+  );
+  for (const Cube<2>& cell : complex.cells()) {
+    REQUIRE(complex.grade(cell) == rebuilt.grade(cell));
+    REQUIRE(graded_boundary(cached, cell) == graded_boundary(rebuilt, cell));
+    REQUIRE(
+        graded_coboundary(cached, cell) == graded_coboundary(rebuilt, cell)
+    );
+  }
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
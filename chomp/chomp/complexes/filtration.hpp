@@ -0,0 +1,512 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains `Filtration`, which sorts the cells of a graded
+ * chain complex by (grade, dimension) once and assembles their boundary
+ * matrix, shared between every grade level.
+ */
+
+#ifndef CHOMP_COMPLEXES_FILTRATION_H
+#define CHOMP_COMPLEXES_FILTRATION_H
+
+#include <chomp/algebra/sparse.hpp>
+#include <chomp/complexes/cached.hpp>
+#include <chomp/complexes/complexes.hpp>
+#include <chomp/complexes/grading.hpp>
+#include <chomp/complexes/morse.hpp>
+#include <chomp/util/concepts.hpp>
+#include <chomp/util/constants.hpp>
+#include <chomp/util/parallel.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+/**
+ * @brief The cells of a graded chain complex in filtration order, with the
+ * boundary matrix on them, computed in a single pass and shared by the
+ * analyses of every grade level.
+ *
+ * Cells are sorted by grade, then dimension, and identified by their position
+ * in that order. Each cell is graded and its boundary computed once. Rows and
+ * columns of `matrix()` are the positions, as in
+ * `CubicalComplex::boundary_matrix`; since gradings are closed under faces,
+ * every face precedes its cofaces, so the matrix and `dimensions()` are
+ * suitable input for `ColumnReduction`.
+ *
+ * The cells of each grade, a level of the filtration, are contiguous, and the
+ * cells of grade at most that of a level are a prefix, the sublevel complex.
+ * The faces of a cell with its own grade are thus the rows of its column from
+ * the first position of its level. Graded boundaries, as by `graded_boundary`,
+ * and the boundary matrix of each level, as by
+ * `CubicalComplex::boundary_matrix(grade)`, are read from the shared matrix
+ * rather than by one pass over the complex per level.
+ *
+ * If `CC` models `IndexedChainComplex`, positions are looked up by cell index
+ * rather than in a map; the complex is then referenced for `position` and
+ * `contains`, and must outlive their calls.
+ *
+ * @tparam CC Chain complex type modeling `DimensionedChainComplex`.
+ *
+ * @sa `MorseMatching`, which processes cells in the same order.
+ */
+template <DimensionedChainComplex CC>
+class Filtration {
+public:
+  /** @brief Cell type of the filtered complex. */
+  using CellType = typename CC::CellType;
+  /** @brief Coefficient ring type of the filtered complex. */
+  using RingType = typename CC::RingType;
+  /** @brief Chain (module) type of the filtered complex. */
+  using ChainType = typename CC::ChainType;
+  /** @brief Matrix type of the boundary operator. */
+  using MatrixType = SparseMatrix<RingType>;
+
+  /** @brief Position of cells that are not in the filtration. */
+  static constexpr std::size_t ABSENT =
+      std::numeric_limits<std::size_t>::max();
+
+private:
+  using EntryType = typename MatrixType::EntryType;
+
+  static constexpr bool INDEXED = IndexedChainComplex<CC>;
+
+  // Boundary entries of a range of consecutive positions, sorted by row
+  // within each column, with the end of the entries of each
+  struct Columns {
+    std::vector<std::size_t> ends;
+    std::vector<EntryType> entries;
+  };
+
+  const CC* indexing = nullptr;
+  std::vector<CellType> ordered_cells;
+  std::vector<GradingResultType> cell_grades;
+  std::vector<std::size_t> cell_dimensions;
+  // Position of each cell, by complex index when the complex is indexed
+  std::conditional_t<
+      INDEXED, std::vector<std::size_t>, DefaultMap<CellType, std::size_t>>
+      positions;
+  // Distinct grades, increasing, and the first position of each; the last
+  // entry of `level_begins` is the number of cells.
+  std::vector<GradingResultType> level_grades;
+  std::vector<std::size_t> level_begins;
+  MatrixType boundaries;
+
+  template <ExecutionPolicy P>
+  static void grade_cells(
+      CC& complex, std::span<const CellType> cells,
+      std::span<GradingResultType> grades, const P& policy
+  ) {
+    const auto grade_range = [&complex, cells,
+                              grades](std::size_t first, std::size_t last) {
+      const std::span<const CellType> range =
+          cells.subspan(first, last - first);
+      const std::span<GradingResultType> out =
+          grades.subspan(first, last - first);
+      if constexpr (requires { complex.grade_many(range, out); }) {
+        complex.grade_many(range, out);
+      } else {
+        std::ranges::transform(range, out.begin(), [&](const CellType& c) {
+          return complex.grade(c);
+        });
+      }
+    };
+    if constexpr (std::same_as<P, SequencedPolicy>) {
+      grade_range(0, cells.size());
+    } else {
+      parallel_for(policy, cells.size(), grade_range);
+    }
+  }
+
+  [[nodiscard]] std::size_t
+  find_position(const CC* complex, const CellType& cell) const {
+    if constexpr (INDEXED) {
+      if (complex == nullptr) {
+        return ABSENT;
+      }
+      const std::size_t index = complex->index_of(cell);
+      return index < positions.size() ? positions[index] : ABSENT;
+    } else {
+      const auto it = positions.find(cell);
+      return it == positions.end() ? ABSENT : it->second;
+    }
+  }
+
+  [[nodiscard]] Columns
+  compute_columns(CC& complex, std::size_t first, std::size_t last) const {
+    Columns columns;
+    columns.ends.reserve(last - first);
+    const auto add_face = [&columns](std::size_t face, const RingType& coef) {
+      if (face != ABSENT) {
+        columns.entries.emplace_back(face, coef);
+      }
+    };
+    for (std::size_t position = first; position < last; ++position) {
+      const std::size_t begin = columns.entries.size();
+      if constexpr (requires(std::size_t index) {
+                      requires INDEXED;
+                      complex.for_each_boundary_index(
+                          index, [](std::size_t, const RingType&) {}
+                      );
+                    }) {
+        // Faces by index, without constructing cells
+        complex.for_each_boundary_index(
+            complex.index_of(ordered_cells[position]),
+            [this, &add_face](std::size_t face, const RingType& coef) {
+              add_face(positions[face], coef);
+            }
+        );
+      } else {
+        for_each_boundary(
+            complex, ordered_cells[position],
+            [this, &complex,
+             &add_face](const CellType& face, const RingType& coef) {
+              add_face(find_position(&complex, face), coef);
+            }
+        );
+      }
+      // Faces are distinct, so sorting leaves the column combined
+      std::sort(
+          columns.entries.begin() + std::ptrdiff_t(begin),
+          columns.entries.end(),
+          [](const EntryType& lhs, const EntryType& rhs) {
+            return lhs.first < rhs.first;
+          }
+      );
+      columns.ends.push_back(columns.entries.size());
+    }
+    return columns;
+  }
+
+  void push_columns(const Columns& columns) {
+    boundaries.reserve(columns.ends.size(), columns.entries.size());
+    const std::span<const EntryType> entries(columns.entries);
+    std::size_t begin = 0;
+    for (const std::size_t end : columns.ends) {
+      boundaries.push_sorted_column(entries.subspan(begin, end - begin));
+      begin = end;
+    }
+  }
+
+  [[nodiscard]] ChainType chain_of(
+      std::span<const std::size_t> rows, std::span<const RingType> values
+  ) const {
+    ChainType chain;
+    for (std::size_t entry = 0; entry < rows.size(); ++entry) {
+      chain.insert(ordered_cells[rows[entry]], values[entry]);
+    }
+    return chain;
+  }
+
+  // First entry of the column of `position` with the grade of its cell
+  [[nodiscard]] std::size_t graded_offset(std::size_t position) const {
+    const std::span<const std::size_t> rows = boundaries.column_rows(position);
+    return std::size_t(
+        std::ranges::lower_bound(rows, level_begins[level_of(position)]) -
+        rows.begin()
+    );
+  }
+
+public:
+  /** @brief Initialize an empty filtration. */
+  Filtration() = default;
+
+  /**
+   * @brief Sort `cells` of `complex` by (grade, dimension) and assemble their
+   * boundary matrix under `policy`.
+   *
+   * Every cell is graded once, in `grade_many` batches when the complex
+   * provides them, and its boundary is computed once, from cell indices when
+   * the complex provides `for_each_boundary_index`. The range should contain
+   * every cell of the (sub)complex to filter, each once; faces outside the
+   * range are treated as absent. Cells of equal grade and dimension keep
+   * their order in the range.
+   *
+   * Under `ParallelPolicy`, the cells are graded and their boundaries
+   * computed by contiguous ranges as in `parallel_for`, so the methods of the
+   * complex, including its grading, must be safe to call concurrently.
+   *
+   * @tparam Cells Input range type of cells.
+   * @tparam P Execution policy type.
+   * @param complex
+   * @param cells
+   * @param policy
+   */
+  template <
+      std::ranges::input_range Cells, ExecutionPolicy P = SequencedPolicy>
+  requires std::convertible_to<std::ranges::range_value_t<Cells>, CellType>
+  Filtration(CC& complex, Cells&& cells, const P& policy = P()) {
+    std::vector<CellType> input;
+    if constexpr (std::ranges::sized_range<Cells>) {
+      input.reserve(std::ranges::size(cells));
+    }
+    for (const CellType& cell : cells) {
+      input.push_back(cell);
+    }
+    std::vector<GradingResultType> grades(input.size());
+    grade_cells(
+        complex, std::span<const CellType>(input),
+        std::span<GradingResultType>(grades), policy
+    );
+    std::vector<std::size_t> dimensions(input.size());
+    std::ranges::transform(
+        input, dimensions.begin(),
+        [&complex](const CellType& c) {
+          return std::size_t(complex.dimension(c));
+        }
+    );
+
+    std::vector<std::size_t> order(input.size());
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::ranges::stable_sort(order, [&](std::size_t lhs, std::size_t rhs) {
+      return std::tie(grades[lhs], dimensions[lhs]) <
+             std::tie(grades[rhs], dimensions[rhs]);
+    });
+
+    ordered_cells.reserve(input.size());
+    cell_grades.reserve(input.size());
+    cell_dimensions.reserve(input.size());
+    if constexpr (INDEXED) {
+      indexing = &complex;
+      positions.assign(complex.cell_count(), ABSENT);
+    } else if constexpr (requires { positions.reserve(input.size()); }) {
+      positions.reserve(input.size());
+    }
+    for (const std::size_t cell : order) {
+      const std::size_t position = ordered_cells.size();
+      if constexpr (INDEXED) {
+        positions[complex.index_of(input[cell])] = position;
+      } else {
+        positions.insert(std::make_pair(input[cell], position));
+      }
+      if (level_grades.empty() || level_grades.back() != grades[cell]) {
+        level_grades.push_back(grades[cell]);
+        level_begins.push_back(position);
+      }
+      cell_grades.push_back(grades[cell]);
+      cell_dimensions.push_back(dimensions[cell]);
+      ordered_cells.push_back(std::move(input[cell]));
+    }
+    level_begins.push_back(ordered_cells.size());
+
+    boundaries = MatrixType(ordered_cells.size());
+    if constexpr (std::same_as<P, SequencedPolicy>) {
+      push_columns(compute_columns(complex, 0, ordered_cells.size()));
+    } else {
+      push_columns(parallel_reduce<Columns>(
+          policy, ordered_cells.size(),
+          [this, &complex](std::size_t first, std::size_t last) {
+            return compute_columns(complex, first, last);
+          },
+          [](Columns& lhs, Columns&& rhs) {
+            const std::size_t offset = lhs.entries.size();
+            for (const std::size_t end : rhs.ends) {
+              lhs.ends.push_back(end + offset);
+            }
+            lhs.entries.insert(
+                lhs.entries.end(), std::make_move_iterator(rhs.entries.begin()),
+                std::make_move_iterator(rhs.entries.end())
+            );
+          }
+      ));
+    }
+  }
+
+  /**
+   * @brief Number of cells in the filtration.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return ordered_cells.size();
+  }
+
+  /**
+   * @brief The cells in filtration order.
+   *
+   * @return std::span<const CellType>
+   */
+  [[nodiscard]] std::span<const CellType> cells() const noexcept {
+    return ordered_cells;
+  }
+  /**
+   * @brief The cell at `position`.
+   *
+   * @param position Less than `size()`.
+   * @return const CellType&
+   */
+  [[nodiscard]] const CellType& cell(std::size_t position) const {
+    return ordered_cells[position];
+  }
+
+  /**
+   * @brief Grade of the cell at each position.
+   *
+   * @return std::span<const GradingResultType>
+   */
+  [[nodiscard]] std::span<const GradingResultType> grades() const noexcept {
+    return cell_grades;
+  }
+  /**
+   * @brief Dimension of the cell at each position.
+   *
+   * @return std::span<const std::size_t>
+   */
+  [[nodiscard]] std::span<const std::size_t> dimensions() const noexcept {
+    return cell_dimensions;
+  }
+
+  /**
+   * @brief Position of `cell` in the filtration.
+   *
+   * @param cell A cell of the filtered complex.
+   * @return std::size_t The position, or `ABSENT` if `cell` is not in the
+   * filtration.
+   */
+  [[nodiscard]] std::size_t position(const CellType& cell) const {
+    return find_position(indexing, cell);
+  }
+  /**
+   * @brief Whether `cell` is in the filtration.
+   *
+   * @param cell A cell of the filtered complex.
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool contains(const CellType& cell) const {
+    return position(cell) != ABSENT;
+  }
+
+  /**
+   * @brief Boundary matrix of the filtration; row and column `i` are the cell
+   * at position `i`.
+   *
+   * @return const MatrixType&
+   */
+  [[nodiscard]] const MatrixType& matrix() const noexcept {
+    return boundaries;
+  }
+
+  /**
+   * @brief The distinct grades of the cells, in increasing order; the levels
+   * of the filtration.
+   *
+   * @return std::span<const GradingResultType>
+   */
+  [[nodiscard]] std::span<const GradingResultType> levels() const noexcept {
+    return level_grades;
+  }
+  /**
+   * @brief Index in `levels()` of the grade of the cell at `position`.
+   *
+   * @param position Less than `size()`.
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t level_of(std::size_t position) const {
+    return std::size_t(
+        std::ranges::upper_bound(level_begins, position) -
+        level_begins.begin() - 1
+    );
+  }
+  /**
+   * @brief Positions `[first, last)` of the cells of the `level`-th grade.
+   *
+   * @param level Less than `levels().size()`.
+   * @return std::pair<std::size_t, std::size_t>
+   */
+  [[nodiscard]] std::pair<std::size_t, std::size_t>
+  level_range(std::size_t level) const {
+    return {level_begins[level], level_begins[level + 1]};
+  }
+  /**
+   * @brief Number of cells of grade at most the `level`-th grade; the cells
+   * at positions `[0, sublevel_size(level))` form the sublevel complex, whose
+   * boundary matrix is the leading square block of `matrix()`.
+   *
+   * @param level Less than `levels().size()`.
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t sublevel_size(std::size_t level) const {
+    return level_begins[level + 1];
+  }
+
+  /**
+   * @brief Boundary matrix of the cells of the `level`-th grade, restricted
+   * to faces of that grade, with rows and columns offset by the first
+   * position of the level.
+   *
+   * Equal to `CubicalComplex::boundary_matrix(grade)` for the filtration of
+   * all cells of a cubical complex, without another pass over the complex.
+   * The dimensions of its columns are
+   * `dimensions().subspan(first, last - first)` for the bounds of
+   * `level_range(level)`.
+   *
+   * @param level Less than `levels().size()`.
+   * @return MatrixType
+   */
+  [[nodiscard]] MatrixType level_matrix(std::size_t level) const {
+    const auto [first, last] = level_range(level);
+    MatrixType result(last - first);
+    std::vector<EntryType> entries;
+    for (std::size_t position = first; position < last; ++position) {
+      const std::span<const std::size_t> rows =
+          boundaries.column_rows(position);
+      const std::span<const RingType> values =
+          boundaries.column_values(position);
+      entries.clear();
+      for (std::size_t entry = graded_offset(position); entry < rows.size();
+           ++entry) {
+        entries.emplace_back(rows[entry] - first, values[entry]);
+      }
+      result.push_column(entries);
+    }
+    return result;
+  }
+
+  /**
+   * @brief The boundary of the cell at `position` among the cells of the
+   * filtration.
+   *
+   * @param position Less than `size()`.
+   * @return ChainType
+   */
+  [[nodiscard]] ChainType boundary(std::size_t position) const {
+    return chain_of(
+        boundaries.column_rows(position), boundaries.column_values(position)
+    );
+  }
+  /**
+   * @brief The boundary of the cell at `position` restricted to the faces
+   * with the same grade; equal to `graded_boundary` in the complex when every
+   * face is in the filtration.
+   *
+   * @param position Less than `size()`.
+   * @return ChainType
+   */
+  [[nodiscard]] ChainType graded_boundary(std::size_t position) const {
+    const std::size_t offset = graded_offset(position);
+    return chain_of(
+        boundaries.column_rows(position).subspan(offset),
+        boundaries.column_values(position).subspan(offset)
+    );
+  }
+};
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_COMPLEXES_FILTRATION_H
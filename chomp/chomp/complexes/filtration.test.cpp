@@ -0,0 +1,149 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/complexes/complexes.hpp>
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/dense.hpp>
+#include <chomp/complexes/filtration.hpp>
+#include <chomp/complexes/morse.hpp>
+#include <chomp/util/parallel.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+TEST_CASE("Filtration of a graded cubical complex", "[complexes]") {
+  using Grading = DenseGrading<2, 0, 4>;
+  using Complex = CubicalComplex<2, Grading, Z<3>>;
+
+  // Five grade levels scattered over the box
+  std::vector<int> voxels(36);
+  for (std::size_t voxel = 0; voxel < voxels.size(); ++voxel) {
+    voxels[voxel] = int((voxel * 7) % 5);
+  }
+  Complex complex(
+      CubeOrthant<2>{5, 5},
+      Grading({0, 0}, {5, 5}, voxels.cbegin(), voxels.cend())
+  );
+
+  SECTION("Orders cells by grade and dimension") {
+    const Filtration filtration(complex, complex.cells());
+    REQUIRE(filtration.size() == complex.cell_count());
+    REQUIRE(filtration.levels().size() == 5);
+
+    std::size_t level_begin = 0;
+    for (std::size_t level = 0; level < filtration.levels().size(); ++level) {
+      const auto [first, last] = filtration.level_range(level);
+      REQUIRE(first == level_begin);
+      REQUIRE(first < last);
+      REQUIRE(filtration.sublevel_size(level) == last);
+      for (std::size_t position = first; position < last; ++position) {
+        REQUIRE(filtration.grades()[position] == filtration.levels()[level]);
+        REQUIRE(filtration.level_of(position) == level);
+      }
+      level_begin = last;
+    }
+    REQUIRE(level_begin == filtration.size());
+
+    const auto grades = filtration.grades();
+    const auto dimensions = filtration.dimensions();
+    for (std::size_t position = 0; position < filtration.size(); ++position) {
+      const Cube<2>& cell = filtration.cell(position);
+      REQUIRE(filtration.position(cell) == position);
+      REQUIRE(grades[position] == complex.grade(cell));
+      REQUIRE(dimensions[position] == complex.dimension(cell));
+      if (position > 0 && grades[position - 1] == grades[position]) {
+        REQUIRE(dimensions[position - 1] <= dimensions[position]);
+      }
+    }
+  }
+
+  SECTION("Shares boundaries between grade levels") {
+    const Filtration filtration(complex, complex.cells());
+
+    // Same order and matrix as the cubical boundary matrix, in a single pass
+    const auto full = complex.boundary_matrix();
+    REQUIRE(filtration.matrix() == full.matrix);
+    for (std::size_t position = 0; position < filtration.size(); ++position) {
+      const Cube<2>& cell = filtration.cell(position);
+      REQUIRE(complex.index_of(cell) == full.cells[position]);
+      for (const std::size_t row : filtration.matrix().column_rows(position)) {
+        REQUIRE(row < position);
+      }
+      REQUIRE(filtration.boundary(position) == boundary(complex, cell));
+      REQUIRE(
+          filtration.graded_boundary(position) == graded_boundary(complex, cell)
+      );
+    }
+
+    for (std::size_t level = 0; level < filtration.levels().size(); ++level) {
+      const auto graded = complex.boundary_matrix(filtration.levels()[level]);
+      const auto [first, last] = filtration.level_range(level);
+      REQUIRE(filtration.level_matrix(level) == graded.matrix);
+      const auto dimensions =
+          filtration.dimensions().subspan(first, last - first);
+      REQUIRE(
+          std::vector<std::size_t>(dimensions.begin(), dimensions.end()) ==
+          graded.dimensions
+      );
+    }
+
+    // Faces outside the filtered cells are absent
+    const Filtration top(complex, complex.cells_of_dimension(2));
+    REQUIRE(top.size() == 36);
+    REQUIRE(top.matrix().nonzeros() == 0);
+    REQUIRE_FALSE(top.contains(Cube<2>({0, 0}, 0b00)));
+    REQUIRE(top.contains(Cube<2>({0, 0}, 0b11)));
+  }
+
+  SECTION("Filters a complex without cell indices") {
+    const auto cells = complex.cells();
+    MorseComplex morse(complex, MorseMatching(complex, cells));
+    const Filtration filtration(morse, morse.cells());
+    REQUIRE(filtration.size() == morse.cells().size());
+    for (std::size_t position = 0; position < filtration.size(); ++position) {
+      const Cube<2>& cell = filtration.cell(position);
+      REQUIRE(filtration.position(cell) == position);
+      REQUIRE(filtration.boundary(position) == boundary(morse, cell));
+      REQUIRE(
+          filtration.graded_boundary(position) == graded_boundary(morse, cell)
+      );
+    }
+    std::size_t critical = 0;
+    for (const Cube<2>& cell : cells) {
+      critical += filtration.contains(cell) ? 1 : 0;
+    }
+    REQUIRE(critical == filtration.size());
+  }
+
+  SECTION("Computes the same order in parallel") {
+    const Filtration sequential(complex, complex.cells());
+    const Filtration parallel(
+        complex, complex.cells(), ParallelPolicy{.threads = 3, .grain = 16}
+    );
+    REQUIRE(parallel.size() == sequential.size());
+    const auto parallel_cells = parallel.cells();
+    const auto sequential_cells = sequential.cells();
+    REQUIRE(
+        std::vector<Cube<2>>(parallel_cells.begin(), parallel_cells.end()) ==
+        std::vector<Cube<2>>(sequential_cells.begin(), sequential_cells.end())
+    );
+    for (std::size_t position = 0; position < parallel.size(); ++position) {
+      REQUIRE(parallel.grades()[position] == sequential.grades()[position]);
+    }
+    REQUIRE(parallel.matrix() == sequential.matrix());
+  }
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
@@ -15,12 +15,21 @@
 #include <chomp/util/cache.hpp>
 #include <chomp/util/concepts.hpp>
 #include <chomp/util/constants.hpp>
+#include <chomp/util/hash.hpp>
+#include <chomp/util/parallel.hpp>
+#include <chomp/util/scheduler.hpp>
+#include <chomp/util/statistics.hpp>
 
+#include <algorithm>
 #include <concepts>
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <memory>
+#include <span>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace chomp::core {
 
@@ -94,6 +103,135 @@ template <typename G>
 concept BoundedGrading =
     Grading<G> && LowerBoundedGrading<G> && UpperBoundedGrading<G>;
 
+/**
+ * @brief A grading function object whose grades can be changed after
+ * construction, one input at a time, with `g.update(input, grade)`.
+ *
+ * An update changes the grade of `input` only; keeping the grading consistent
+ * with the face poset is up to the caller.
+ *
+ * @tparam G Grading function object.
+ */
+template <typename G>
+concept MutableGrading =
+    Grading<G> && requires(
+                      G g, const typename G::InputType input,
+                      GradingResultType grade
+                  ) { g.update(input, grade); };
+
+/**
+ * @brief A grading function object that can also grade a batch of cells in a
+ * single call through a `grade_many` method.
+ *
+ * `g.grade_many(cells, grades)` must assign `grades[i] = g(cells[i])` for each
+ * `i`; `grades` is at least as long as `cells`. Batching amortizes the call
+ * and lookup overhead over many cells, e.g. all faces of a cell.
+ *
+ * @tparam G Grading function object.
+ */
+template <typename G>
+concept BatchGrading =
+    Grading<G> && requires(
+                      G g, std::span<const typename G::InputType> cells,
+                      std::span<GradingResultType> grades
+                  ) { g.grade_many(cells, grades); };
+
+/**
+ * @brief Grade each of `cells` with `grading`, storing the results in
+ * `grades`.
+ *
+ * Calls `grading.grade_many` if `G` models `BatchGrading`; otherwise grades
+ * the cells one at a time.
+ *
+ * @tparam G Function object type modeling `Grading`.
+ * @param grading
+ * @param cells
+ * @param grades Output; at least as long as `cells`.
+ */
+template <Grading G>
+inline void grade_many(
+    G& grading, std::span<const typename G::InputType> cells,
+    std::span<GradingResultType> grades
+) {
+  if constexpr (BatchGrading<G>) {
+    grading.grade_many(cells, grades);
+  } else {
+    for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+      grades[cell] = grading(cells[cell]);
+    }
+  }
+}
+
+/**
+ * @brief Grade each of `cells` with `grading` under `policy`, storing the
+ * results in `grades`.
+ *
+ * Under `ParallelPolicy`, the cells are graded by tasks of the scheduler of the
+ * policy, so `grading` must be safe to call concurrently, e.g. a
+ * `CachedGradingWrapper` over a `ShardedLRUCache`. If `grading` reports the
+ * cache shard of each cell through static `shard_index` and `shard_count`
+ * methods, the cells are grouped by shard and the cells of each shard are
+ * graded by one task submitted to the worker of that index, so that each shard
+ * stays local to one worker. Otherwise, contiguous ranges of cells are graded
+ * with `grade_many` as in `parallel_for`.
+ *
+ * @tparam G Function object type modeling `Grading`.
+ * @tparam P Execution policy type.
+ * @param grading
+ * @param cells
+ * @param grades Output; at least as long as `cells`.
+ * @param policy Execution policy.
+ */
+template <Grading G, ExecutionPolicy P>
+void grade_many(
+    G& grading, std::span<const typename G::InputType> cells,
+    std::span<GradingResultType> grades, const P& policy
+) {
+  if constexpr (std::same_as<P, SequencedPolicy>) {
+    grade_many(grading, cells, grades);
+  } else if constexpr (requires(const typename G::InputType& cell) {
+                         {
+                           G::shard_index(cell)
+                         } -> std::convertible_to<std::size_t>;
+                         {
+                           G::shard_count()
+                         } -> std::convertible_to<std::size_t>;
+                       }) {
+    if (policy.partitions(cells.size()) <= 1) {
+      grade_many(grading, cells, grades);
+      return;
+    }
+    std::vector<std::vector<std::size_t>> shard_cells(G::shard_count());
+    for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+      shard_cells[G::shard_index(cells[cell])].push_back(cell);
+    }
+    TaskGroup shards(policy.executor());
+    for (std::size_t shard = 0; shard < shard_cells.size(); ++shard) {
+      if (!shard_cells[shard].empty()) {
+        shards.run(
+            [&grading, &cells, &grades, &indices = shard_cells[shard]]() {
+              for (const std::size_t cell : indices) {
+                grades[cell] = grading(cells[cell]);
+              }
+            },
+            shard
+        );
+      }
+    }
+    shards.wait();
+  } else {
+    parallel_for(
+        policy, cells.size(),
+        [&grading, &cells, &grades](std::size_t first, std::size_t last) {
+          grade_many(
+              grading, cells.subspan(first, last - first),
+              grades.subspan(first, last - first)
+          );
+        }
+    );
+  }
+}
+
 /**
  * @brief A function object modeling `BoundedGrading` based on a map from the
  * input type `T` and the output type `GradingResultType`.
@@ -108,13 +246,20 @@ concept BoundedGrading =
  * `std::map` or `std::unordered_map`, but any associative container with
  * sufficiently similar interface can work. The default type is
  * `std::unordered_map` if `T` is hashable and `std::map` otherwise.
+ * @tparam Hash Hash function object type for `T`, substituted for that of
+ * `MapType` when it is a hashed map (see `RebindHash`); unused otherwise.
  */
 template <
     AssociativeKey T, GradingResultType MIN, GradingResultType MAX,
-    template <typename...> typename MapType = DefaultMap>
+    template <typename...> typename MapType = DefaultMap,
+    typename Hash = std::hash<T>>
 class MapGrading {
+public:
+  /** @brief The type of the underlying map of graded inputs. */
+  using GradingMapType = RebindHashType<MapType<T, GradingResultType>, Hash>;
+
 private:
-  MapType<T, GradingResultType> grading_map;
+  GradingMapType grading_map;
 
 public:
   /** @brief The type expected as input to the call operator. */
@@ -125,11 +270,23 @@ public:
   using Maximum = std::integral_constant<GradingResultType, MAX>;
 
   /** @brief Initialize the grading by explicitly providing the map. */
-  MapGrading(MapType<T, GradingResultType> grading_map) :
+  MapGrading(GradingMapType grading_map) :
       grading_map(grading_map) {}
   /** @brief Initialize the grading by providing an initializer list. */
   MapGrading(std::initializer_list<std::pair<T, GradingResultType>> grading_list
   ) : grading_map(grading_list) {}
+  /**
+   * @brief Initialize the grading by providing an initializer list, allocating
+   * the map with `allocator`, e.g. an `ArenaAllocator` of `ArenaDefaultMap`.
+   */
+  template <typename Allocator>
+  requires std::constructible_from<GradingMapType, const Allocator&>
+  MapGrading(
+      std::initializer_list<std::pair<T, GradingResultType>> grading_list,
+      const Allocator& allocator
+  ) : grading_map(allocator) {
+    grading_map.insert(grading_list.begin(), grading_list.end());
+  }
 
   /**
    * @brief Call the function object with `input` and return the grade.
@@ -141,10 +298,35 @@ public:
    * @return GradingResultType
    */
   GradingResultType operator()(const InputType& input) const {
-    typename MapType<T, GradingResultType>::const_iterator it =
-        grading_map.find(input);
+    typename GradingMapType::const_iterator it = grading_map.find(input);
     return it != grading_map.cend() ? it->second : MAX;
   }
+
+  /**
+   * @brief Set the grade of `input` to `grade`, clamped to `[MIN, MAX]`.
+   *
+   * Inputs graded `MAX` are removed from the map.
+   *
+   * @param input
+   * @param grade
+   */
+  void update(const InputType& input, GradingResultType grade) {
+    grade = std::clamp(grade, MIN, MAX);
+    if (grade == MAX) {
+      grading_map.erase(input);
+    } else {
+      grading_map[input] = grade;
+    }
+  }
+
+  /**
+   * @brief Get the underlying map of graded inputs.
+   *
+   * @return const GradingMapType&
+   */
+  [[nodiscard]] const GradingMapType& map() const noexcept {
+    return grading_map;
+  }
 };
 
 /**
@@ -162,13 +344,20 @@ public:
  * `std::set` or `std::unordered_set` but any set-like container with
  * sufficiently similar interface can work. The default type is
  * `std::unordered_set` if `T` is hashable and `std::set` otherwise.
+ * @tparam Hash Hash function object type for `T`, substituted for that of
+ * `SetType` when it is a hashed set (see `RebindHash`); unused otherwise.
  */
 template <
     AssociativeKey T, GradingResultType MIN, GradingResultType MAX,
-    template <typename...> typename SetType = DefaultSet>
+    template <typename...> typename SetType = DefaultSet,
+    typename Hash = std::hash<T>>
 class SetGrading {
+public:
+  /** @brief The type of the underlying set of inputs with grade `MIN`. */
+  using GradingSetType = RebindHashType<SetType<T>, Hash>;
+
 private:
-  SetType<T> grading_set;
+  GradingSetType grading_set;
 
 public:
   /** @brief The type expected as input to the call operator. */
@@ -179,10 +368,21 @@ public:
   using Maximum = std::integral_constant<GradingResultType, MAX>;
 
   /** @brief Initialize the grading by explicitly providing the set. */
-  SetGrading(SetType<T> grading_set) : grading_set(grading_set) {}
+  SetGrading(GradingSetType grading_set) : grading_set(grading_set) {}
   /** @brief Initialize the grading by providing an initializer list. */
   SetGrading(std::initializer_list<T> grading_list) :
       grading_set(grading_list) {}
+  /**
+   * @brief Initialize the grading by providing an initializer list, allocating
+   * the set with `allocator`, e.g. an `ArenaAllocator` of `ArenaDefaultSet`.
+   */
+  template <typename Allocator>
+  requires std::constructible_from<GradingSetType, const Allocator&>
+  SetGrading(
+      std::initializer_list<T> grading_list, const Allocator& allocator
+  ) : grading_set(allocator) {
+    grading_set.insert(grading_list.begin(), grading_list.end());
+  }
 
   /**
    * @brief Call the function object with `input` and return the grade.
@@ -196,28 +396,108 @@ public:
   GradingResultType operator()(const InputType& input) const {
     return grading_set.contains(input) ? MIN : MAX;
   }
+
+  /**
+   * @brief Set the grade of `input` to `MIN` if `grade` is at most `MIN`, and
+   * to `MAX` otherwise.
+   *
+   * @param input
+   * @param grade
+   */
+  void update(const InputType& input, GradingResultType grade) {
+    if (grade <= MIN) {
+      grading_set.insert(input);
+    } else {
+      grading_set.erase(input);
+    }
+  }
+
+  /**
+   * @brief Get the underlying set of inputs with grade `MIN`.
+   *
+   * @return const GradingSetType&
+   */
+  [[nodiscard]] const GradingSetType& set() const noexcept {
+    return grading_set;
+  }
+};
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+// Member types `Minimum` and `Maximum` of `G`, where present, for wrappers of
+// `G` to model the same bounded grading concepts
+template <Grading G>
+struct GradingBounds {};
+
+template <LowerBoundedGrading G>
+struct GradingBounds<G> {
+  using Minimum = typename G::Minimum;
 };
 
+template <UpperBoundedGrading G>
+struct GradingBounds<G> {
+  using Maximum = typename G::Maximum;
+};
+
+template <BoundedGrading G>
+struct GradingBounds<G> {
+  using Minimum = typename G::Minimum;
+  using Maximum = typename G::Maximum;
+};
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
 /**
  * @brief A wrapper for a grading function object that caches the results with
  * the `LRUCache` container.
  *
+ * The wrapper has the member types `Minimum` and `Maximum` of `G`, if any, so
+ * it models the same bounded grading concepts as `G`.
+ *
+ * Cached grades are not refreshed when the wrapped function changes. `update`
+ * changes a single grade of a `MutableGrading` and drops its cached value;
+ * after changing the wrapped function through `wrapped()` instead, drop the
+ * cached grades of the affected inputs with `invalidate` or `invalidate_if`,
+ * e.g. those in a `DirtyRegion`.
+ *
+ * With a `ShardedLRUCache`, the wrapped function is shared by all shards and
+ * called concurrently, so it must be safe to do so; it must not be changed
+ * while the wrapper is in use by other threads.
+ *
  * @tparam G Function object type modeling `Grading`.
  * @tparam MapType Type of map used for the `LRUCache`.
+ * @tparam CacheType The cache type, modeling `ValueCache`; `LRUCache` by
+ * default. Use `ClockCache` for compact storage or `ShardedLRUCache` to share
+ * one wrapper (and one cache) between threads.
  *
- * @sa `LRUCache`.
+ * @sa `LRUCache`, `ClockCache`, `ShardedLRUCache`.
  */
-template <Grading G, template <typename...> typename MapType = DefaultMap>
-class CachedGradingWrapper {
-private:
-  LRUCache<typename G::InputType, GradingResultType, MapType> cache;
-
+template <
+    Grading G, template <typename...> typename MapType = DefaultMap,
+    ValueCache<typename G::InputType, GradingResultType> CacheType =
+        LRUCache<typename G::InputType, GradingResultType, MapType>>
+class CachedGradingWrapper : public detail::GradingBounds<G> {
 public:
   /** @brief Wrapped function object type. */
   using FunctionType = G;
   /** @brief The type expected as input to the call operator. */
   using InputType = typename FunctionType::InputType;
 
+private:
+  // Held on the heap so that the cache may call it across moves of the wrapper
+  std::unique_ptr<G> function;
+  CacheType cache;
+
+  static std::function<GradingResultType(const InputType&)>
+  construct_grade(G* grading) {
+    return [grading](const InputType& input) {
+      return (*grading)(input);
+    };
+  }
+
+public:
   /**
    * @brief Initialize the wrapper with the function object to wrap and a
    * maximum number of elements to store in the cache.
@@ -226,48 +506,49 @@ public:
    * @param cache_max_size
    */
   CachedGradingWrapper(G wrapped_function, std::size_t cache_max_size) :
-      cache(wrapped_function, cache_max_size) {}
+      function(std::make_unique<G>(std::move(wrapped_function))),
+      cache(construct_grade(function.get()), cache_max_size) {}
 
   /**
-   * @brief Call the function object with `input` and return the grade.
+   * @brief Copy constructor; copies the wrapped function, with an empty cache
+   * of the same maximum size.
    *
-   * The result may be from the cache if present. Otherwise, it is added to the
-   * cache.
-   *
-   * @tparam InFor Forwarding type.
-   * @param input The input object to the grading call.
-   * @return GradingResultType The grade of `input`.
+   * @param other
    */
-  template <typename InFor>
-  requires std::same_as<std::remove_cvref_t<InFor>, InputType>
-  GradingResultType operator()(InFor&& input) {
-    return cache[std::forward<InFor>(input)];
-  }
-};
+  CachedGradingWrapper(const CachedGradingWrapper& other) :
+      function(std::make_unique<G>(*other.function)),
+      cache(construct_grade(function.get()), other.cache.max_size()) {}
 
-/** @brief Specialization for G modeling `LowerBoundedGrading`. */
-template <LowerBoundedGrading G, template <typename...> typename MapType>
-class CachedGradingWrapper<G, MapType> {
-private:
-  LRUCache<typename G::InputType, GradingResultType, MapType> cache;
+  /**
+   * @brief Move constructor.
+   *
+   * @param other
+   */
+  CachedGradingWrapper(CachedGradingWrapper&& other) noexcept = default;
 
-public:
-  /** @brief Wrapped function object type. */
-  using FunctionType = G;
-  /** @brief The type expected as input to the call operator. */
-  using InputType = typename FunctionType::InputType;
-  /** @brief The minimal value output by the wrapped function. */
-  using Minimum = typename FunctionType::Minimum;
+  /**
+   * @brief Copy assignment operator; see the copy constructor.
+   *
+   * @param other
+   * @return CachedGradingWrapper&
+   */
+  CachedGradingWrapper& operator=(const CachedGradingWrapper& other) {
+    if (this != &other) {
+      *this = CachedGradingWrapper(other);
+    }
+    return *this;
+  }
 
   /**
-   * @brief Initialize the wrapper with the function object to wrap and a
-   * maximum number of elements to store in the cache.
+   * @brief Move assignment operator.
    *
-   * @param wrapped_function
-   * @param cache_max_size
+   * @param other
+   * @return CachedGradingWrapper&
    */
-  CachedGradingWrapper(G wrapped_function, std::size_t cache_max_size) :
-      cache(wrapped_function, cache_max_size) {}
+  CachedGradingWrapper& operator=(CachedGradingWrapper&& other) noexcept =
+      default;
+
+  ~CachedGradingWrapper() = default;
 
   /**
    * @brief Call the function object with `input` and return the grade.
@@ -284,89 +565,126 @@ public:
   GradingResultType operator()(InFor&& input) {
     return cache[std::forward<InFor>(input)];
   }
-};
-
-/** @brief Specialization for G modeling `UpperBoundedGrading`. */
-template <UpperBoundedGrading G, template <typename...> typename MapType>
-class CachedGradingWrapper<G, MapType> {
-private:
-  LRUCache<typename G::InputType, GradingResultType, MapType> cache;
-
-public:
-  /** @brief Wrapped function object type. */
-  using FunctionType = G;
-  /** @brief The type expected as input to the call operator. */
-  using InputType = typename FunctionType::InputType;
-  /** @brief The maximal value output by the wrapped function. */
-  using Maximum = typename FunctionType::Maximum;
 
   /**
-   * @brief Initialize the wrapper with the function object to wrap and a
-   * maximum number of elements to store in the cache.
+   * @brief Grade each of `cells` through the cache, storing the results in
+   * `grades`.
    *
-   * @param wrapped_function
-   * @param cache_max_size
+   * @param cells
+   * @param grades Output; at least as long as `cells`.
    */
-  CachedGradingWrapper(G wrapped_function, std::size_t cache_max_size) :
-      cache(wrapped_function, cache_max_size) {}
+  void grade_many(
+      std::span<const InputType> cells, std::span<GradingResultType> grades
+  ) {
+    for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+      grades[cell] = cache[cells[cell]];
+    }
+  }
 
   /**
-   * @brief Call the function object with `input` and return the grade.
+   * @brief The wrapped function object.
    *
-   * The result may be from the cache if present. Otherwise, it is added to the
-   * cache.
+   * @return const G&
+   */
+  [[nodiscard]] const G& wrapped() const noexcept {
+    return *function;
+  }
+  /**
+   * @brief The wrapped function object, for changing it in place; invalidate
+   * the cached grades of the affected inputs afterwards.
    *
-   * @tparam InFor Forwarding type.
-   * @param input The input object to the grading call.
-   * @return GradingResultType The grade of `input`.
+   * @return G&
    */
-  template <typename InFor>
-  requires std::same_as<std::remove_cvref_t<InFor>, InputType>
-  GradingResultType operator()(InFor&& input) {
-    return cache[std::forward<InFor>(input)];
+  [[nodiscard]] G& wrapped() noexcept {
+    return *function;
   }
-};
 
-/** @brief Specialization for G modeling `BoundedGrading`. */
-template <BoundedGrading G, template <typename...> typename MapType>
-class CachedGradingWrapper<G, MapType> {
-private:
-  LRUCache<typename G::InputType, GradingResultType, MapType> cache;
+  /**
+   * @brief Set the grade of `input` in the wrapped function, dropping its
+   * cached grade.
+   *
+   * @param input
+   * @param grade
+   */
+  void update(const InputType& input, GradingResultType grade)
+  requires MutableGrading<G> && requires(CacheType& c) { c.erase(input); }
+  {
+    function->update(input, grade);
+    cache.erase(input);
+  }
 
-public:
-  /** @brief Wrapped function object type. */
-  using FunctionType = G;
-  /** @brief The type expected as input to the call operator. */
-  using InputType = typename FunctionType::InputType;
-  /** @brief The minimal value output by the wrapped function. */
-  using Minimum = typename FunctionType::Minimum;
-  /** @brief The maximal value output by the wrapped function. */
-  using Maximum = typename FunctionType::Maximum;
+  /**
+   * @brief Drop the cached grade of `input`, if any.
+   *
+   * @param input
+   * @return true If a cached grade was dropped.
+   * @return false
+   */
+  bool invalidate(const InputType& input)
+  requires requires(CacheType& c) { c.erase(input); }
+  {
+    return cache.erase(input);
+  }
 
   /**
-   * @brief Initialize the wrapper with the function object to wrap and a
-   * maximum number of elements to store in the cache.
+   * @brief Drop the cached grades of the inputs satisfying `pred`.
    *
-   * @param wrapped_function
-   * @param cache_max_size
+   * @tparam Pred Predicate type on (constant references to) inputs.
+   * @param pred
+   * @return std::size_t Number of cached grades dropped.
    */
-  CachedGradingWrapper(G wrapped_function, std::size_t cache_max_size) :
-      cache(wrapped_function, cache_max_size) {}
+  template <typename Pred>
+  requires std::predicate<const Pred&, const InputType&> &&
+           requires(CacheType& c, const Pred& pred) { c.erase_if(pred); }
+  std::size_t invalidate_if(const Pred& pred) {
+    return cache.erase_if(pred);
+  }
+
+  /** @brief Drop every cached grade. */
+  void invalidate_all()
+  requires requires(CacheType& c) { c.clear(); }
+  {
+    cache.clear();
+  }
 
   /**
-   * @brief Call the function object with `input` and return the grade.
+   * @brief Index of the cache shard holding the grade of `input`, if the cache
+   * is sharded.
    *
-   * The result may be from the cache if present. Otherwise, it is added to the
-   * cache.
+   * @param input
+   * @return std::size_t Less than `shard_count()`.
+   */
+  [[nodiscard]] static std::size_t shard_index(const InputType& input)
+  requires requires { CacheType::shard_index(input); }
+  {
+    return CacheType::shard_index(input);
+  }
+  /**
+   * @brief Number of shards of the cache, if the cache is sharded.
    *
-   * @tparam InFor Forwarding type.
-   * @param input The input object to the grading call.
-   * @return GradingResultType The grade of `input`.
+   * @return std::size_t
    */
-  template <typename InFor>
-  requires std::same_as<std::remove_cvref_t<InFor>, InputType>
-  GradingResultType operator()(InFor&& input) {
-    return cache[std::forward<InFor>(input)];
+  [[nodiscard]] static constexpr std::size_t shard_count()
+  requires requires { CacheType::shard_count(); }
+  {
+    return CacheType::shard_count();
+  }
+
+  /**
+   * @brief Statistics counters of the cache.
+   *
+   * @return CacheStatistics
+   */
+  [[nodiscard]] CacheStatistics statistics() const
+  requires requires(const CacheType& c) { c.statistics(); }
+  {
+    return cache.statistics();
+  }
+  /** @brief Reset the statistics counters of the cache. */
+  void reset_statistics()
+  requires requires(CacheType& c) { c.reset_statistics(); }
+  {
+    cache.reset_statistics();
   }
 };
 
@@ -5,14 +5,24 @@
  */
 
 #include <chomp/complexes/grading.hpp>
+#include <chomp/util/cache.hpp>
+#include <chomp/util/concepts.hpp>
 #include <chomp/util/constants.hpp>
+#include <chomp/util/hash.hpp>
+#include <chomp/util/parallel.hpp>
+#include <chomp/util/scheduler.hpp>
 
 #include <catch2/catch_test_macros.hpp>
 
 #include <cstddef>
 #include <initializer_list>
+#include <map>
+#include <span>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #ifndef CHOMP_DOXYGEN
 
@@ -123,6 +133,75 @@ TEST_CASE(
   CHECK_FALSE(BoundedGrading<CachedGradingWrapper<LBGradingTest>>);
   CHECK_FALSE(BoundedGrading<CachedGradingWrapper<UBGradingTest>>);
   CHECK(BoundedGrading<CachedGradingWrapper<BGradingTest>>);
+
+  using ShardedCache = ShardedLRUCache<std::size_t, GradingResultType>;
+  using ShardedWrapper =
+      CachedGradingWrapper<BGradingTest, DefaultMap, ShardedCache>;
+  CHECK(BoundedGrading<ShardedWrapper>);
+  CHECK_FALSE(BoundedGrading<
+              CachedGradingWrapper<LBGradingTest, DefaultMap, ShardedCache>>);
+
+  ShardedWrapper sharded(BGradingTest(), 8);
+  BGradingTest unwrapped;
+  for (std::size_t input = 0; input < 32; ++input) {
+    REQUIRE(sharded(input) == unwrapped(input));
+  }
+}
+
+TEST_CASE("grade_many grades batches with or without support", "[complexes]") {
+  CHECK_FALSE(BatchGrading<GradingTest>);
+  CHECK(BatchGrading<CachedGradingWrapper<GradingTest>>);
+
+  const std::vector<std::size_t> inputs = {0, 11, 31, 5, 40};
+  std::vector<GradingResultType> grades(inputs.size());
+  GradingTest grading;
+  grade_many(grading, std::span<const std::size_t>(inputs), grades);
+  REQUIRE(grades == std::vector<GradingResultType>{12, 2, 4, 12, 4});
+
+  CachedGradingWrapper cached(GradingTest(), 2);
+  std::vector<GradingResultType> cached_grades(inputs.size());
+  grade_many(cached, std::span<const std::size_t>(inputs), cached_grades);
+  REQUIRE(cached_grades == grades);
+}
+
+TEST_CASE("grade_many grades in parallel by cache shard", "[complexes]") {
+  using ShardedCache = ShardedLRUCache<std::size_t, GradingResultType>;
+  using ShardedWrapper =
+      CachedGradingWrapper<GradingTest, DefaultMap, ShardedCache>;
+  REQUIRE(ShardedWrapper::shard_count() == ShardedCache::shard_count());
+  REQUIRE(ShardedWrapper::shard_index(7) == ShardedCache::shard_index(7));
+
+  std::vector<std::size_t> inputs(500);
+  for (std::size_t input = 0; input < inputs.size(); ++input) {
+    inputs[input] = (input * 7) % 64;
+  }
+  std::vector<GradingResultType> expected(inputs.size());
+  GradingTest grading;
+  grade_many(grading, std::span<const std::size_t>(inputs), expected);
+
+  WorkStealingScheduler scheduler(SchedulerOptions{.workers = 3});
+  const ParallelPolicy policy{
+      .threads = 4, .grain = 16, .scheduler = &scheduler
+  };
+
+  ShardedWrapper sharded(GradingTest(), 32);
+  std::vector<GradingResultType> sharded_grades(inputs.size());
+  grade_many(
+      sharded, std::span<const std::size_t>(inputs), sharded_grades, policy
+  );
+  REQUIRE(sharded_grades == expected);
+
+  std::vector<GradingResultType> ranged_grades(inputs.size());
+  grade_many(
+      grading, std::span<const std::size_t>(inputs), ranged_grades, policy
+  );
+  REQUIRE(ranged_grades == expected);
+
+  std::vector<GradingResultType> sequenced_grades(inputs.size());
+  grade_many(
+      grading, std::span<const std::size_t>(inputs), sequenced_grades, seq
+  );
+  REQUIRE(sequenced_grades == expected);
 }
 
 TEST_CASE("SetGrading functions correctly", "[complexes]") {
@@ -166,6 +245,111 @@ TEST_CASE("MapGrading functions correctly", "[complexes]") {
   CHECK(grade_func(-3) == MAX);
 }
 
+TEST_CASE("Mutable gradings update single grades", "[complexes]") {
+  CHECK(MutableGrading<MapGrading<int, 4, 10>>);
+  CHECK(MutableGrading<SetGrading<int, 4, 10>>);
+  CHECK_FALSE(MutableGrading<GradingTest>);
+
+  MapGrading<int, 4, 10> map_grading(
+      DefaultMap<int, GradingResultType>{{0, 4}, {1, 5}}
+  );
+  map_grading.update(1, 7);
+  map_grading.update(2, 0);
+  map_grading.update(0, 12);
+  REQUIRE(map_grading(1) == 7);
+  REQUIRE(map_grading(2) == 4);
+  REQUIRE(map_grading(0) == 10);
+  REQUIRE_FALSE(map_grading.map().contains(0));
+
+  SetGrading<int, 4, 10> set_grading({0, 1});
+  set_grading.update(0, 10);
+  set_grading.update(3, 4);
+  REQUIRE(set_grading(0) == 10);
+  REQUIRE(set_grading(1) == 4);
+  REQUIRE(set_grading(3) == 4);
+}
+
+TEST_CASE("Map and set gradings take a hasher", "[complexes]") {
+  using Hash = MixedHash<int>;
+  using Map = MapGrading<int, 4, 10, DefaultMap, Hash>;
+  STATIC_REQUIRE(std::is_same_v<
+                 Map::GradingMapType,
+                 std::unordered_map<int, GradingResultType, Hash>>);
+  Map map_grading(Map::GradingMapType{{0, 4}, {1, 5}});
+  map_grading.update(2, 6);
+  REQUIRE(map_grading(1) == 5);
+  REQUIRE(map_grading(2) == 6);
+  REQUIRE(map_grading(3) == 10);
+
+  using Set = SetGrading<int, 4, 10, DefaultSet, Hash>;
+  STATIC_REQUIRE(
+      std::is_same_v<Set::GradingSetType, std::unordered_set<int, Hash>>
+  );
+  const Set set_grading({0, 1});
+  REQUIRE(set_grading(1) == 4);
+  REQUIRE(set_grading(2) == 10);
+
+  // Ordered containers do not hash
+  STATIC_REQUIRE(std::is_same_v<
+                 MapGrading<int, 4, 10, std::map, Hash>::GradingMapType,
+                 std::map<int, GradingResultType>>);
+}
+
+TEST_CASE("CachedGradingWrapper invalidates updated grades", "[complexes]") {
+  using Wrapper = CachedGradingWrapper<MapGrading<int, 4, 10>>;
+  CHECK(MutableGrading<Wrapper>);
+  CHECK(BoundedGrading<Wrapper>);
+
+  Wrapper cached(
+      MapGrading<int, 4, 10>(
+          DefaultMap<int, GradingResultType>{{0, 4}, {1, 5}, {2, 6}}
+      ),
+      8
+  );
+  REQUIRE(cached(1) == 5);
+  REQUIRE(cached(2) == 6);
+
+  cached.update(1, 8);
+  REQUIRE(cached(1) == 8);
+  REQUIRE(cached.wrapped()(1) == 8);
+
+  // Changes through `wrapped` are stale until invalidated
+  cached.wrapped().update(2, 9);
+  REQUIRE(cached(2) == 6);
+  REQUIRE(cached.invalidate(2));
+  REQUIRE(cached(2) == 9);
+
+  REQUIRE(cached(0) == 4);
+  cached.wrapped().update(0, 7);
+  cached.wrapped().update(1, 7);
+  REQUIRE(cached(0) == 4);
+  REQUIRE(cached.invalidate_if([](const int& input) { return input < 1; }) ==
+          1);
+  REQUIRE(cached(0) == 7);
+  REQUIRE(cached(1) == 8);
+  cached.invalidate_all();
+  REQUIRE(cached(1) == 7);
+
+  // Copies own their wrapped function
+  Wrapper copy(cached);
+  copy.update(1, 5);
+  REQUIRE(copy(1) == 5);
+  REQUIRE(cached(1) == 7);
+  Wrapper moved(std::move(copy));
+  REQUIRE(moved(1) == 5);
+  REQUIRE(moved(3) == 10);
+
+  using ShardedWrapper = CachedGradingWrapper<
+      MapGrading<int, 4, 10>, DefaultMap,
+      ShardedLRUCache<int, GradingResultType>>;
+  ShardedWrapper sharded(
+      MapGrading<int, 4, 10>(DefaultMap<int, GradingResultType>{{0, 4}}), 32
+  );
+  REQUIRE(sharded(0) == 4);
+  sharded.update(0, 6);
+  REQUIRE(sharded(0) == 6);
+}
+
 }  // namespace chomp::core
 
 #endif  // CHOMP_DOXYGEN
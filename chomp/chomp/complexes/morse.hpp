@@ -0,0 +1,655 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains the discrete Morse theoretic reduction of chain
+ * complexes: the `MorseMatching` computed by coreduction, and the
+ * `MorseComplex` on its critical cells.
+ */
+
+#ifndef CHOMP_COMPLEXES_MORSE_H
+#define CHOMP_COMPLEXES_MORSE_H
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/algebra/modules.hpp>
+#include <chomp/complexes/complexes.hpp>
+#include <chomp/complexes/grading.hpp>
+#include <chomp/util/concepts.hpp>
+#include <chomp/util/constants.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <ranges>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+/**
+ * @brief Requirements on a chain complex class whose cells have a dimension,
+ * as needed for discrete Morse theoretic reduction.
+ *
+ * @tparam CC
+ */
+template <typename CC>
+concept DimensionedChainComplex = requires(
+    const CC complex, const typename CC::CellType cell
+) {
+  requires ChainComplex<CC>;
+  { complex.dimension(cell) } -> std::convertible_to<std::size_t>;
+};
+
+/**
+ * @brief Classification of cells by an acyclic partial matching.
+ *
+ * Matched pairs consist of a queen and a king, where the queen is a face of
+ * the king. Unmatched cells are aces, i.e. critical cells.
+ */
+enum class MorseType { Ace, King, Queen };
+
+/**
+ * @brief An acyclic partial matching on the cells of a chain complex, computed
+ * by the coreduction algorithm.
+ *
+ * The matching respects the grading of the complex: only cells of the same
+ * grade are matched, so that the resulting `MorseComplex` is graded as well.
+ * Cells are processed in increasing order of (grade, dimension). A cell with
+ * no remaining faces of its grade is chosen as an ace whenever no coreduction
+ * pair is available; a cell with exactly one remaining face of its grade,
+ * with invertible (unit) coefficient, is matched as king with that face as
+ * queen.
+ *
+ * Each ace and matched pair is stamped with its removal time. Every face of a
+ * king other than its queen is removed strictly earlier than the pair, which
+ * is what makes the matching acyclic and the Morse boundary computable.
+ *
+ * Implementation follows "Discrete Morse theoretic algorithms for computing
+ * homology of complexes and maps" Harker et al.
+ *
+ * @tparam CC Chain complex type modeling `DimensionedChainComplex`.
+ *
+ * @sa `MorseComplex`
+ */
+template <DimensionedChainComplex CC>
+class MorseMatching {
+public:
+  /** @brief Cell type of the matched complex. */
+  using CellType = typename CC::CellType;
+  /** @brief Coefficient ring type of the matched complex. */
+  using RingType = typename CC::RingType;
+
+private:
+  struct CellRecord {
+    GradingResultType grade;
+    std::size_t dimension;
+    MorseType type = MorseType::Ace;
+    bool removed = false;
+    std::size_t time = 0;
+    // Index into `partners`, valid for kings and queens.
+    std::size_t partner = 0;
+    // Coefficient of the queen in the boundary of its king.
+    RingType incidence = zero<RingType>();
+  };
+
+  DefaultMap<CellType, CellRecord> records;
+  std::vector<CellType> partners;
+  std::vector<CellType> critical_cells;
+  // Removal times in use are [0, removal_count).
+  std::size_t removal_count = 0;
+
+  [[nodiscard]] static bool is_unit(const RingType& coef) {
+    return coef == one<RingType>() || coef == -one<RingType>();
+  }
+
+  [[nodiscard]] CellRecord* remaining(const CellType& cell) {
+    auto it = records.find(cell);
+    return it == records.end() || it->second.removed ? nullptr : &it->second;
+  }
+
+  // Stream the (co)faces of `cell` that may share its grade: exactly those if
+  // the complex provides them, e.g. from `CachedChainComplex`, else all. Faces
+  // of another grade are skipped by the callers either way.
+  template <bool COBOUNDARY, typename V>
+  static void
+  for_each_candidate(CC& complex, const CellType& cell, V&& visitor) {
+    if constexpr (COBOUNDARY) {
+      if constexpr (requires {
+                      complex.for_each_graded_coboundary(cell, visitor);
+                    }) {
+        complex.for_each_graded_coboundary(cell, visitor);
+      } else {
+        for_each_coboundary(complex, cell, visitor);
+      }
+    } else {
+      if constexpr (requires {
+                      complex.for_each_graded_boundary(cell, visitor);
+                    }) {
+        complex.for_each_graded_boundary(cell, visitor);
+      } else {
+        for_each_boundary(complex, cell, visitor);
+      }
+    }
+  }
+
+  void enqueue_cofaces(
+      CC& complex, const CellType& cell, GradingResultType grade,
+      std::queue<CellType>& queue
+  ) {
+    for_each_candidate<true>(
+        complex, cell,
+        [this, grade, &queue](const CellType& coface, const RingType&) {
+          const CellRecord* record = remaining(coface);
+          if (record != nullptr && record->grade == grade) {
+            queue.push(coface);
+          }
+        }
+    );
+  }
+
+public:
+  /** @brief Initialize an empty matching, e.g. to `merge` others into. */
+  MorseMatching() = default;
+
+  /**
+   * @brief Compute the coreduction matching on `cells` in `complex`.
+   *
+   * The range should contain every cell of the (sub)complex to reduce, each
+   * once; faces outside the range are treated as absent.
+   *
+   * @tparam Cells Input range type of cells.
+   * @param complex
+   * @param cells
+   */
+  template <std::ranges::input_range Cells>
+  requires std::convertible_to<std::ranges::range_value_t<Cells>, CellType>
+  MorseMatching(CC& complex, Cells&& cells) {
+    // Sort cells by grade, then dimension, to select aces in order
+    std::vector<std::tuple<GradingResultType, std::size_t, CellType>> order;
+    for (const CellType& cell : cells) {
+      const GradingResultType cell_grade = complex.grade(cell);
+      const std::size_t cell_dimension = complex.dimension(cell);
+      order.emplace_back(cell_grade, cell_dimension, cell);
+      records.insert(
+          std::make_pair(cell, CellRecord{cell_grade, cell_dimension})
+      );
+    }
+    std::ranges::stable_sort(order, [](const auto& lhs, const auto& rhs) {
+      return std::tie(std::get<0>(lhs), std::get<1>(lhs)) <
+             std::tie(std::get<0>(rhs), std::get<1>(rhs));
+    });
+
+    std::size_t time = 0;
+    std::queue<CellType> queue;
+    auto next_ace = order.cbegin();
+    while (true) {
+      if (queue.empty()) {
+        while (next_ace != order.cend() &&
+               remaining(std::get<2>(*next_ace)) == nullptr) {
+          ++next_ace;
+        }
+        if (next_ace == order.cend()) {
+          break;
+        }
+        const CellType& ace = std::get<2>(*next_ace);
+        CellRecord& record = *remaining(ace);
+        record.removed = true;
+        record.time = time++;
+        critical_cells.push_back(ace);
+        enqueue_cofaces(complex, ace, record.grade, queue);
+        continue;
+      }
+
+      const CellType king = std::move(queue.front());
+      queue.pop();
+      CellRecord* king_record = remaining(king);
+      if (king_record == nullptr) {
+        continue;
+      }
+
+      // Find the remaining faces of the same grade, stopping past one
+      const GradingResultType grade = king_record->grade;
+      std::size_t face_count = 0;
+      std::optional<std::pair<CellType, RingType>> queen;
+      for_each_candidate<false>(
+          complex, king,
+          [&](const CellType& face, const RingType& coef) {
+            const CellRecord* record = remaining(face);
+            if (record == nullptr || record->grade != grade) {
+              return true;
+            }
+            queen.emplace(face, coef);
+            return ++face_count < 2;
+          }
+      );
+
+      if (face_count == 0) {
+        // Possibly freed later; otherwise chosen as an ace
+        enqueue_cofaces(complex, king, grade, queue);
+        continue;
+      }
+      if (face_count > 1 || !is_unit(queen->second)) {
+        continue;
+      }
+
+      CellRecord& queen_record = *remaining(queen->first);
+      queen_record.removed = true;
+      queen_record.type = MorseType::Queen;
+      queen_record.time = time;
+      queen_record.partner = partners.size();
+      queen_record.incidence = queen->second;
+      partners.push_back(king);
+
+      king_record->removed = true;
+      king_record->type = MorseType::King;
+      king_record->time = time++;
+      king_record->partner = partners.size();
+      partners.push_back(queen->first);
+
+      enqueue_cofaces(complex, queen->first, grade, queue);
+      enqueue_cofaces(complex, king, grade, queue);
+    }
+    removal_count = time;
+  }
+
+  /**
+   * @brief Merge the matching `other`, on cells disjoint from those of this
+   * matching, as if its cells were removed after all cells of this matching.
+   *
+   * The union is again an acyclic matching whose removal times are valid for
+   * `MorseComplex` provided no cell of this matching has a face among the
+   * cells of `other`; e.g. `other` matches the cells on the interface between
+   * subcomplexes matched independently and merged into this matching.
+   *
+   * @param other Matching on cells disjoint from those of this matching.
+   *
+   * @sa `tiled_morse_matching`
+   */
+  void merge(MorseMatching&& other) {
+    const std::size_t partner_offset = partners.size();
+    for (auto& [cell, record] : other.records) {
+      record.time += removal_count;
+      if (record.type != MorseType::Ace) {
+        record.partner += partner_offset;
+      }
+      records.insert(std::make_pair(cell, std::move(record)));
+    }
+    partners.insert(
+        partners.end(), std::make_move_iterator(other.partners.begin()),
+        std::make_move_iterator(other.partners.end())
+    );
+    critical_cells.insert(
+        critical_cells.end(),
+        std::make_move_iterator(other.critical_cells.begin()),
+        std::make_move_iterator(other.critical_cells.end())
+    );
+    removal_count += other.removal_count;
+    other = MorseMatching();
+  }
+
+  /**
+   * @brief Whether `cell` was among the matched cells.
+   *
+   * @param cell
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool contains(const CellType& cell) const {
+    return records.contains(cell);
+  }
+
+  /**
+   * @brief Classification of `cell` by the matching.
+   *
+   * @param cell Must be contained in the matching.
+   * @return MorseType
+   */
+  [[nodiscard]] MorseType type(const CellType& cell) const {
+    return records.find(cell)->second.type;
+  }
+
+  /**
+   * @brief The cell matched with `cell`: its king if `cell` is a queen, and
+   * its queen if `cell` is a king.
+   *
+   * @param cell Must be a king or queen in the matching.
+   * @return const CellType&
+   */
+  [[nodiscard]] const CellType& partner(const CellType& cell) const {
+    return partners[records.find(cell)->second.partner];
+  }
+
+  /**
+   * @brief Coefficient of the queen `cell` in the boundary of its king; this
+   * is always a unit, `1` or `-1`.
+   *
+   * @param cell Must be a queen in the matching.
+   * @return const RingType&
+   */
+  [[nodiscard]] const RingType& incidence(const CellType& cell) const {
+    return records.find(cell)->second.incidence;
+  }
+
+  /**
+   * @brief Removal time of `cell` during coreduction; matched cells share
+   * their time.
+   *
+   * @param cell Must be contained in the matching.
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t time(const CellType& cell) const {
+    return records.find(cell)->second.time;
+  }
+
+  /**
+   * @brief Grade of `cell` in the matched complex.
+   *
+   * @param cell Must be contained in the matching.
+   * @return GradingResultType
+   */
+  [[nodiscard]] GradingResultType grade(const CellType& cell) const {
+    return records.find(cell)->second.grade;
+  }
+
+  /**
+   * @brief Dimension of `cell` in the matched complex.
+   *
+   * @param cell Must be contained in the matching.
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t dimension(const CellType& cell) const {
+    return records.find(cell)->second.dimension;
+  }
+
+  /**
+   * @brief The aces (critical cells) in order of removal.
+   *
+   * @return const std::vector<CellType>&
+   */
+  [[nodiscard]] const std::vector<CellType>& aces() const noexcept {
+    return critical_cells;
+  }
+};
+
+/**
+ * @brief The Morse complex of a chain complex with respect to an acyclic
+ * partial matching, on the critical cells of the matching.
+ *
+ * This models `DimensionedChainComplex`, so that it can be reduced further.
+ * Its chain homology is that of the original complex. The grading of each
+ * critical cell is its grade in the original complex, and the Morse boundary
+ * of a critical cell only contains critical cells of lower or equal grade.
+ *
+ * The Morse boundary of an ace is computed from its boundary by repeatedly
+ * eliminating the queen of latest removal time, replacing it through the
+ * boundary of its king, and finally projecting onto the aces. The coboundary
+ * operator is the transpose of the boundary operator.
+ *
+ * @tparam CC Chain complex type modeling `DimensionedChainComplex`.
+ *
+ * @sa `MorseMatching`
+ */
+template <DimensionedChainComplex CC>
+class MorseComplex {
+public:
+  /** @brief Coefficient ring type for chains. */
+  using RingType = typename CC::RingType;
+  /** @brief Cell type; critical cells of the original complex. */
+  using CellType = typename CC::CellType;
+  /** @brief Chain (module) type. */
+  using ChainType = DefaultModule<CellType, RingType>;
+  /** @brief Grading function object type; grades of the critical cells. */
+  using GradingType = MapGrading<
+      CellType, 0, std::numeric_limits<GradingResultType>::max()>;
+
+private:
+  struct AceRecord {
+    std::size_t dimension;
+    ChainType boundary;
+    ChainType coboundary;
+  };
+
+  std::vector<CellType> critical_cells;
+  DefaultMap<CellType, AceRecord> aces;
+  GradingType grading_function;
+
+  [[nodiscard]] static GradingType
+  ace_grading(const MorseMatching<CC>& matching) {
+    DefaultMap<CellType, GradingResultType> grades;
+    for (const CellType& ace : matching.aces()) {
+      grades.insert(std::make_pair(ace, matching.grade(ace)));
+    }
+    return GradingType(std::move(grades));
+  }
+
+  [[nodiscard]] static ChainType morse_boundary(
+      CC& complex, const MorseMatching<CC>& matching, const CellType& ace
+  ) {
+    ChainType chain;
+    // Queens present in `chain`, latest removal time first; entries may be
+    // stale if the coefficient has since cancelled.
+    using QueenEntry = std::pair<std::size_t, CellType>;
+    const auto earlier = [](const QueenEntry& lhs, const QueenEntry& rhs) {
+      return lhs.first < rhs.first;
+    };
+    std::priority_queue<QueenEntry, std::vector<QueenEntry>, decltype(earlier)>
+        queens(earlier);
+    const auto add_faces = [&](const CellType& cell, const RingType& scale) {
+      for_each_boundary(
+          complex, cell,
+          [&](const CellType& face, const RingType& coef) {
+            if (!matching.contains(face)) {
+              return;
+            }
+            chain.insert(face, scale * coef);
+            if (matching.type(face) == MorseType::Queen) {
+              queens.emplace(matching.time(face), face);
+            }
+          }
+      );
+    };
+
+    add_faces(ace, one<RingType>());
+    while (!queens.empty()) {
+      const CellType queen = queens.top().second;
+      queens.pop();
+      const RingType coef = chain[queen];
+      if (coef == zero<RingType>()) {
+        continue;
+      }
+      // The incidence of the queen in its king is a unit, 1 or -1, hence its
+      // own inverse.
+      add_faces(matching.partner(queen), -(coef * matching.incidence(queen)));
+    }
+
+    ChainType result;
+    for (const CellType& cell : chain) {
+      if (matching.type(cell) == MorseType::Ace) {
+        result.insert(cell, chain[cell]);
+      }
+    }
+    return result;
+  }
+
+public:
+  /**
+   * @brief Initialize the Morse complex of `complex` with respect to
+   * `matching`.
+   *
+   * @param complex
+   * @param matching Acyclic partial matching on the cells of `complex`.
+   */
+  MorseComplex(CC& complex, const MorseMatching<CC>& matching) :
+      critical_cells(matching.aces()), grading_function(ace_grading(matching)) {
+    for (const CellType& ace : critical_cells) {
+      aces.insert(std::make_pair(
+          ace, AceRecord{matching.dimension(ace), ChainType(), ChainType()}
+      ));
+    }
+    for (const CellType& ace : critical_cells) {
+      ChainType ace_boundary = morse_boundary(complex, matching, ace);
+      for (const CellType& face : ace_boundary) {
+        aces.find(face)->second.coboundary.insert(ace, ace_boundary[face]);
+      }
+      aces.find(ace)->second.boundary = std::move(ace_boundary);
+    }
+  }
+
+  /**
+   * @brief Initialize the Morse complex of `complex` with respect to the
+   * coreduction matching on `cells`.
+   *
+   * @tparam Cells Input range type of cells.
+   * @param complex
+   * @param cells Every cell of the (sub)complex to reduce, each once.
+   *
+   * @sa `MorseMatching`
+   */
+  template <std::ranges::input_range Cells>
+  requires std::convertible_to<std::ranges::range_value_t<Cells>, CellType>
+  MorseComplex(CC& complex, Cells&& cells) :
+      MorseComplex(
+          complex, MorseMatching<CC>(complex, std::forward<Cells>(cells))
+      ) {}
+
+  /**
+   * @brief Restore a Morse complex from its critical cells and their
+   * dimensions, grades, and Morse boundaries, e.g. as read back by
+   * `read_morse_complex`.
+   *
+   * The coboundaries are recomputed as the transpose of `boundaries`. All
+   * four vectors must have the same length.
+   *
+   * @param cells The critical cells, in order of removal.
+   * @param dimensions Dimension of each critical cell.
+   * @param grades Grade of each critical cell.
+   * @param boundaries Morse boundary of each critical cell; supported on
+   * `cells`.
+   */
+  MorseComplex(
+      std::vector<CellType> cells, const std::vector<std::size_t>& dimensions,
+      const std::vector<GradingResultType>& grades,
+      std::vector<ChainType> boundaries
+  ) :
+      critical_cells(std::move(cells)),
+      grading_function(DefaultMap<CellType, GradingResultType>()) {
+    DefaultMap<CellType, GradingResultType> cell_grades;
+    for (std::size_t ace = 0; ace < critical_cells.size(); ++ace) {
+      cell_grades.insert(std::make_pair(critical_cells[ace], grades[ace]));
+      aces.insert(std::make_pair(
+          critical_cells[ace],
+          AceRecord{dimensions[ace], ChainType(), ChainType()}
+      ));
+    }
+    grading_function = GradingType(std::move(cell_grades));
+    for (std::size_t ace = 0; ace < critical_cells.size(); ++ace) {
+      for (const CellType& face : boundaries[ace]) {
+        aces.find(face)->second.coboundary.insert(
+            critical_cells[ace], boundaries[ace][face]
+        );
+      }
+      aces.find(critical_cells[ace])->second.boundary =
+          std::move(boundaries[ace]);
+    }
+  }
+
+  /**
+   * @brief The critical cells of the complex, in order of removal during
+   * coreduction.
+   *
+   * @return const std::vector<CellType>&
+   */
+  [[nodiscard]] const std::vector<CellType>& cells() const noexcept {
+    return critical_cells;
+  }
+
+  /**
+   * @brief Dimension of the critical cell `cell`.
+   *
+   * @param cell
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t dimension(const CellType& cell) const {
+    return aces.find(cell)->second.dimension;
+  }
+
+  /**
+   * @brief Grade a critical cell by its grade in the original complex.
+   *
+   * @param cell
+   * @return GradingResultType
+   */
+  GradingResultType grade(const CellType& cell) {
+    return grading_function(cell);
+  }
+
+  /**
+   * @brief Get the Morse boundary of the critical cell `cell` subject to some
+   * constraint `cond`.
+   *
+   * @tparam F Predicate type on (constant references to) cells.
+   * @param cell
+   * @param cond A function taking (a constant reference to) a potential
+   * boundary cell and returning a boolean value; if `true`, the cell is added
+   * to the boundary.
+   * @return ChainType
+   */
+  template <typename F>
+  requires std::predicate<const F&, const CellType&>
+  [[nodiscard]] ChainType boundary_if(const CellType& cell, const F& cond) {
+    const ChainType& full = aces.find(cell)->second.boundary;
+    ChainType result;
+    for (const CellType& face : full) {
+      if (cond(face)) {
+        result.insert(face, full[face]);
+      }
+    }
+    return result;
+  }
+  /** @brief Overload of `boundary_if` for type-erased conditions. */
+  [[nodiscard]] ChainType
+  boundary_if(const CellType& cell, const ConditionalType<CellType>& cond) {
+    return boundary_if<ConditionalType<CellType>>(cell, cond);
+  }
+
+  /**
+   * @brief Get the Morse coboundary of the critical cell `cell` subject to
+   * some constraint `cond`.
+   *
+   * @tparam F Predicate type on (constant references to) cells.
+   * @param cell
+   * @param cond A function taking (a constant reference to) a potential
+   * coboundary cell and returning a boolean value; if `true`, the cell is added
+   * to the coboundary.
+   * @return ChainType
+   */
+  template <typename F>
+  requires std::predicate<const F&, const CellType&>
+  [[nodiscard]] ChainType coboundary_if(const CellType& cell, const F& cond) {
+    const ChainType& full = aces.find(cell)->second.coboundary;
+    ChainType result;
+    for (const CellType& coface : full) {
+      if (cond(coface)) {
+        result.insert(coface, full[coface]);
+      }
+    }
+    return result;
+  }
+  /** @brief Overload of `coboundary_if` for type-erased conditions. */
+  [[nodiscard]] ChainType
+  coboundary_if(const CellType& cell, const ConditionalType<CellType>& cond) {
+    return coboundary_if<ConditionalType<CellType>>(cell, cond);
+  }
+};
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_COMPLEXES_MORSE_H
@@ -0,0 +1,114 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/complexes/complexes.hpp>
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/dense.hpp>
+#include <chomp/complexes/morse.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+namespace {
+
+// Euler characteristic of the cells of each grade
+template <typename CC, typename Cells>
+std::map<GradingResultType, long> euler_by_grade(CC& complex, Cells&& cells) {
+  std::map<GradingResultType, long> result;
+  for (const auto& cell : cells) {
+    result[complex.grade(cell)] += complex.dimension(cell) % 2 ? -1 : 1;
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST_CASE("MorseComplex models DimensionedChainComplex", "[complexes]") {
+  using Complex = CubicalComplex<2, DenseBinaryGrading<2, 0, 1>, Z<3>>;
+  CHECK(DimensionedChainComplex<Complex>);
+  CHECK(DimensionedChainComplex<MorseComplex<Complex>>);
+}
+
+TEST_CASE(
+    "Coreduction of an open box has an acyclic Morse complex", "[complexes]"
+) {
+  CubicalComplex<1, DenseGrading<1, 0, 0>> complex(
+      CubeOrthant<1>{0}, CubeOrthant<1>{4}, DenseGrading<1, 0, 0>({0}, {4})
+  );
+  const MorseMatching matching(complex, complex.cells());
+  REQUIRE(matching.aces().size() == 2);
+  REQUIRE(matching.aces()[0] == Cube<1>({0}, 0));
+  REQUIRE(matching.aces()[1] == Cube<1>({4}, 1));
+  REQUIRE(matching.type(Cube<1>({1}, 0)) == MorseType::Queen);
+  REQUIRE(matching.partner(Cube<1>({1}, 0)) == Cube<1>({0}, 1));
+  REQUIRE(matching.time(Cube<1>({1}, 0)) == matching.time(Cube<1>({0}, 1)));
+
+  MorseComplex morse(complex, matching);
+  REQUIRE(morse.cells() == matching.aces());
+  typename decltype(morse)::ChainType expected;
+  expected.insert(Cube<1>({0}, 0), one<Z<2>>());
+  REQUIRE(boundary(morse, Cube<1>({4}, 1)) == expected);
+  REQUIRE(coboundary(morse, Cube<1>({0}, 0)).size() == 1);
+}
+
+TEST_CASE("Coreduction respects the grading", "[complexes]") {
+  // A ring of voxels with grade 0 around a hole and a second component, in a
+  // box with margin so that the grade 0 cells form a closed subcomplex
+  const std::vector<int> voxels = {
+      2, 2, 2, 2, 2, 2,  //
+      2, 0, 0, 0, 2, 2,  //
+      2, 0, 2, 0, 2, 2,  //
+      2, 0, 0, 0, 2, 1,  //
+      2, 2, 2, 2, 2, 2,  //
+      2, 2, 2, 2, 2, 2
+  };
+  using Grading = DenseGrading<2, 0, 2>;
+  CubicalComplex<2, Grading, Z<5>> complex(
+      CubeOrthant<2>{0, 0}, CubeOrthant<2>{5, 5},
+      Grading({0, 0}, {5, 5}, voxels.cbegin(), voxels.cend())
+  );
+  MorseComplex morse(complex, complex.cells());
+
+  // Reduction preserves the Euler characteristic of each grade
+  REQUIRE(
+      euler_by_grade(morse, morse.cells()) ==
+      euler_by_grade(complex, complex.cells())
+  );
+  REQUIRE(morse.cells().size() < complex.cell_count() / 10);
+
+  // The grade 0 subcomplex is an annulus: one vertex and one cycle
+  std::vector<std::size_t> grade_zero_dimensions;
+  for (const Cube<2>& cell : morse.cells()) {
+    if (morse.grade(cell) == 0) {
+      grade_zero_dimensions.push_back(morse.dimension(cell));
+      REQUIRE(boundary(morse, cell) == typename decltype(morse)::ChainType());
+    }
+  }
+  REQUIRE(grade_zero_dimensions == std::vector<std::size_t>{0, 1});
+
+  // Boundaries are graded and square to zero
+  for (const Cube<2>& cell : morse.cells()) {
+    const auto cell_boundary = boundary(morse, cell);
+    for (const Cube<2>& face : cell_boundary) {
+      REQUIRE(morse.grade(face) <= morse.grade(cell));
+      REQUIRE(morse.dimension(face) + 1 == morse.dimension(cell));
+    }
+    REQUIRE(boundary(morse, cell_boundary).size() == 0);
+  }
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
@@ -0,0 +1,331 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains the spatial partitioning of a cubical complex
+ * into tiles, and the tiled Morse reduction matching each tile independently
+ * before matching the interface between tiles.
+ */
+
+#ifndef CHOMP_COMPLEXES_TILING_H
+#define CHOMP_COMPLEXES_TILING_H
+
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/morse.hpp>
+#include <chomp/util/constants.hpp>
+#include <chomp/util/parallel.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+/**
+ * @brief Partition of the orthants of a `CubicalComplex` box into sub-boxes,
+ * the tiles, of a fixed shape.
+ *
+ * Every cell belongs to the tile containing its orthant. The closure of a
+ * cell may extend into the tiles after its own along the axes of its extent;
+ * such cells are *interface* cells. The remaining *interior* cells of a tile
+ * form a subcomplex: all of their faces are interior cells of the same tile.
+ * With the boundary-edge handling of `CubicalComplex`, faces beyond the
+ * maximum orthant of the whole box are absent, so cells there are interior.
+ *
+ * The outer faces of the cells of a tile lie in its halo, the orthants up to
+ * `halo_maximum`, one layer beyond the tile along each axis where the box
+ * continues.
+ *
+ * @tparam CCDIM Ambient dimension of the cubical complex.
+ *
+ * @sa `tiled_morse_matching`
+ */
+template <std::size_t CCDIM>
+class CubicalTiling {
+  CubeOrthant<CCDIM> minimum_orthant;
+  CubeOrthant<CCDIM> maximum_orthant;
+  std::array<std::size_t, CCDIM> tile_shape;
+  std::array<std::size_t, CCDIM> tile_counts;
+  std::array<std::size_t, CCDIM> tile_strides;
+
+  [[nodiscard]] std::size_t offset(
+      const CubeOrthant<CCDIM>& orthant, std::size_t axis
+  ) const noexcept {
+    return std::size_t(orthant[axis] - minimum_orthant[axis]);
+  }
+
+  // Cells of `tile` satisfying `include`, orthant by orthant
+  template <CubicalCell<CCDIM> C, typename F>
+  [[nodiscard]] std::vector<C>
+  collect_cells(std::size_t tile, const F& include) const {
+    std::vector<C> result;
+    for_each_orthant(
+        tile_minimum(tile), tile_maximum(tile),
+        [&result, &include](const CubeOrthant<CCDIM>& orthant) {
+          for (std::size_t extent = 0; extent < (std::size_t(1) << CCDIM);
+               ++extent) {
+            C cell(orthant, extent);
+            if (include(cell)) {
+              result.push_back(std::move(cell));
+            }
+          }
+        }
+    );
+    return result;
+  }
+
+public:
+  /**
+   * @brief Partition the box of orthants from `minimum` to `maximum`
+   * (inclusive) into tiles of `shape` orthants along each axis.
+   *
+   * Tiles at the maximal end of an axis are truncated to the box.
+   *
+   * @param minimum Minimum orthant of the box.
+   * @param maximum Maximum orthant of the box; at least `minimum` along each
+   * axis.
+   * @param shape Number of orthants of a tile along each axis; each positive.
+   */
+  CubicalTiling(
+      const CubeOrthant<CCDIM>& minimum, const CubeOrthant<CCDIM>& maximum,
+      const std::array<std::size_t, CCDIM>& shape
+  ) :
+      minimum_orthant(minimum), maximum_orthant(maximum), tile_shape(shape) {
+    std::size_t stride = 1;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      const std::size_t length = offset(maximum_orthant, axis) + 1;
+      tile_counts[axis] = (length + tile_shape[axis] - 1) / tile_shape[axis];
+      tile_strides[axis] = stride;
+      stride *= tile_counts[axis];
+    }
+  }
+
+  /**
+   * @brief Partition the box of a cubical complex.
+   *
+   * @tparam CC Cubical complex type.
+   * @param complex
+   * @param shape Number of orthants of a tile along each axis; each positive.
+   */
+  template <typename CC>
+  requires requires(const CC& complex) {
+    { complex.minimum() } -> std::convertible_to<CubeOrthant<CCDIM>>;
+    { complex.maximum() } -> std::convertible_to<CubeOrthant<CCDIM>>;
+  }
+  CubicalTiling(
+      const CC& complex, const std::array<std::size_t, CCDIM>& shape
+  ) : CubicalTiling(complex.minimum(), complex.maximum(), shape) {}
+
+  /**
+   * @brief Number of tiles.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t tile_count() const noexcept {
+    return tile_strides[CCDIM - 1] * tile_counts[CCDIM - 1];
+  }
+
+  /**
+   * @brief Minimum orthant of `tile`.
+   *
+   * @param tile Must be less than `tile_count()`.
+   * @return CubeOrthant<CCDIM>
+   */
+  [[nodiscard]] CubeOrthant<CCDIM> tile_minimum(std::size_t tile
+  ) const noexcept {
+    CubeOrthant<CCDIM> result;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      const std::size_t position =
+          (tile / tile_strides[axis]) % tile_counts[axis];
+      result[axis] = static_cast<HypercubeCoordinate>(
+          minimum_orthant[axis] + position * tile_shape[axis]
+      );
+    }
+    return result;
+  }
+
+  /**
+   * @brief Maximum orthant of `tile`, inclusive.
+   *
+   * @param tile Must be less than `tile_count()`.
+   * @return CubeOrthant<CCDIM>
+   */
+  [[nodiscard]] CubeOrthant<CCDIM> tile_maximum(std::size_t tile
+  ) const noexcept {
+    CubeOrthant<CCDIM> result = tile_minimum(tile);
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      result[axis] = static_cast<HypercubeCoordinate>(std::min<std::size_t>(
+          result[axis] + tile_shape[axis] - 1, maximum_orthant[axis]
+      ));
+    }
+    return result;
+  }
+
+  /**
+   * @brief Maximum orthant of the halo of `tile`, which contains the
+   * closures of all cells of the tile.
+   *
+   * @param tile Must be less than `tile_count()`.
+   * @return CubeOrthant<CCDIM>
+   */
+  [[nodiscard]] CubeOrthant<CCDIM> halo_maximum(std::size_t tile
+  ) const noexcept {
+    CubeOrthant<CCDIM> result = tile_maximum(tile);
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      if (result[axis] < maximum_orthant[axis]) {
+        ++result[axis];
+      }
+    }
+    return result;
+  }
+
+  /**
+   * @brief The tile to which `cell` belongs.
+   *
+   * @tparam C Cell type modeling `CubicalCell`.
+   * @param cell Cell whose orthant is in the box.
+   * @return std::size_t
+   */
+  template <CubicalCell<CCDIM> C>
+  [[nodiscard]] std::size_t tile_of(const C& cell) const {
+    const CubeOrthant<CCDIM> orthant = cell.orthant();
+    std::size_t tile = 0;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      tile += offset(orthant, axis) / tile_shape[axis] * tile_strides[axis];
+    }
+    return tile;
+  }
+
+  /**
+   * @brief Whether the closure of `cell` extends beyond its tile.
+   *
+   * @tparam C Cell type modeling `CubicalCell`.
+   * @param cell Cell whose orthant is in the box.
+   * @return true
+   * @return false
+   */
+  template <CubicalCell<CCDIM> C>
+  [[nodiscard]] bool is_interface(const C& cell) const {
+    const CubeOrthant<CCDIM> orthant = cell.orthant();
+    const std::size_t extent = cell.extent();
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      if (((extent >> axis) & 1) != 0 &&
+          orthant[axis] < maximum_orthant[axis] &&
+          offset(orthant, axis) % tile_shape[axis] == tile_shape[axis] - 1) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief The interior cells of `tile`, which form a subcomplex.
+   *
+   * @tparam C Cell type modeling `CubicalCell`.
+   * @param tile Must be less than `tile_count()`.
+   * @return std::vector<C>
+   */
+  template <CubicalCell<CCDIM> C>
+  [[nodiscard]] std::vector<C> interior_cells(std::size_t tile) const {
+    return collect_cells<C>(tile, [this](const C& cell) {
+      return !is_interface(cell);
+    });
+  }
+
+  /**
+   * @brief The interface cells of `tile`.
+   *
+   * @tparam C Cell type modeling `CubicalCell`.
+   * @param tile Must be less than `tile_count()`.
+   * @return std::vector<C>
+   */
+  template <CubicalCell<CCDIM> C>
+  [[nodiscard]] std::vector<C> interface_cells(std::size_t tile) const {
+    return collect_cells<C>(tile, [this](const C& cell) {
+      return is_interface(cell);
+    });
+  }
+};
+
+/**
+ * @brief Acyclic partial matching on the cells of the cubical complex
+ * `complex`, computed tile by tile.
+ *
+ * The interior cells of each tile are matched on their own with
+ * `MorseMatching`, possibly in parallel under `policy`, as each interior is a
+ * subcomplex. The matchings are merged in tile order, and then merged with
+ * the matching of all interface cells, which are exactly the cells whose
+ * closure crosses between tiles. The result is a valid matching for
+ * `MorseComplex` on all cells of `complex`.
+ *
+ * The tiles may equally be matched elsewhere, e.g. on other processes, and
+ * merged with `MorseMatching::merge` in the same order.
+ *
+ * @tparam CC Cubical complex type modeling `DimensionedChainComplex`.
+ * @tparam CCDIM Ambient dimension of the cubical complex.
+ * @tparam P Execution policy type. Under `ParallelPolicy`, tiles are
+ * distributed over at most `threads` tasks of the scheduler of the policy
+ * regardless of `grain`, and the methods of `complex` must be safe to call
+ * concurrently.
+ * @param complex
+ * @param tiling Tiling of the box of `complex`.
+ * @param policy Execution policy; sequential by default.
+ * @return MorseMatching<CC>
+ */
+template <
+    DimensionedChainComplex CC, std::size_t CCDIM,
+    ExecutionPolicy P = SequencedPolicy>
+requires CubicalCell<typename CC::CellType, CCDIM>
+[[nodiscard]] MorseMatching<CC> tiled_morse_matching(
+    CC& complex, const CubicalTiling<CCDIM>& tiling, const P& policy = P()
+) {
+  using C = typename CC::CellType;
+  const auto match_tiles = [&complex, &tiling](
+                               std::size_t first, std::size_t last
+                           ) {
+    MorseMatching<CC> matching;
+    for (std::size_t tile = first; tile < last; ++tile) {
+      matching.merge(
+          MorseMatching<CC>(complex, tiling.template interior_cells<C>(tile))
+      );
+    }
+    return matching;
+  };
+
+  MorseMatching<CC> matching;
+  if constexpr (std::same_as<P, SequencedPolicy>) {
+    matching = match_tiles(0, tiling.tile_count());
+  } else {
+    matching = parallel_reduce<MorseMatching<CC>>(
+        ParallelPolicy{
+            .threads = policy.threads, .grain = 1, .scheduler = policy.scheduler
+        },
+        tiling.tile_count(), match_tiles,
+        [](MorseMatching<CC>& lhs, MorseMatching<CC>&& rhs) {
+          lhs.merge(std::move(rhs));
+        }
+    );
+  }
+
+  std::vector<C> interface;
+  for (std::size_t tile = 0; tile < tiling.tile_count(); ++tile) {
+    std::vector<C> cells = tiling.template interface_cells<C>(tile);
+    interface.insert(
+        interface.end(), std::make_move_iterator(cells.begin()),
+        std::make_move_iterator(cells.end())
+    );
+  }
+  matching.merge(MorseMatching<CC>(complex, interface));
+  return matching;
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_COMPLEXES_TILING_H
@@ -0,0 +1,136 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/complexes/complexes.hpp>
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/dense.hpp>
+#include <chomp/complexes/morse.hpp>
+#include <chomp/complexes/tiling.hpp>
+#include <chomp/util/parallel.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <utility>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+TEST_CASE("CubicalTiling partitions cells into tiles", "[complexes]") {
+  CubicalComplex<2, DenseGrading<2, 0, 0>> complex(
+      CubeOrthant<2>{1, 0}, CubeOrthant<2>{5, 3},
+      DenseGrading<2, 0, 0>({1, 0}, {5, 3})
+  );
+  const CubicalTiling<2> tiling(complex, {2, 3});
+  REQUIRE(tiling.tile_count() == 6);
+  REQUIRE(tiling.tile_minimum(0) == CubeOrthant<2>{1, 0});
+  REQUIRE(tiling.tile_maximum(0) == CubeOrthant<2>{2, 2});
+  REQUIRE(tiling.halo_maximum(0) == CubeOrthant<2>{3, 3});
+  REQUIRE(tiling.tile_minimum(5) == CubeOrthant<2>{5, 3});
+  REQUIRE(tiling.tile_maximum(5) == CubeOrthant<2>{5, 3});
+  REQUIRE(tiling.halo_maximum(5) == CubeOrthant<2>{5, 3});
+
+  std::vector<std::size_t> owned(tiling.tile_count(), 0);
+  for (const Cube<2>& cell : complex.cells()) {
+    ++owned[tiling.tile_of(cell)];
+  }
+  std::size_t total = 0;
+  for (std::size_t tile = 0; tile < tiling.tile_count(); ++tile) {
+    const std::vector<Cube<2>> interior =
+        tiling.interior_cells<Cube<2>>(tile);
+    const std::vector<Cube<2>> interface =
+        tiling.interface_cells<Cube<2>>(tile);
+    REQUIRE(interior.size() + interface.size() == owned[tile]);
+    total += owned[tile];
+
+    // Interiors are subcomplexes of their tile
+    for (const Cube<2>& cell : interior) {
+      REQUIRE(tiling.tile_of(cell) == tile);
+      for (const Cube<2>& face : boundary(complex, cell)) {
+        REQUIRE(tiling.tile_of(face) == tile);
+        REQUIRE_FALSE(tiling.is_interface(face));
+      }
+    }
+    // Interface cells have a face in another tile, within the halo
+    const CubeOrthant<2> halo = tiling.halo_maximum(tile);
+    for (const Cube<2>& cell : interface) {
+      const auto faces = boundary(complex, cell);
+      REQUIRE(std::ranges::any_of(faces, [&](const Cube<2>& face) {
+        return tiling.tile_of(face) != tile;
+      }));
+      for (const Cube<2>& face : faces) {
+        REQUIRE(face.coordinate(0) <= halo[0]);
+        REQUIRE(face.coordinate(1) <= halo[1]);
+      }
+    }
+  }
+  REQUIRE(total == complex.cell_count());
+}
+
+TEST_CASE(
+    "Tiled coreduction gives a valid Morse complex", "[complexes]"
+) {
+  const std::vector<int> voxels = {
+      2, 2, 2, 2, 2, 2,  //
+      2, 0, 0, 0, 2, 2,  //
+      2, 0, 2, 0, 2, 2,  //
+      2, 0, 0, 0, 2, 1,  //
+      2, 2, 2, 2, 2, 2,  //
+      2, 2, 2, 2, 2, 2
+  };
+  using Grading = DenseGrading<2, 0, 2>;
+  CubicalComplex<2, Grading, Z<5>> complex(
+      CubeOrthant<2>{0, 0}, CubeOrthant<2>{5, 5},
+      Grading({0, 0}, {5, 5}, voxels.cbegin(), voxels.cend())
+  );
+  const MorseMatching untiled(complex, complex.cells());
+
+  // A single tile is matched as the untiled complex
+  const CubicalTiling<2> single(complex, {6, 6});
+  REQUIRE(single.tile_count() == 1);
+  REQUIRE(tiled_morse_matching(complex, single).aces() == untiled.aces());
+
+  const CubicalTiling<2> tiling(complex, {2, 3});
+  const MorseMatching matching = tiled_morse_matching(complex, tiling);
+  const MorseMatching parallel_matching = tiled_morse_matching(
+      complex, tiling, ParallelPolicy{.threads = 3}
+  );
+  REQUIRE(parallel_matching.aces() == matching.aces());
+  REQUIRE(matching.aces().size() >= untiled.aces().size());
+
+  MorseComplex morse(complex, matching);
+  for (const Cube<2>& cell : morse.cells()) {
+    const auto cell_boundary = boundary(morse, cell);
+    for (const Cube<2>& face : cell_boundary) {
+      REQUIRE(morse.grade(face) <= morse.grade(cell));
+      REQUIRE(morse.dimension(face) + 1 == morse.dimension(cell));
+    }
+    REQUIRE(boundary(morse, cell_boundary).size() == 0);
+  }
+
+  // Reducing the merged complex again leaves aces of the grades and
+  // dimensions of those of the untiled matching
+  MorseComplex reduced(morse, morse.cells());
+  std::multiset<std::pair<GradingResultType, std::size_t>> reduced_aces;
+  for (const Cube<2>& cell : reduced.cells()) {
+    reduced_aces.emplace(reduced.grade(cell), reduced.dimension(cell));
+  }
+  std::multiset<std::pair<GradingResultType, std::size_t>> untiled_aces;
+  for (const Cube<2>& cell : untiled.aces()) {
+    untiled_aces.emplace(complex.grade(cell), complex.dimension(cell));
+  }
+  REQUIRE(reduced_aces == untiled_aces);
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
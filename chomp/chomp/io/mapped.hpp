@@ -0,0 +1,168 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains the read-only memory mapping of files shared by
+ * the voxel image readers and the binary serialization format.
+ */
+
+#ifndef CHOMP_IO_MAPPED_H
+#define CHOMP_IO_MAPPED_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+namespace chomp::core {
+
+/**
+ * @brief Read-only memory mapping of a whole file.
+ *
+ * The mapping is released when the object is destroyed. A default
+ * constructed object, or one whose file could not be mapped, is not open and
+ * has no bytes.
+ */
+class MappedFile {
+private:
+  const std::byte* mapped_data = nullptr;
+  std::size_t mapped_size = 0;
+
+  // Widen [offset, offset + length) to whole pages in the mapping.
+  [[nodiscard]] std::pair<void*, std::size_t>
+  page_range(std::size_t offset, std::size_t length) const noexcept {
+    const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t first = std::min(offset, mapped_size) / page * page;
+    const std::size_t last = std::min(offset + length, mapped_size);
+    return {
+        const_cast<std::byte*>(mapped_data) + first,
+        last > first ? last - first : 0
+    };
+  }
+
+  void unmap() noexcept {
+    if (mapped_data != nullptr) {
+      munmap(const_cast<std::byte*>(mapped_data), mapped_size);
+    }
+    mapped_data = nullptr;
+    mapped_size = 0;
+  }
+
+public:
+  /** @brief Construct a file mapping that is not open. */
+  MappedFile() noexcept = default;
+
+  /**
+   * @brief Map the file at `path`.
+   *
+   * If the file cannot be opened or mapped, or is empty, the object is not
+   * open.
+   *
+   * @param path
+   */
+  explicit MappedFile(const std::filesystem::path& path) noexcept {
+    const int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+      return;
+    }
+    struct stat status {};
+    if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+      void* address = mmap(
+          nullptr, static_cast<std::size_t>(status.st_size), PROT_READ,
+          MAP_SHARED, descriptor, 0
+      );
+      if (address != MAP_FAILED) {
+        mapped_data = static_cast<const std::byte*>(address);
+        mapped_size = static_cast<std::size_t>(status.st_size);
+      }
+    }
+    // The mapping holds its own reference to the file.
+    close(descriptor);
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /** @brief Move constructor; `other` is left not open. */
+  MappedFile(MappedFile&& other) noexcept :
+      mapped_data(std::exchange(other.mapped_data, nullptr)),
+      mapped_size(std::exchange(other.mapped_size, 0)) {}
+
+  /** @brief Move assignment; `other` is left not open. */
+  MappedFile& operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      mapped_data = std::exchange(other.mapped_data, nullptr);
+      mapped_size = std::exchange(other.mapped_size, 0);
+    }
+    return *this;
+  }
+
+  /** @brief Release the mapping. */
+  ~MappedFile() {
+    unmap();
+  }
+
+  /**
+   * @brief Whether the file is mapped.
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool is_open() const noexcept {
+    return mapped_data != nullptr;
+  }
+
+  /**
+   * @brief The mapped bytes of the file.
+   *
+   * @return std::span<const std::byte>
+   */
+  [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+    return {mapped_data, mapped_size};
+  }
+
+  /**
+   * @brief Hint that the bytes `[offset, offset + length)` are about to be
+   * read in order.
+   *
+   * @param offset
+   * @param length
+   */
+  void prefetch(std::size_t offset, std::size_t length) const noexcept {
+    const auto [address, size] = page_range(offset, length);
+    if (size > 0) {
+      madvise(address, size, MADV_SEQUENTIAL);
+      madvise(address, size, MADV_WILLNEED);
+    }
+  }
+
+  /**
+   * @brief Release the resident pages of the bytes `[offset, offset + length)`.
+   *
+   * The bytes remain readable; they are paged in again from the file if they
+   * are accessed later.
+   *
+   * @param offset
+   * @param length
+   */
+  void evict(std::size_t offset, std::size_t length) const noexcept {
+    const auto [address, size] = page_range(offset, length);
+    if (size > 0) {
+      madvise(address, size, MADV_DONTNEED);
+    }
+  }
+};
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_IO_MAPPED_H
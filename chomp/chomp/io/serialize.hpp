@@ -0,0 +1,741 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains a compact, versioned binary format for chains
+ * over cubical cells, for `MapGrading` and `SetGrading` over cubical cells,
+ * and for `MorseComplex` objects of cubical complexes.
+ *
+ * Each record starts with a header: the magic bytes `CHMP`, the format
+ * version, the kind of record, the ambient dimension, the divisor of the
+ * coefficient ring (or the grade bounds of a grading), and the bounding box of
+ * the cells. Cells are stored as their `CubeIndexer` indices in the bounding
+ * box, sorted and delta encoded as LEB128 variable-length integers, so that
+ * dense chains take close to one byte per cell; coefficients of `Z<p>` follow
+ * as one varint each, and are omitted for `Z<2>`.
+ *
+ * Records are written to a `BinaryWriter` buffer, saved in one bulk write,
+ * and read back with a `BinaryReader` directly from the bytes of a
+ * `MappedFile`, without intermediate copies.
+ */
+
+#ifndef CHOMP_IO_SERIALIZE_H
+#define CHOMP_IO_SERIALIZE_H
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/grading.hpp>
+#include <chomp/complexes/morse.hpp>
+#include <chomp/io/mapped.hpp>
+#include <chomp/util/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+/** @brief Version of the binary format written by this header. */
+constexpr std::uint64_t SERIALIZE_FORMAT_VERSION = 1;
+
+/** @brief Kind of a serialized record. */
+enum class RecordKind : std::uint8_t {
+  Chain = 1,
+  MapGrading = 2,
+  SetGrading = 3,
+  MorseComplex = 4
+};
+
+/**
+ * @brief Growable byte buffer that records are serialized into.
+ *
+ * @sa `BinaryReader`
+ */
+class BinaryWriter {
+private:
+  std::vector<std::byte> buffer;
+
+public:
+  /**
+   * @brief Append one byte.
+   *
+   * @param value
+   */
+  void put_byte(std::uint8_t value) {
+    buffer.push_back(std::byte(value));
+  }
+
+  /**
+   * @brief Append `value` as an LEB128 varint: seven bits per byte, least
+   * significant first, with the high bit set on all but the last byte.
+   *
+   * @param value
+   */
+  void put_varint(std::uint64_t value) {
+    while (value >= 0x80) {
+      put_byte(static_cast<std::uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    put_byte(static_cast<std::uint8_t>(value));
+  }
+
+  /**
+   * @brief Append raw bytes.
+   *
+   * @param bytes
+   */
+  void put_bytes(std::span<const std::byte> bytes) {
+    buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+  }
+
+  /**
+   * @brief Reserve capacity for `count` more bytes.
+   *
+   * @param count
+   */
+  void reserve(std::size_t count) {
+    buffer.reserve(buffer.size() + count);
+  }
+
+  /**
+   * @brief The bytes written so far.
+   *
+   * @return std::span<const std::byte>
+   */
+  [[nodiscard]] std::span<const std::byte> bytes() const noexcept {
+    return buffer;
+  }
+
+  /**
+   * @brief Write the buffer to the file at `path` in one bulk write,
+   * replacing its contents.
+   *
+   * @param path
+   * @return true If the file was written.
+   * @return false Otherwise.
+   */
+  [[nodiscard]] bool save(const std::filesystem::path& path) const {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream.write(
+        reinterpret_cast<const char*>(buffer.data()),
+        static_cast<std::streamsize>(buffer.size())
+    );
+    return static_cast<bool>(stream);
+  }
+};
+
+/**
+ * @brief Cursor over serialized bytes, e.g. the bytes of a `MappedFile`.
+ *
+ * The reader does not own or copy the bytes. Reading past the end, or a
+ * malformed varint, marks the reader as failed; every read after that fails
+ * too, so a record can be read in full and checked once.
+ *
+ * @sa `BinaryWriter`
+ */
+class BinaryReader {
+private:
+  std::span<const std::byte> data;
+  std::size_t position = 0;
+  bool failed = false;
+
+public:
+  /**
+   * @brief Read from `bytes`, which must outlive the reader.
+   *
+   * @param bytes
+   */
+  explicit BinaryReader(std::span<const std::byte> bytes) noexcept :
+      data(bytes) {}
+
+  /**
+   * @brief Read one byte.
+   *
+   * @return std::uint8_t The byte, or zero if the reader fails.
+   */
+  std::uint8_t get_byte() noexcept {
+    if (failed || position == data.size()) {
+      failed = true;
+      return 0;
+    }
+    return std::to_integer<std::uint8_t>(data[position++]);
+  }
+
+  /**
+   * @brief Read an LEB128 varint.
+   *
+   * @return std::uint64_t The value, or zero if the reader fails.
+   */
+  std::uint64_t get_varint() noexcept {
+    std::uint64_t value = 0;
+    for (std::size_t shift = 0; shift < 64; shift += 7) {
+      const std::uint8_t byte = get_byte();
+      value |= std::uint64_t(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return failed ? 0 : value;
+      }
+    }
+    failed = true;
+    return 0;
+  }
+
+  /**
+   * @brief Whether every read so far succeeded.
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool ok() const noexcept {
+    return !failed;
+  }
+
+  /**
+   * @brief Number of bytes not yet read.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t remaining() const noexcept {
+    return data.size() - position;
+  }
+
+  /** @brief Mark the reader as failed, e.g. on invalid contents. */
+  void fail() noexcept {
+    failed = true;
+  }
+};
+
+/**
+ * @brief Coefficient rings that can be serialized: the integers modulo `p`,
+ * through their representatives.
+ *
+ * @tparam R
+ */
+template <typename R>
+concept SerializableRing = Ring<R> && requires(const R coef, int rep) {
+  { R::divisor() } -> std::convertible_to<int>;
+  { coef.rep() } -> std::convertible_to<int>;
+  R(rep);
+};
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+template <typename C>
+struct CubicalDimension {};
+
+template <std::size_t CCDIM>
+struct CubicalDimension<Cube<CCDIM>>
+    : std::integral_constant<std::size_t, CCDIM> {};
+
+template <std::size_t CCDIM>
+struct CubicalDimension<PackedCube<CCDIM>>
+    : std::integral_constant<std::size_t, CCDIM> {};
+
+template <typename C>
+concept SerializableCell = requires { CubicalDimension<C>::value; };
+
+constexpr std::array<std::uint8_t, 4> SERIALIZE_MAGIC = {'C', 'H', 'M', 'P'};
+
+// Smallest box containing the orthants of `cells`; the zero box if empty.
+template <std::size_t CCDIM, typename Cells>
+[[nodiscard]] CubeIndexer<CCDIM> bounding_indexer(const Cells& cells) {
+  CubeOrthant<CCDIM> minimum;
+  CubeOrthant<CCDIM> maximum;
+  minimum.fill(std::numeric_limits<HypercubeCoordinate>::max());
+  maximum.fill(0);
+  bool empty = true;
+  for (const auto& cell : cells) {
+    empty = false;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      minimum[axis] = std::min(minimum[axis], cell.coordinate(axis));
+      maximum[axis] = std::max(maximum[axis], cell.coordinate(axis));
+    }
+  }
+  if (empty) {
+    minimum.fill(0);
+  }
+  return CubeIndexer<CCDIM>(minimum, maximum);
+}
+
+template <std::size_t CCDIM>
+void write_header(
+    BinaryWriter& writer, RecordKind kind, std::uint64_t first_parameter,
+    std::uint64_t second_parameter, const CubeIndexer<CCDIM>& indexer
+) {
+  for (std::uint8_t byte : SERIALIZE_MAGIC) {
+    writer.put_byte(byte);
+  }
+  writer.put_varint(SERIALIZE_FORMAT_VERSION);
+  writer.put_byte(static_cast<std::uint8_t>(kind));
+  writer.put_varint(CCDIM);
+  writer.put_varint(first_parameter);
+  writer.put_varint(second_parameter);
+  for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+    writer.put_byte(static_cast<std::uint8_t>(indexer.minimum()[axis]));
+  }
+  for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+    writer.put_byte(static_cast<std::uint8_t>(indexer.maximum()[axis]));
+  }
+}
+
+// Read a header and check it against the expected kind and parameters.
+template <std::size_t CCDIM>
+[[nodiscard]] std::optional<CubeIndexer<CCDIM>> read_header(
+    BinaryReader& reader, RecordKind kind, std::uint64_t first_parameter,
+    std::uint64_t second_parameter
+) {
+  for (std::uint8_t byte : SERIALIZE_MAGIC) {
+    if (reader.get_byte() != byte) {
+      reader.fail();
+    }
+  }
+  const std::uint64_t version = reader.get_varint();
+  if (version == 0 || version > SERIALIZE_FORMAT_VERSION ||
+      reader.get_byte() != static_cast<std::uint8_t>(kind) ||
+      reader.get_varint() != CCDIM ||
+      reader.get_varint() != first_parameter ||
+      reader.get_varint() != second_parameter) {
+    reader.fail();
+  }
+  CubeOrthant<CCDIM> minimum;
+  CubeOrthant<CCDIM> maximum;
+  for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+    minimum[axis] = reader.get_byte();
+  }
+  for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+    maximum[axis] = reader.get_byte();
+    if (maximum[axis] < minimum[axis]) {
+      reader.fail();
+    }
+  }
+  if (!reader.ok()) {
+    return std::nullopt;
+  }
+  return CubeIndexer<CCDIM>(minimum, maximum);
+}
+
+// Sorted indices as a count followed by the first index and the gaps.
+inline void
+write_indices(BinaryWriter& writer, const std::vector<std::size_t>& indices) {
+  writer.reserve(indices.size() + 10);
+  writer.put_varint(indices.size());
+  std::size_t previous = 0;
+  for (std::size_t index : indices) {
+    writer.put_varint(index - previous);
+    previous = index;
+  }
+}
+
+[[nodiscard]] inline std::vector<std::size_t>
+read_indices(BinaryReader& reader, std::size_t index_count) {
+  const std::uint64_t count = reader.get_varint();
+  // Each index takes at least one byte, which bounds the allocation.
+  if (count > reader.remaining()) {
+    reader.fail();
+    return {};
+  }
+  std::vector<std::size_t> indices;
+  indices.reserve(count);
+  std::size_t index = 0;
+  for (std::uint64_t entry = 0; entry < count; ++entry) {
+    const std::uint64_t gap = reader.get_varint();
+    if ((entry > 0 && gap == 0) || gap >= index_count - index) {
+      reader.fail();
+      return {};
+    }
+    index += gap;
+    indices.push_back(index);
+  }
+  return indices;
+}
+
+template <typename C, typename Cells>
+[[nodiscard]] std::vector<std::size_t> sorted_indices(
+    const CubeIndexer<CubicalDimension<C>::value>& indexer, const Cells& cells
+) {
+  std::vector<std::size_t> indices;
+  for (const C& cell : cells) {
+    indices.push_back(indexer.index_of(cell));
+  }
+  std::ranges::sort(indices);
+  return indices;
+}
+
+template <Module M>
+void write_terms(
+    BinaryWriter& writer,
+    const CubeIndexer<CubicalDimension<typename M::BasisType>::value>&
+        indexer,
+    const M& chain
+) {
+  using C = typename M::BasisType;
+  using R = typename M::RingType;
+  const std::vector<std::size_t> indices = sorted_indices<C>(indexer, chain);
+  write_indices(writer, indices);
+  if constexpr (R::divisor() != 2) {
+    for (std::size_t index : indices) {
+      writer.put_varint(
+          static_cast<std::uint64_t>(chain[indexer.template cell_at<C>(index)]
+                                         .rep())
+      );
+    }
+  }
+}
+
+template <Module M>
+[[nodiscard]] M read_terms(
+    BinaryReader& reader,
+    const CubeIndexer<CubicalDimension<typename M::BasisType>::value>&
+        indexer
+) {
+  using C = typename M::BasisType;
+  using R = typename M::RingType;
+  const std::vector<std::size_t> indices =
+      read_indices(reader, indexer.size());
+  std::vector<std::pair<C, R>> terms;
+  terms.reserve(indices.size());
+  for (std::size_t index : indices) {
+    R coef = one<R>();
+    if constexpr (R::divisor() != 2) {
+      const std::uint64_t rep = reader.get_varint();
+      if (rep == 0 || rep >= std::uint64_t(R::divisor())) {
+        reader.fail();
+      }
+      coef = R(static_cast<int>(rep));
+    }
+    terms.emplace_back(indexer.template cell_at<C>(index), coef);
+  }
+
+  M chain;
+  if (!reader.ok()) {
+    return chain;
+  }
+  if constexpr (requires { chain.insert(terms.begin(), terms.end()); }) {
+    chain.insert(terms.begin(), terms.end());
+  } else {
+    if constexpr (requires { chain.reserve(terms.size()); }) {
+      chain.reserve(terms.size());
+    }
+    for (auto& [cell, coef] : terms) {
+      chain.insert(std::move(cell), std::move(coef));
+    }
+  }
+  return chain;
+}
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
+/**
+ * @brief Serialize the chain `chain` over cubical cells.
+ *
+ * @tparam M Module type over `Cube<CCDIM>` or `PackedCube<CCDIM>` with
+ * coefficients modeling `SerializableRing`.
+ * @param writer
+ * @param chain
+ *
+ * @sa `read_chain`
+ */
+template <Module M>
+requires detail::SerializableCell<typename M::BasisType> &&
+         SerializableRing<typename M::RingType>
+void write_chain(BinaryWriter& writer, const M& chain) {
+  constexpr std::size_t CCDIM =
+      detail::CubicalDimension<typename M::BasisType>::value;
+  const CubeIndexer<CCDIM> indexer =
+      detail::bounding_indexer<CCDIM>(chain);
+  detail::write_header(
+      writer, RecordKind::Chain, M::RingType::divisor(), 0, indexer
+  );
+  detail::write_terms(writer, indexer, chain);
+}
+
+/**
+ * @brief Read a chain written by `write_chain`.
+ *
+ * Cells are inserted in one bulk insertion where the module supports it.
+ *
+ * @tparam M Module type; must match the basis dimension and ring divisor of
+ * the written chain.
+ * @param reader
+ * @return std::optional<M> The chain, or `std::nullopt` if the record is
+ * malformed or does not match `M`.
+ */
+template <Module M>
+requires detail::SerializableCell<typename M::BasisType> &&
+         SerializableRing<typename M::RingType>
+[[nodiscard]] std::optional<M> read_chain(BinaryReader& reader) {
+  constexpr std::size_t CCDIM =
+      detail::CubicalDimension<typename M::BasisType>::value;
+  const std::optional<CubeIndexer<CCDIM>> indexer = detail::read_header<CCDIM>(
+      reader, RecordKind::Chain, M::RingType::divisor(), 0
+  );
+  if (!indexer) {
+    return std::nullopt;
+  }
+  M chain = detail::read_terms<M>(reader, *indexer);
+  if (!reader.ok()) {
+    return std::nullopt;
+  }
+  return chain;
+}
+
+/**
+ * @brief Serialize the grading `grading` of cubical cells.
+ *
+ * @param writer
+ * @param grading
+ *
+ * @sa `read_grading`
+ */
+template <
+    AssociativeKey T, GradingResultType MIN, GradingResultType MAX,
+    template <typename...> typename MapType, typename Hash>
+requires detail::SerializableCell<T>
+void write_grading(
+    BinaryWriter& writer, const MapGrading<T, MIN, MAX, MapType, Hash>& grading
+) {
+  constexpr std::size_t CCDIM = detail::CubicalDimension<T>::value;
+  const auto cells = std::views::keys(grading.map());
+  const CubeIndexer<CCDIM> indexer = detail::bounding_indexer<CCDIM>(cells);
+  detail::write_header(writer, RecordKind::MapGrading, MIN, MAX, indexer);
+  const std::vector<std::size_t> indices =
+      detail::sorted_indices<T>(indexer, cells);
+  detail::write_indices(writer, indices);
+  for (std::size_t index : indices) {
+    writer.put_varint(
+        grading(indexer.template cell_at<T>(index)) - MIN
+    );
+  }
+}
+
+/** @copydoc write_grading() */
+template <
+    AssociativeKey T, GradingResultType MIN, GradingResultType MAX,
+    template <typename...> typename SetType, typename Hash>
+requires detail::SerializableCell<T>
+void write_grading(
+    BinaryWriter& writer, const SetGrading<T, MIN, MAX, SetType, Hash>& grading
+) {
+  constexpr std::size_t CCDIM = detail::CubicalDimension<T>::value;
+  const CubeIndexer<CCDIM> indexer =
+      detail::bounding_indexer<CCDIM>(grading.set());
+  detail::write_header(writer, RecordKind::SetGrading, MIN, MAX, indexer);
+  detail::write_indices(
+      writer, detail::sorted_indices<T>(indexer, grading.set())
+  );
+}
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+template <typename G>
+struct GradingReader {};
+
+template <
+    AssociativeKey T, GradingResultType MIN, GradingResultType MAX,
+    template <typename...> typename MapType, typename Hash>
+struct GradingReader<MapGrading<T, MIN, MAX, MapType, Hash>> {
+  using GradingType = MapGrading<T, MIN, MAX, MapType, Hash>;
+
+  [[nodiscard]] static std::optional<GradingType> read(BinaryReader& reader) {
+    constexpr std::size_t CCDIM = CubicalDimension<T>::value;
+    const std::optional<CubeIndexer<CCDIM>> indexer =
+        read_header<CCDIM>(reader, RecordKind::MapGrading, MIN, MAX);
+    if (!indexer) {
+      return std::nullopt;
+    }
+    const std::vector<std::size_t> indices =
+        read_indices(reader, indexer->size());
+    typename GradingType::GradingMapType grades;
+    if constexpr (requires { grades.reserve(indices.size()); }) {
+      grades.reserve(indices.size());
+    }
+    for (std::size_t index : indices) {
+      const std::uint64_t offset = reader.get_varint();
+      if (offset > MAX - MIN) {
+        reader.fail();
+      }
+      grades.emplace(indexer->template cell_at<T>(index), MIN + offset);
+    }
+    if (!reader.ok()) {
+      return std::nullopt;
+    }
+    return GradingType(std::move(grades));
+  }
+};
+
+template <
+    AssociativeKey T, GradingResultType MIN, GradingResultType MAX,
+    template <typename...> typename SetType, typename Hash>
+struct GradingReader<SetGrading<T, MIN, MAX, SetType, Hash>> {
+  using GradingType = SetGrading<T, MIN, MAX, SetType, Hash>;
+
+  [[nodiscard]] static std::optional<GradingType> read(BinaryReader& reader) {
+    constexpr std::size_t CCDIM = CubicalDimension<T>::value;
+    const std::optional<CubeIndexer<CCDIM>> indexer =
+        read_header<CCDIM>(reader, RecordKind::SetGrading, MIN, MAX);
+    if (!indexer) {
+      return std::nullopt;
+    }
+    const std::vector<std::size_t> indices =
+        read_indices(reader, indexer->size());
+    if (!reader.ok()) {
+      return std::nullopt;
+    }
+    typename GradingType::GradingSetType cells;
+    if constexpr (requires { cells.reserve(indices.size()); }) {
+      cells.reserve(indices.size());
+    }
+    for (std::size_t index : indices) {
+      cells.insert(indexer->template cell_at<T>(index));
+    }
+    return GradingType(std::move(cells));
+  }
+};
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
+/**
+ * @brief Read a grading written by `write_grading`.
+ *
+ * @tparam G `MapGrading` or `SetGrading` type over cubical cells; must match
+ * the kind, dimension, and grade bounds of the written grading.
+ * @param reader
+ * @return std::optional<G> The grading, or `std::nullopt` if the record is
+ * malformed or does not match `G`.
+ */
+template <typename G>
+requires requires(BinaryReader& reader) {
+  detail::GradingReader<G>::read(reader);
+}
+[[nodiscard]] std::optional<G> read_grading(BinaryReader& reader) {
+  return detail::GradingReader<G>::read(reader);
+}
+
+/**
+ * @brief Serialize the Morse complex `complex` of a cubical complex.
+ *
+ * The critical cells are stored in their order, each with its dimension and
+ * grade, followed by the Morse boundary of each, so that the complex can be
+ * restored without recomputing the matching.
+ *
+ * @tparam CC Chain complex type of the reduced complex, over cubical cells
+ * with coefficients modeling `SerializableRing`.
+ * @param writer
+ * @param complex
+ *
+ * @sa `read_morse_complex`
+ */
+template <DimensionedChainComplex CC>
+requires detail::SerializableCell<typename CC::CellType> &&
+         SerializableRing<typename CC::RingType>
+void write_morse_complex(BinaryWriter& writer, MorseComplex<CC>& complex) {
+  using C = typename CC::CellType;
+  constexpr std::size_t CCDIM = detail::CubicalDimension<C>::value;
+  const std::vector<C>& cells = complex.cells();
+  const CubeIndexer<CCDIM> indexer = detail::bounding_indexer<CCDIM>(cells);
+  detail::write_header(
+      writer, RecordKind::MorseComplex, CC::RingType::divisor(), 0, indexer
+  );
+
+  writer.put_varint(cells.size());
+  for (const C& cell : cells) {
+    writer.put_varint(indexer.index_of(cell));
+    writer.put_varint(complex.dimension(cell));
+    writer.put_varint(complex.grade(cell));
+  }
+  for (const C& cell : cells) {
+    detail::write_terms(
+        writer, indexer, complex.boundary_if(cell, [](const C&) {
+          return true;
+        })
+    );
+  }
+}
+
+/**
+ * @brief Read a Morse complex written by `write_morse_complex`.
+ *
+ * @tparam CC Chain complex type of the reduced complex; must match the cell
+ * dimension and ring divisor of the written complex.
+ * @param reader
+ * @return std::optional<MorseComplex<CC>> The complex, or `std::nullopt` if
+ * the record is malformed or does not match `CC`.
+ */
+template <DimensionedChainComplex CC>
+requires detail::SerializableCell<typename CC::CellType> &&
+         SerializableRing<typename CC::RingType>
+[[nodiscard]] std::optional<MorseComplex<CC>>
+read_morse_complex(BinaryReader& reader) {
+  using C = typename CC::CellType;
+  using M = typename MorseComplex<CC>::ChainType;
+  constexpr std::size_t CCDIM = detail::CubicalDimension<C>::value;
+  const std::optional<CubeIndexer<CCDIM>> indexer = detail::read_header<CCDIM>(
+      reader, RecordKind::MorseComplex, CC::RingType::divisor(), 0
+  );
+  if (!indexer) {
+    return std::nullopt;
+  }
+
+  // Each critical cell takes at least three bytes, which bounds the count.
+  const std::uint64_t count = reader.get_varint();
+  if (count > reader.remaining() / 3) {
+    return std::nullopt;
+  }
+  std::vector<C> cells;
+  std::vector<std::size_t> dimensions;
+  std::vector<GradingResultType> grades;
+  cells.reserve(count);
+  dimensions.reserve(count);
+  grades.reserve(count);
+  DefaultSet<C> critical;
+  for (std::uint64_t ace = 0; ace < count; ++ace) {
+    const std::uint64_t index = reader.get_varint();
+    if (index >= indexer->size()) {
+      return std::nullopt;
+    }
+    cells.push_back(indexer->template cell_at<C>(index));
+    dimensions.push_back(reader.get_varint());
+    grades.push_back(reader.get_varint());
+    if (!critical.insert(cells.back()).second) {
+      return std::nullopt;
+    }
+  }
+
+  std::vector<M> boundaries;
+  boundaries.reserve(count);
+  for (std::uint64_t ace = 0; ace < count && reader.ok(); ++ace) {
+    boundaries.push_back(detail::read_terms<M>(reader, *indexer));
+    for (const C& face : boundaries.back()) {
+      if (!critical.contains(face)) {
+        reader.fail();
+      }
+    }
+  }
+  if (!reader.ok()) {
+    return std::nullopt;
+  }
+  return MorseComplex<CC>(
+      std::move(cells), dimensions, grades, std::move(boundaries)
+  );
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_IO_SERIALIZE_H
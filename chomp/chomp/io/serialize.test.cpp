@@ -0,0 +1,218 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/algebra/modules.hpp>
+#include <chomp/complexes/complexes.hpp>
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/dense.hpp>
+#include <chomp/complexes/grading.hpp>
+#include <chomp/complexes/morse.hpp>
+#include <chomp/io/mapped.hpp>
+#include <chomp/io/serialize.hpp>
+#include <chomp/util/hash.hpp>
+
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+TEMPLATE_TEST_CASE(
+    "Chains round trip through the binary format", "[io]",
+    (DefaultModule<Cube<2>, Z<2>>), (DefaultModule<Cube<2>, Z<5>>),
+    (DefaultModule<Cube<3>, Z<3>, SortedModuleStorage>),
+    (DefaultModule<PackedCube<3>, Z<3>, FlatModuleStorage>),
+    (SmallChain<Cube<2>, Z<7>, 4>)
+) {
+  using M = TestType;
+  using C = typename M::BasisType;
+  using R = typename M::RingType;
+  constexpr std::size_t CCDIM = detail::CubicalDimension<C>::value;
+
+  M chain;
+  CubeOrthant<CCDIM> orthant;
+  for (std::size_t cell = 0; cell < 40; ++cell) {
+    orthant.fill(HypercubeCoordinate(3 + cell % 5));
+    orthant[0] = HypercubeCoordinate(10 + cell / 5);
+    chain.insert(C(orthant, cell % (1 << CCDIM)), R(int(cell % 4) + 1));
+  }
+
+  BinaryWriter writer;
+  write_chain(writer, chain);
+  write_chain(writer, M());
+  BinaryReader reader(writer.bytes());
+  const std::optional<M> read = read_chain<M>(reader);
+  REQUIRE(read);
+  REQUIRE(*read == chain);
+  const std::optional<M> empty = read_chain<M>(reader);
+  REQUIRE(empty);
+  REQUIRE(empty->size() == 0);
+  REQUIRE(reader.remaining() == 0);
+}
+
+TEST_CASE("Binary format rejects mismatched and damaged records", "[io]") {
+  DefaultModule<Cube<2>, Z<3>> chain;
+  chain.insert(Cube<2>({4, 5}, 0b01), Z<3>(2));
+  chain.insert(Cube<2>({9, 5}, 0b11), Z<3>(1));
+  BinaryWriter writer;
+  write_chain(writer, chain);
+  const std::span<const std::byte> bytes = writer.bytes();
+
+  BinaryReader wrong_ring(bytes);
+  REQUIRE_FALSE(read_chain<DefaultModule<Cube<2>, Z<5>>>(wrong_ring));
+  BinaryReader wrong_dimension(bytes);
+  REQUIRE_FALSE(read_chain<DefaultModule<Cube<3>, Z<3>>>(wrong_dimension));
+  BinaryReader wrong_kind(bytes);
+  REQUIRE_FALSE(read_grading<SetGrading<Cube<2>, 0, 3>>(wrong_kind));
+  for (std::size_t length = 0; length < bytes.size(); ++length) {
+    BinaryReader truncated(bytes.first(length));
+    REQUIRE_FALSE(read_chain<DefaultModule<Cube<2>, Z<3>>>(truncated));
+  }
+}
+
+TEST_CASE("Dense chains take about one byte per cell", "[io]") {
+  DefaultModule<Cube<3>, Z<2>> chain;
+  for (HypercubeCoordinate x = 0; x < 16; ++x) {
+    for (HypercubeCoordinate y = 0; y < 16; ++y) {
+      for (std::size_t extent = 0; extent < 8; ++extent) {
+        chain.insert(Cube<3>({x, y, 7}, extent), one<Z<2>>());
+      }
+    }
+  }
+  BinaryWriter writer;
+  write_chain(writer, chain);
+  REQUIRE(writer.bytes().size() < chain.size() + 32);
+}
+
+TEST_CASE("Gradings round trip through the binary format", "[io]") {
+  const MapGrading<Cube<2>, 1, 9> map_grading(
+      DefaultMap<Cube<2>, GradingResultType>{
+          {Cube<2>({0, 0}, 0b00), 1},
+          {Cube<2>({3, 1}, 0b10), 4},
+          {Cube<2>({2, 7}, 0b11), 9}
+      }
+  );
+  const SetGrading<Cube<2>, 0, 1> set_grading(
+      {Cube<2>({5, 5}, 0b01), Cube<2>({6, 5}, 0b10)}
+  );
+  BinaryWriter writer;
+  write_grading(writer, map_grading);
+  write_grading(writer, set_grading);
+
+  BinaryReader reader(writer.bytes());
+  const auto read_map = read_grading<MapGrading<Cube<2>, 1, 9>>(reader);
+  const auto read_set = read_grading<SetGrading<Cube<2>, 0, 1>>(reader);
+  REQUIRE(read_map);
+  REQUIRE(read_set);
+  REQUIRE(read_map->map() == map_grading.map());
+  REQUIRE(read_set->set() == set_grading.set());
+
+  BinaryReader wrong_bounds(writer.bytes());
+  REQUIRE_FALSE(read_grading<MapGrading<Cube<2>, 0, 9>>(wrong_bounds));
+}
+
+TEST_CASE("Gradings with a hasher round trip", "[io]") {
+  using Hash = MixedHash<Cube<2>>;
+  using Map = MapGrading<Cube<2>, 0, 5, DefaultMap, Hash>;
+  using Set = SetGrading<Cube<2>, 0, 1, DefaultSet, Hash>;
+  const Map map_grading(Map::GradingMapType{
+      {Cube<2>({1, 2}, 0b01), 0}, {Cube<2>({4, 0}, 0b11), 3}
+  });
+  const Set set_grading(Set::GradingSetType{
+      Cube<2>({0, 3}, 0b00), Cube<2>({2, 2}, 0b10)
+  });
+  BinaryWriter writer;
+  write_grading(writer, map_grading);
+  write_grading(writer, set_grading);
+
+  BinaryReader reader(writer.bytes());
+  const std::optional<Map> read_map = read_grading<Map>(reader);
+  const std::optional<Set> read_set = read_grading<Set>(reader);
+  REQUIRE(read_map);
+  REQUIRE(read_set);
+  REQUIRE(read_map->map() == map_grading.map());
+  REQUIRE(read_set->set() == set_grading.set());
+}
+
+TEST_CASE("Morse complexes round trip through mapped files", "[io]") {
+  // Annulus of grade 0 voxels inside a margin of grade 1
+  const std::vector<int> voxels = {
+      1, 1, 1, 1, 1,  //
+      1, 0, 0, 0, 1,  //
+      1, 0, 1, 0, 1,  //
+      1, 0, 0, 0, 1,  //
+      1, 1, 1, 1, 1,
+  };
+  using Grading = DenseGrading<2, 0, 1>;
+  using Complex = CubicalComplex<2, Grading, Z<3>>;
+  const CubeOrthant<2> maximum{4, 4};
+  Complex complex(
+      maximum, Grading({0, 0}, maximum, voxels.cbegin(), voxels.cend())
+  );
+  MorseComplex<Complex> morse(complex, complex.cells());
+
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "chomp_morse.bin";
+  BinaryWriter writer;
+  write_morse_complex(writer, morse);
+  REQUIRE(writer.save(path));
+
+  std::optional<MorseComplex<Complex>> read;
+  {
+    const MappedFile file(path);
+    REQUIRE(file.is_open());
+    BinaryReader reader(file.bytes());
+    read = read_morse_complex<Complex>(reader);
+  }
+  std::filesystem::remove(path);
+  REQUIRE(read);
+
+  REQUIRE_FALSE(morse.cells().empty());
+  REQUIRE(read->cells() == morse.cells());
+  for (const Cube<2>& cell : morse.cells()) {
+    REQUIRE(read->dimension(cell) == morse.dimension(cell));
+    REQUIRE(read->grade(cell) == morse.grade(cell));
+    REQUIRE(boundary(*read, cell) == boundary(morse, cell));
+    REQUIRE(coboundary(*read, cell) == coboundary(morse, cell));
+  }
+
+  // Damaged records, e.g. listing an ace twice, are rejected
+  const std::span<const std::byte> bytes = writer.bytes();
+  for (std::size_t length = 0; length < bytes.size(); ++length) {
+    BinaryReader truncated(bytes.first(length));
+    REQUIRE_FALSE(read_morse_complex<Complex>(truncated));
+  }
+  const CubeIndexer<2> indexer(CubeOrthant<2>{0, 0}, maximum);
+  BinaryWriter duplicate;
+  detail::write_header(duplicate, RecordKind::MorseComplex, 3, 0, indexer);
+  duplicate.put_varint(2);
+  for (std::size_t ace = 0; ace < 2; ++ace) {
+    duplicate.put_varint(indexer.index_of(Cube<2>({1, 1}, 0b00)));
+    duplicate.put_varint(0);
+    duplicate.put_varint(0);
+  }
+  for (std::size_t ace = 0; ace < 2; ++ace) {
+    detail::write_terms(
+        duplicate, indexer, MorseComplex<Complex>::ChainType()
+    );
+  }
+  BinaryReader duplicate_reader(duplicate.bytes());
+  REQUIRE_FALSE(read_morse_complex<Complex>(duplicate_reader));
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
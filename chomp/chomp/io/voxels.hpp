@@ -0,0 +1,926 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains memory-mapped readers for voxel image files
+ * (raw, NRRD, and NumPy `.npy`) and a grading function object reading the
+ * grade of each cube lazily from the mapped voxels.
+ *
+ * Files are mapped read-only with POSIX `mmap`, so voxels are paged in from
+ * the file on first access and nothing is copied or parsed ahead of time.
+ * Images larger than memory are processed in slabs along their slowest axis
+ * with `for_each_slab`, which hints the pages of each slab in before it is
+ * visited and releases them afterwards.
+ */
+
+#ifndef CHOMP_IO_VOXELS_H
+#define CHOMP_IO_VOXELS_H
+
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/io/mapped.hpp>
+#include <chomp/util/constants.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+/** @brief Scalar type of the voxels of an image file. */
+enum class VoxelType : std::uint8_t {
+  Int8,
+  UInt8,
+  Int16,
+  UInt16,
+  Int32,
+  UInt32,
+  Int64,
+  UInt64,
+  Float32,
+  Float64
+};
+
+/**
+ * @brief Size in bytes of a voxel of scalar type `type`.
+ *
+ * @param type
+ * @return std::size_t
+ */
+[[nodiscard]] constexpr std::size_t voxel_size(VoxelType type) noexcept {
+  switch (type) {
+  case VoxelType::Int8:
+  case VoxelType::UInt8:
+    return 1;
+  case VoxelType::Int16:
+  case VoxelType::UInt16:
+    return 2;
+  case VoxelType::Int32:
+  case VoxelType::UInt32:
+  case VoxelType::Float32:
+    return 4;
+  case VoxelType::Int64:
+  case VoxelType::UInt64:
+  case VoxelType::Float64:
+    return 8;
+  }
+  return 0;
+}
+
+/**
+ * @brief Layout of the voxels of an image file.
+ *
+ * Voxels are stored contiguously from `data_offset`, with axis `0` varying
+ * fastest; this is the order of orthants of `CubeIndexer`.
+ */
+struct VoxelLayout {
+  /** @brief Scalar type of each voxel. */
+  VoxelType type = VoxelType::UInt8;
+  /** @brief Whether multi-byte voxels are stored little-endian. */
+  bool little_endian = true;
+  /** @brief Number of voxels along each axis, fastest varying first. */
+  std::vector<std::size_t> shape;
+  /** @brief Offset in bytes of the first voxel in the file. */
+  std::size_t data_offset = 0;
+
+  /**
+   * @brief Total number of voxels.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t voxel_count() const noexcept {
+    std::size_t count = 1;
+    for (std::size_t length : shape) {
+      count *= length;
+    }
+    return count;
+  }
+};
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+[[nodiscard]] inline std::string_view trim(std::string_view text) noexcept {
+  const std::size_t first = text.find_first_not_of(" \t\r");
+  if (first == std::string_view::npos) {
+    return {};
+  }
+  const std::size_t last = text.find_last_not_of(" \t\r");
+  return text.substr(first, last - first + 1);
+}
+
+[[nodiscard]] inline std::string_view
+as_text(std::span<const std::byte> bytes) noexcept {
+  return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+}
+
+// Parse whitespace- or comma-separated sizes, skipping parentheses.
+[[nodiscard]] inline std::optional<std::vector<std::size_t>>
+parse_sizes(std::string_view text) {
+  std::vector<std::size_t> sizes;
+  const char* position = text.data();
+  const char* const end = text.data() + text.size();
+  while (position != end) {
+    if (std::strchr(" \t,()", *position) != nullptr) {
+      ++position;
+      continue;
+    }
+    std::size_t size = 0;
+    const auto [next, error] = std::from_chars(position, end, size);
+    if (error != std::errc() || size == 0) {
+      return std::nullopt;
+    }
+    sizes.push_back(size);
+    position = next;
+  }
+  return sizes;
+}
+
+[[nodiscard]] inline std::optional<VoxelType>
+nrrd_type(std::string_view name) noexcept {
+  struct Entry {
+    std::string_view name;
+    VoxelType type;
+  };
+  static constexpr std::array<Entry, 30> TYPES = {{
+      {"signed char", VoxelType::Int8},
+      {"int8", VoxelType::Int8},
+      {"int8_t", VoxelType::Int8},
+      {"uchar", VoxelType::UInt8},
+      {"unsigned char", VoxelType::UInt8},
+      {"uint8", VoxelType::UInt8},
+      {"uint8_t", VoxelType::UInt8},
+      {"short", VoxelType::Int16},
+      {"short int", VoxelType::Int16},
+      {"signed short", VoxelType::Int16},
+      {"int16", VoxelType::Int16},
+      {"int16_t", VoxelType::Int16},
+      {"ushort", VoxelType::UInt16},
+      {"unsigned short", VoxelType::UInt16},
+      {"uint16", VoxelType::UInt16},
+      {"uint16_t", VoxelType::UInt16},
+      {"int", VoxelType::Int32},
+      {"signed int", VoxelType::Int32},
+      {"int32", VoxelType::Int32},
+      {"int32_t", VoxelType::Int32},
+      {"uint", VoxelType::UInt32},
+      {"unsigned int", VoxelType::UInt32},
+      {"uint32", VoxelType::UInt32},
+      {"uint32_t", VoxelType::UInt32},
+      {"longlong", VoxelType::Int64},
+      {"int64", VoxelType::Int64},
+      {"ulonglong", VoxelType::UInt64},
+      {"uint64", VoxelType::UInt64},
+      {"float", VoxelType::Float32},
+      {"double", VoxelType::Float64},
+  }};
+  for (const Entry& entry : TYPES) {
+    if (entry.name == name) {
+      return entry.type;
+    }
+  }
+  return std::nullopt;
+}
+
+[[nodiscard]] inline std::optional<VoxelType>
+npy_type(char kind, std::size_t size) noexcept {
+  switch (kind) {
+  case 'b':
+    return size == 1 ? std::optional(VoxelType::UInt8) : std::nullopt;
+  case 'u':
+    switch (size) {
+    case 1:
+      return VoxelType::UInt8;
+    case 2:
+      return VoxelType::UInt16;
+    case 4:
+      return VoxelType::UInt32;
+    case 8:
+      return VoxelType::UInt64;
+    }
+    return std::nullopt;
+  case 'i':
+    switch (size) {
+    case 1:
+      return VoxelType::Int8;
+    case 2:
+      return VoxelType::Int16;
+    case 4:
+      return VoxelType::Int32;
+    case 8:
+      return VoxelType::Int64;
+    }
+    return std::nullopt;
+  case 'f':
+    switch (size) {
+    case 4:
+      return VoxelType::Float32;
+    case 8:
+      return VoxelType::Float64;
+    }
+    return std::nullopt;
+  }
+  return std::nullopt;
+}
+
+// Value of the quoted string or bare token following `key` in an npy header
+// dictionary.
+[[nodiscard]] inline std::optional<std::string_view>
+npy_field(std::string_view header, std::string_view key) noexcept {
+  std::size_t position = header.find(key);
+  if (position == std::string_view::npos) {
+    return std::nullopt;
+  }
+  position = header.find(':', position + key.size());
+  if (position == std::string_view::npos) {
+    return std::nullopt;
+  }
+  std::string_view rest = trim(header.substr(position + 1));
+  if (rest.empty()) {
+    return std::nullopt;
+  }
+  if (rest.front() == '\'' || rest.front() == '"') {
+    const std::size_t close = rest.find(rest.front(), 1);
+    if (close == std::string_view::npos) {
+      return std::nullopt;
+    }
+    return rest.substr(1, close - 1);
+  }
+  if (rest.front() == '(') {
+    const std::size_t close = rest.find(')');
+    if (close == std::string_view::npos) {
+      return std::nullopt;
+    }
+    return rest.substr(0, close + 1);
+  }
+  return rest.substr(0, rest.find_first_of(",}"));
+}
+
+template <typename U>
+[[nodiscard]] U load_voxel(const std::byte* data, bool swap) noexcept {
+  U bits;
+  std::memcpy(&bits, data, sizeof(U));
+  if constexpr (sizeof(U) > 1) {
+    if (swap) {
+      bits = std::byteswap(bits);
+    }
+  }
+  return bits;
+}
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
+/**
+ * @brief Parse the header of an NRRD file with attached raw data.
+ *
+ * The fields `type`, `dimension`, `sizes`, `encoding` (which must be `raw`)
+ * and `endian` are read; other fields are ignored. Detached data files and
+ * compressed encodings are not supported.
+ *
+ * @param bytes The bytes of the file.
+ * @return std::optional<VoxelLayout> The layout, or `std::nullopt` if the
+ * header is malformed, unsupported, or the file is too short for its data.
+ */
+[[nodiscard]] inline std::optional<VoxelLayout>
+parse_nrrd(std::span<const std::byte> bytes) {
+  const std::string_view text = detail::as_text(bytes);
+  if (!text.starts_with("NRRD000")) {
+    return std::nullopt;
+  }
+  VoxelLayout layout;
+  std::optional<VoxelType> type;
+  std::size_t dimension = 0;
+  bool raw = false;
+  bool endian_given = false;
+
+  std::size_t position = text.find('\n');
+  while (true) {
+    if (position == std::string_view::npos) {
+      return std::nullopt;
+    }
+    const std::size_t line_end = text.find('\n', position + 1);
+    if (line_end == std::string_view::npos) {
+      return std::nullopt;
+    }
+    const std::string_view line =
+        detail::trim(text.substr(position + 1, line_end - position - 1));
+    position = line_end;
+    if (line.empty()) {
+      break;
+    }
+    const std::size_t separator = line.find(':');
+    if (line.front() == '#' || separator == std::string_view::npos ||
+        line.substr(separator).starts_with(":=")) {
+      continue;
+    }
+    const std::string_view key = detail::trim(line.substr(0, separator));
+    const std::string_view value = detail::trim(line.substr(separator + 1));
+    if (key == "type") {
+      type = detail::nrrd_type(value);
+    } else if (key == "dimension") {
+      std::from_chars(value.data(), value.data() + value.size(), dimension);
+    } else if (key == "sizes") {
+      std::optional<std::vector<std::size_t>> sizes =
+          detail::parse_sizes(value);
+      if (!sizes) {
+        return std::nullopt;
+      }
+      layout.shape = std::move(*sizes);
+    } else if (key == "encoding") {
+      raw = value == "raw";
+    } else if (key == "endian") {
+      layout.little_endian = value == "little";
+      endian_given = true;
+    } else if (key == "data file" || key == "datafile") {
+      return std::nullopt;
+    }
+  }
+
+  if (!type || !raw || dimension == 0 || layout.shape.size() != dimension ||
+      (!endian_given && voxel_size(*type) > 1)) {
+    return std::nullopt;
+  }
+  layout.type = *type;
+  layout.data_offset = position + 1;
+  if (bytes.size() - std::min(bytes.size(), layout.data_offset) <
+      layout.voxel_count() * voxel_size(layout.type)) {
+    return std::nullopt;
+  }
+  return layout;
+}
+
+/**
+ * @brief Parse the header of a NumPy `.npy` file (format versions 1 to 3).
+ *
+ * Arrays in C order are reported with their axes reversed, so that axis `0` of
+ * the layout varies fastest; arrays in Fortran order keep their axes. Boolean,
+ * integer, and floating point arrays are supported.
+ *
+ * @param bytes The bytes of the file.
+ * @return std::optional<VoxelLayout> The layout, or `std::nullopt` if the
+ * header is malformed, unsupported, or the file is too short for its data.
+ */
+[[nodiscard]] inline std::optional<VoxelLayout>
+parse_npy(std::span<const std::byte> bytes) {
+  const std::string_view text = detail::as_text(bytes);
+  if (text.size() < 10 || !text.starts_with("\x93NUMPY")) {
+    return std::nullopt;
+  }
+  const auto byte_at = [&bytes](std::size_t index) {
+    return std::size_t(std::to_integer<unsigned char>(bytes[index]));
+  };
+  std::size_t header_length = byte_at(8) | byte_at(9) << 8;
+  std::size_t header_start = 10;
+  if (byte_at(6) >= 2) {
+    if (text.size() < 12) {
+      return std::nullopt;
+    }
+    header_length |= byte_at(10) << 16 | byte_at(11) << 24;
+    header_start = 12;
+  }
+  if (text.size() < header_start + header_length) {
+    return std::nullopt;
+  }
+  const std::string_view header = text.substr(header_start, header_length);
+
+  const std::optional<std::string_view> descr =
+      detail::npy_field(header, "'descr'");
+  const std::optional<std::string_view> order =
+      detail::npy_field(header, "'fortran_order'");
+  const std::optional<std::string_view> shape =
+      detail::npy_field(header, "'shape'");
+  if (!descr || !order || !shape || descr->size() < 3) {
+    return std::nullopt;
+  }
+
+  VoxelLayout layout;
+  std::size_t size = 0;
+  const std::string_view size_text = descr->substr(2);
+  if (std::from_chars(
+          size_text.data(), size_text.data() + size_text.size(), size
+      ).ptr != size_text.data() + size_text.size()) {
+    return std::nullopt;
+  }
+  const std::optional<VoxelType> type = detail::npy_type((*descr)[1], size);
+  if (!type) {
+    return std::nullopt;
+  }
+  layout.type = *type;
+  switch ((*descr)[0]) {
+  case '<':
+  case '|':
+    layout.little_endian = true;
+    break;
+  case '>':
+    layout.little_endian = false;
+    break;
+  case '=':
+    layout.little_endian = std::endian::native == std::endian::little;
+    break;
+  default:
+    return std::nullopt;
+  }
+
+  std::optional<std::vector<std::size_t>> sizes = detail::parse_sizes(*shape);
+  if (!sizes || sizes->empty()) {
+    return std::nullopt;
+  }
+  layout.shape = std::move(*sizes);
+  if (*order == "False") {
+    std::reverse(layout.shape.begin(), layout.shape.end());
+  } else if (*order != "True") {
+    return std::nullopt;
+  }
+  layout.data_offset = header_start + header_length;
+  if (bytes.size() - layout.data_offset <
+      layout.voxel_count() * voxel_size(layout.type)) {
+    return std::nullopt;
+  }
+  return layout;
+}
+
+/**
+ * @brief A memory-mapped voxel image.
+ *
+ * Voxel values are decoded on access from the mapped bytes of the file; the
+ * image is never copied. Objects are move-only; share one between gradings
+ * with `std::shared_ptr`.
+ *
+ * @sa `MappedVoxelGrading`, `for_each_slab`
+ */
+class VoxelImage {
+private:
+  MappedFile file;
+  VoxelLayout image_layout;
+  const std::byte* voxel_data;
+  bool swap_bytes;
+
+  VoxelImage(MappedFile&& file, VoxelLayout&& layout) noexcept :
+      file(std::move(file)), image_layout(std::move(layout)),
+      voxel_data(this->file.bytes().data() + image_layout.data_offset),
+      swap_bytes(
+          image_layout.little_endian != (std::endian::native ==
+                                         std::endian::little)
+      ) {}
+
+  // Bytes of the layers [first_layer, last_layer) along the slowest axis
+  [[nodiscard]] std::pair<std::size_t, std::size_t>
+  layer_bytes(std::size_t first_layer, std::size_t last_layer) const noexcept {
+    const std::size_t layer_size = image_layout.voxel_count() /
+                                   image_layout.shape.back() *
+                                   voxel_size(image_layout.type);
+    return {
+        image_layout.data_offset + first_layer * layer_size,
+        (last_layer - first_layer) * layer_size
+    };
+  }
+
+public:
+  /**
+   * @brief Map a raw file of voxels with the given layout.
+   *
+   * @param path
+   * @param layout Layout of the voxels; `shape` must be non-empty.
+   * @return std::optional<VoxelImage> The image, or `std::nullopt` if the file
+   * cannot be mapped or is too short for `layout`.
+   */
+  [[nodiscard]] static std::optional<VoxelImage>
+  open_raw(const std::filesystem::path& path, VoxelLayout layout) {
+    MappedFile file(path);
+    const std::size_t data_size =
+        layout.voxel_count() * voxel_size(layout.type);
+    if (!file.is_open() || layout.shape.empty() ||
+        file.bytes().size() < layout.data_offset + data_size) {
+      return std::nullopt;
+    }
+    return VoxelImage(std::move(file), std::move(layout));
+  }
+
+  /**
+   * @brief Map an NRRD file with attached raw data.
+   *
+   * @param path
+   * @return std::optional<VoxelImage> The image, or `std::nullopt` if the file
+   * cannot be mapped or its header is rejected by `parse_nrrd`.
+   */
+  [[nodiscard]] static std::optional<VoxelImage>
+  open_nrrd(const std::filesystem::path& path) {
+    MappedFile file(path);
+    std::optional<VoxelLayout> layout = parse_nrrd(file.bytes());
+    if (!layout) {
+      return std::nullopt;
+    }
+    return VoxelImage(std::move(file), std::move(*layout));
+  }
+
+  /**
+   * @brief Map a NumPy `.npy` file.
+   *
+   * @param path
+   * @return std::optional<VoxelImage> The image, or `std::nullopt` if the file
+   * cannot be mapped or its header is rejected by `parse_npy`.
+   */
+  [[nodiscard]] static std::optional<VoxelImage>
+  open_npy(const std::filesystem::path& path) {
+    MappedFile file(path);
+    std::optional<VoxelLayout> layout = parse_npy(file.bytes());
+    if (!layout) {
+      return std::nullopt;
+    }
+    return VoxelImage(std::move(file), std::move(*layout));
+  }
+
+  /**
+   * @brief Map an NRRD or NumPy file, recognized by its leading magic bytes.
+   *
+   * @param path
+   * @return std::optional<VoxelImage> The image, or `std::nullopt` if the file
+   * is neither or cannot be read.
+   */
+  [[nodiscard]] static std::optional<VoxelImage>
+  open(const std::filesystem::path& path) {
+    MappedFile file(path);
+    std::optional<VoxelLayout> layout = parse_nrrd(file.bytes());
+    if (!layout) {
+      layout = parse_npy(file.bytes());
+    }
+    if (!layout) {
+      return std::nullopt;
+    }
+    return VoxelImage(std::move(file), std::move(*layout));
+  }
+
+  VoxelImage(const VoxelImage&) = delete;
+  VoxelImage& operator=(const VoxelImage&) = delete;
+  /** @brief Move constructor. */
+  VoxelImage(VoxelImage&&) noexcept = default;
+  /** @brief Move assignment. */
+  VoxelImage& operator=(VoxelImage&&) noexcept = default;
+  ~VoxelImage() = default;
+
+  /**
+   * @brief Layout of the voxels in the file.
+   *
+   * @return const VoxelLayout&
+   */
+  [[nodiscard]] const VoxelLayout& layout() const noexcept {
+    return image_layout;
+  }
+
+  /**
+   * @brief Number of axes of the image.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t dimension() const noexcept {
+    return image_layout.shape.size();
+  }
+
+  /**
+   * @brief Number of voxels along each axis, fastest varying first.
+   *
+   * @return const std::vector<std::size_t>&
+   */
+  [[nodiscard]] const std::vector<std::size_t>& shape() const noexcept {
+    return image_layout.shape;
+  }
+
+  /**
+   * @brief Value of the voxel with linear index `index` (axis `0` varying
+   * fastest).
+   *
+   * @param index Less than `layout().voxel_count()`.
+   * @return double
+   */
+  [[nodiscard]] double value(std::size_t index) const noexcept {
+    const std::byte* data = voxel_data + index * voxel_size(image_layout.type);
+    switch (image_layout.type) {
+    case VoxelType::Int8:
+      return static_cast<std::int8_t>(std::to_integer<std::uint8_t>(*data));
+    case VoxelType::UInt8:
+      return std::to_integer<std::uint8_t>(*data);
+    case VoxelType::Int16:
+      return static_cast<std::int16_t>(
+          detail::load_voxel<std::uint16_t>(data, swap_bytes)
+      );
+    case VoxelType::UInt16:
+      return detail::load_voxel<std::uint16_t>(data, swap_bytes);
+    case VoxelType::Int32:
+      return static_cast<std::int32_t>(
+          detail::load_voxel<std::uint32_t>(data, swap_bytes)
+      );
+    case VoxelType::UInt32:
+      return detail::load_voxel<std::uint32_t>(data, swap_bytes);
+    case VoxelType::Int64:
+      return static_cast<double>(static_cast<std::int64_t>(
+          detail::load_voxel<std::uint64_t>(data, swap_bytes)
+      ));
+    case VoxelType::UInt64:
+      return static_cast<double>(
+          detail::load_voxel<std::uint64_t>(data, swap_bytes)
+      );
+    case VoxelType::Float32:
+      return std::bit_cast<float>(
+          detail::load_voxel<std::uint32_t>(data, swap_bytes)
+      );
+    case VoxelType::Float64:
+      return std::bit_cast<double>(
+          detail::load_voxel<std::uint64_t>(data, swap_bytes)
+      );
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Hint that the layers `[first_layer, last_layer)` along the slowest
+   * axis are about to be read.
+   *
+   * @param first_layer
+   * @param last_layer At most `shape().back()`.
+   */
+  void prefetch(std::size_t first_layer, std::size_t last_layer)
+      const noexcept {
+    const auto [offset, length] = layer_bytes(first_layer, last_layer);
+    file.prefetch(offset, length);
+  }
+
+  /**
+   * @brief Release the resident pages of the layers `[first_layer,
+   * last_layer)` along the slowest axis; they are read again from the file if
+   * accessed later.
+   *
+   * @param first_layer
+   * @param last_layer At most `shape().back()`.
+   */
+  void evict(std::size_t first_layer, std::size_t last_layer) const noexcept {
+    const auto [offset, length] = layer_bytes(first_layer, last_layer);
+    file.evict(offset, length);
+  }
+};
+
+/**
+ * @brief Visit a voxel image in slabs of `layers` layers along its slowest
+ * axis, so that only about one slab is resident in memory at a time.
+ *
+ * Each slab, together with the preceding layer (which grades the lower faces
+ * of its first layer), is prefetched before `visitor(first_layer,
+ * last_layer)` is called for the layers `[first_layer, last_layer)`, and
+ * evicted afterwards. The visitor typically constructs a `MappedVoxelGrading`
+ * whose window is the slab, i.e. with origin at `first_layer` and
+ * `last_layer - first_layer` voxels along the slowest axis.
+ *
+ * @tparam F Function object type invocable on two `std::size_t`.
+ * @param image
+ * @param layers Number of layers per slab; positive.
+ * @param visitor
+ */
+template <typename F>
+requires std::invocable<F&, std::size_t, std::size_t>
+void for_each_slab(const VoxelImage& image, std::size_t layers, F&& visitor) {
+  const std::size_t total = image.shape().back();
+  for (std::size_t first = 0; first < total; first += layers) {
+    const std::size_t last = std::min(first + layers, total);
+    image.prefetch(first == 0 ? 0 : first - 1, last);
+    std::invoke(visitor, first, last);
+    image.evict(first, last);
+  }
+}
+
+/**
+ * @brief A function object modeling `BoundedGrading` that grades the cubes of
+ * a box of orthants by the voxels of a memory-mapped image.
+ *
+ * The top-dimensional cube of orthant `o` is graded by the voxel at
+ * `origin + o`, transformed by `F` and clamped to `[MIN, MAX]`; NaN values
+ * and cells outside the window have grade `MAX`. Every other cell is graded
+ * by the minimum grade of the top-dimensional cubes of the image containing
+ * it, as in `DenseGrading`, computed on each call from at most `2^CCDIM`
+ * voxels. These include the voxels just before the window (its halo), so
+ * each cell is graded the same by every window containing it as by a grading
+ * of the whole image, and windows tiling the image agree along their seams.
+ * Nothing is precomputed, so the grading is cheap to construct and copy;
+ * wrap it in `CachedGradingWrapper` if cells are graded repeatedly.
+ *
+ * As orthant coordinates are `HypercubeCoordinate`, a window has at most 256
+ * voxels along each axis; larger images are graded by several windows, e.g.
+ * one per slab of `for_each_slab`.
+ *
+ * @tparam CCDIM Ambient dimension of the hypercubical grid; the dimension of
+ * the image.
+ * @tparam MIN The minimal grade.
+ * @tparam MAX The maximal grade.
+ * @tparam C Cell type modeling `CubicalCell`; default `Cube<CCDIM>`.
+ * @tparam F Function object type mapping a voxel value (`double`) to a value
+ * convertible to `double`; the identity by default, so voxel values are
+ * truncated to grades.
+ *
+ * @sa `VoxelImage`, `DenseGrading`
+ */
+template <
+    std::size_t CCDIM, GradingResultType MIN, GradingResultType MAX,
+    CubicalCell<CCDIM> C = Cube<CCDIM>, typename F = std::identity>
+requires(MIN <= MAX) && std::regular_invocable<const F&, double>
+class MappedVoxelGrading {
+private:
+  std::shared_ptr<const VoxelImage> voxel_image;
+  std::array<std::size_t, CCDIM> window_origin;
+  std::array<std::size_t, CCDIM> window_shape{};
+  std::array<std::size_t, CCDIM> voxel_strides{};
+  F transform;
+
+  // Window shape running to the end of the image along each axis
+  static constexpr std::array<std::size_t, CCDIM> UNBOUNDED = [] {
+    std::array<std::size_t, CCDIM> shape;
+    shape.fill(std::numeric_limits<std::size_t>::max());
+    return shape;
+  }();
+
+  // Grade of the voxel at `voxel` of the image
+  [[nodiscard]] GradingResultType
+  grade_voxel(const std::array<std::size_t, CCDIM>& voxel) const noexcept {
+    std::size_t index = 0;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      index += voxel[axis] * voxel_strides[axis];
+    }
+    const double value =
+        static_cast<double>(std::invoke(transform, voxel_image->value(index)));
+    if (std::isnan(value)) {
+      return MAX;
+    }
+    return static_cast<GradingResultType>(std::clamp(
+        value, static_cast<double>(MIN), static_cast<double>(MAX)
+    ));
+  }
+
+public:
+  /** @brief The type expected as input to the call operator. */
+  using InputType = C;
+  /** @brief The minimal output value. */
+  using Minimum = std::integral_constant<GradingResultType, MIN>;
+  /** @brief The maximal output value. */
+  using Maximum = std::integral_constant<GradingResultType, MAX>;
+
+  /**
+   * @brief Grade by the window of `image` of `shape` voxels starting at the
+   * voxel `origin`.
+   *
+   * The window is clamped to the image and to 256 voxels along each axis. It
+   * is empty, grading every cell `MAX`, if the dimension of `image` is not
+   * `CCDIM`.
+   *
+   * @param image Shared image.
+   * @param origin Voxel at orthant zero.
+   * @param shape Number of voxels of the window along each axis.
+   * @param transform Map from voxel values to grades.
+   */
+  MappedVoxelGrading(
+      std::shared_ptr<const VoxelImage> image,
+      const std::array<std::size_t, CCDIM>& origin,
+      const std::array<std::size_t, CCDIM>& shape, F transform = F()
+  ) :
+      voxel_image(std::move(image)), window_origin(origin),
+      transform(std::move(transform)) {
+    if (voxel_image->dimension() != CCDIM) {
+      return;
+    }
+    std::size_t stride = 1;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      const std::size_t length = voxel_image->shape()[axis];
+      window_shape[axis] = std::min<std::size_t>(
+          {shape[axis],
+           length - std::min(window_origin[axis], length),
+           std::size_t(std::numeric_limits<HypercubeCoordinate>::max()) + 1}
+      );
+      voxel_strides[axis] = stride;
+      stride *= length;
+    }
+  }
+
+  /**
+   * @brief Grade by the window of `image` starting at the voxel `origin` and
+   * running to the end of the image (or 256 voxels) along each axis.
+   *
+   * @param image Shared image.
+   * @param origin Voxel at orthant zero.
+   * @param transform Map from voxel values to grades.
+   */
+  explicit MappedVoxelGrading(
+      std::shared_ptr<const VoxelImage> image,
+      const std::array<std::size_t, CCDIM>& origin = {}, F transform = F()
+  ) :
+      MappedVoxelGrading(
+          std::move(image), origin, UNBOUNDED, std::move(transform)
+      ) {}
+
+  /**
+   * @brief Call the function object with `input` and return the grade.
+   *
+   * @param input
+   * @return GradingResultType
+   */
+  GradingResultType operator()(const InputType& input) const noexcept {
+    std::array<std::size_t, CCDIM> voxel;
+    std::size_t free_axes = 0;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      const std::size_t coordinate = input.coordinate(axis);
+      if (coordinate >= window_shape[axis]) {
+        return MAX;
+      }
+      voxel[axis] = window_origin[axis] + coordinate;
+      // Axes without extent where the cube has a top coface in the image,
+      // possibly in the halo before the window
+      if (((input.extent() >> axis) & 1) == 0 && voxel[axis] > 0) {
+        free_axes |= std::size_t(1) << axis;
+      }
+    }
+
+    // Minimum over the top cofaces at orthant - delta for every subset delta
+    // of the free axes
+    GradingResultType grade = MAX;
+    std::size_t delta = free_axes;
+    while (true) {
+      std::array<std::size_t, CCDIM> position = voxel;
+      for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+        position[axis] -= (delta >> axis) & 1;
+      }
+      grade = std::min(grade, grade_voxel(position));
+      if (delta == 0 || grade == MIN) {
+        return grade;
+      }
+      delta = (delta - 1) & free_axes;
+    }
+  }
+
+  /**
+   * @brief Grade each of `cells`, storing the results in `grades`.
+   *
+   * @param cells
+   * @param grades Output; at least as long as `cells`.
+   */
+  void grade_many(
+      std::span<const InputType> cells, std::span<GradingResultType> grades
+  ) const noexcept {
+    for (std::size_t cell = 0; cell < cells.size(); ++cell) {
+      grades[cell] = (*this)(cells[cell]);
+    }
+  }
+
+  /**
+   * @brief Whether the window holds no voxel, e.g. as the image is not of
+   * dimension `CCDIM`.
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool empty() const noexcept {
+    return std::ranges::find(window_shape, 0) != window_shape.end();
+  }
+
+  /**
+   * @brief Maximum orthant of the window, for constructing a
+   * `CubicalComplex` over it with minimum orthant zero.
+   *
+   * Requires a nonempty window.
+   *
+   * @return CubeOrthant<CCDIM>
+   */
+  [[nodiscard]] CubeOrthant<CCDIM> maximum() const noexcept {
+    CubeOrthant<CCDIM> result;
+    for (std::size_t axis = 0; axis < CCDIM; ++axis) {
+      result[axis] = static_cast<HypercubeCoordinate>(window_shape[axis] - 1);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Voxel of the image at orthant zero.
+   *
+   * @return const std::array<std::size_t, CCDIM>&
+   */
+  [[nodiscard]] const std::array<std::size_t, CCDIM>& origin() const noexcept {
+    return window_origin;
+  }
+};
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_IO_VOXELS_H
@@ -0,0 +1,230 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/complexes/cubical.hpp>
+#include <chomp/complexes/dense.hpp>
+#include <chomp/complexes/grading.hpp>
+#include <chomp/io/voxels.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+namespace {
+
+// Temporary file removed at the end of the test
+class TemporaryFile {
+  std::filesystem::path file_path;
+
+public:
+  TemporaryFile(const std::string& name, const std::string& contents) :
+      file_path(std::filesystem::temp_directory_path() / name) {
+    std::ofstream stream(file_path, std::ios::binary);
+    stream.write(contents.data(), std::streamsize(contents.size()));
+  }
+  TemporaryFile(const TemporaryFile&) = delete;
+  TemporaryFile& operator=(const TemporaryFile&) = delete;
+  ~TemporaryFile() {
+    std::filesystem::remove(file_path);
+  }
+
+  [[nodiscard]] const std::filesystem::path& path() const noexcept {
+    return file_path;
+  }
+};
+
+std::string little_endian_u16(const std::vector<std::uint16_t>& values) {
+  std::string bytes;
+  for (std::uint16_t value : values) {
+    bytes.push_back(char(value & 0xFF));
+    bytes.push_back(char(value >> 8));
+  }
+  return bytes;
+}
+
+std::string big_endian_u16(const std::vector<std::uint16_t>& values) {
+  std::string bytes;
+  for (std::uint16_t value : values) {
+    bytes.push_back(char(value >> 8));
+    bytes.push_back(char(value & 0xFF));
+  }
+  return bytes;
+}
+
+// Voxels of a 4x3x2 image, axis 0 varying fastest
+const std::vector<std::uint16_t> VOXELS = {
+    4, 2, 7, 1, 5, 3, 6, 0, 9, 8, 2, 4,
+    1, 1, 3, 5, 7, 9, 2, 4, 6, 8, 0, 3
+};
+
+void require_matches_dense(const std::shared_ptr<const VoxelImage>& image) {
+  using Grading = MappedVoxelGrading<3, 0, 8>;
+  const Grading grading(image);
+  REQUIRE(grading.maximum() == CubeOrthant<3>{3, 2, 1});
+
+  const DenseGrading<3, 0, 8> dense(
+      CubeOrthant<3>{0, 0, 0}, grading.maximum(), VOXELS.cbegin(),
+      VOXELS.cend()
+  );
+  const CubeIndexer<3>& indexer = dense.indexer();
+  for (std::size_t index = 0; index < indexer.size(); ++index) {
+    const Cube<3> cell = indexer.cell_at<Cube<3>>(index);
+    REQUIRE(grading(cell) == dense(cell));
+  }
+}
+
+}  // namespace
+
+TEST_CASE("MappedVoxelGrading models BoundedGrading", "[io]") {
+  CHECK(BoundedGrading<MappedVoxelGrading<3, 0, 8>>);
+  CHECK(BoundedGrading<MappedVoxelGrading<2, 1, 4, PackedCube<2>>>);
+}
+
+TEST_CASE("VoxelImage maps raw, NRRD and NumPy files", "[io]") {
+  SECTION("Raw") {
+    const TemporaryFile file("chomp_voxels.raw", little_endian_u16(VOXELS));
+    VoxelLayout layout;
+    layout.type = VoxelType::UInt16;
+    layout.shape = {4, 3, 2};
+    std::optional<VoxelImage> image = VoxelImage::open_raw(file.path(), layout);
+    REQUIRE(image);
+    REQUIRE(image->dimension() == 3);
+    REQUIRE(image->value(8) == 9);
+    require_matches_dense(std::make_shared<VoxelImage>(std::move(*image)));
+
+    layout.shape = {4, 3, 3};
+    REQUIRE_FALSE(VoxelImage::open_raw(file.path(), layout));
+  }
+
+  SECTION("NRRD") {
+    const TemporaryFile file(
+        "chomp_voxels.nrrd", "NRRD0004\n"
+                             "# Complete NRRD file format specification at:\n"
+                             "type: unsigned short\n"
+                             "dimension: 3\n"
+                             "sizes: 4 3 2\n"
+                             "endian: big\n"
+                             "encoding: raw\n"
+                             "\n" +
+                                 big_endian_u16(VOXELS)
+    );
+    std::optional<VoxelImage> image = VoxelImage::open(file.path());
+    REQUIRE(image);
+    REQUIRE(image->layout().type == VoxelType::UInt16);
+    REQUIRE_FALSE(image->layout().little_endian);
+    require_matches_dense(std::make_shared<VoxelImage>(std::move(*image)));
+  }
+
+  SECTION("NumPy") {
+    // C order: shape is listed slowest axis first
+    std::string header =
+        "{'descr': '<u2', 'fortran_order': False, 'shape': (2, 3, 4), }";
+    header.append(128 - 10 - header.size() - 1, ' ');
+    header.push_back('\n');
+    const TemporaryFile file(
+        "chomp_voxels.npy", std::string("\x93NUMPY\x01\x00", 8) +
+                                char(header.size()) + '\0' + header +
+                                little_endian_u16(VOXELS)
+    );
+    std::optional<VoxelImage> image = VoxelImage::open_npy(file.path());
+    REQUIRE(image);
+    REQUIRE(image->shape() == std::vector<std::size_t>{4, 3, 2});
+    require_matches_dense(std::make_shared<VoxelImage>(std::move(*image)));
+  }
+
+  SECTION("Rejected") {
+    const TemporaryFile compressed(
+        "chomp_voxels_gzip.nrrd",
+        "NRRD0004\ntype: uchar\ndimension: 1\nsizes: 4\nencoding: gzip\n\n1234"
+    );
+    REQUIRE_FALSE(VoxelImage::open(compressed.path()));
+    const TemporaryFile truncated(
+        "chomp_voxels_short.nrrd",
+        "NRRD0004\ntype: uchar\ndimension: 1\nsizes: 8\nencoding: raw\n\n1234"
+    );
+    REQUIRE_FALSE(VoxelImage::open(truncated.path()));
+    REQUIRE_FALSE(VoxelImage::open("chomp_voxels_missing.npy"));
+  }
+}
+
+TEST_CASE("MappedVoxelGrading grades windows of slabs", "[io]") {
+  const TemporaryFile file("chomp_slabs.raw", little_endian_u16(VOXELS));
+  VoxelLayout layout;
+  layout.type = VoxelType::UInt16;
+  layout.shape = {4, 3, 2};
+  std::optional<VoxelImage> opened = VoxelImage::open_raw(file.path(), layout);
+  REQUIRE(opened);
+  const auto image = std::make_shared<const VoxelImage>(std::move(*opened));
+
+  // One slab per layer along axis 2; each window holds one 4x3 layer. Every
+  // cell, including the faces on the seam between the slabs, is graded as by
+  // a grading of the whole image.
+  const DenseGrading<3, 0, 8> dense(
+      CubeOrthant<3>{0, 0, 0}, CubeOrthant<3>{3, 2, 1}, VOXELS.cbegin(),
+      VOXELS.cend()
+  );
+  std::vector<std::size_t> slabs;
+  std::size_t graded = 0;
+  for_each_slab(*image, 1, [&](std::size_t first, std::size_t last) {
+    REQUIRE(last == first + 1);
+    slabs.push_back(first);
+    const MappedVoxelGrading<3, 0, 8> window(
+        image, {0, 0, first}, {4, 3, last - first}
+    );
+    REQUIRE(window.maximum() == CubeOrthant<3>{3, 2, 0});
+    const CubeIndexer<3> indexer(CubeOrthant<3>{0, 0, 0}, window.maximum());
+    for (std::size_t index = 0; index < indexer.size(); ++index) {
+      const Cube<3> cell = indexer.cell_at<Cube<3>>(index);
+      const Cube<3> whole(
+          {cell.coordinate(0), cell.coordinate(1),
+           static_cast<HypercubeCoordinate>(cell.coordinate(2) + first)},
+          cell.extent()
+      );
+      REQUIRE(window(cell) == dense(whole));
+      ++graded;
+    }
+    // Cells past the slab belong to the next window
+    REQUIRE(window(Cube<3>({0, 0, 1}, 0b000)) == 8);
+  });
+  REQUIRE(slabs == std::vector<std::size_t>{0, 1});
+  REQUIRE(graded == dense.indexer().size());
+
+  // An unbounded window runs to the end of the image
+  const MappedVoxelGrading<3, 0, 8> rest(image, {1, 0, 1});
+  REQUIRE(rest.maximum() == CubeOrthant<3>{2, 2, 0});
+  REQUIRE(rest(Cube<3>({0, 0, 0}, 0b000)) == dense(Cube<3>({1, 0, 1}, 0b000)));
+
+  // Images of another dimension give an empty window
+  const MappedVoxelGrading<2, 0, 8> mismatched(image);
+  REQUIRE(mismatched.empty());
+  REQUIRE(mismatched(Cube<2>({0, 0}, 0b11)) == 8);
+  REQUIRE_FALSE(rest.empty());
+
+  // Voxel values mapped through a transform; out of the window is maximal
+  const auto halve = [](double value) { return value / 2; };
+  const MappedVoxelGrading<3, 0, 3, Cube<3>, decltype(halve)> halved(
+      image, {}, halve
+  );
+  REQUIRE(halved(Cube<3>({0, 0, 0}, 0b111)) == 2);
+  REQUIRE(halved(Cube<3>({0, 2, 1}, 0b111)) == 3);
+  REQUIRE(halved(Cube<3>({3, 2, 2}, 0b000)) == 3);
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
@@ -5,21 +5,30 @@
  */
 
 /** @file
- * @brief This header contains an LRU cache implementation specialized for
- * memory efficiency in CHomP3R data structures.
+ * @brief This header contains LRU cache implementations specialized for
+ * memory efficiency in CHomP3R data structures, including a sharded variant
+ * safe for concurrent use and a contiguous CLOCK cache.
  */
 
 #ifndef CHOMP_UTIL_CACHE_H
 #define CHOMP_UTIL_CACHE_H
 
 #include <chomp/util/concepts.hpp>
+#include <chomp/util/constants.hpp>
+#include <chomp/util/hash.hpp>
+#include <chomp/util/hashtable.hpp>
+#include <chomp/util/statistics.hpp>
 
 #include <concepts>
 #include <cstddef>
 #include <functional>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace chomp::core {
 
@@ -35,20 +44,30 @@ namespace chomp::core {
  * @tparam V Value type.
  * @tparam MapType The type of map, which is expected to be either `std::map`,
  * `std::unordered_map`, or another type structurally equivalent.
+ * @tparam Allocator Allocator template of the list of entries, e.g.
+ * `ArenaAllocator` together with `ArenaDefaultMap` as `MapType` to keep the
+ * cache off the global allocator.
+ * @tparam Hash Hash function object type for `K`, substituted for that of
+ * `MapType` when it is a hashed map (see `RebindHash`); unused otherwise.
  */
 template <
     AssociativeKey K, typename V,
-    template <typename...> typename MapType = DefaultMap>
+    template <typename...> typename MapType = DefaultMap,
+    template <typename> typename Allocator = std::allocator,
+    typename Hash = std::hash<K>>
 class LRUCache {
 private:
-  std::list<std::pair<K, V>> cache_list;
+  using ListType = std::list<std::pair<K, V>, Allocator<std::pair<K, V>>>;
+  ListType cache_list;
 
-  using ListIterType = typename std::list<std::pair<K, V>>::const_iterator;
-  MapType<K, ListIterType> cache_map;
-  using MapIterType = typename MapType<K, ListIterType>::iterator;
+  using ListIterType = typename ListType::const_iterator;
+  using CacheMapType = RebindHashType<MapType<K, ListIterType>, Hash>;
+  CacheMapType cache_map;
+  using MapIterType = typename CacheMapType::iterator;
 
   std::function<V(const K&)> construct_value;
   std::size_t cache_max_size;
+  [[no_unique_address]] detail::CacheCounters<> counters;
 
   void recompute_iterators() {
     // When copy constructed/assigned, the iterators in the map point to the
@@ -92,7 +111,7 @@ public:
   LRUCache(const LRUCache& other) noexcept :
       cache_list(other.cache_list), cache_map(other.cache_map),
       construct_value(other.construct_value),
-      cache_max_size(other.cache_max_size) {
+      cache_max_size(other.cache_max_size), counters(other.counters) {
     recompute_iterators();
   }
 
@@ -117,6 +136,7 @@ public:
     cache_map = other.cache_map;
     construct_value = other.construct_value;
     cache_max_size = other.cache_max_size;
+    counters = other.counters;
     recompute_iterators();
     return *this;
   }
@@ -156,7 +176,9 @@ public:
     // Value is not present in the cache.
     // Construct it, add to the cache, and return (a reference to) the object.
     if (find_result == cache_map.end()) {
-      cache_list.push_front(std::make_pair(key, construct_value(key)));
+      cache_list.push_front(std::make_pair(key, counters.record_miss([&]() {
+        return construct_value(key);
+      })));
       cache_map[std::forward<TFor>(key)] = cache_list.cbegin();
       // Remove from end of cache if necessary.
       if (cache_map.size() > cache_max_size) {
@@ -164,12 +186,14 @@ public:
         it--;
         cache_map.erase(it->first);
         cache_list.pop_back();
+        counters.record_eviction();
       }
       return cache_list.front().second;
     }
 
     // Value is present in the cache.
     // Move the list node corresponding to this key to the front and return.
+    counters.record_hit();
     cache_list.splice(cache_list.cbegin(), cache_list, find_result->second);
     return find_result->second->second;
   }
@@ -185,6 +209,53 @@ public:
     return cache_map.contains(key);
   }
 
+  /**
+   * @brief Remove the entry of `key`, if cached, so that its value is
+   * constructed anew on its next access.
+   *
+   * @param key
+   * @return true If an entry was removed.
+   * @return false If `key` was not cached.
+   */
+  bool erase(const K& key) {
+    const MapIterType find_result = cache_map.find(key);
+    if (find_result == cache_map.end()) {
+      return false;
+    }
+    cache_list.erase(find_result->second);
+    cache_map.erase(find_result);
+    return true;
+  }
+
+  /**
+   * @brief Remove the entries whose keys satisfy `pred`.
+   *
+   * @tparam Pred Predicate type on (constant references to) keys.
+   * @param pred
+   * @return std::size_t Number of entries removed.
+   */
+  template <typename Pred>
+  requires std::predicate<const Pred&, const K&>
+  std::size_t erase_if(const Pred& pred) {
+    std::size_t erased = 0;
+    for (ListIterType it = cache_list.cbegin(); it != cache_list.cend();) {
+      if (pred(it->first)) {
+        cache_map.erase(it->first);
+        it = cache_list.erase(it);
+        ++erased;
+      } else {
+        ++it;
+      }
+    }
+    return erased;
+  }
+
+  /** @brief Remove every entry. */
+  void clear() noexcept {
+    cache_map.clear();
+    cache_list.clear();
+  }
+
   /**
    * @brief Get the current size of the container.
    *
@@ -201,6 +272,528 @@ public:
   [[nodiscard]] std::size_t max_size() const noexcept {
     return cache_max_size;
   }
+
+  /**
+   * @brief Snapshot of the hit, miss, eviction, and construction time
+   * counters; all zero unless `CHOMP_ENABLE_STATISTICS` is enabled.
+   *
+   * @return CacheStatistics
+   */
+  [[nodiscard]] CacheStatistics statistics() const noexcept {
+    return counters.snapshot();
+  }
+  /** @brief Reset the statistics counters to zero. */
+  void reset_statistics() noexcept {
+    counters.reset();
+  }
+};
+
+/**
+ * @brief A cache storing its entries in a preallocated contiguous array with
+ * CLOCK (second chance) eviction.
+ *
+ * Entries are held in an array of `max_size` slots, located through an
+ * open-addressing `FlatHashMap` from keys to slots. Compared with `LRUCache`,
+ * there is no list node per entry and a hit only sets a reference bit instead
+ * of splicing a list. When the cache is full, a clock hand sweeps the slots,
+ * clearing reference bits, and the first entry not referenced since the last
+ * sweep is replaced. Newly inserted entries start unreferenced, so entries
+ * accessed only once are evicted before entries that have been hit.
+ *
+ * Provides the same interface as `LRUCache`; the memory used is bounded by
+ * `max_size` entries plus the index, both allocated at construction.
+ *
+ * @tparam K Key type; models `Hashable`.
+ * @tparam V Value type.
+ * @tparam Hash Hash function object type for `K`.
+ *
+ * @sa `LRUCache`
+ */
+template <Hashable K, typename V, typename Hash = std::hash<K>>
+class ClockCache {
+private:
+  std::vector<std::pair<K, V>> entries;
+  std::vector<bool> referenced;
+  FlatHashMap<K, std::size_t, Hash> slots;
+  std::function<V(const K&)> construct_value;
+  std::size_t cache_max_size;
+  std::size_t hand = 0;
+  // Holds the last value when `cache_max_size` is zero and nothing is stored
+  std::optional<V> uncached;
+  [[no_unique_address]] detail::CacheCounters<> counters;
+
+  // Slot of the entry to replace; only called when the cache is full.
+  std::size_t advance_hand() noexcept {
+    while (referenced[hand]) {
+      referenced[hand] = false;
+      hand = hand + 1 == cache_max_size ? 0 : hand + 1;
+    }
+    const std::size_t victim = hand;
+    hand = hand + 1 == cache_max_size ? 0 : hand + 1;
+    return victim;
+  }
+
+  // Fill `slot` with the last entry; its key must already be unindexed.
+  void erase_slot(std::size_t slot) {
+    const std::size_t last = entries.size() - 1;
+    if (slot != last) {
+      entries[slot] = std::move(entries[last]);
+      referenced[slot] = referenced[last];
+      slots.find(entries[slot].first)->second = slot;
+    }
+    referenced[last] = false;
+    entries.pop_back();
+  }
+
+public:
+  /** @brief Key type. */
+  using KeyType = K;
+  /** @brief Value type. */
+  using ValueType = V;
+
+  /**
+   * @brief Construct the cache with a function constructing values from keys
+   * and a maximum size, allocating storage for `max_size` entries.
+   *
+   * @param construct_value `std::function` object taking a constant reference
+   * to the key type and returning a value type object.
+   * @param max_size The maximum number of entries in the cache; if zero,
+   * values are constructed on every access and never stored.
+   */
+  ClockCache(std::function<V(const K&)> construct_value, std::size_t max_size) :
+      referenced(max_size, false), construct_value(std::move(construct_value)),
+      cache_max_size(max_size) {
+    entries.reserve(max_size);
+    slots.reserve(max_size);
+  }
+
+  /**
+   * @brief Return a constant reference to the value corresponding to `key` by
+   * either accessing it in the cache or by constructing the object and adding
+   * it to the cache first.
+   *
+   * The reference is valid until the next call to this method.
+   *
+   * @tparam TFor Forwarding type.
+   * @param key Possibly `const`-qualified lvalue or rvalue reference to an
+   * object of key type `K`.
+   * @return const V& Constant reference to the corresponding value type object.
+   */
+  template <typename TFor>
+  requires std::same_as<std::remove_cvref_t<TFor>, K>
+  const V& operator[](TFor&& key) {
+    const auto find_result = slots.find(key);
+    if (find_result != slots.end()) {
+      referenced[find_result->second] = true;
+      counters.record_hit();
+      return entries[find_result->second].second;
+    }
+
+    V value = counters.record_miss([&]() {
+      return construct_value(key);
+    });
+    if (cache_max_size == 0) {
+      return uncached.emplace(std::move(value));
+    }
+    std::size_t slot = entries.size();
+    if (slot < cache_max_size) {
+      entries.emplace_back(key, std::move(value));
+    } else {
+      slot = advance_hand();
+      slots.erase(entries[slot].first);
+      entries[slot] = std::make_pair(key, std::move(value));
+      counters.record_eviction();
+    }
+    slots.insert(std::make_pair(std::forward<TFor>(key), slot));
+    return entries[slot].second;
+  }
+
+  /**
+   * @brief Query whether the cache contains `key`.
+   *
+   * @param key
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool contains(const K& key) const {
+    return slots.contains(key);
+  }
+
+  /**
+   * @brief Remove the entry of `key`, if cached, so that its value is
+   * constructed anew on its next access.
+   *
+   * The last entry of the array is moved into the freed slot, keeping the
+   * entries contiguous.
+   *
+   * @param key
+   * @return true If an entry was removed.
+   * @return false If `key` was not cached.
+   */
+  bool erase(const K& key) {
+    const auto find_result = slots.find(key);
+    if (find_result == slots.end()) {
+      return false;
+    }
+    const std::size_t slot = find_result->second;
+    slots.erase(find_result);
+    erase_slot(slot);
+    return true;
+  }
+
+  /**
+   * @brief Remove the entries whose keys satisfy `pred`.
+   *
+   * @tparam Pred Predicate type on (constant references to) keys.
+   * @param pred
+   * @return std::size_t Number of entries removed.
+   */
+  template <typename Pred>
+  requires std::predicate<const Pred&, const K&>
+  std::size_t erase_if(const Pred& pred) {
+    std::size_t erased = 0;
+    for (std::size_t slot = entries.size(); slot-- > 0;) {
+      if (pred(entries[slot].first)) {
+        slots.erase(entries[slot].first);
+        erase_slot(slot);
+        ++erased;
+      }
+    }
+    return erased;
+  }
+
+  /** @brief Remove every entry. */
+  void clear() noexcept {
+    slots.clear();
+    entries.clear();
+    referenced.assign(cache_max_size, false);
+    hand = 0;
+  }
+
+  /**
+   * @brief Get the current size of the container.
+   *
+   * @return std::size_t Current number of elements in the cache.
+   */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return entries.size();
+  }
+  /**
+   * @brief Get the maximum size of the container.
+   *
+   * @return std::size_t Maximum number of elements in the cache.
+   */
+  [[nodiscard]] std::size_t max_size() const noexcept {
+    return cache_max_size;
+  }
+
+  /**
+   * @brief Snapshot of the hit, miss, eviction, and construction time
+   * counters; all zero unless `CHOMP_ENABLE_STATISTICS` is enabled.
+   *
+   * @return CacheStatistics
+   */
+  [[nodiscard]] CacheStatistics statistics() const noexcept {
+    return counters.snapshot();
+  }
+  /** @brief Reset the statistics counters to zero. */
+  void reset_statistics() noexcept {
+    counters.reset();
+  }
+};
+
+/**
+ * @brief The requirements for a type `C` to serve as the cache of
+ * `CachedFunctionWrapper` and `CachedGradingWrapper` with key type `K` and
+ * value type `V`.
+ *
+ * The cache is constructed from a function computing values from keys and a
+ * maximum size, and `operator[]` returns the (possibly cached) value.
+ *
+ * @tparam C
+ * @tparam K
+ * @tparam V
+ */
+template <typename C, typename K, typename V>
+concept ValueCache =
+    std::constructible_from<C, std::function<V(const K&)>, std::size_t> &&
+    requires(C cache, const K& key) {
+      { cache[key] } -> std::convertible_to<V>;
+      { cache.size() } -> std::convertible_to<std::size_t>;
+      { cache.max_size() } -> std::convertible_to<std::size_t>;
+    };
+
+/**
+ * @brief An LRU cache safe for concurrent access, sharded by key hash.
+ *
+ * Keys are distributed across `SHARDS` independent `LRUCache` shards by their
+ * hash, each guarded by its own mutex, so that threads accessing different
+ * shards never contend. Each shard holds at most `max_size / SHARDS` (rounded
+ * up) entries and evicts its own least recently used entry; recency is thus
+ * tracked per shard rather than globally.
+ *
+ * Unlike `LRUCache`, `operator[]` returns the value by copy, as a reference
+ * into a shard could be invalidated by another thread once the shard lock is
+ * released. Values are constructed while holding the shard lock, so the
+ * construction function is called at most once per key while it is cached.
+ *
+ * @tparam K Key type; models `Hashable`.
+ * @tparam V Value type; copyable.
+ * @tparam MapType The type of map used for each shard.
+ * @tparam SHARDS Number of shards; required positive.
+ * @tparam Hash Hash function object type for `K`, choosing the shard of each
+ * key and used by the map of each shard.
+ *
+ * @sa `LRUCache`
+ */
+template <
+    Hashable K, std::copy_constructible V,
+    template <typename...> typename MapType = DefaultMap,
+    std::size_t SHARDS = 16, typename Hash = std::hash<K>>
+requires(SHARDS > 0)
+class ShardedLRUCache {
+private:
+  struct Shard {
+    mutable std::mutex mutex;
+    LRUCache<K, V, MapType, std::allocator, Hash> cache;
+
+    Shard(std::function<V(const K&)> construct_value, std::size_t max_size) :
+        cache(std::move(construct_value), max_size) {}
+    Shard(const Shard& other) : cache(other.cache) {}
+  };
+
+  // Shards are held by pointer so that the cache is movable despite the
+  // mutexes.
+  std::vector<std::unique_ptr<Shard>> shards;
+  std::size_t cache_max_size;
+
+  [[nodiscard]] Shard& shard_of(const K& key) const noexcept {
+    return *shards[shard_index(key)];
+  }
+
+public:
+  /** @brief Key type. */
+  using KeyType = K;
+  /** @brief Value type. */
+  using ValueType = V;
+
+  /**
+   * @brief Construct the sharded cache with a function constructing values
+   * from keys and the maximum total number of entries.
+   *
+   * @param construct_value `std::function` object taking a constant reference
+   * to the key type and returning a value type object. It may be called
+   * concurrently for keys in different shards.
+   * @param max_size The maximum number of entries in the cache, divided
+   * evenly among the shards.
+   */
+  ShardedLRUCache(
+      std::function<V(const K&)> construct_value, std::size_t max_size
+  ) :
+      cache_max_size(max_size) {
+    const std::size_t shard_max_size = (max_size + SHARDS - 1) / SHARDS;
+    shards.reserve(SHARDS);
+    for (std::size_t shard = 0; shard < SHARDS; ++shard) {
+      shards.push_back(std::make_unique<Shard>(construct_value, shard_max_size)
+      );
+    }
+  }
+
+  /**
+   * @brief Copy constructor; each shard is locked while it is copied.
+   *
+   * @param other
+   */
+  ShardedLRUCache(const ShardedLRUCache& other) :
+      cache_max_size(other.cache_max_size) {
+    shards.reserve(SHARDS);
+    for (const std::unique_ptr<Shard>& shard : other.shards) {
+      const std::lock_guard lock(shard->mutex);
+      shards.push_back(std::make_unique<Shard>(*shard));
+    }
+  }
+
+  /**
+   * @brief Move constructor; not safe while `other` is in use.
+   *
+   * @param other
+   */
+  ShardedLRUCache(ShardedLRUCache&& other) noexcept = default;
+
+  /**
+   * @brief Copy assignment operator.
+   *
+   * @param other
+   * @return ShardedLRUCache&
+   */
+  ShardedLRUCache& operator=(const ShardedLRUCache& other) {
+    if (this != &other) {
+      *this = ShardedLRUCache(other);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment operator; not safe while either cache is in use.
+   *
+   * @param other
+   * @return ShardedLRUCache&
+   */
+  ShardedLRUCache& operator=(ShardedLRUCache&& other) noexcept = default;
+
+  /**
+   * @brief Deconstructor deconstructs the stored objects and deallocates
+   * storage.
+   */
+  ~ShardedLRUCache() = default;
+
+  /**
+   * @brief Return a copy of the value corresponding to `key`, constructing it
+   * and adding it to the cache first if it is not present.
+   *
+   * Locks only the shard containing `key`.
+   *
+   * @tparam TFor Forwarding type.
+   * @param key Possibly `const`-qualified lvalue or rvalue reference to an
+   * object of key type `K`.
+   * @return V Copy of the corresponding value type object.
+   */
+  template <typename TFor>
+  requires std::same_as<std::remove_cvref_t<TFor>, K>
+  V operator[](TFor&& key) {
+    Shard& shard = shard_of(key);
+    const std::lock_guard lock(shard.mutex);
+    return shard.cache[std::forward<TFor>(key)];
+  }
+
+  /**
+   * @brief Query whether the cache contains `key`.
+   *
+   * @param key
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool contains(const K& key) const {
+    const Shard& shard = shard_of(key);
+    const std::lock_guard lock(shard.mutex);
+    return shard.cache.contains(key);
+  }
+
+  /**
+   * @brief Remove the entry of `key`, if cached, so that its value is
+   * constructed anew on its next access.
+   *
+   * Locks only the shard containing `key`.
+   *
+   * @param key
+   * @return true If an entry was removed.
+   * @return false If `key` was not cached.
+   */
+  bool erase(const K& key) {
+    Shard& shard = shard_of(key);
+    const std::lock_guard lock(shard.mutex);
+    return shard.cache.erase(key);
+  }
+
+  /**
+   * @brief Remove the entries whose keys satisfy `pred`.
+   *
+   * Shards are locked one at a time.
+   *
+   * @tparam Pred Predicate type on (constant references to) keys.
+   * @param pred
+   * @return std::size_t Number of entries removed.
+   */
+  template <typename Pred>
+  requires std::predicate<const Pred&, const K&>
+  std::size_t erase_if(const Pred& pred) {
+    std::size_t erased = 0;
+    for (const std::unique_ptr<Shard>& shard : shards) {
+      const std::lock_guard lock(shard->mutex);
+      erased += shard->cache.erase_if(pred);
+    }
+    return erased;
+  }
+
+  /** @brief Remove every entry; shards are locked one at a time. */
+  void clear() {
+    for (const std::unique_ptr<Shard>& shard : shards) {
+      const std::lock_guard lock(shard->mutex);
+      shard->cache.clear();
+    }
+  }
+
+  /**
+   * @brief Get the current size of the container.
+   *
+   * Shards are locked one at a time, so the result is approximate while other
+   * threads insert entries.
+   *
+   * @return std::size_t Current number of elements in the cache.
+   */
+  [[nodiscard]] std::size_t size() const {
+    std::size_t result = 0;
+    for (const std::unique_ptr<Shard>& shard : shards) {
+      const std::lock_guard lock(shard->mutex);
+      result += shard->cache.size();
+    }
+    return result;
+  }
+  /**
+   * @brief Get the maximum size of the container.
+   *
+   * @return std::size_t Maximum number of elements in the cache.
+   */
+  [[nodiscard]] std::size_t max_size() const noexcept {
+    return cache_max_size;
+  }
+  /**
+   * @brief Get the number of shards.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] static constexpr std::size_t shard_count() noexcept {
+    return SHARDS;
+  }
+  /**
+   * @brief Index of the shard holding `key`.
+   *
+   * Running the work on keys of one shard on one thread, e.g. by submitting it
+   * to the same `WorkStealingScheduler` worker, keeps the shard local to that
+   * thread and its lock uncontended.
+   *
+   * @param key
+   * @return std::size_t Less than `shard_count()`.
+   */
+  [[nodiscard]] static std::size_t shard_index(const K& key) noexcept {
+    // Fibonacci mixing so that regular hashes (e.g. identity hashes of
+    // integers) spread across shards
+    const std::size_t mixed = Hash{}(key) *
+                              static_cast<std::size_t>(0x9E3779B97F4A7C15ULL);
+    return (mixed >> (SIZE_T_BITS / 2)) % SHARDS;
+  }
+
+  /**
+   * @brief Sum of the statistics counters of every shard; all zero unless
+   * `CHOMP_ENABLE_STATISTICS` is enabled.
+   *
+   * @return CacheStatistics
+   */
+  [[nodiscard]] CacheStatistics statistics() const {
+    CacheStatistics result;
+    for (const std::unique_ptr<Shard>& shard : shards) {
+      const std::lock_guard lock(shard->mutex);
+      result += shard->cache.statistics();
+    }
+    return result;
+  }
+  /** @brief Reset the statistics counters of every shard to zero. */
+  void reset_statistics() {
+    for (const std::unique_ptr<Shard>& shard : shards) {
+      const std::lock_guard lock(shard->mutex);
+      shard->cache.reset_statistics();
+    }
+  }
 };
 
 /**
@@ -212,15 +805,19 @@ public:
  * @tparam Out The output type of the function.
  * @tparam MapType The type of map used for `LRUCache`; `std::unordered_map` if
  * `In` is hashable else `std::map`.
+ * @tparam CacheType The cache type, modeling `ValueCache`; `LRUCache` by
+ * default. Use `ClockCache` for compact storage or `ShardedLRUCache` to share
+ * the wrapper between threads.
  *
- * @sa `LRUCache`
+ * @sa `LRUCache`, `ClockCache`, `ShardedLRUCache`
  */
 template <
     AssociativeKey In, typename Out,
-    template <typename...> typename MapType = DefaultMap>
+    template <typename...> typename MapType = DefaultMap,
+    ValueCache<In, Out> CacheType = LRUCache<In, Out, MapType>>
 class CachedFunctionWrapper {
 private:
-  LRUCache<In, Out, MapType> cache;
+  CacheType cache;
 
 public:
   /** @brief Input type to wrapped function is `const InputType&`. */
@@ -255,6 +852,37 @@ public:
   OutputType operator()(InFor&& input) {
     return cache[std::forward<InFor>(input)];
   }
+
+  /**
+   * @brief Drop the cached result for `input`, if any, e.g. after the state
+   * the wrapped function reads has changed.
+   *
+   * @param input
+   * @return true If a cached result was dropped.
+   * @return false
+   */
+  bool invalidate(const InputType& input)
+  requires requires(CacheType& c) { c.erase(input); }
+  {
+    return cache.erase(input);
+  }
+
+  /**
+   * @brief Statistics counters of the cache.
+   *
+   * @return CacheStatistics
+   */
+  [[nodiscard]] CacheStatistics statistics() const
+  requires requires(const CacheType& c) { c.statistics(); }
+  {
+    return cache.statistics();
+  }
+  /** @brief Reset the statistics counters of the cache. */
+  void reset_statistics()
+  requires requires(CacheType& c) { c.reset_statistics(); }
+  {
+    cache.reset_statistics();
+  }
 };
 
 }  // namespace chomp::core
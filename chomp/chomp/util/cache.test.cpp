@@ -9,14 +9,21 @@
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include <atomic>
+#include <cstddef>
 #include <map>
+#include <thread>
 #include <tuple>
+#include <vector>
 
 #ifndef CHOMP_DOXYGEN
 
 namespace chomp::core {
 
-using CacheTypes = std::tuple<LRUCache<int, int>, LRUCache<int, int, std::map>>;
+// A single shard has exactly the semantics of LRUCache
+using CacheTypes = std::tuple<
+    LRUCache<int, int>, LRUCache<int, int, std::map>,
+    ShardedLRUCache<int, int, DefaultMap, 1>>;
 
 
 TEMPLATE_LIST_TEST_CASE(
@@ -64,6 +71,48 @@ TEMPLATE_LIST_TEST_CASE(
   REQUIRE_FALSE(c.contains(2));
 }
 
+using ErasableCacheTypes = std::tuple<
+    LRUCache<int, int>, LRUCache<int, int, std::map>, ClockCache<int, int>,
+    ShardedLRUCache<int, int, DefaultMap, 1>, ShardedLRUCache<int, int>>;
+
+TEMPLATE_LIST_TEST_CASE(
+    "Caches invalidate entries by key and predicate", "[util]",
+    ErasableCacheTypes
+) {
+  int offset = 0;
+  TestType c(
+      [&offset](const int& x) {
+        return x + offset;
+      },
+      8
+  );
+  for (int key = 0; key < 6; ++key) {
+    REQUIRE(c[key] == key);
+  }
+
+  offset = 100;
+  REQUIRE(c[2] == 2);  // stale until invalidated
+  REQUIRE(c.erase(2));
+  REQUIRE_FALSE(c.erase(2));
+  REQUIRE_FALSE(c.contains(2));
+  REQUIRE(c.size() == 5);
+  REQUIRE(c[2] == 102);
+
+  REQUIRE(c.erase_if([](const int& key) { return key % 2 == 1; }) == 3);
+  REQUIRE(c.size() == 3);
+  for (int key = 0; key < 6; ++key) {
+    REQUIRE(c.contains(key) == (key % 2 == 0));
+  }
+  REQUIRE(c[1] == 101);
+  REQUIRE(c[0] == 0);
+
+  c.clear();
+  REQUIRE(c.size() == 0);
+  for (int key = 0; key < 12; ++key) {
+    REQUIRE(c[key] == key + 100);
+  }
+}
+
 TEST_CASE("CachedFunctionWrapper functions correctly", "[util]") {
   CachedFunctionWrapper<int, int> wrapped_func(
       [](int input) -> int {
@@ -79,6 +128,145 @@ TEST_CASE("CachedFunctionWrapper functions correctly", "[util]") {
   REQUIRE(wrapped_func(3) == 12);
   REQUIRE(wrapped_func(4) == 16);
   REQUIRE(wrapped_func(0) == 0);
+  REQUIRE(wrapped_func.invalidate(0));
+  REQUIRE_FALSE(wrapped_func.invalidate(0));
+  REQUIRE(wrapped_func(0) == 0);
+}
+
+TEST_CASE("ClockCache gives referenced entries a second chance", "[util]") {
+  std::size_t calls = 0;
+  ClockCache<int, int> cache(
+      [&calls](const int& x) {
+        ++calls;
+        return 2 * x + 1;
+      },
+      4
+  );
+  CHECK(ValueCache<decltype(cache), int, int>);
+  REQUIRE(cache.size() == 0);
+  REQUIRE(cache.max_size() == 4);
+
+  REQUIRE(cache[3] == 7);
+  REQUIRE(cache[2] == 5);
+  REQUIRE(cache[-1] == -1);
+  REQUIRE(cache[0] == 1);
+  REQUIRE(cache.size() == 4);
+  REQUIRE(calls == 4);
+
+  REQUIRE(cache[3] == 7);  // hit sets the reference bit of 3
+  REQUIRE(calls == 4);
+  REQUIRE(cache[10] == 21);  // 3 is spared, 2 is evicted
+  REQUIRE(cache.size() == 4);
+  REQUIRE(cache.contains(3));
+  REQUIRE_FALSE(cache.contains(2));
+
+  REQUIRE(cache[11] == 23);  // the sweep continues from the hand: -1 evicted
+  REQUIRE_FALSE(cache.contains(-1));
+  REQUIRE(cache.contains(0));
+  REQUIRE(cache[12] == 25);  // 0 evicted
+  REQUIRE(cache[13] == 27);  // reference bit of 3 was cleared: 3 evicted
+  REQUIRE_FALSE(cache.contains(3));
+  REQUIRE(cache.contains(10));
+  REQUIRE(cache.size() == 4);
+  REQUIRE(calls == 8);
+
+  const ClockCache<int, int> copy(cache);
+  REQUIRE(copy.contains(13));
+  REQUIRE(copy.size() == 4);
+
+  // A cache of no entries constructs every value and stores none
+  ClockCache<int, int> uncached(
+      [&calls](const int& x) {
+        ++calls;
+        return -x;
+      },
+      0
+  );
+  REQUIRE(uncached[3] == -3);
+  REQUIRE(uncached[3] == -3);
+  REQUIRE(uncached[4] == -4);
+  REQUIRE(calls == 11);
+  REQUIRE(uncached.size() == 0);
+  REQUIRE_FALSE(uncached.contains(3));
+
+  CachedFunctionWrapper<int, int, DefaultMap, ClockCache<int, int>>
+      wrapped_func(
+          [](const int& input) {
+            return input << 2;
+          },
+          2
+      );
+  for (int input = 0; input < 8; ++input) {
+    REQUIRE(wrapped_func(input) == input << 2);
+    REQUIRE(wrapped_func(input / 2) == (input / 2) << 2);
+  }
+}
+
+TEST_CASE("ShardedLRUCache distributes keys across shards", "[util]") {
+  ShardedLRUCache<int, int> cache(
+      [](const int& x) {
+        return -x;
+      },
+      64
+  );
+  REQUIRE(cache.max_size() == 64);
+  REQUIRE(cache.shard_count() == 16);
+  CHECK(ValueCache<decltype(cache), int, int>);
+
+  for (int key = 0; key < 32; ++key) {
+    REQUIRE(cache[key] == -key);
+  }
+  REQUIRE(cache.size() <= 32);
+  REQUIRE(cache.size() > 4);  // not all keys in one shard of size 4
+
+  for (int key = 0; key < 1000; ++key) {
+    REQUIRE(cache[key] == -key);
+  }
+  REQUIRE(cache.size() <= 64);
+  REQUIRE(cache.contains(999));
+  for (int key = 0; key < 100; ++key) {
+    REQUIRE(cache.shard_index(key) < cache.shard_count());
+  }
+
+  const ShardedLRUCache<int, int> copy(cache);
+  REQUIRE(copy.size() == cache.size());
+  REQUIRE(copy.contains(999));
+}
+
+TEST_CASE("CachedFunctionWrapper shared between threads", "[util]") {
+  std::atomic<std::size_t> calls = 0;
+  CachedFunctionWrapper<int, int, DefaultMap, ShardedLRUCache<int, int>>
+      wrapped_func(
+          [&calls](const int& input) {
+            calls.fetch_add(1, std::memory_order_relaxed);
+            return 3 * input;
+          },
+          1024
+      );
+
+  constexpr int thread_count = 4;
+  constexpr int key_count = 256;
+  std::vector<std::thread> threads;
+  std::atomic<bool> correct = true;
+  for (int thread = 0; thread < thread_count; ++thread) {
+    threads.emplace_back([&wrapped_func, &correct, thread]() {
+      for (int round = 0; round < 8; ++round) {
+        for (int key = 0; key < key_count; ++key) {
+          const int input = (key + thread * 17) % key_count;
+          if (wrapped_func(input) != 3 * input) {
+            correct = false;
+          }
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(correct);
+  // Every key fits in its shard, so each value is constructed once
+  REQUIRE(calls == key_count);
 }
 
 }  // namespace chomp::core
@@ -40,13 +40,6 @@ using GradingResultType = std::size_t;
  */
 using HypercubeCoordinate = std::uint_fast8_t;
 
-/**
- * @brief Prime value used in custom hash function for `CubicalCell`.
- *
- * @sa `CubicalCell`
- */
-constexpr std::size_t CUBE_HASH_PRIME = 11;
-
 
 }  // namespace chomp::core
 
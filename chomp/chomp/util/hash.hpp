@@ -0,0 +1,156 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains the hash functions used by the hashes of CHomP3R
+ * cell types, the `MixedHash` adaptor, and `RebindHash`, which substitutes the
+ * hash function object of hashed containers so that it can be passed as a
+ * template parameter alongside a container template.
+ */
+
+#ifndef CHOMP_UTIL_HASH_H
+#define CHOMP_UTIL_HASH_H
+
+#include <chomp/util/hashtable.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace chomp::core {
+
+/**
+ * @brief Bijective mixing of the bits of `value`, so that every input bit
+ * affects every output bit (the `splitmix64` finalizer).
+ *
+ * Being a bijection, distinct values never collide; regular inputs such as
+ * the packed coordinates of a grid are spread uniformly over both the low and
+ * the high bits, e.g. for tables reducing hashes to buckets by a mask.
+ *
+ * @param value
+ * @return std::size_t
+ */
+[[nodiscard]] constexpr std::size_t hash_mix(std::size_t value) noexcept {
+  std::uint64_t mixed = value;
+  mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+  return static_cast<std::size_t>(mixed ^ (mixed >> 31));
+}
+
+/**
+ * @brief Hash of a sequence of machine words.
+ *
+ * A single word is its own hash, so distinct words never collide and nearby
+ * words (e.g. packed neighboring cells) stay in nearby buckets of
+ * `std::unordered_map`, which reduces hashes modulo a prime; `FlatHashMap`
+ * mixes the hashes itself. Longer sequences are folded one word at a time,
+ * mixing the running hash by `hash_mix` after each, so that every word and
+ * its position matters.
+ *
+ * @param words
+ * @return std::size_t
+ */
+[[nodiscard]] constexpr std::size_t
+hash_words(std::span<const std::size_t> words) noexcept {
+  if (words.size() == 1) {
+    return words[0];
+  }
+  std::size_t result = static_cast<std::size_t>(0x9E3779B97F4A7C15ULL);
+  for (const std::size_t word : words) {
+    result = hash_mix(result ^ word);
+  }
+  return result;
+}
+
+/**
+ * @brief Hash function object applying `hash_mix` to the hash computed by
+ * `Hash`.
+ *
+ * Use it as the `Hash` parameter of hashed containers, modules, gradings and
+ * caches whose keys are not traversed in order, or with tables reducing
+ * hashes by a mask, to spread regular hashes (e.g. the identity hashes of
+ * integers or the packed words of `PackedCube`) over every bit. Mixing
+ * preserves the absence of collisions of such hashes.
+ *
+ * @tparam K Key type.
+ * @tparam Hash Underlying hash function object type for `K`.
+ */
+template <typename K, typename Hash = std::hash<K>>
+struct MixedHash {
+  /** @brief Underlying hash function object. */
+  [[no_unique_address]] Hash hash_function;
+
+  /**
+   * @brief The mixed hash of `key`.
+   *
+   * @param key
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t operator()(const K& key) const
+      noexcept(noexcept(hash_function(key))) {
+    return hash_mix(static_cast<std::size_t>(hash_function(key)));
+  }
+};
+
+/**
+ * @brief Substitute `Hash` for the hash function object type of the hashed
+ * container type `Container`.
+ *
+ * Specialized for `std::unordered_map`, `std::unordered_set`, `FlatHashMap`
+ * and `FlatHashSet`, keeping their other parameters (e.g. allocators). Other
+ * containers, e.g. `std::map` and `std::set`, do not hash and are unchanged.
+ * This lets classes taking a container template, such as `MapGrading` or
+ * `LRUCache`, also take a hash function object type.
+ *
+ * @tparam Container Container type.
+ * @tparam Hash Hash function object type for the keys of `Container`.
+ */
+template <typename Container, typename Hash>
+struct RebindHash {
+  /** @brief The container type with `Hash` as hash function object type. */
+  using type = Container;
+};
+
+#ifndef CHOMP_DOXYGEN
+
+template <
+    typename K, typename V, typename OldHash, typename KeyEqual,
+    typename Allocator, typename Hash>
+struct RebindHash<
+    std::unordered_map<K, V, OldHash, KeyEqual, Allocator>, Hash> {
+  using type = std::unordered_map<K, V, Hash, KeyEqual, Allocator>;
+};
+
+template <
+    typename K, typename OldHash, typename KeyEqual, typename Allocator,
+    typename Hash>
+struct RebindHash<std::unordered_set<K, OldHash, KeyEqual, Allocator>, Hash> {
+  using type = std::unordered_set<K, Hash, KeyEqual, Allocator>;
+};
+
+template <
+    typename K, typename V, typename OldHash, typename KeyEqual, typename Hash>
+struct RebindHash<detail::FlatHashTable<K, V, OldHash, KeyEqual>, Hash> {
+  using type = detail::FlatHashTable<K, V, Hash, KeyEqual>;
+};
+
+#endif  // CHOMP_DOXYGEN
+
+/**
+ * @brief Alias for `RebindHash<Container, Hash>::type`.
+ *
+ * @tparam Container Container type.
+ * @tparam Hash Hash function object type for the keys of `Container`.
+ */
+template <typename Container, typename Hash>
+using RebindHashType = typename RebindHash<Container, Hash>::type;
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_UTIL_HASH_H
@@ -0,0 +1,147 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/algebra/modules.hpp>
+#include <chomp/util/cache.hpp>
+#include <chomp/util/hash.hpp>
+#include <chomp/util/hashtable.hpp>
+#include <chomp/util/memory.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+namespace {
+
+// Weak hash of consecutive values, spread by `MixedHash`
+struct ShiftedHash {
+  std::size_t operator()(int key) const noexcept {
+    return std::size_t(key) + 1;
+  }
+};
+
+}  // namespace
+
+TEST_CASE("hash_mix spreads regular inputs", "[util]") {
+  static_assert(hash_mix(0) == 0);
+  static_assert(hash_mix(1) != hash_mix(2));
+
+  // Consecutive inputs fill the low and the high buckets alike
+  constexpr std::size_t BUCKETS = 64;
+  std::array<std::size_t, BUCKETS> low{};
+  std::array<std::size_t, BUCKETS> high{};
+  std::set<std::size_t> hashes;
+  for (std::size_t value = 0; value < 64 * BUCKETS; ++value) {
+    const std::size_t hash = hash_mix(value);
+    hashes.insert(hash);
+    ++low[hash % BUCKETS];
+    ++high[hash >> (SIZE_T_BITS - 6)];
+  }
+  REQUIRE(hashes.size() == 64 * BUCKETS);
+  for (std::size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+    REQUIRE((low[bucket] > 32 && low[bucket] < 96));
+    REQUIRE((high[bucket] > 32 && high[bucket] < 96));
+  }
+
+  // Flipping one input bit flips about half of the output bits
+  std::size_t flipped = 0;
+  for (std::size_t bit = 0; bit < SIZE_T_BITS; ++bit) {
+    flipped += std::size_t(
+        std::popcount(hash_mix(0x1234) ^ hash_mix(0x1234 ^ (1ULL << bit)))
+    );
+  }
+  REQUIRE((flipped > SIZE_T_BITS * 24 && flipped < SIZE_T_BITS * 40));
+}
+
+TEST_CASE("hash_words depends on every word and its position", "[util]") {
+  const std::array<std::size_t, 1> single{7};
+  REQUIRE(hash_words(single) == 7);
+
+  const std::array<std::size_t, 2> pair{1, 2};
+  const std::array<std::size_t, 2> swapped{2, 1};
+  const std::array<std::size_t, 2> other{1, 3};
+  REQUIRE(hash_words(pair) != hash_words(swapped));
+  REQUIRE(hash_words(pair) != hash_words(other));
+  REQUIRE(hash_words(pair) == hash_words(std::array<std::size_t, 2>{1, 2}));
+}
+
+TEST_CASE("RebindHash substitutes the hash of hashed containers", "[util]") {
+  using Mixed = MixedHash<int>;
+  STATIC_REQUIRE(std::same_as<
+                 RebindHashType<std::unordered_map<int, char>, Mixed>,
+                 std::unordered_map<int, char, Mixed>>);
+  STATIC_REQUIRE(std::same_as<
+                 RebindHashType<std::unordered_set<int>, Mixed>,
+                 std::unordered_set<int, Mixed>>);
+  STATIC_REQUIRE(std::same_as<
+                 RebindHashType<FlatHashMap<int, char>, Mixed>,
+                 FlatHashMap<int, char, Mixed>>);
+  STATIC_REQUIRE(std::same_as<
+                 RebindHashType<FlatHashSet<int>, Mixed>,
+                 FlatHashSet<int, Mixed>>);
+  STATIC_REQUIRE(std::same_as<
+                 RebindHashType<ArenaUnorderedMap<int, char>, Mixed>,
+                 std::unordered_map<
+                     int, char, Mixed, std::equal_to<int>,
+                     ArenaAllocator<std::pair<const int, char>>>>);
+  STATIC_REQUIRE(std::same_as<
+                 RebindHashType<std::map<int, char>, Mixed>,
+                 std::map<int, char>>);
+  STATIC_REQUIRE(std::same_as<
+                 RebindHashType<std::set<int>, Mixed>, std::set<int>>);
+
+  const MixedHash<int, ShiftedHash> mixed;
+  REQUIRE(mixed(4) == hash_mix(5));
+}
+
+TEST_CASE("Hashed modules and caches take a hasher", "[util]") {
+  UnorderedMapModule<int, Z<3>, MixedHash<int>> map_elem;
+  map_elem.insert(1, Z<3>(2));
+  map_elem.insert(1, Z<3>(2));
+  map_elem.insert(4, Z<3>(1));
+  REQUIRE(map_elem.size() == 2);
+  REQUIRE(map_elem[1] == Z<3>(1));
+
+  FlatHashSetModule<int, Z<2>, MixedHash<int>> set_elem;
+  set_elem.insert(3, Z<2>(1));
+  set_elem.insert(5, Z<2>(1));
+  set_elem.insert(3, Z<2>(1));
+  REQUIRE(set_elem.size() == 1);
+  REQUIRE(set_elem[5] == Z<2>(1));
+
+  using Cache = LRUCache<
+      int, int, DefaultMap, std::allocator, MixedHash<int, ShiftedHash>>;
+  Cache cache([](const int& key) { return 2 * key; }, 4);
+  for (int key = 0; key < 6; ++key) {
+    REQUIRE(cache[key] == 2 * key);
+  }
+  REQUIRE(cache.size() == 4);
+
+  ShardedLRUCache<int, int, DefaultMap, 4, MixedHash<int>> sharded(
+      [](const int& key) { return key + 1; }, 64
+  );
+  for (int key = 0; key < 32; ++key) {
+    REQUIRE(sharded[key] == key + 1);
+  }
+  REQUIRE(sharded.size() == 32);
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
@@ -0,0 +1,547 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains open-addressing hash tables storing their
+ * entries contiguously, used as flat alternatives to `std::unordered_map` and
+ * `std::unordered_set` in CHomP3R data structures.
+ */
+
+#ifndef CHOMP_UTIL_HASHTABLE_H
+#define CHOMP_UTIL_HASHTABLE_H
+
+#include <chomp/util/constants.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+namespace detail {
+
+/**
+ * @brief Common implementation for `FlatHashMap` and `FlatHashSet`.
+ *
+ * Entries are stored in a single contiguous table of slots using linear
+ * probing. Erasure uses backward-shift deletion rather than tombstones, so
+ * that repeatedly inserting and erasing entries (such as coefficients
+ * cancelling in module arithmetic) never degrades lookups.
+ *
+ * It is preferable to use the template aliases in the `chomp::core` namespace
+ * than to directly access this.
+ *
+ * @tparam K Key type.
+ * @tparam V Mapped type, or `void` for a set.
+ * @tparam Hash Hash function object type for `K`.
+ * @tparam KeyEqual Equality function object type for `K`.
+ *
+ * @sa `FlatHashMap`, `FlatHashSet`
+ */
+template <typename K, typename V, typename Hash, typename KeyEqual>
+class FlatHashTable {
+public:
+  /** @brief Key type. */
+  using key_type = K;
+  /** @brief Stored entry type; `std::pair<K, V>` for maps and `K` for sets. */
+  using value_type =
+      std::conditional_t<std::is_void_v<V>, K, std::pair<K, V>>;
+  /** @brief Size type. */
+  using size_type = std::size_t;
+  /** @brief Hash function object type. */
+  using hasher = Hash;
+  /** @brief Key equality function object type. */
+  using key_equal = KeyEqual;
+
+private:
+  using SlotType = std::optional<value_type>;
+
+  // Odd multiplier spreading hash values across the high bits (Fibonacci
+  // hashing); the table index is taken from the high bits of the product.
+  static constexpr std::size_t HASH_MULTIPLIER =
+      static_cast<std::size_t>(0x9E3779B97F4A7C15ULL);
+  static constexpr std::size_t MIN_CAPACITY = 8;
+
+  std::vector<SlotType> slots;
+  std::size_t entry_count = 0;
+  std::size_t index_shift = SIZE_T_BITS;
+  [[no_unique_address]] Hash hash_function;
+  [[no_unique_address]] KeyEqual key_equality;
+
+  [[nodiscard]] static const K& key_of(const value_type& value) noexcept {
+    if constexpr (std::is_void_v<V>) {
+      return value;
+    } else {
+      return value.first;
+    }
+  }
+
+  [[nodiscard]] std::size_t mask() const noexcept {
+    return slots.size() - 1;
+  }
+
+  [[nodiscard]] std::size_t home_of(const K& key) const {
+    return (static_cast<std::size_t>(hash_function(key)) * HASH_MULTIPLIER) >>
+           index_shift;
+  }
+
+  // Index of the slot holding `key`, or of the empty slot ending its probe
+  // sequence. Requires a nonempty table.
+  [[nodiscard]] std::size_t probe(const K& key) const {
+    std::size_t idx = home_of(key);
+    while (slots[idx] && !key_equality(key_of(*slots[idx]), key)) {
+      idx = (idx + 1) & mask();
+    }
+    return idx;
+  }
+
+  // Largest number of entries stored before growing (load factor 3/4).
+  [[nodiscard]] static constexpr std::size_t max_entries(std::size_t capacity
+  ) noexcept {
+    return capacity - capacity / 4;
+  }
+
+  void erase_slot(std::size_t hole) {
+    // Backward-shift deletion (Knuth, Algorithm R): move later entries of the
+    // cluster into the hole unless their home lies cyclically in
+    // (hole, current].
+    slots[hole].reset();
+    --entry_count;
+    std::size_t current = hole;
+    while (true) {
+      current = (current + 1) & mask();
+      if (!slots[current]) {
+        return;
+      }
+      const std::size_t home = home_of(key_of(*slots[current]));
+      const bool stays = hole <= current ? (hole < home && home <= current)
+                                         : (hole < home || home <= current);
+      if (!stays) {
+        slots[hole] = std::move(slots[current]);
+        slots[current].reset();
+        hole = current;
+      }
+    }
+  }
+
+  template <bool CONST>
+  class Iterator {
+  private:
+    using SlotPointer =
+        std::conditional_t<CONST, const SlotType*, SlotType*>;
+    SlotPointer slot = nullptr;
+    SlotPointer slot_end = nullptr;
+
+    void skip_empty() noexcept {
+      while (slot != slot_end && !*slot) {
+        ++slot;
+      }
+    }
+
+    friend class FlatHashTable;
+    friend class Iterator<!CONST>;
+
+    Iterator(SlotPointer slot, SlotPointer slot_end) noexcept :
+        slot(slot), slot_end(slot_end) {
+      skip_empty();
+    }
+
+  public:
+    using difference_type = std::ptrdiff_t;
+    using value_type = FlatHashTable::value_type;
+    using pointer =
+        std::conditional_t<CONST, const value_type*, value_type*>;
+    using reference =
+        std::conditional_t<CONST, const value_type&, value_type&>;
+    using iterator_category = std::forward_iterator_tag;
+    using iterator_concept = std::forward_iterator_tag;
+
+    Iterator() = default;
+
+    // Mutable iterators convert to constant iterators.
+    template <bool OTHER_CONST>
+    requires(CONST && !OTHER_CONST)
+    Iterator(const Iterator<OTHER_CONST>& other) noexcept :
+        slot(other.slot), slot_end(other.slot_end) {}
+
+    [[nodiscard]] reference operator*() const noexcept {
+      return **slot;
+    }
+    [[nodiscard]] pointer operator->() const noexcept {
+      return &**slot;
+    }
+
+    Iterator& operator++() noexcept {
+      ++slot;
+      skip_empty();
+      return *this;
+    }
+    Iterator operator++(int) noexcept {
+      Iterator temp = *this;
+      ++*this;
+      return temp;
+    }
+
+    [[nodiscard]] bool operator==(const Iterator& rhs) const noexcept {
+      return slot == rhs.slot;
+    }
+  };
+
+public:
+  /**
+   * @brief Forward iterator over the entries.
+   *
+   * Keys must not be modified through this iterator.
+   */
+  using iterator =
+      std::conditional_t<std::is_void_v<V>, Iterator<true>, Iterator<false>>;
+  /** @brief Constant forward iterator over the entries. */
+  using const_iterator = Iterator<true>;
+
+  /** @brief Initialize an empty table; no storage is allocated. */
+  FlatHashTable() = default;
+
+  /**
+   * @brief Initialize the table from a range of entries.
+   *
+   * @tparam I Input iterator type yielding entries.
+   * @param first
+   * @param last
+   */
+  template <std::input_iterator I>
+  FlatHashTable(I first, I last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  /**
+   * @brief Initialize the table from an initializer list of entries.
+   *
+   * @param ilist
+   */
+  FlatHashTable(std::initializer_list<value_type> ilist) :
+      FlatHashTable(ilist.begin(), ilist.end()) {}
+
+  /** @brief Copy constructor. */
+  FlatHashTable(const FlatHashTable&) = default;
+  /** @brief Copy assignment operator. */
+  FlatHashTable& operator=(const FlatHashTable&) = default;
+
+  /**
+   * @brief Move constructor; `other` is left empty.
+   *
+   * @param other
+   */
+  FlatHashTable(FlatHashTable&& other) noexcept :
+      slots(std::exchange(other.slots, {})),
+      entry_count(std::exchange(other.entry_count, 0)),
+      index_shift(std::exchange(other.index_shift, SIZE_T_BITS)),
+      hash_function(std::move(other.hash_function)),
+      key_equality(std::move(other.key_equality)) {}
+
+  /**
+   * @brief Move assignment operator; `other` is left empty.
+   *
+   * @param other
+   * @return FlatHashTable&
+   */
+  FlatHashTable& operator=(FlatHashTable&& other) noexcept {
+    if (this != &other) {
+      slots = std::exchange(other.slots, {});
+      entry_count = std::exchange(other.entry_count, 0);
+      index_shift = std::exchange(other.index_shift, SIZE_T_BITS);
+      hash_function = std::move(other.hash_function);
+      key_equality = std::move(other.key_equality);
+    }
+    return *this;
+  }
+
+  /** @brief Iterator to the first entry. */
+  [[nodiscard]] iterator begin() noexcept {
+    return iterator(slots.data(), slots.data() + slots.size());
+  }
+  /** @brief Iterator past the last entry. */
+  [[nodiscard]] iterator end() noexcept {
+    return iterator(slots.data() + slots.size(), slots.data() + slots.size());
+  }
+  /** @brief Constant iterator to the first entry. */
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return cbegin();
+  }
+  /** @brief Constant iterator past the last entry. */
+  [[nodiscard]] const_iterator end() const noexcept {
+    return cend();
+  }
+  /** @brief Constant iterator to the first entry. */
+  [[nodiscard]] const_iterator cbegin() const noexcept {
+    return const_iterator(slots.data(), slots.data() + slots.size());
+  }
+  /** @brief Constant iterator past the last entry. */
+  [[nodiscard]] const_iterator cend() const noexcept {
+    return const_iterator(
+        slots.data() + slots.size(), slots.data() + slots.size()
+    );
+  }
+
+  /** @brief Number of entries in the table. */
+  [[nodiscard]] std::size_t size() const noexcept {
+    return entry_count;
+  }
+  /** @brief Whether the table has no entries. */
+  [[nodiscard]] bool empty() const noexcept {
+    return entry_count == 0;
+  }
+  /** @brief Number of slots in the table. */
+  [[nodiscard]] std::size_t bucket_count() const noexcept {
+    return slots.size();
+  }
+
+  /** @brief Remove all entries, keeping the allocated table. */
+  void clear() noexcept {
+    for (SlotType& slot : slots) {
+      slot.reset();
+    }
+    entry_count = 0;
+  }
+
+  /**
+   * @brief Resize the table to hold at least `count` entries without further
+   * rehashing.
+   *
+   * The table never shrinks below its current number of entries.
+   *
+   * @param count
+   */
+  void rehash(std::size_t count) {
+    count = std::max(count, entry_count);
+    std::size_t capacity = MIN_CAPACITY;
+    while (max_entries(capacity) < count) {
+      capacity <<= 1;
+    }
+    if (capacity == slots.size()) {
+      return;
+    }
+
+    std::vector<SlotType> old_slots(capacity);
+    old_slots.swap(slots);
+    index_shift = SIZE_T_BITS - static_cast<std::size_t>(std::countr_zero(
+                                    capacity
+                                ));
+    for (SlotType& slot : old_slots) {
+      if (slot) {
+        slots[probe(key_of(*slot))] = std::move(slot);
+      }
+    }
+  }
+
+  /**
+   * @brief Reserve storage for at least `count` entries.
+   *
+   * @param count
+   */
+  void reserve(std::size_t count) {
+    if (count > max_entries(slots.size())) {
+      rehash(count);
+    }
+  }
+
+  /**
+   * @brief Find the entry with key `key`.
+   *
+   * @param key
+   * @return iterator Iterator to the entry, or `end()` if not present.
+   */
+  [[nodiscard]] iterator find(const K& key) {
+    if (entry_count == 0) {
+      return end();
+    }
+    const std::size_t idx = probe(key);
+    if (!slots[idx]) {
+      return end();
+    }
+    return iterator(slots.data() + idx, slots.data() + slots.size());
+  }
+  /** @copydoc find() */
+  [[nodiscard]] const_iterator find(const K& key) const {
+    if (entry_count == 0) {
+      return cend();
+    }
+    const std::size_t idx = probe(key);
+    if (!slots[idx]) {
+      return cend();
+    }
+    return const_iterator(slots.data() + idx, slots.data() + slots.size());
+  }
+
+  /** @brief Whether an entry with key `key` is present. */
+  [[nodiscard]] bool contains(const K& key) const {
+    return find(key) != cend();
+  }
+  /** @brief Number of entries with key `key` (zero or one). */
+  [[nodiscard]] std::size_t count(const K& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  /**
+   * @brief Insert `value` if no entry with its key is present.
+   *
+   * Invalidates iterators.
+   *
+   * @tparam VFor Forwarding type convertible to `value_type`.
+   * @param value
+   * @return std::pair<iterator, bool> Iterator to the entry with the key of
+   * `value`, and whether `value` was inserted.
+   */
+  template <typename VFor>
+  requires std::constructible_from<value_type, VFor&&>
+  std::pair<iterator, bool> insert(VFor&& value) {
+    const value_type& key_source = value;
+    // Only grow for new keys, so updating an entry never rehashes.
+    std::size_t idx = slots.empty() ? 0 : probe(key_of(key_source));
+    if (!slots.empty() && slots[idx]) {
+      return std::make_pair(
+          iterator(slots.data() + idx, slots.data() + slots.size()), false
+      );
+    }
+    if (entry_count + 1 > max_entries(slots.size())) {
+      rehash(entry_count + 1);
+      idx = probe(key_of(key_source));
+    }
+    slots[idx].emplace(std::forward<VFor>(value));
+    ++entry_count;
+    return std::make_pair(
+        iterator(slots.data() + idx, slots.data() + slots.size()), true
+    );
+  }
+  /** @copydoc insert() */
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return insert<value_type>(std::move(value));
+  }
+
+  /**
+   * @brief Get a reference to the mapped value of `key`, default constructing
+   * it if not present.
+   *
+   * Only available for maps. Invalidates iterators.
+   *
+   * @param key
+   * @return V&
+   */
+  template <typename KFor>
+  requires(!std::is_void_v<V> && std::same_as<std::remove_cvref_t<KFor>, K>)
+  auto& operator[](KFor&& key) {
+    const iterator it = find(key);
+    if (it != end()) {
+      return it->second;
+    }
+    return insert(value_type(std::forward<KFor>(key), V())).first->second;
+  }
+
+  /**
+   * @brief Erase the entry at `pos`.
+   *
+   * Invalidates iterators.
+   *
+   * @param pos Iterator to an entry of this table.
+   */
+  void erase(const_iterator pos) {
+    erase_slot(static_cast<std::size_t>(pos.slot - slots.data()));
+  }
+
+  /**
+   * @brief Erase the entry with key `key` if present.
+   *
+   * Invalidates iterators.
+   *
+   * @param key
+   * @return std::size_t Number of entries erased (zero or one).
+   */
+  std::size_t erase(const K& key) {
+    if (entry_count == 0) {
+      return 0;
+    }
+    const std::size_t idx = probe(key);
+    if (!slots[idx]) {
+      return 0;
+    }
+    erase_slot(idx);
+    return 1;
+  }
+
+  /**
+   * @brief Equality as unordered collections of entries.
+   *
+   * @param rhs
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] bool operator==(const FlatHashTable& rhs) const {
+    if (entry_count != rhs.entry_count) {
+      return false;
+    }
+    for (const value_type& value : *this) {
+      const const_iterator it = rhs.find(key_of(value));
+      if (it == rhs.cend()) {
+        return false;
+      }
+      if constexpr (!std::is_void_v<V>) {
+        if (!(it->second == value.second)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Open-addressing hash map storing its entries contiguously.
+ *
+ * Provides the subset of the `std::unordered_map` interface used throughout
+ * CHomP3R, along with `reserve` and `rehash`. Unlike `std::unordered_map`,
+ * every insertion or erasure invalidates iterators, and entries are stored as
+ * `std::pair<K, V>` rather than `std::pair<const K, V>`.
+ *
+ * @tparam K Key type modeling `Hashable`.
+ * @tparam V Mapped type.
+ * @tparam Hash Hash function object type for `K`.
+ * @tparam KeyEqual Equality function object type for `K`.
+ */
+template <
+    typename K, typename V, typename Hash = std::hash<K>,
+    typename KeyEqual = std::equal_to<K>>
+using FlatHashMap = detail::FlatHashTable<K, V, Hash, KeyEqual>;
+
+/**
+ * @brief Open-addressing hash set storing its entries contiguously.
+ *
+ * Provides the subset of the `std::unordered_set` interface used throughout
+ * CHomP3R, along with `reserve` and `rehash`. Unlike `std::unordered_set`,
+ * every insertion or erasure invalidates iterators.
+ *
+ * @tparam K Key type modeling `Hashable`.
+ * @tparam Hash Hash function object type for `K`.
+ * @tparam KeyEqual Equality function object type for `K`.
+ */
+template <
+    typename K, typename Hash = std::hash<K>,
+    typename KeyEqual = std::equal_to<K>>
+using FlatHashSet = detail::FlatHashTable<K, void, Hash, KeyEqual>;
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_UTIL_HASHTABLE_H
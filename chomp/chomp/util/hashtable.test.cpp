@@ -0,0 +1,142 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/util/hashtable.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <set>
+#include <utility>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+// Sends every key to the same home slot to exercise probing and erasure.
+struct CollidingHash {
+  std::size_t operator()(int) const noexcept {
+    return 0;
+  }
+};
+
+TEST_CASE("FlatHashMap insertion, lookup, and iteration", "[util]") {
+  FlatHashMap<int, int> map;
+  REQUIRE(map.empty());
+  REQUIRE(map.bucket_count() == 0);
+  REQUIRE(map.find(3) == map.end());
+
+  for (int key = 0; key < 100; ++key) {
+    const auto [it, inserted] = map.insert({key, 2 * key});
+    REQUIRE(inserted);
+    REQUIRE(it->second == 2 * key);
+  }
+  REQUIRE(map.size() == 100);
+  REQUIRE_FALSE(map.insert({5, 0}).second);
+  REQUIRE(map[5] == 10);
+  REQUIRE(map.contains(99));
+  REQUIRE_FALSE(map.contains(100));
+  REQUIRE(map.count(100) == 0);
+
+  map[100] = 1;
+  REQUIRE(map.size() == 101);
+  REQUIRE(std::distance(map.begin(), map.end()) == 101);
+
+  int key_sum = 0;
+  for (const auto& [key, value] : map) {
+    key_sum += key;
+  }
+  REQUIRE(key_sum == 5050);
+
+  const FlatHashMap<int, int> copy(map);
+  REQUIRE(copy == map);
+  map[100] = 2;
+  REQUIRE_FALSE(copy == map);
+
+  map.clear();
+  REQUIRE(map.empty());
+  REQUIRE(map.begin() == map.end());
+}
+
+TEST_CASE("FlatHashSet erasure with colliding hashes", "[util]") {
+  FlatHashSet<int, CollidingHash> set;
+  std::set<int> expected;
+  for (int key = 0; key < 40; ++key) {
+    set.insert(key);
+    expected.insert(key);
+  }
+
+  // Erase from the middle of the single probe cluster; remaining keys must
+  // stay reachable after backward shifting.
+  for (int key = 0; key < 40; key += 3) {
+    REQUIRE(set.erase(key) == 1);
+    expected.erase(key);
+  }
+  REQUIRE(set.erase(0) == 0);
+  REQUIRE(set.size() == expected.size());
+  for (int key = 0; key < 40; ++key) {
+    REQUIRE(set.contains(key) == expected.contains(key));
+  }
+
+  set.erase(set.find(1));
+  expected.erase(1);
+  REQUIRE_FALSE(set.contains(1));
+  REQUIRE(std::set<int>(set.begin(), set.end()) == expected);
+}
+
+TEST_CASE("FlatHashSet reserve and rehash", "[util]") {
+  FlatHashSet<int> set;
+  set.reserve(100);
+  const std::size_t buckets = set.bucket_count();
+  REQUIRE(buckets >= 100);
+  for (int key = 0; key < 100; ++key) {
+    set.insert(key);
+  }
+  REQUIRE(set.bucket_count() == buckets);
+
+  set.rehash(1000);
+  REQUIRE(set.bucket_count() >= 1000);
+  REQUIRE(set.size() == 100);
+  for (int key = 0; key < 100; ++key) {
+    REQUIRE(set.contains(key));
+  }
+
+  // Rehashing never shrinks below the current entry count.
+  set.rehash(0);
+  REQUIRE(set.bucket_count() >= 100);
+  REQUIRE(set.size() == 100);
+}
+
+TEST_CASE("FlatHashMap moved-from tables are empty and usable", "[util]") {
+  FlatHashMap<int, int> map;
+  map.insert({1, 2});
+  FlatHashMap<int, int> moved(std::move(map));
+  REQUIRE(moved.size() == 1);
+  REQUIRE(moved.contains(1));
+
+  // NOLINTBEGIN(bugprone-use-after-move)
+  REQUIRE(map.empty());
+  REQUIRE(map.bucket_count() == 0);
+  REQUIRE_FALSE(map.contains(1));
+  REQUIRE(map.find(1) == map.end());
+  REQUIRE(map.erase(1) == 0);
+  map[3] = 4;
+  REQUIRE(map.size() == 1);
+  REQUIRE(map[3] == 4);
+
+  moved = std::move(map);
+  REQUIRE(moved.size() == 1);
+  REQUIRE(moved[3] == 4);
+  REQUIRE_FALSE(moved.contains(1));
+  REQUIRE(map.empty());
+  REQUIRE_FALSE(map.contains(3));
+  // NOLINTEND(bugprone-use-after-move)
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
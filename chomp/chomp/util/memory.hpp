@@ -0,0 +1,317 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains the allocator and per-thread memory arenas used
+ * to keep temporary chains and cache nodes away from the global allocator.
+ *
+ * Containers using `ArenaAllocator` draw their memory from the memory resource
+ * current on the constructing thread when they are default constructed. A
+ * `ScopedArena` makes a monotonic arena current for its lifetime, so every
+ * temporary chain of, e.g., one `boundary(complex, chain)` pass is allocated
+ * from it without locking and released at once when the arena is destroyed.
+ */
+
+#ifndef CHOMP_UTIL_MEMORY_H
+#define CHOMP_UTIL_MEMORY_H
+
+#include <chomp/util/concepts.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <set>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace chomp::core {
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+inline std::pmr::memory_resource*& thread_memory_resource() noexcept {
+  thread_local std::pmr::memory_resource* resource = nullptr;
+  return resource;
+}
+
+// Upstream of the arenas of this thread; recycles their blocks without
+// touching the global allocator after warm up.
+inline std::pmr::memory_resource* thread_pool_resource() {
+  thread_local std::pmr::unsynchronized_pool_resource pool(
+      std::pmr::new_delete_resource()
+  );
+  return &pool;
+}
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
+/**
+ * @brief Memory resource current on this thread.
+ *
+ * This is the resource of the innermost live `ScopedMemoryResource` (or
+ * `ScopedArena`) of this thread, or `std::pmr::get_default_resource()` if there
+ * is none.
+ *
+ * @return std::pmr::memory_resource*
+ */
+[[nodiscard]] inline std::pmr::memory_resource*
+current_memory_resource() noexcept {
+  std::pmr::memory_resource* resource = detail::thread_memory_resource();
+  return resource != nullptr ? resource : std::pmr::get_default_resource();
+}
+
+/**
+ * @brief Make a memory resource current on this thread for the lifetime of
+ * this object.
+ *
+ * Scopes nest; destroying the object restores the previously current
+ * resource. Objects must be destroyed on the thread that created them, in
+ * reverse order of creation.
+ */
+class ScopedMemoryResource {
+  std::pmr::memory_resource* previous;
+
+public:
+  /**
+   * @brief Make `resource` current on this thread.
+   *
+   * @param resource Memory resource; must outlive every container allocating
+   * from it.
+   */
+  explicit ScopedMemoryResource(std::pmr::memory_resource* resource) noexcept :
+      previous(detail::thread_memory_resource()) {
+    detail::thread_memory_resource() = resource;
+  }
+
+  ScopedMemoryResource(const ScopedMemoryResource&) = delete;
+  ScopedMemoryResource& operator=(const ScopedMemoryResource&) = delete;
+
+  /** @brief Restore the previously current resource. */
+  ~ScopedMemoryResource() {
+    detail::thread_memory_resource() = previous;
+  }
+};
+
+/**
+ * @brief Monotonic arena made current on this thread for the lifetime of this
+ * object.
+ *
+ * Deallocation from the arena does nothing; all of its memory is released in
+ * one step when the arena is destroyed or `release` is called. Blocks are
+ * obtained from a pool private to the thread, so arenas do not contend on the
+ * global allocator once the pool is warm.
+ *
+ * Every container allocating from the arena must be destroyed before the
+ * arena, so results computed under an arena should be copied out (or use the
+ * default allocator) if they are needed afterwards.
+ */
+class ScopedArena {
+  std::pmr::monotonic_buffer_resource arena;
+  ScopedMemoryResource scope;
+
+public:
+  /** @brief Construct an empty arena and make it current. */
+  ScopedArena() : arena(detail::thread_pool_resource()), scope(&arena) {}
+
+  /**
+   * @brief Construct an empty arena whose first block holds at least
+   * `initial_size` bytes and make it current.
+   *
+   * @param initial_size
+   */
+  explicit ScopedArena(std::size_t initial_size) :
+      arena(initial_size, detail::thread_pool_resource()), scope(&arena) {}
+
+  ScopedArena(const ScopedArena&) = delete;
+  ScopedArena& operator=(const ScopedArena&) = delete;
+  ~ScopedArena() = default;
+
+  /**
+   * @brief Release all memory allocated from the arena.
+   *
+   * Precondition: no container allocating from the arena is alive.
+   */
+  void release() {
+    arena.release();
+  }
+
+  /**
+   * @brief Memory resource of the arena.
+   *
+   * @return std::pmr::memory_resource*
+   */
+  [[nodiscard]] std::pmr::memory_resource* resource() noexcept {
+    return &arena;
+  }
+};
+
+/**
+ * @brief Allocator drawing from a `std::pmr::memory_resource`, by default the
+ * resource current on the constructing thread.
+ *
+ * Unlike `std::pmr::polymorphic_allocator`, a default constructed
+ * `ArenaAllocator` (and its copy for a copy constructed container) uses
+ * `current_memory_resource()`, so containers and module elements default
+ * constructed inside a `ScopedArena` allocate from it with no change to the
+ * code constructing them.
+ *
+ * @tparam T Value type.
+ */
+template <typename T>
+class ArenaAllocator {
+  std::pmr::memory_resource* memory;
+
+  template <typename U>
+  friend class ArenaAllocator;
+
+public:
+  /** @brief Value type. */
+  using value_type = T;
+  /**
+   * @brief Move assigning containers moves their allocators, as move
+   * construction does, so storage is always handed over rather than moved
+   * element-wise.
+   */
+  using propagate_on_container_move_assignment = std::true_type;
+  /** @brief Swapping containers swaps their allocators. */
+  using propagate_on_container_swap = std::true_type;
+
+  /** @brief Allocate from the resource current on this thread. */
+  ArenaAllocator() noexcept : memory(current_memory_resource()) {}
+  /**
+   * @brief Allocate from `resource`.
+   *
+   * @param resource
+   */
+  explicit ArenaAllocator(std::pmr::memory_resource* resource) noexcept :
+      memory(resource) {}
+  /** @brief Rebinding constructor; shares the resource of `other`. */
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept :
+      memory(other.memory) {}
+
+  /**
+   * @brief Allocate uninitialized storage for `count` objects of type `T`.
+   *
+   * @param count
+   * @return T*
+   */
+  [[nodiscard]] T* allocate(std::size_t count) {
+    return static_cast<T*>(memory->allocate(count * sizeof(T), alignof(T)));
+  }
+  /**
+   * @brief Return storage obtained from `allocate(count)`.
+   *
+   * @param ptr
+   * @param count
+   */
+  void deallocate(T* ptr, std::size_t count) noexcept {
+    memory->deallocate(ptr, count * sizeof(T), alignof(T));
+  }
+
+  /**
+   * @brief Copies of containers allocate from the resource current where they
+   * are copied.
+   *
+   * @return ArenaAllocator
+   */
+  [[nodiscard]] ArenaAllocator
+  select_on_container_copy_construction() const noexcept {
+    return ArenaAllocator();
+  }
+
+  /**
+   * @brief Underlying memory resource.
+   *
+   * @return std::pmr::memory_resource*
+   */
+  [[nodiscard]] std::pmr::memory_resource* resource() const noexcept {
+    return memory;
+  }
+
+  /** @brief Allocators are equal if their resources are equal. */
+  template <typename U>
+  [[nodiscard]] bool operator==(const ArenaAllocator<U>& rhs) const noexcept {
+    return memory == rhs.memory || memory->is_equal(*rhs.memory);
+  }
+};
+
+/** @brief `std::map` allocating with `ArenaAllocator`. */
+template <typename K, typename V>
+using ArenaMap =
+    std::map<K, V, std::less<K>, ArenaAllocator<std::pair<const K, V>>>;
+
+/** @brief `std::unordered_map` allocating with `ArenaAllocator`. */
+template <typename K, typename V>
+using ArenaUnorderedMap = std::unordered_map<
+    K, V, std::hash<K>, std::equal_to<K>,
+    ArenaAllocator<std::pair<const K, V>>>;
+
+/** @brief `std::set` allocating with `ArenaAllocator`. */
+template <typename K>
+using ArenaSet = std::set<K, std::less<K>, ArenaAllocator<K>>;
+
+/** @brief `std::unordered_set` allocating with `ArenaAllocator`. */
+template <typename K>
+using ArenaUnorderedSet =
+    std::unordered_set<K, std::hash<K>, std::equal_to<K>, ArenaAllocator<K>>;
+
+/** @brief `std::list` allocating with `ArenaAllocator`. */
+template <typename T>
+using ArenaList = std::list<T, ArenaAllocator<T>>;
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+template <bool H, typename K, typename V>
+struct ArenaMapChooser {
+  using type = ArenaMap<K, V>;
+};
+
+template <typename K, typename V>
+struct ArenaMapChooser<true, K, V> {
+  using type = ArenaUnorderedMap<K, V>;
+};
+
+template <bool H, typename K>
+struct ArenaSetChooser {
+  using type = ArenaSet<K>;
+};
+
+template <typename K>
+struct ArenaSetChooser<true, K> {
+  using type = ArenaUnorderedSet<K>;
+};
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
+/**
+ * @brief Analogue of `DefaultMap` allocating with `ArenaAllocator`.
+ *
+ * @tparam K Key type; must model `AssociativeKey`.
+ * @tparam V Value type.
+ */
+template <AssociativeKey K, typename V>
+using ArenaDefaultMap =
+    typename detail::ArenaMapChooser<Hashable<K>, K, V>::type;
+
+/**
+ * @brief Analogue of `DefaultSet` allocating with `ArenaAllocator`.
+ *
+ * @tparam K Key type; must model `AssociativeKey`.
+ */
+template <AssociativeKey K>
+using ArenaDefaultSet = typename detail::ArenaSetChooser<Hashable<K>, K>::type;
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_UTIL_MEMORY_H
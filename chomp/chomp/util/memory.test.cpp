@@ -0,0 +1,154 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/algebra/algebra.hpp>
+#include <chomp/algebra/cyclic.hpp>
+#include <chomp/algebra/modules.hpp>
+#include <chomp/complexes/grading.hpp>
+#include <chomp/util/cache.hpp>
+#include <chomp/util/memory.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+namespace {
+
+// Memory resource counting its outstanding allocations.
+class CountingResource : public std::pmr::memory_resource {
+  std::pmr::memory_resource* upstream = std::pmr::new_delete_resource();
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    ++allocations;
+    ++outstanding;
+    return upstream->allocate(bytes, alignment);
+  }
+  void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+      override {
+    --outstanding;
+    upstream->deallocate(ptr, bytes, alignment);
+  }
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other
+  ) const noexcept override {
+    return this == &other;
+  }
+
+public:
+  std::size_t allocations = 0;
+  std::size_t outstanding = 0;
+};
+
+}  // namespace
+
+TEST_CASE("Scoped memory resources nest and restore", "[util]") {
+  std::pmr::memory_resource* initial = current_memory_resource();
+  REQUIRE(initial == std::pmr::get_default_resource());
+
+  CountingResource counting;
+  {
+    const ScopedMemoryResource scope(&counting);
+    REQUIRE(current_memory_resource() == &counting);
+    {
+      ScopedArena arena;
+      REQUIRE(current_memory_resource() == arena.resource());
+      REQUIRE(ArenaAllocator<int>().resource() == arena.resource());
+    }
+    REQUIRE(current_memory_resource() == &counting);
+  }
+  REQUIRE(current_memory_resource() == initial);
+}
+
+TEST_CASE("Arena containers allocate from the current resource", "[util]") {
+  CountingResource counting;
+  {
+    const ScopedMemoryResource scope(&counting);
+    ArenaMapModule<int, Z<5>> elem;
+    elem.insert(1, Z<5>(2));
+    elem.insert(2, Z<5>(3));
+    REQUIRE(counting.outstanding == 2);
+
+    ArenaUnorderedSetModule<int, Z<2>> set_elem;
+    set_elem.insert(4, Z<2>(1));
+    REQUIRE(counting.outstanding > 2);
+
+    // Copies use the resource current where they are made, and elements free
+    // into the resource they were constructed with.
+    {
+      const ScopedMemoryResource inner(std::pmr::new_delete_resource());
+      ArenaMapModule<int, Z<5>> copy(elem);
+      REQUIRE(copy == elem);
+      elem.clear();
+      set_elem.clear();
+    }
+    REQUIRE(counting.outstanding <= 1);  // unordered_set keeps its buckets
+  }
+  REQUIRE(counting.outstanding == 0);
+  REQUIRE(counting.allocations >= 3);
+}
+
+TEST_CASE("Arena linear maps release temporaries at once", "[util]") {
+  using M = DefaultModule<int, Z<3>, ArenaModuleStorage>;
+  CHECK(std::same_as<M, ArenaUnorderedMapModule<int, Z<3>>>);
+
+  M expected;
+  expected.insert(1, Z<3>(1));
+  expected.insert(3, Z<3>(2));
+
+  ScopedArena arena(1024);
+  M chain;
+  chain.insert(1, Z<3>(1));
+  chain.insert(2, Z<3>(1));
+  const M result = linear_apply(chain, [](const int cell) {
+    M image;
+    image.insert(cell, Z<3>(1));
+    image.insert(cell + 1, Z<3>(2));
+    return image;
+  });
+  REQUIRE(result == expected);
+}
+
+TEST_CASE("Caches and gradings accept arena allocators", "[util]") {
+  CountingResource counting;
+  const ScopedMemoryResource scope(&counting);
+  {
+    LRUCache<int, int, ArenaDefaultMap, ArenaAllocator> cache(
+        [](const int key) { return 2 * key; }, 2
+    );
+    REQUIRE(cache[1] == 2);
+    REQUIRE(cache[2] == 4);
+    REQUIRE(cache[3] == 6);
+    REQUIRE(cache.size() == 2);
+    REQUIRE_FALSE(cache.contains(1));
+
+    auto moved = std::move(cache);
+    REQUIRE(moved[2] == 4);
+    REQUIRE(counting.outstanding > 0);
+  }
+  REQUIRE(counting.outstanding == 0);
+
+  const MapGrading<int, 0, 5, ArenaDefaultMap> map_grading(
+      {{1, 2}, {3, 4}}, ArenaAllocator<std::pair<const int, int>>(&counting)
+  );
+  REQUIRE(map_grading(1) == 2);
+  REQUIRE(map_grading(2) == 5);
+  const SetGrading<int, 0, 1, ArenaDefaultSet> set_grading(
+      {1, 3}, ArenaAllocator<int>(&counting)
+  );
+  REQUIRE(set_grading(3) == 0);
+  REQUIRE(set_grading(2) == 1);
+  REQUIRE(counting.outstanding > 0);
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
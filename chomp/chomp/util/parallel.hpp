@@ -0,0 +1,214 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains the execution policies accepted by the
+ * chain-level operators and the partitioned parallel loops implementing their
+ * parallel versions, which run as tasks of a `WorkStealingScheduler`.
+ */
+
+#ifndef CHOMP_UTIL_PARALLEL_H
+#define CHOMP_UTIL_PARALLEL_H
+
+#include <chomp/util/scheduler.hpp>
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace chomp::core {
+
+/** @brief Execution policy running an operation on the calling thread. */
+struct SequencedPolicy {};
+
+/**
+ * @brief Execution policy partitioning an operation over several threads.
+ *
+ * Inputs are split into contiguous ranges of at least `grain` items, at most
+ * one per thread, which run as tasks of `scheduler`; the partial results are
+ * merged with a tree reduction.
+ */
+struct ParallelPolicy {
+  /**
+   * @brief Maximum number of threads; `0` uses
+   * `std::thread::hardware_concurrency()`.
+   */
+  std::size_t threads = 0;
+  /** @brief Minimum number of items per thread. */
+  std::size_t grain = 1024;
+  /**
+   * @brief Scheduler running the ranges; `nullptr` uses
+   * `WorkStealingScheduler::global()`.
+   */
+  WorkStealingScheduler* scheduler = nullptr;
+
+  /**
+   * @brief Scheduler running the ranges under this policy.
+   *
+   * @return WorkStealingScheduler&
+   */
+  [[nodiscard]] WorkStealingScheduler& executor() const {
+    return scheduler != nullptr ? *scheduler : WorkStealingScheduler::global();
+  }
+
+  /**
+   * @brief Number of ranges `count` items are partitioned into.
+   *
+   * @param count Number of items.
+   * @return std::size_t At least one, unless `count` is zero.
+   */
+  [[nodiscard]] std::size_t partitions(std::size_t count) const noexcept {
+    std::size_t max_threads = threads;
+    if (max_threads == 0) {
+      max_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    const std::size_t min_grain = std::max<std::size_t>(grain, 1);
+    return std::min(max_threads, (count + min_grain - 1) / min_grain);
+  }
+};
+
+/** @brief Instance of `SequencedPolicy`. */
+inline constexpr SequencedPolicy seq{};
+/** @brief Instance of `ParallelPolicy` with default settings. */
+inline constexpr ParallelPolicy par{};
+
+/**
+ * @brief Execution policy types accepted by the chain-level operators.
+ *
+ * @tparam P
+ */
+template <typename P>
+concept ExecutionPolicy =
+    std::same_as<std::remove_cvref_t<P>, SequencedPolicy> ||
+    std::same_as<std::remove_cvref_t<P>, ParallelPolicy>;
+
+/**
+ * @brief Reduce the items `[0, count)` in parallel.
+ *
+ * The items are partitioned according to `policy` into contiguous ranges;
+ * `map(first, last)` computes the partial result of each range as a task of
+ * `policy.executor()`, and the partial results are merged pairwise with
+ * `combine(lhs, std::move(rhs))` in a tree of depth logarithmic in the
+ * number of ranges, whose merges at equal depth also run concurrently. The
+ * calling thread computes the first range and the merges into it, running
+ * other pending tasks while it waits. The `part`-th range is submitted to
+ * worker `part`, so repeated reductions of the same items keep each range on
+ * the same worker unless it is stolen. With a single range, everything runs on
+ * the calling thread.
+ *
+ * Both `map` and `combine` are called concurrently and must be safe to do so.
+ * Ranges are always combined in order, so `combine` need not be commutative.
+ *
+ * @tparam T Partial result type.
+ * @tparam Map Function object type invocable on two `std::size_t` and
+ * returning `T`.
+ * @tparam Combine Function object type invocable on `T&` and `T&&`.
+ * @param policy Parallel execution policy.
+ * @param count Number of items.
+ * @param map Function computing the partial result of a range.
+ * @param combine Function merging its second argument into its first.
+ * @return T The partial result of `[0, count)`; default constructed if
+ * `count` is zero.
+ */
+template <std::default_initializable T, typename Map, typename Combine>
+requires std::invocable<const Map&, std::size_t, std::size_t> &&
+         std::convertible_to<
+             std::invoke_result_t<const Map&, std::size_t, std::size_t>, T> &&
+         std::invocable<const Combine&, T&, T&&>
+[[nodiscard]] T parallel_reduce(
+    const ParallelPolicy& policy, std::size_t count, const Map& map,
+    const Combine& combine
+) {
+  const std::size_t parts = policy.partitions(count);
+  if (parts == 0) {
+    return T();
+  }
+  if (parts == 1) {
+    return map(0, count);
+  }
+
+  std::vector<T> partials(parts);
+  {
+    const auto range_begin = [count, parts](std::size_t part) {
+      return count * part / parts;
+    };
+    TaskGroup ranges(policy.executor());
+    for (std::size_t part = 1; part < parts; ++part) {
+      ranges.run(
+          [&, part]() {
+            partials[part] = map(range_begin(part), range_begin(part + 1));
+          },
+          part
+      );
+    }
+    partials[0] = map(0, range_begin(1));
+  }
+
+  for (std::size_t stride = 1; stride < parts; stride *= 2) {
+    TaskGroup merges(policy.executor());
+    for (std::size_t lhs = 2 * stride; lhs + stride < parts;
+         lhs += 2 * stride) {
+      merges.run(
+          [&, lhs]() {
+            combine(partials[lhs], std::move(partials[lhs + stride]));
+          },
+          lhs
+      );
+    }
+    combine(partials[0], std::move(partials[stride]));
+  }
+  return std::move(partials[0]);
+}
+
+/**
+ * @brief Call `body(first, last)` on a partition of the items `[0, count)`
+ * in parallel.
+ *
+ * The items are partitioned according to `policy` into contiguous ranges as
+ * for `parallel_reduce`; the ranges run as tasks of `policy.executor()`,
+ * except for the first, which runs on the calling thread. Returns once every
+ * range is done.
+ *
+ * @tparam Body Function object type invocable on two `std::size_t`; called
+ * concurrently.
+ * @param policy Parallel execution policy.
+ * @param count Number of items.
+ * @param body Function processing a range.
+ */
+template <typename Body>
+requires std::invocable<const Body&, std::size_t, std::size_t>
+void parallel_for(
+    const ParallelPolicy& policy, std::size_t count, const Body& body
+) {
+  const std::size_t parts = policy.partitions(count);
+  if (parts == 0) {
+    return;
+  }
+  if (parts == 1) {
+    body(0, count);
+    return;
+  }
+
+  const auto range_begin = [count, parts](std::size_t part) {
+    return count * part / parts;
+  };
+  TaskGroup ranges(policy.executor());
+  for (std::size_t part = 1; part < parts; ++part) {
+    ranges.run(
+        [&, part]() { body(range_begin(part), range_begin(part + 1)); }, part
+    );
+  }
+  body(0, range_begin(1));
+  ranges.wait();
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_UTIL_PARALLEL_H
@@ -0,0 +1,74 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/util/parallel.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+TEST_CASE("ParallelPolicy partitions by threads and grain", "[util]") {
+  CHECK(ExecutionPolicy<SequencedPolicy>);
+  CHECK(ExecutionPolicy<const ParallelPolicy&>);
+  CHECK_FALSE(ExecutionPolicy<int>);
+
+  const ParallelPolicy policy{.threads = 8, .grain = 10};
+  REQUIRE(policy.partitions(0) == 0);
+  REQUIRE(policy.partitions(1) == 1);
+  REQUIRE(policy.partitions(25) == 3);
+  REQUIRE(policy.partitions(1000) == 8);
+  REQUIRE(par.partitions(1) == 1);
+  REQUIRE(ParallelPolicy{.threads = 2, .grain = 0}.partitions(5) == 2);
+}
+
+TEST_CASE("parallel_reduce combines ranges in order", "[util]") {
+  // Concatenation is not commutative, so this checks the reduction order.
+  const auto map = [](std::size_t first, std::size_t last) {
+    std::vector<std::size_t> range(last - first);
+    std::iota(range.begin(), range.end(), first);
+    return range;
+  };
+  const auto combine = [](std::vector<std::size_t>& lhs,
+                          std::vector<std::size_t>&& rhs) {
+    lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+  };
+
+  for (const std::size_t threads : {1, 2, 3, 5, 8}) {
+    for (const std::size_t count : {0, 1, 7, 100, 1001}) {
+      const ParallelPolicy policy{.threads = threads, .grain = 1};
+      const std::vector<std::size_t> result =
+          parallel_reduce<std::vector<std::size_t>>(
+              policy, count, map, combine
+          );
+      REQUIRE(result == map(0, count));
+    }
+  }
+
+  const ParallelPolicy policy{.threads = 4, .grain = 1};
+  const auto sum = parallel_reduce<std::size_t>(
+      policy, 10000,
+      [](std::size_t first, std::size_t last) {
+        std::size_t partial = 0;
+        for (std::size_t item = first; item < last; ++item) {
+          partial += item;
+        }
+        return partial;
+      },
+      [](std::size_t& lhs, std::size_t&& rhs) { lhs += rhs; }
+  );
+  REQUIRE(sum == 10000 * 9999 / 2);
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
@@ -0,0 +1,562 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains the work-stealing task scheduler shared by the
+ * parallel operators, `WorkStealingScheduler`, and `TaskGroup` for waiting on
+ * a set of its tasks.
+ *
+ * Each worker owns a deque of tasks; it runs its own tasks newest first and,
+ * when out of work, steals the oldest task of another worker, trying the
+ * workers on its own NUMA node first. Threads waiting on a `TaskGroup` run
+ * pending tasks meanwhile, so tasks may themselves start and wait on groups
+ * without exhausting the workers.
+ */
+
+#ifndef CHOMP_UTIL_SCHEDULER_H
+#define CHOMP_UTIL_SCHEDULER_H
+
+#include <chomp/util/memory.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace chomp::core {
+
+/** @brief Construction options of `WorkStealingScheduler`. */
+struct SchedulerOptions {
+  /**
+   * @brief Number of worker threads; `0` uses
+   * `std::thread::hardware_concurrency()`.
+   */
+  std::size_t workers = 0;
+  /**
+   * @brief Pin each worker to one CPU, filling the CPUs node by node; only
+   * supported on Linux, and ignored elsewhere.
+   */
+  bool pin_workers = false;
+  /**
+   * @brief Run the tasks of each worker with a memory resource private to the
+   * worker current, see `current_memory_resource()`.
+   */
+  bool worker_arenas = true;
+};
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+// Maximum NUMA node id probed in sysfs
+inline constexpr unsigned MAX_NUMA_NODES = 256;
+
+// Parse a Linux CPU list such as "0-3,8,10-11" into its CPU ids, ascending
+inline std::vector<unsigned> parse_cpu_list(std::string_view list) {
+  std::vector<unsigned> cpus;
+  while (!list.empty()) {
+    const std::size_t comma = list.find(',');
+    std::string_view range = list.substr(0, comma);
+    list = comma == std::string_view::npos ? std::string_view()
+                                           : list.substr(comma + 1);
+
+    unsigned first = 0;
+    unsigned last = 0;
+    bool second = false;
+    bool digits = false;
+    for (const char next : range) {
+      if (next >= '0' && next <= '9') {
+        unsigned& bound = second ? last : first;
+        bound = 10 * bound + static_cast<unsigned>(next - '0');
+        digits = true;
+      } else if (next == '-' && !second) {
+        second = true;
+      }
+    }
+    if (!digits) {
+      continue;
+    }
+    if (!second) {
+      last = first;
+    }
+    for (unsigned cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  std::ranges::sort(cpus);
+  const auto [end, unused] = std::ranges::unique(cpus);
+  cpus.erase(end, cpus.end());
+  return cpus;
+}
+
+// CPUs available to this process grouped by NUMA node, from sysfs; a single
+// node of `hardware_concurrency` CPUs if the topology is unavailable
+inline std::vector<std::vector<unsigned>> numa_topology() {
+  std::vector<std::vector<unsigned>> nodes;
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  const bool masked = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+  for (unsigned node = 0; node < MAX_NUMA_NODES; ++node) {
+    std::ifstream file(
+        "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"
+    );
+    std::string list;
+    if (!file || !std::getline(file, list)) {
+      continue;
+    }
+    std::vector<unsigned> cpus = parse_cpu_list(list);
+    if (masked) {
+      std::erase_if(cpus, [&allowed](unsigned cpu) {
+        return cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed);
+      });
+    }
+    if (!cpus.empty()) {
+      nodes.push_back(std::move(cpus));
+    }
+  }
+#endif
+  if (nodes.empty()) {
+    nodes.emplace_back(std::max(std::thread::hardware_concurrency(), 1U));
+    for (unsigned cpu = 0; cpu < nodes.front().size(); ++cpu) {
+      nodes.front()[cpu] = cpu;
+    }
+  }
+  return nodes;
+}
+
+// Pin the calling thread to `cpu`; failure leaves it unpinned
+inline void pin_current_thread([[maybe_unused]] unsigned cpu) noexcept {
+#ifdef __linux__
+  if (cpu < CPU_SETSIZE) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+#endif
+}
+
+}  // namespace detail
+#endif  // CHOMP_DOXYGEN
+
+/**
+ * @brief A pool of worker threads running tasks with work stealing.
+ *
+ * Tasks are submitted to the deque of one worker: the worker submitting it,
+ * the worker named by the caller, or else the next worker in turn. Each worker
+ * runs the newest task of its own deque first, keeping related work on one
+ * thread, and steals the oldest task of another worker when its deque is
+ * empty, trying workers on the same NUMA node before the others. Workers with
+ * nothing to run sleep until a task is submitted.
+ *
+ * Workers are laid out over the CPUs available to the process node by node,
+ * so consecutive workers share a node; with `SchedulerOptions::pin_workers`,
+ * each is also pinned to its CPU. With `SchedulerOptions::worker_arenas`,
+ * each worker owns a pool memory resource which is current while it runs
+ * tasks, so containers allocating with `ArenaAllocator` inside tasks do not
+ * contend on the global allocator. Such containers may be moved to and
+ * destroyed on other threads, but must not outlive the scheduler.
+ *
+ * Tasks must not throw. Destroying the scheduler runs all pending tasks before
+ * joining the workers.
+ *
+ * @sa `TaskGroup`, `ParallelPolicy`
+ */
+class WorkStealingScheduler {
+public:
+  /** @brief Type-erased task. */
+  using Task = std::move_only_function<void()>;
+
+private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::size_t node = 0;
+    unsigned cpu = 0;
+    // Workers to steal from, in order: same node first
+    std::vector<std::size_t> victims;
+    std::pmr::synchronized_pool_resource arena;
+  };
+
+  struct ThreadState {
+    const WorkStealingScheduler* scheduler = nullptr;
+    std::size_t worker = 0;
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  std::size_t nodes;
+  bool worker_arenas;
+  std::atomic<std::size_t> pending = 0;
+  std::atomic<std::size_t> next_worker = 0;
+  std::mutex idle_mutex;
+  std::condition_variable idle;
+  bool stopping = false;
+  std::vector<std::jthread> threads;
+
+  static ThreadState& thread_state() noexcept {
+    thread_local ThreadState state;
+    return state;
+  }
+
+  std::optional<Task> pop(std::size_t worker) {
+    Worker& own = *workers[worker];
+    const std::lock_guard lock(own.mutex);
+    if (own.tasks.empty()) {
+      return std::nullopt;
+    }
+    Task task = std::move(own.tasks.back());
+    own.tasks.pop_back();
+    pending.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+  }
+
+  // Gives up on a contended deque unless `blocking`
+  std::optional<Task> steal(std::size_t victim, bool blocking = false) {
+    Worker& other = *workers[victim];
+    std::unique_lock lock(other.mutex, std::defer_lock);
+    if (blocking) {
+      lock.lock();
+    } else if (!lock.try_lock()) {
+      return std::nullopt;
+    }
+    if (other.tasks.empty()) {
+      return std::nullopt;
+    }
+    Task task = std::move(other.tasks.front());
+    other.tasks.pop_front();
+    pending.fetch_sub(1, std::memory_order_relaxed);
+    return task;
+  }
+
+  std::optional<Task> take(std::size_t worker, bool blocking = false) {
+    if (std::optional<Task> task = pop(worker)) {
+      return task;
+    }
+    for (const std::size_t victim : workers[worker]->victims) {
+      if (std::optional<Task> task = steal(victim, blocking)) {
+        return task;
+      }
+    }
+    return std::nullopt;
+  }
+
+  void run_on(std::size_t worker, Task& task) {
+    if (worker_arenas) {
+      const ScopedMemoryResource scope(&workers[worker]->arena);
+      task();
+    } else {
+      task();
+    }
+  }
+
+  void work(std::size_t worker, bool pin) {
+    thread_state() = {this, worker};
+    if (pin) {
+      detail::pin_current_thread(workers[worker]->cpu);
+    }
+    while (true) {
+      if (std::optional<Task> task = take(worker)) {
+        run_on(worker, *task);
+        continue;
+      }
+      // Contended deques were skipped; look again through every deque before
+      // sleeping, as `pending` counts their tasks and would wake the worker
+      if (std::optional<Task> task = take(worker, true)) {
+        run_on(worker, *task);
+        continue;
+      }
+      std::unique_lock lock(idle_mutex);
+      idle.wait(lock, [this]() {
+        return stopping || pending.load(std::memory_order_relaxed) != 0;
+      });
+      if (stopping && pending.load(std::memory_order_relaxed) == 0) {
+        return;
+      }
+    }
+  }
+
+public:
+  /**
+   * @brief Start the workers.
+   *
+   * @param options
+   */
+  explicit WorkStealingScheduler(const SchedulerOptions& options = {}) :
+      worker_arenas(options.worker_arenas) {
+    const std::vector<std::vector<unsigned>> topology = detail::numa_topology();
+    std::vector<std::pair<std::size_t, unsigned>> cpus;
+    for (std::size_t node = 0; node < topology.size(); ++node) {
+      for (const unsigned cpu : topology[node]) {
+        cpus.emplace_back(node, cpu);
+      }
+    }
+    nodes = topology.size();
+
+    std::size_t count = options.workers;
+    if (count == 0) {
+      count = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    workers.reserve(count);
+    for (std::size_t worker = 0; worker < count; ++worker) {
+      workers.push_back(std::make_unique<Worker>());
+      std::tie(workers.back()->node, workers.back()->cpu) =
+          cpus[worker % cpus.size()];
+    }
+    for (std::size_t worker = 0; worker < count; ++worker) {
+      std::vector<std::size_t>& victims = workers[worker]->victims;
+      for (const bool same_node : {true, false}) {
+        for (std::size_t offset = 1; offset < count; ++offset) {
+          const std::size_t victim = (worker + offset) % count;
+          if ((workers[victim]->node == workers[worker]->node) == same_node) {
+            victims.push_back(victim);
+          }
+        }
+      }
+    }
+
+    threads.reserve(count);
+    for (std::size_t worker = 0; worker < count; ++worker) {
+      threads.emplace_back(
+          [this, worker, pin = options.pin_workers]() { work(worker, pin); }
+      );
+    }
+  }
+
+  WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+  WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+  /** @brief Run the pending tasks, then stop and join the workers. */
+  ~WorkStealingScheduler() {
+    {
+      const std::lock_guard lock(idle_mutex);
+      stopping = true;
+    }
+    idle.notify_all();
+    threads.clear();
+  }
+
+  /**
+   * @brief Scheduler shared by the parallel operators unless a policy names
+   * another, with default options; started on first use.
+   *
+   * @return WorkStealingScheduler&
+   */
+  [[nodiscard]] static WorkStealingScheduler& global() {
+    static WorkStealingScheduler scheduler;
+    return scheduler;
+  }
+
+  /**
+   * @brief Number of worker threads.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t worker_count() const noexcept {
+    return workers.size();
+  }
+  /**
+   * @brief Number of NUMA nodes the workers are laid out over.
+   *
+   * @return std::size_t
+   */
+  [[nodiscard]] std::size_t node_count() const noexcept {
+    return nodes;
+  }
+  /**
+   * @brief NUMA node of `worker`.
+   *
+   * @param worker Less than `worker_count()`.
+   * @return std::size_t Less than `node_count()`.
+   */
+  [[nodiscard]] std::size_t node_of(std::size_t worker) const noexcept {
+    return workers[worker]->node;
+  }
+
+  /**
+   * @brief Index of the worker of this scheduler running the calling thread.
+   *
+   * @return std::optional<std::size_t> Empty if the calling thread is not a
+   * worker of this scheduler.
+   */
+  [[nodiscard]] std::optional<std::size_t> current_worker() const noexcept {
+    const ThreadState& state = thread_state();
+    if (state.scheduler != this) {
+      return std::nullopt;
+    }
+    return state.worker;
+  }
+
+  /**
+   * @brief Submit `task` to the deque of worker `worker % worker_count()`.
+   *
+   * Naming the same worker for tasks touching the same data, e.g. the same
+   * shard of a `ShardedLRUCache`, keeps that data local to one thread unless
+   * the task is stolen.
+   *
+   * @param task
+   * @param worker
+   */
+  void submit(Task task, std::size_t worker) {
+    Worker& target = *workers[worker % workers.size()];
+    {
+      // Counted under the deque lock, so that `pending` never exceeds the
+      // number of queued tasks
+      const std::lock_guard lock(target.mutex);
+      target.tasks.push_back(std::move(task));
+      pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+      // Synchronize with workers checking `pending` before they sleep
+      const std::lock_guard lock(idle_mutex);
+    }
+    idle.notify_one();
+  }
+
+  /**
+   * @brief Submit `task` to the deque of the calling worker, or of the next
+   * worker in turn if the calling thread is not a worker of this scheduler.
+   *
+   * @param task
+   */
+  void submit(Task task) {
+    const std::optional<std::size_t> worker = current_worker();
+    submit(
+        std::move(task),
+        worker ? *worker
+               : next_worker.fetch_add(1, std::memory_order_relaxed)
+    );
+  }
+
+  /**
+   * @brief Run one pending task on the calling thread, if any.
+   *
+   * A worker of this scheduler takes from its own deque first; other threads
+   * steal from the workers in turn.
+   *
+   * @return true If a task was run.
+   * @return false If no task was found.
+   */
+  bool run_one() {
+    if (const std::optional<std::size_t> worker = current_worker()) {
+      if (std::optional<Task> task = take(*worker)) {
+        run_on(*worker, *task);
+        return true;
+      }
+      return false;
+    }
+    const std::size_t start = next_worker.load(std::memory_order_relaxed);
+    for (std::size_t offset = 0; offset < workers.size(); ++offset) {
+      const std::size_t victim = (start + offset) % workers.size();
+      if (std::optional<Task> task = steal(victim)) {
+        (*task)();
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/**
+ * @brief A set of tasks running on a `WorkStealingScheduler` which can be
+ * waited on together.
+ *
+ * `wait` returns once every task run through the group, including tasks run
+ * by those tasks, has finished; the waiting thread runs pending tasks of the
+ * scheduler meanwhile. The group waits on destruction.
+ */
+class TaskGroup {
+  WorkStealingScheduler* scheduler;
+  std::atomic<std::size_t> outstanding = 0;
+
+  // The function object is destroyed before the task is released, as a
+  // waiter may then destroy what its captures refer to
+  template <typename F>
+  WorkStealingScheduler::Task wrap(F&& func) {
+    return [this, func = std::optional<std::decay_t<F>>(std::forward<F>(func))](
+           ) mutable {
+      (*func)();
+      func.reset();
+      outstanding.fetch_sub(1, std::memory_order_release);
+    };
+  }
+
+public:
+  /**
+   * @brief Initialize an empty group of tasks of `scheduler`.
+   *
+   * @param scheduler
+   */
+  explicit TaskGroup(WorkStealingScheduler& scheduler) noexcept :
+      scheduler(&scheduler) {}
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  /** @brief Wait for all tasks of the group. */
+  ~TaskGroup() {
+    wait();
+  }
+
+  /**
+   * @brief Run `func` as a task of the group; see
+   * `WorkStealingScheduler::submit(Task)`.
+   *
+   * @tparam F Function object type invocable with no arguments.
+   * @param func
+   */
+  template <std::invocable F>
+  void run(F&& func) {
+    outstanding.fetch_add(1, std::memory_order_relaxed);
+    scheduler->submit(wrap(std::forward<F>(func)));
+  }
+
+  /**
+   * @brief Run `func` as a task of the group on the deque of worker `worker`;
+   * see `WorkStealingScheduler::submit(Task, std::size_t)`.
+   *
+   * @tparam F Function object type invocable with no arguments.
+   * @param func
+   * @param worker
+   */
+  template <std::invocable F>
+  void run(F&& func, std::size_t worker) {
+    outstanding.fetch_add(1, std::memory_order_relaxed);
+    scheduler->submit(wrap(std::forward<F>(func)), worker);
+  }
+
+  /** @brief Wait for all tasks of the group, running pending tasks. */
+  void wait() {
+    while (outstanding.load(std::memory_order_acquire) != 0) {
+      if (!scheduler->run_one()) {
+        std::this_thread::yield();
+      }
+    }
+  }
+};
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_UTIL_SCHEDULER_H
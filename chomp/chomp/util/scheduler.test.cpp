@@ -0,0 +1,195 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/util/memory.hpp>
+#include <chomp/util/parallel.hpp>
+#include <chomp/util/scheduler.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+namespace {
+
+// Sum of `[first, last)` by recursive splitting into nested task groups
+std::size_t nested_sum(
+    WorkStealingScheduler& scheduler, std::size_t first, std::size_t last
+) {
+  if (last - first <= 8) {
+    std::size_t sum = 0;
+    for (std::size_t value = first; value < last; ++value) {
+      sum += value;
+    }
+    return sum;
+  }
+  const std::size_t middle = first + (last - first) / 2;
+  std::size_t upper = 0;
+  TaskGroup group(scheduler);
+  group.run([&]() { upper = nested_sum(scheduler, middle, last); });
+  const std::size_t lower = nested_sum(scheduler, first, middle);
+  group.wait();
+  return lower + upper;
+}
+
+}  // namespace
+
+TEST_CASE("parse_cpu_list reads Linux CPU lists", "[util]") {
+  REQUIRE(detail::parse_cpu_list("0-3,8,10-11\n") ==
+          std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11});
+  REQUIRE(detail::parse_cpu_list("5") == std::vector<unsigned>{5});
+  REQUIRE(detail::parse_cpu_list("2,0-2") == std::vector<unsigned>{0, 1, 2});
+  REQUIRE(detail::parse_cpu_list("").empty());
+  REQUIRE(detail::parse_cpu_list("\n").empty());
+
+  const std::vector<std::vector<unsigned>> topology = detail::numa_topology();
+  REQUIRE_FALSE(topology.empty());
+  for (const std::vector<unsigned>& node : topology) {
+    REQUIRE_FALSE(node.empty());
+  }
+}
+
+TEST_CASE("WorkStealingScheduler runs every task", "[util]") {
+  for (const bool pin : {false, true}) {
+    WorkStealingScheduler scheduler(
+        SchedulerOptions{.workers = 3, .pin_workers = pin}
+    );
+    REQUIRE(scheduler.worker_count() == 3);
+    REQUIRE(scheduler.node_count() >= 1);
+    for (std::size_t worker = 0; worker < 3; ++worker) {
+      REQUIRE(scheduler.node_of(worker) < scheduler.node_count());
+    }
+    REQUIRE_FALSE(scheduler.current_worker().has_value());
+
+    std::atomic<std::size_t> runs = 0;
+    std::atomic<bool> on_workers = true;
+    {
+      TaskGroup group(scheduler);
+      for (std::size_t task = 0; task < 1000; ++task) {
+        group.run(
+            [&]() {
+              // Tasks also run on the waiting thread, which is no worker
+              const std::optional<std::size_t> worker =
+                  scheduler.current_worker();
+              if (worker && *worker >= 3) {
+                on_workers = false;
+              }
+              ++runs;
+            },
+            task
+        );
+      }
+      group.wait();
+      REQUIRE(runs == 1000);
+      for (std::size_t task = 0; task < 100; ++task) {
+        group.run([&runs]() { ++runs; });
+      }
+    }
+    REQUIRE(runs == 1100);
+    REQUIRE(on_workers);
+  }
+}
+
+TEST_CASE("WorkStealingScheduler runs nested task groups", "[util]") {
+  WorkStealingScheduler scheduler(SchedulerOptions{.workers = 2});
+  REQUIRE(nested_sum(scheduler, 0, 10000) == 10000 * 9999 / 2);
+
+  std::atomic<std::size_t> sum = 0;
+  {
+    TaskGroup outer(scheduler);
+    for (std::size_t task = 0; task < 8; ++task) {
+      outer.run([&scheduler, &sum]() {
+        sum += nested_sum(scheduler, 0, 1000);
+      });
+    }
+  }
+  REQUIRE(sum == 8 * (1000 * 999 / 2));
+
+  // Captures are destroyed by the time the group is waited for
+  std::weak_ptr<int> captured;
+  std::atomic<int> total = 0;
+  {
+    TaskGroup group(scheduler);
+    auto shared = std::make_shared<int>(1);
+    captured = shared;
+    for (std::size_t task = 0; task < 64; ++task) {
+      group.run([shared, &total]() { total += *shared; });
+    }
+    shared.reset();
+    group.wait();
+    REQUIRE(captured.expired());
+  }
+  REQUIRE(total == 64);
+}
+
+TEST_CASE("WorkStealingScheduler runs tasks under worker arenas", "[util]") {
+  for (const bool arenas : {false, true}) {
+    WorkStealingScheduler scheduler(
+        SchedulerOptions{.workers = 2, .worker_arenas = arenas}
+    );
+    std::atomic<std::size_t> arena_runs = 0;
+    std::atomic<std::size_t> worker_runs = 0;
+    {
+      TaskGroup group(scheduler);
+      for (std::size_t task = 0; task < 200; ++task) {
+        group.run([&]() {
+          if (scheduler.current_worker()) {
+            ++worker_runs;
+            if (current_memory_resource() !=
+                std::pmr::get_default_resource()) {
+              ++arena_runs;
+            }
+          }
+        });
+      }
+    }
+    REQUIRE(arena_runs == (arenas ? worker_runs.load() : 0));
+  }
+}
+
+TEST_CASE("parallel_reduce and parallel_for run on a scheduler", "[util]") {
+  WorkStealingScheduler scheduler(SchedulerOptions{.workers = 3});
+  const ParallelPolicy policy{
+      .threads = 5, .grain = 1, .scheduler = &scheduler
+  };
+  REQUIRE(&policy.executor() == &scheduler);
+  REQUIRE(&par.executor() == &WorkStealingScheduler::global());
+
+  const auto map = [](std::size_t first, std::size_t last) {
+    std::vector<std::size_t> range(last - first);
+    std::iota(range.begin(), range.end(), first);
+    return range;
+  };
+  const std::vector<std::size_t> result =
+      parallel_reduce<std::vector<std::size_t>>(
+          policy, 1001, map,
+          [](std::vector<std::size_t>& lhs, std::vector<std::size_t>&& rhs) {
+            lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+          }
+      );
+  REQUIRE(result == map(0, 1001));
+
+  std::vector<std::size_t> visits(1001);
+  parallel_for(policy, visits.size(), [&](std::size_t first, std::size_t last) {
+    for (std::size_t item = first; item < last; ++item) {
+      ++visits[item];
+    }
+  });
+  REQUIRE(visits == std::vector<std::size_t>(1001, 1));
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN
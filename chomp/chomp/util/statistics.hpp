@@ -0,0 +1,225 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+/** @file
+ * @brief This header contains the optional statistics counters of caches and
+ * complexes, enabled at compile time by defining `CHOMP_ENABLE_STATISTICS`.
+ *
+ * When `CHOMP_ENABLE_STATISTICS` is undefined or `0`, the counters are empty
+ * classes whose methods do nothing, so instrumented data structures keep their
+ * size and their hot paths compile to the uninstrumented code. The macro must
+ * have the same value in every translation unit of a program.
+ */
+
+#ifndef CHOMP_UTIL_STATISTICS_H
+#define CHOMP_UTIL_STATISTICS_H
+
+#ifndef CHOMP_ENABLE_STATISTICS
+#define CHOMP_ENABLE_STATISTICS 0
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <utility>
+
+namespace chomp::core {
+
+/**
+ * @brief Whether statistics counters are compiled in; set by the
+ * `CHOMP_ENABLE_STATISTICS` macro.
+ */
+constexpr bool STATISTICS_ENABLED = CHOMP_ENABLE_STATISTICS;
+
+/**
+ * @brief Snapshot of the counters of a cache.
+ *
+ * @sa `LRUCache`, `ClockCache`, `ShardedLRUCache`
+ */
+struct CacheStatistics {
+  /** @brief Lookups that found the key in the cache. */
+  std::size_t hits = 0;
+  /** @brief Lookups that constructed the value. */
+  std::size_t misses = 0;
+  /** @brief Entries removed to respect the maximum size. */
+  std::size_t evictions = 0;
+  /** @brief Total time spent constructing values on misses. */
+  std::chrono::nanoseconds construction_time{0};
+
+  /**
+   * @brief Accumulate another snapshot, e.g. of another shard.
+   *
+   * @param rhs
+   * @return CacheStatistics&
+   */
+  CacheStatistics& operator+=(const CacheStatistics& rhs) noexcept {
+    hits += rhs.hits;
+    misses += rhs.misses;
+    evictions += rhs.evictions;
+    construction_time += rhs.construction_time;
+    return *this;
+  }
+
+  /** @brief Equality operator; compares every counter. */
+  [[nodiscard]] bool operator==(const CacheStatistics&) const = default;
+};
+
+/**
+ * @brief Snapshot of the counters of a cell complex.
+ *
+ * @sa `CubicalComplex`
+ */
+struct ComplexStatistics {
+  /** @brief Boundary computations (chain or visitor based). */
+  std::size_t boundary_calls = 0;
+  /** @brief Coboundary computations (chain or visitor based). */
+  std::size_t coboundary_calls = 0;
+  /** @brief Cells emitted into (co)boundary chains. */
+  std::size_t emitted_cells = 0;
+  /** @brief Cells graded through the complex. */
+  std::size_t grading_calls = 0;
+
+  /** @brief Equality operator; compares every counter. */
+  [[nodiscard]] bool operator==(const ComplexStatistics&) const = default;
+};
+
+#ifndef CHOMP_DOXYGEN
+namespace detail {
+
+/**
+ * @brief Counters of a cache; an empty no-op class when `ENABLED` is `false`.
+ *
+ * Counters are not synchronized; caches accessed concurrently update them
+ * under their own locks.
+ */
+template <bool ENABLED = STATISTICS_ENABLED>
+class CacheCounters {
+  CacheStatistics counts;
+
+public:
+  void record_hit() noexcept {
+    ++counts.hits;
+  }
+  void record_eviction() noexcept {
+    ++counts.evictions;
+  }
+  // Count a miss and time the construction of its value.
+  template <typename F>
+  decltype(auto) record_miss(F&& construct) {
+    ++counts.misses;
+    const auto start = std::chrono::steady_clock::now();
+    auto value = std::forward<F>(construct)();
+    counts.construction_time += std::chrono::duration_cast<
+        std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return value;
+  }
+  [[nodiscard]] CacheStatistics snapshot() const noexcept {
+    return counts;
+  }
+  void reset() noexcept {
+    counts = CacheStatistics();
+  }
+};
+
+template <>
+class CacheCounters<false> {
+public:
+  void record_hit() noexcept {}
+  void record_eviction() noexcept {}
+  template <typename F>
+  decltype(auto) record_miss(F&& construct) {
+    return std::forward<F>(construct)();
+  }
+  [[nodiscard]] CacheStatistics snapshot() const noexcept {
+    return {};
+  }
+  void reset() noexcept {}
+};
+
+/**
+ * @brief Relaxed atomic counter that is copyable, for counters updated from
+ * `const` methods which may run concurrently.
+ */
+class RelaxedCounter {
+  std::atomic<std::size_t> count = 0;
+
+public:
+  RelaxedCounter() = default;
+  RelaxedCounter(const RelaxedCounter& other) noexcept : count(other.load()) {}
+  RelaxedCounter& operator=(const RelaxedCounter& other) noexcept {
+    count.store(other.load(), std::memory_order_relaxed);
+    return *this;
+  }
+  ~RelaxedCounter() = default;
+
+  void add(std::size_t amount) noexcept {
+    count.fetch_add(amount, std::memory_order_relaxed);
+  }
+  [[nodiscard]] std::size_t load() const noexcept {
+    return count.load(std::memory_order_relaxed);
+  }
+  void reset() noexcept {
+    count.store(0, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * @brief Counters of a cell complex; an empty no-op class when `ENABLED` is
+ * `false`.
+ */
+template <bool ENABLED = STATISTICS_ENABLED>
+class ComplexCounters {
+  RelaxedCounter boundary_calls;
+  RelaxedCounter coboundary_calls;
+  RelaxedCounter emitted_cells;
+  RelaxedCounter grading_calls;
+
+public:
+  void record_boundary() noexcept {
+    boundary_calls.add(1);
+  }
+  void record_coboundary() noexcept {
+    coboundary_calls.add(1);
+  }
+  void record_emitted(std::size_t count) noexcept {
+    emitted_cells.add(count);
+  }
+  void record_grading(std::size_t count = 1) noexcept {
+    grading_calls.add(count);
+  }
+  [[nodiscard]] ComplexStatistics snapshot() const noexcept {
+    return {
+        boundary_calls.load(), coboundary_calls.load(), emitted_cells.load(),
+        grading_calls.load()
+    };
+  }
+  void reset() noexcept {
+    boundary_calls.reset();
+    coboundary_calls.reset();
+    emitted_cells.reset();
+    grading_calls.reset();
+  }
+};
+
+template <>
+class ComplexCounters<false> {
+public:
+  void record_boundary() noexcept {}
+  void record_coboundary() noexcept {}
+  void record_emitted(std::size_t) noexcept {}
+  void record_grading(std::size_t = 1) noexcept {}
+  [[nodiscard]] ComplexStatistics snapshot() const noexcept {
+    return {};
+  }
+  void reset() noexcept {}
+};
+
+}  // namespace detail
+#endif
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_UTIL_STATISTICS_H
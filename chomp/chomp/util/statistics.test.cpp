@@ -0,0 +1,104 @@
+/*
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ */
+
+#include <chomp/util/cache.hpp>
+#include <chomp/util/statistics.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <type_traits>
+
+#ifndef CHOMP_DOXYGEN
+
+namespace chomp::core {
+
+TEST_CASE("Disabled statistics counters are empty", "[util]") {
+  CHECK(std::is_empty_v<detail::CacheCounters<false>>);
+  CHECK(std::is_empty_v<detail::ComplexCounters<false>>);
+
+  detail::CacheCounters<false> cache_counters;
+  cache_counters.record_hit();
+  REQUIRE(cache_counters.record_miss([]() { return 5; }) == 5);
+  REQUIRE(cache_counters.snapshot() == CacheStatistics());
+
+  detail::ComplexCounters<false> complex_counters;
+  complex_counters.record_boundary();
+  complex_counters.record_emitted(4);
+  REQUIRE(complex_counters.snapshot() == ComplexStatistics());
+}
+
+TEST_CASE("Enabled statistics counters record and reset", "[util]") {
+  detail::CacheCounters<true> cache_counters;
+  cache_counters.record_hit();
+  cache_counters.record_hit();
+  cache_counters.record_eviction();
+  REQUIRE(cache_counters.record_miss([]() { return 5; }) == 5);
+
+  CacheStatistics snapshot = cache_counters.snapshot();
+  REQUIRE(snapshot.hits == 2);
+  REQUIRE(snapshot.misses == 1);
+  REQUIRE(snapshot.evictions == 1);
+  REQUIRE(snapshot.construction_time >= std::chrono::nanoseconds(0));
+
+  snapshot += cache_counters.snapshot();
+  REQUIRE(snapshot.hits == 4);
+  cache_counters.reset();
+  REQUIRE(cache_counters.snapshot() == CacheStatistics());
+
+  detail::ComplexCounters<true> complex_counters;
+  complex_counters.record_boundary();
+  complex_counters.record_coboundary();
+  complex_counters.record_coboundary();
+  complex_counters.record_emitted(4);
+  complex_counters.record_grading();
+  const detail::ComplexCounters<true> copy(complex_counters);
+  REQUIRE(copy.snapshot() == ComplexStatistics{1, 2, 4, 1});
+  complex_counters.reset();
+  REQUIRE(complex_counters.snapshot() == ComplexStatistics());
+}
+
+TEST_CASE("Cache statistics count hits, misses, and evictions", "[util]") {
+  CachedFunctionWrapper<int, int> wrapped_func(
+      [](const int& input) {
+        return input + 1;
+      },
+      2
+  );
+  wrapped_func(0);
+  wrapped_func(0);
+  wrapped_func(1);
+  wrapped_func(2);  // evicts 0
+
+  ClockCache<int, int> clock_cache(
+      [](const int& input) {
+        return input;
+      },
+      1
+  );
+  clock_cache[0];
+  clock_cache[1];  // evicts 0
+  clock_cache[1];
+
+  if constexpr (STATISTICS_ENABLED) {
+    const CacheStatistics snapshot = wrapped_func.statistics();
+    REQUIRE(snapshot.hits == 1);
+    REQUIRE(snapshot.misses == 3);
+    REQUIRE(snapshot.evictions == 1);
+    REQUIRE(clock_cache.statistics().hits == 1);
+    REQUIRE(clock_cache.statistics().evictions == 1);
+  } else {
+    REQUIRE(wrapped_func.statistics() == CacheStatistics());
+    REQUIRE(clock_cache.statistics() == CacheStatistics());
+  }
+
+  wrapped_func.reset_statistics();
+  REQUIRE(wrapped_func.statistics() == CacheStatistics());
+}
+
+}  // namespace chomp::core
+
+#endif  // CHOMP_DOXYGEN